@@ -0,0 +1,44 @@
+#ifndef EVAS_BENCH_H
+#define EVAS_BENCH_H
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "evas_common.h"
+
+typedef struct _Evas_Bench Evas_Bench;
+
+/* one benchmark. setup runs once before timing and may fail by returning
+ * EINA_FALSE (missing font, engine not built in, ...), run does one pass
+ * and returns how many pixels it produced, cleanup undoes setup */
+struct _Evas_Bench
+{
+   const char *name;
+   Eina_Bool (*setup)   (Evas_Bench *b);
+   int       (*run)     (Evas_Bench *b);
+   void      (*cleanup) (Evas_Bench *b);
+   int         param[4];
+   void       *data;
+};
+
+typedef struct _Evas_Bench_Config Evas_Bench_Config;
+
+struct _Evas_Bench_Config
+{
+   const char *font;   /* font file for the text benchmarks */
+   int         w, h;   /* destination / canvas size */
+};
+
+extern Evas_Bench_Config evas_bench_config;
+
+Evas_Bench *evas_bench_add(const char *name,
+                           Eina_Bool (*setup) (Evas_Bench *b),
+                           int (*run) (Evas_Bench *b),
+                           void (*cleanup) (Evas_Bench *b),
+                           int p0, int p1, int p2, int p3);
+
+void evas_bench_core_register(void);
+void evas_bench_scene_register(void);
+
+#endif /* EVAS_BENCH_H */
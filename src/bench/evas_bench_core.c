@@ -0,0 +1,401 @@
+#include "evas_bench.h"
+#include "evas_blend_private.h"
+
+#include <math.h>
+
+/* benchmarks straight on top of the common engine code, no canvas: span
+ * functions, scaling, glyph drawing and map4 into a plain rgba surface */
+
+enum
+{
+   OP_PIXEL,
+   OP_COLOR,
+   OP_PIXEL_COLOR,
+   OP_MASK_COLOR,
+   OP_PIXEL_MASK,
+   OP_LAST
+};
+
+typedef struct _Bench_Surfaces Bench_Surfaces;
+
+struct _Bench_Surfaces
+{
+   RGBA_Image        *src, *dst;
+   RGBA_Draw_Context *dc;
+   DATA8             *mask;
+   DATA32             col;
+   RGBA_Gfx_Func      func;
+   RGBA_Font         *font;
+   Eina_Unicode      *text;
+   int                text_w, line_h;
+   RGBA_Map_Point     pt[4];
+};
+
+static const struct
+{
+   const char *name;
+   int         op;
+} bench_ops[] =
+{
+     { "blend", EVAS_RENDER_BLEND },
+     { "blend_rel", EVAS_RENDER_BLEND_REL },
+     { "copy", EVAS_RENDER_COPY },
+     { "copy_rel", EVAS_RENDER_COPY_REL },
+     { "mask", EVAS_RENDER_MASK },
+     { "mul", EVAS_RENDER_MUL }
+};
+
+static const char *bench_op_kinds[OP_LAST] =
+{
+   "pixel", "color", "pixel_color", "mask_color", "pixel_mask"
+};
+
+static const int bench_font_sizes[] = { 10, 24, 64 };
+
+static const char bench_text[] =
+  "The quick brown fox jumps over the lazy dog. 0123456789 "
+  "Pack my box with five dozen liquor jugs! ";
+
+/* an image full of a pattern with every alpha level in it, premultiplied
+ * like the engines expect */
+static RGBA_Image *
+_bench_image_new(int w, int h, int alpha)
+{
+   RGBA_Image *im;
+   DATA32 *p;
+   int x, y;
+
+   im = (RGBA_Image *)evas_cache_image_copied_data(evas_common_image_cache_get(),
+                                                   w, h, NULL, alpha,
+                                                   EVAS_COLORSPACE_ARGB8888);
+   if (!im) return NULL;
+   /* the pixels are all there, nothing to load */
+   im->cache_entry.flags.loaded = 1;
+   p = im->image.data;
+   for (y = 0; y < h; y++)
+     {
+        for (x = 0; x < w; x++)
+          {
+             int a = alpha ? ((x + y) & 0xff) : 0xff;
+             int r = (x * 7) & 0xff, g = (y * 3) & 0xff, b = (x ^ y) & 0xff;
+
+             *p++ = ARGB_JOIN(a, (r * a) / 255, (g * a) / 255, (b * a) / 255);
+          }
+     }
+   return im;
+}
+
+static void
+_bench_surfaces_free(Evas_Bench *b)
+{
+   Bench_Surfaces *bs = b->data;
+
+   if (!bs) return;
+   if (bs->src) evas_cache_image_drop(&bs->src->cache_entry);
+   if (bs->dst) evas_cache_image_drop(&bs->dst->cache_entry);
+   if (bs->dc) evas_common_draw_context_free(bs->dc);
+   if (bs->font) evas_common_font_free(bs->font);
+   free(bs->text);
+   free(bs->mask);
+   free(bs);
+   b->data = NULL;
+}
+
+static Bench_Surfaces *
+_bench_surfaces_new(Evas_Bench *b, int sw, int sh, int src_alpha, int dst_alpha)
+{
+   Bench_Surfaces *bs;
+
+   bs = calloc(1, sizeof(Bench_Surfaces));
+   if (!bs) return NULL;
+   b->data = bs;
+   if ((sw > 0) && (sh > 0))
+     {
+        bs->src = _bench_image_new(sw, sh, src_alpha);
+        if (!bs->src) goto error;
+     }
+   bs->dst = _bench_image_new(evas_bench_config.w, evas_bench_config.h, dst_alpha);
+   bs->dc = evas_common_draw_context_new();
+   if ((!bs->dst) || (!bs->dc)) goto error;
+   return bs;
+
+error:
+   _bench_surfaces_free(b);
+   return NULL;
+}
+
+/* span functions. param: op, kind, src alpha (or translucent color),
+ * dst alpha */
+
+static Eina_Bool
+_bench_op_setup(Evas_Bench *b)
+{
+   Bench_Surfaces *bs;
+   int op = bench_ops[b->param[0]].op;
+   int w = evas_bench_config.w, i;
+
+   bs = _bench_surfaces_new(b, w, evas_bench_config.h, b->param[2], b->param[3]);
+   if (!bs) return EINA_FALSE;
+   bs->col = b->param[2] ? 0x80604020 : 0xffc08040;
+   bs->mask = malloc(w);
+   if (!bs->mask) goto error;
+   /* runs of fully clear, partial and solid coverage */
+   for (i = 0; i < w; i++)
+     {
+        int v = i & 0xff;
+
+        bs->mask[i] = (v < 64) ? 0 : ((v < 192) ? v : 0xff);
+     }
+   switch (b->param[1])
+     {
+      case OP_PIXEL:
+        bs->func = evas_common_gfx_func_composite_pixel_span_get(bs->src, bs->dst, w, op);
+        break;
+      case OP_COLOR:
+        bs->func = evas_common_gfx_func_composite_color_span_get(bs->col, bs->dst, w, op);
+        break;
+      case OP_PIXEL_COLOR:
+        bs->func = evas_common_gfx_func_composite_pixel_color_span_get(bs->src, bs->col, bs->dst, w, op);
+        break;
+      case OP_MASK_COLOR:
+        bs->func = evas_common_gfx_func_composite_mask_color_span_get(bs->col, bs->dst, w, op);
+        break;
+      case OP_PIXEL_MASK:
+        bs->func = evas_common_gfx_func_composite_pixel_mask_span_get(bs->src, bs->dst, w, op);
+        break;
+      default:
+        break;
+     }
+   if (bs->func) return EINA_TRUE;
+
+error:
+   _bench_surfaces_free(b);
+   return EINA_FALSE;
+}
+
+static int
+_bench_op_run(Evas_Bench *b)
+{
+   Bench_Surfaces *bs = b->data;
+   int w = bs->dst->cache_entry.w, h = bs->dst->cache_entry.h, y;
+   DATA32 *s = bs->src->image.data, *d = bs->dst->image.data;
+
+   for (y = 0; y < h; y++)
+     {
+        bs->func(s, bs->mask, bs->col, d, w);
+        s += w;
+        d += w;
+     }
+   evas_common_cpu_end_opt();
+   return w * h;
+}
+
+/* scaling. param: smooth, up (or down), src alpha */
+
+static Eina_Bool
+_bench_scale_setup(Evas_Bench *b)
+{
+   Bench_Surfaces *bs;
+   int sw, sh;
+
+   if (b->param[1])
+     {
+        sw = (evas_bench_config.w + 1) / 2;
+        sh = (evas_bench_config.h + 1) / 2;
+     }
+   else
+     {
+        sw = evas_bench_config.w * 2;
+        sh = evas_bench_config.h * 2;
+     }
+   bs = _bench_surfaces_new(b, sw, sh, b->param[2], 0);
+   if (!bs) return EINA_FALSE;
+   evas_common_draw_context_set_render_op(bs->dc, EVAS_RENDER_BLEND);
+   return EINA_TRUE;
+}
+
+static int
+_bench_scale_run(Evas_Bench *b)
+{
+   Bench_Surfaces *bs = b->data;
+   int w = bs->dst->cache_entry.w, h = bs->dst->cache_entry.h;
+
+   if (b->param[0])
+     evas_common_scale_rgba_in_to_out_clip_smooth(bs->src, bs->dst, bs->dc,
+                                                  0, 0,
+                                                  bs->src->cache_entry.w,
+                                                  bs->src->cache_entry.h,
+                                                  0, 0, w, h);
+   else
+     evas_common_scale_rgba_in_to_out_clip_sample(bs->src, bs->dst, bs->dc,
+                                                  0, 0,
+                                                  bs->src->cache_entry.w,
+                                                  bs->src->cache_entry.h,
+                                                  0, 0, w, h);
+   evas_common_cpu_end_opt();
+   return w * h;
+}
+
+/* text. param: font size. counts the pixels of the line boxes drawn */
+
+static Eina_Bool
+_bench_font_setup(Evas_Bench *b)
+{
+   Bench_Surfaces *bs;
+   Evas_BiDi_Props props;
+   int len, th;
+
+   if (!evas_bench_config.font) return EINA_FALSE;
+   bs = _bench_surfaces_new(b, 0, 0, 0, 1);
+   if (!bs) return EINA_FALSE;
+   bs->font = evas_common_font_load(evas_bench_config.font, b->param[0]);
+   bs->text = evas_common_encoding_utf8_to_unicode(bench_text, &len);
+   if ((!bs->font) || (!bs->text)) goto error;
+   memset(&props, 0, sizeof(props));
+   evas_common_font_query_size(bs->font, bs->text, &props, &bs->text_w, &th);
+   bs->line_h = evas_common_font_get_line_advance(bs->font);
+   if (bs->line_h < 1) goto error;
+   if (bs->text_w > evas_bench_config.w) bs->text_w = evas_bench_config.w;
+   evas_common_draw_context_set_color(bs->dc, 0x20, 0x20, 0x20, 0xff);
+   evas_common_draw_context_set_render_op(bs->dc, EVAS_RENDER_BLEND);
+   return EINA_TRUE;
+
+error:
+   _bench_surfaces_free(b);
+   return EINA_FALSE;
+}
+
+static int
+_bench_font_run(Evas_Bench *b)
+{
+   Bench_Surfaces *bs = b->data;
+   Evas_BiDi_Props props;
+   int asc, y, lines = 0;
+
+   memset(&props, 0, sizeof(props));
+   asc = evas_common_font_max_ascent_get(bs->font);
+   for (y = 0; (y + bs->line_h) <= (int)bs->dst->cache_entry.h; y += bs->line_h)
+     {
+        evas_common_font_draw(bs->dst, bs->dc, bs->font, 0, y + asc, bs->text, &props);
+        lines++;
+     }
+   evas_common_cpu_end_opt();
+   return lines * bs->line_h * bs->text_w;
+}
+
+/* map4. param: smooth, src alpha. a half sized image turned by 30
+ * degrees around the middle of the surface */
+
+static Eina_Bool
+_bench_map_setup(Evas_Bench *b)
+{
+   Bench_Surfaces *bs;
+   double cx, cy, co, si;
+   int sw, sh, i;
+
+   sw = (evas_bench_config.w + 1) / 2;
+   sh = (evas_bench_config.h + 1) / 2;
+   bs = _bench_surfaces_new(b, sw, sh, b->param[1], 0);
+   if (!bs) return EINA_FALSE;
+   evas_common_draw_context_set_render_op(bs->dc, EVAS_RENDER_BLEND);
+   cx = evas_bench_config.w / 2.0;
+   cy = evas_bench_config.h / 2.0;
+   co = cos(M_PI / 6.0);
+   si = sin(M_PI / 6.0);
+   for (i = 0; i < 4; i++)
+     {
+        double u = ((i == 1) || (i == 2)) ? sw : 0;
+        double v = (i >= 2) ? sh : 0;
+        double x = u - (sw / 2.0), y = v - (sh / 2.0);
+
+        bs->pt[i].x = (FPc)((cx + (x * co) - (y * si)) * (1 << FP));
+        bs->pt[i].y = (FPc)((cy + (x * si) + (y * co)) * (1 << FP));
+        bs->pt[i].u = (FPc)(u * (1 << FP));
+        bs->pt[i].v = (FPc)(v * (1 << FP));
+        bs->pt[i].col = 0xffffffff;
+     }
+   return EINA_TRUE;
+}
+
+static int
+_bench_map_run(Evas_Bench *b)
+{
+   Bench_Surfaces *bs = b->data;
+
+   evas_common_map_rgba(bs->src, bs->dst, bs->dc, 4, bs->pt, b->param[0], 0);
+   evas_common_cpu_end_opt();
+   return bs->src->cache_entry.w * bs->src->cache_entry.h;
+}
+
+void
+evas_bench_core_register(void)
+{
+   char buf[256];
+   unsigned int op, i;
+   int kind, sa, da, smooth, up;
+
+   evas_common_cpu_init();
+   evas_common_blend_init();
+   evas_common_image_init();
+   evas_common_convert_init();
+   evas_common_scale_init();
+   evas_common_rectangle_init();
+   evas_common_polygon_init();
+   evas_common_line_init();
+   evas_common_font_init();
+   evas_common_draw_init();
+   evas_common_tilebuf_init();
+
+   for (op = 0; op < (sizeof(bench_ops) / sizeof(bench_ops[0])); op++)
+     {
+        for (kind = 0; kind < OP_LAST; kind++)
+          {
+             for (sa = 0; sa <= 1; sa++)
+               {
+                  for (da = 0; da <= 1; da++)
+                    {
+                       snprintf(buf, sizeof(buf), "op/%s/%s/%s/%s",
+                                bench_ops[op].name, bench_op_kinds[kind],
+                                sa ? "src_alpha" : "src_solid",
+                                da ? "dst_alpha" : "dst_solid");
+                       evas_bench_add(buf, _bench_op_setup, _bench_op_run,
+                                      _bench_surfaces_free, op, kind, sa, da);
+                    }
+               }
+          }
+     }
+
+   for (smooth = 1; smooth >= 0; smooth--)
+     {
+        for (up = 1; up >= 0; up--)
+          {
+             for (sa = 0; sa <= 1; sa++)
+               {
+                  snprintf(buf, sizeof(buf), "scale/%s/%s/%s",
+                           smooth ? "smooth" : "sample", up ? "up" : "down",
+                           sa ? "src_alpha" : "src_solid");
+                  evas_bench_add(buf, _bench_scale_setup, _bench_scale_run,
+                                 _bench_surfaces_free, smooth, up, sa, 0);
+               }
+          }
+     }
+
+   for (i = 0; i < (sizeof(bench_font_sizes) / sizeof(bench_font_sizes[0])); i++)
+     {
+        snprintf(buf, sizeof(buf), "font/draw/%i", bench_font_sizes[i]);
+        evas_bench_add(buf, _bench_font_setup, _bench_font_run,
+                       _bench_surfaces_free, bench_font_sizes[i], 0, 0, 0);
+     }
+
+   for (smooth = 1; smooth >= 0; smooth--)
+     {
+        for (sa = 0; sa <= 1; sa++)
+          {
+             snprintf(buf, sizeof(buf), "map4/%s/%s",
+                      smooth ? "smooth" : "sample",
+                      sa ? "src_alpha" : "src_solid");
+             evas_bench_add(buf, _bench_map_setup, _bench_map_run,
+                            _bench_surfaces_free, smooth, sa, 0, 0);
+          }
+     }
+}
@@ -0,0 +1,470 @@
+#include "evas_bench.h"
+
+#include <time.h>
+
+/* evas_bench - throughput of the software rasterizer, from single span
+ * functions up to whole frames through evas_render_updates(). every
+ * benchmark is run for a fixed time a few rounds in a row and the best
+ * round counts. results can be written as json and compared against an
+ * earlier json file, which makes the exit status non zero when anything
+ * got slower than the threshold. */
+
+typedef struct _Bench_Result Bench_Result;
+
+struct _Bench_Result
+{
+   char   *name;
+   double  mpix;
+   double  secs;
+   int     runs;
+};
+
+Evas_Bench_Config evas_bench_config = { NULL, 800, 600 };
+
+static Evas_Bench **benches = NULL;
+static int benches_num = 0;
+static int benches_alloc = 0;
+
+static const char *default_fonts[] =
+{
+   "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+   "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+   "/usr/share/fonts/TTF/DejaVuSans.ttf",
+   "/usr/share/fonts/truetype/ttf-dejavu/DejaVuSans.ttf",
+   "/usr/share/fonts/truetype/freefont/FreeSans.ttf",
+   "/usr/share/fonts/liberation/LiberationSans-Regular.ttf",
+   NULL
+};
+
+Evas_Bench *
+evas_bench_add(const char *name,
+               Eina_Bool (*setup) (Evas_Bench *b),
+               int (*run) (Evas_Bench *b),
+               void (*cleanup) (Evas_Bench *b),
+               int p0, int p1, int p2, int p3)
+{
+   Evas_Bench *b;
+
+   if (benches_num == benches_alloc)
+     {
+        Evas_Bench **tmp;
+
+        tmp = realloc(benches, (benches_alloc + 64) * sizeof(Evas_Bench *));
+        if (!tmp) return NULL;
+        benches = tmp;
+        benches_alloc += 64;
+     }
+   b = calloc(1, sizeof(Evas_Bench));
+   if (!b) return NULL;
+   b->name = strdup(name);
+   b->setup = setup;
+   b->run = run;
+   b->cleanup = cleanup;
+   b->param[0] = p0;
+   b->param[1] = p1;
+   b->param[2] = p2;
+   b->param[3] = p3;
+   benches[benches_num++] = b;
+   return b;
+}
+
+static double
+_bench_time_get(void)
+{
+   struct timespec t;
+
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return (double)t.tv_sec + ((double)t.tv_nsec / 1000000000.0);
+}
+
+static Eina_Bool
+_bench_run(Evas_Bench *b, double min_time, int rounds, Bench_Result *res)
+{
+   int i;
+
+   if ((b->setup) && (!b->setup(b))) return EINA_FALSE;
+   /* warm caches, lazy inits and the like before anything is timed */
+   b->run(b);
+   for (i = 0; i < rounds; i++)
+     {
+        double t0, t;
+        double pixels = 0.0;
+        int runs = 0;
+
+        t0 = _bench_time_get();
+        do
+          {
+             pixels += b->run(b);
+             runs++;
+             t = _bench_time_get() - t0;
+          }
+        while (t < min_time);
+        if ((pixels / t) > (res->mpix * 1000000.0))
+          {
+             res->mpix = pixels / t / 1000000.0;
+             res->secs = t;
+             res->runs = runs;
+          }
+     }
+   if (b->cleanup) b->cleanup(b);
+   return EINA_TRUE;
+}
+
+static void
+_bench_json_string_write(FILE *f, const char *s)
+{
+   fputc('"', f);
+   for (; *s; s++)
+     {
+        if ((*s == '"') || (*s == '\\')) fputc('\\', f);
+        fputc(*s, f);
+     }
+   fputc('"', f);
+}
+
+static const char *
+_bench_cpu_string(void)
+{
+   static char buf[128];
+
+   buf[0] = 0;
+   if (evas_common_cpu_has_feature(CPU_FEATURE_MMX)) strcat(buf, " mmx");
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE)) strcat(buf, " sse");
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE2)) strcat(buf, " sse2");
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSSE3)) strcat(buf, " ssse3");
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE4_1)) strcat(buf, " sse4.1");
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2)) strcat(buf, " avx2");
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON)) strcat(buf, " neon");
+   if (evas_common_cpu_has_feature(CPU_FEATURE_ALTIVEC)) strcat(buf, " altivec");
+   return buf[0] ? buf + 1 : "c";
+}
+
+static Eina_Bool
+_bench_json_write(const char *file, Bench_Result *res, int num,
+                  double min_time, int rounds)
+{
+   FILE *f;
+   int i;
+
+   if (!strcmp(file, "-")) f = stdout;
+   else f = fopen(file, "w");
+   if (!f) return EINA_FALSE;
+   fprintf(f, "{\n");
+   fprintf(f, "  \"version\": 1,\n");
+   fprintf(f, "  \"cpu\": \"%s\",\n", _bench_cpu_string());
+   fprintf(f, "  \"width\": %i,\n", evas_bench_config.w);
+   fprintf(f, "  \"height\": %i,\n", evas_bench_config.h);
+   fprintf(f, "  \"time\": %.3f,\n", min_time);
+   fprintf(f, "  \"rounds\": %i,\n", rounds);
+   fprintf(f, "  \"results\": [\n");
+   for (i = 0; i < num; i++)
+     {
+        fprintf(f, "    { \"name\": ");
+        _bench_json_string_write(f, res[i].name);
+        fprintf(f, ", \"mpix_s\": %.3f, \"runs\": %i, \"seconds\": %.4f }%s\n",
+                res[i].mpix, res[i].runs, res[i].secs,
+                (i < (num - 1)) ? "," : "");
+     }
+   fprintf(f, "  ]\n}\n");
+   if (f != stdout) fclose(f);
+   return EINA_TRUE;
+}
+
+/* reads back what _bench_json_write() writes, it is not a general json
+ * parser: every "name" string is paired with the "mpix_s" number of the
+ * same object */
+static Bench_Result *
+_bench_json_read(const char *file, int *num)
+{
+   Bench_Result *res = NULL;
+   char *buf, *p;
+   FILE *f;
+   long size;
+   int n = 0, alloc = 0;
+
+   *num = 0;
+   f = fopen(file, "r");
+   if (!f) return NULL;
+   fseek(f, 0, SEEK_END);
+   size = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   buf = malloc(size + 1);
+   if ((!buf) || (fread(buf, 1, size, f) != (size_t)size))
+     {
+        free(buf);
+        fclose(f);
+        return NULL;
+     }
+   buf[size] = 0;
+   fclose(f);
+
+   p = buf;
+   while ((p = strstr(p, "\"name\"")))
+     {
+        char *name, *s, *d, *end, *v;
+
+        p += 6;
+        name = strchr(p, '"');
+        if (!name) break;
+        name++;
+        /* unescape in place */
+        for (s = d = name; (*s) && (*s != '"'); s++)
+          {
+             if ((*s == '\\') && (s[1])) s++;
+             *d++ = *s;
+          }
+        if (!*s) break;
+        end = strchr(s, '}');
+        v = strstr(s, "\"mpix_s\"");
+        *d = 0;
+        if ((!v) || ((end) && (v > end)))
+          {
+             p = s + 1;
+             continue;
+          }
+        if (n == alloc)
+          {
+             Bench_Result *tmp;
+
+             tmp = realloc(res, (alloc + 64) * sizeof(Bench_Result));
+             if (!tmp) break;
+             res = tmp;
+             alloc += 64;
+          }
+        v = strchr(v + 8, ':');
+        if (!v) break;
+        memset(res + n, 0, sizeof(Bench_Result));
+        res[n].name = strdup(name);
+        res[n].mpix = strtod(v + 1, NULL);
+        n++;
+        p = v;
+     }
+   free(buf);
+   *num = n;
+   return res;
+}
+
+static int
+_bench_compare(Bench_Result *base, int base_num,
+               Bench_Result *res, int num, double threshold)
+{
+   int i, j, worse = 0, better = 0;
+
+   printf("\n%-52s %10s %10s %8s\n", "benchmark", "base", "now", "change");
+   for (i = 0; i < num; i++)
+     {
+        const char *mark = "";
+        double change;
+
+        for (j = 0; j < base_num; j++)
+          if (!strcmp(base[j].name, res[i].name)) break;
+        if ((j == base_num) || (base[j].mpix <= 0.0))
+          {
+             printf("%-52s %10s %10.1f %8s\n", res[i].name, "-", res[i].mpix, "new");
+             continue;
+          }
+        change = ((res[i].mpix - base[j].mpix) * 100.0) / base[j].mpix;
+        if (change < -threshold)
+          {
+             mark = "  SLOWER";
+             worse++;
+          }
+        else if (change > threshold)
+          {
+             mark = "  faster";
+             better++;
+          }
+        printf("%-52s %10.1f %10.1f %+7.1f%%%s\n", res[i].name,
+               base[j].mpix, res[i].mpix, change, mark);
+     }
+   printf("\n%i slower, %i faster (threshold %.1f%%)\n", worse, better, threshold);
+   return worse;
+}
+
+static void
+_bench_results_free(Bench_Result *res, int num)
+{
+   int i;
+
+   if (!res) return;
+   for (i = 0; i < num; i++) free(res[i].name);
+   free(res);
+}
+
+static const char *
+_bench_font_find(void)
+{
+   const char *s;
+   int i;
+
+   s = getenv("EVAS_BENCH_FONT");
+   if (s) return s;
+   for (i = 0; default_fonts[i]; i++)
+     {
+        if (!access(default_fonts[i], R_OK)) return default_fonts[i];
+     }
+   return NULL;
+}
+
+static void
+_bench_usage(const char *prog)
+{
+   printf("Usage: %s [OPTIONS]\n"
+          "\n"
+          "Options:\n"
+          "\t-h, --help              This help\n"
+          "\t-l, --list              List the benchmarks and exit\n"
+          "\t-f, --filter TEXT       Only run benchmarks whose name contains TEXT\n"
+          "\t-t, --time SECONDS      Time each round runs for (default 0.25)\n"
+          "\t-r, --rounds N          Rounds per benchmark, the best one counts (default 3)\n"
+          "\t-s, --size WxH          Destination/canvas size (default 800x600)\n"
+          "\t    --font FILE         Font file for the text benchmarks\n"
+          "\t-o, --json FILE         Write results as json to FILE (- for stdout)\n"
+          "\t-c, --compare FILE      Compare results against an earlier json file\n"
+          "\t-i, --input FILE        With --compare: compare FILE instead of running\n"
+          "\t-T, --threshold PERCENT Change that counts as slower/faster (default 5)\n"
+          "\n"
+          "With --compare the exit status is 1 if any benchmark got slower.\n",
+          prog);
+}
+
+int
+main(int argc, char **argv)
+{
+   Bench_Result *res = NULL, *base = NULL;
+   const char *filter = NULL, *json = NULL, *compare = NULL, *input = NULL;
+   double min_time = 0.25, threshold = 5.0;
+   int rounds = 3, list = 0, num = 0, base_num = 0, ret = 0;
+   int i;
+
+   for (i = 1; i < argc; i++)
+     {
+#define ARG(s, l) ((!strcmp(argv[i], s)) || (!strcmp(argv[i], l)))
+#define VAL(s, l) (ARG(s, l) && (i < (argc - 1)))
+        if (ARG("-h", "--help"))
+          {
+             _bench_usage(argv[0]);
+             return 0;
+          }
+        else if (ARG("-l", "--list")) list = 1;
+        else if (VAL("-f", "--filter")) filter = argv[++i];
+        else if (VAL("-t", "--time")) min_time = atof(argv[++i]);
+        else if (VAL("-r", "--rounds")) rounds = atoi(argv[++i]);
+        else if (VAL("-s", "--size"))
+          {
+             i++;
+             if (sscanf(argv[i], "%ix%i", &evas_bench_config.w, &evas_bench_config.h) != 2)
+               {
+                  fprintf(stderr, "ERROR: bad size '%s'\n", argv[i]);
+                  return -1;
+               }
+          }
+        else if ((!strcmp(argv[i], "--font")) && (i < (argc - 1)))
+          evas_bench_config.font = argv[++i];
+        else if (VAL("-o", "--json")) json = argv[++i];
+        else if (VAL("-c", "--compare")) compare = argv[++i];
+        else if (VAL("-i", "--input")) input = argv[++i];
+        else if (VAL("-T", "--threshold")) threshold = atof(argv[++i]);
+        else
+          {
+             fprintf(stderr, "ERROR: unknown option '%s'\n", argv[i]);
+             _bench_usage(argv[0]);
+             return -1;
+          }
+#undef VAL
+#undef ARG
+     }
+   if (rounds < 1) rounds = 1;
+   if ((evas_bench_config.w < 1) || (evas_bench_config.h < 1))
+     {
+        fprintf(stderr, "ERROR: bad size %ix%i\n", evas_bench_config.w, evas_bench_config.h);
+        return -1;
+     }
+
+   if (compare)
+     {
+        base = _bench_json_read(compare, &base_num);
+        if (!base)
+          {
+             fprintf(stderr, "ERROR: cannot read results from '%s'\n", compare);
+             return -1;
+          }
+     }
+   if (input)
+     {
+        if (!compare)
+          {
+             fprintf(stderr, "ERROR: --input needs --compare\n");
+             return -1;
+          }
+        res = _bench_json_read(input, &num);
+        if (!res)
+          {
+             fprintf(stderr, "ERROR: cannot read results from '%s'\n", input);
+             return -1;
+          }
+        ret = (_bench_compare(base, base_num, res, num, threshold) > 0);
+        _bench_results_free(res, num);
+        _bench_results_free(base, base_num);
+        return ret;
+     }
+
+   evas_init();
+   if (!evas_bench_config.font) evas_bench_config.font = _bench_font_find();
+   evas_bench_core_register();
+   evas_bench_scene_register();
+
+   if (list)
+     {
+        for (i = 0; i < benches_num; i++)
+          {
+             if ((!filter) || (strstr(benches[i]->name, filter)))
+               printf("%s\n", benches[i]->name);
+          }
+        goto done;
+     }
+
+   res = calloc(benches_num ? benches_num : 1, sizeof(Bench_Result));
+   if (!res) goto done;
+   /* progress goes to stderr so json on stdout stays clean */
+   fprintf(stderr, "evas_bench: %ix%i, %.2fs x %i rounds, cpu: %s\n",
+           evas_bench_config.w, evas_bench_config.h, min_time, rounds,
+           _bench_cpu_string());
+   for (i = 0; i < benches_num; i++)
+     {
+        Evas_Bench *b = benches[i];
+
+        if ((filter) && (!strstr(b->name, filter))) continue;
+        if (!_bench_run(b, min_time, rounds, res + num))
+          {
+             fprintf(stderr, "%-52s %12s\n", b->name, "skipped");
+             continue;
+          }
+        res[num].name = strdup(b->name);
+        fprintf(stderr, "%-52s %10.1f Mpix/s\n", res[num].name, res[num].mpix);
+        num++;
+     }
+
+   if ((json) && (!_bench_json_write(json, res, num, min_time, rounds)))
+     {
+        fprintf(stderr, "ERROR: cannot write '%s'\n", json);
+        ret = -1;
+     }
+   if (base)
+     {
+        if (_bench_compare(base, base_num, res, num, threshold) > 0)
+          ret = 1;
+     }
+
+done:
+   _bench_results_free(res, num);
+   _bench_results_free(base, base_num);
+   for (i = 0; i < benches_num; i++)
+     {
+        free((char *)benches[i]->name);
+        free(benches[i]);
+     }
+   free(benches);
+   evas_shutdown();
+   return ret;
+}
@@ -0,0 +1,228 @@
+#include "evas_bench.h"
+
+#include <Evas_Engine_Buffer.h>
+
+/* whole frames through evas_render_updates() on the buffer engine. the
+ * full canvas is damaged before every frame so each run repaints all of
+ * it, whatever the object count */
+
+enum
+{
+   SCENE_RECT,
+   SCENE_IMAGE,
+   SCENE_IMAGE_SCALED,
+   SCENE_TEXT,
+   SCENE_TEXTBLOCK,
+   SCENE_LAST
+};
+
+typedef struct _Bench_Scene Bench_Scene;
+
+struct _Bench_Scene
+{
+   Evas   *evas;
+   DATA32 *pixels;
+};
+
+static const char *bench_scene_names[SCENE_LAST] =
+{
+   "rect", "image", "image_scaled", "text", "textblock"
+};
+
+static const int bench_scene_counts[] = { 10, 100, 1000 };
+
+#define IMG_W 64
+#define IMG_H 64
+
+static void
+_bench_scene_cleanup(Evas_Bench *b)
+{
+   Bench_Scene *sc = b->data;
+
+   if (!sc) return;
+   /* objects go away with the canvas */
+   if (sc->evas) evas_free(sc->evas);
+   free(sc->pixels);
+   free(sc);
+   b->data = NULL;
+}
+
+static Evas *
+_bench_scene_canvas_new(Bench_Scene *sc, int w, int h)
+{
+   Evas_Engine_Info_Buffer *einfo;
+   Evas *e;
+   int method;
+
+   method = evas_render_method_lookup("buffer");
+   if (method <= 0) return NULL;
+   sc->pixels = malloc(w * h * sizeof(DATA32));
+   if (!sc->pixels) return NULL;
+   e = evas_new();
+   if (!e) return NULL;
+   evas_output_method_set(e, method);
+   evas_output_size_set(e, w, h);
+   evas_output_viewport_set(e, 0, 0, w, h);
+   einfo = (Evas_Engine_Info_Buffer *)evas_engine_info_get(e);
+   if (!einfo)
+     {
+        evas_free(e);
+        return NULL;
+     }
+   einfo->info.depth_type = EVAS_ENGINE_BUFFER_DEPTH_ARGB32;
+   einfo->info.dest_buffer = sc->pixels;
+   einfo->info.dest_buffer_row_bytes = w * sizeof(DATA32);
+   einfo->info.use_color_key = 0;
+   einfo->info.alpha_threshold = 0;
+   einfo->info.func.new_update_region = NULL;
+   einfo->info.func.free_update_region = NULL;
+   evas_engine_info_set(e, (Evas_Engine_Info *)einfo);
+   return e;
+}
+
+static void
+_bench_scene_image_fill(Evas_Object *o)
+{
+   DATA32 pixels[IMG_W * IMG_H], *p = pixels;
+   int x, y;
+
+   for (y = 0; y < IMG_H; y++)
+     {
+        for (x = 0; x < IMG_W; x++)
+          {
+             int a = ((x ^ y) & 0x20) ? 0xff : 0x80 + (x * 2);
+
+             *p++ = ARGB_JOIN(a, (x * 4 * a) / 255, (y * 4 * a) / 255, a / 2);
+          }
+     }
+   evas_object_image_alpha_set(o, 1);
+   evas_object_image_size_set(o, IMG_W, IMG_H);
+   evas_object_image_data_copy_set(o, pixels);
+}
+
+static Eina_Bool
+_bench_scene_setup(Evas_Bench *b)
+{
+   Bench_Scene *sc;
+   Evas_Object *o;
+   char buf[PATH_MAX + 128];
+   int w = evas_bench_config.w, h = evas_bench_config.h;
+   int kind = b->param[0], num = b->param[1], ow, oh, i;
+   unsigned int seed = 0x1234567;
+
+   if (((kind == SCENE_TEXT) || (kind == SCENE_TEXTBLOCK)) &&
+       (!evas_bench_config.font))
+     return EINA_FALSE;
+   sc = calloc(1, sizeof(Bench_Scene));
+   if (!sc) return EINA_FALSE;
+   b->data = sc;
+   sc->evas = _bench_scene_canvas_new(sc, w, h);
+   if (!sc->evas)
+     {
+        _bench_scene_cleanup(b);
+        return EINA_FALSE;
+     }
+
+   o = evas_object_rectangle_add(sc->evas);
+   evas_object_color_set(o, 255, 255, 255, 255);
+   evas_object_resize(o, w, h);
+   evas_object_show(o);
+
+   ow = w / 6;
+   oh = h / 6;
+   if (kind == SCENE_IMAGE)
+     {
+        ow = IMG_W;
+        oh = IMG_H;
+     }
+   for (i = 0; i < num; i++)
+     {
+        int x, y, a;
+
+        /* same layout every run, so numbers stay comparable */
+        seed = (seed * 1103515245) + 12345;
+        x = (seed >> 8) % (w - ow + 1);
+        seed = (seed * 1103515245) + 12345;
+        y = (seed >> 8) % (h - oh + 1);
+        a = (i & 1) ? 255 : 160;
+        switch (kind)
+          {
+           case SCENE_RECT:
+             o = evas_object_rectangle_add(sc->evas);
+             evas_object_color_set(o, (i * 37) & a, (i * 91) & a, (i * 13) & a, a);
+             break;
+           case SCENE_IMAGE:
+           case SCENE_IMAGE_SCALED:
+             o = evas_object_image_add(sc->evas);
+             _bench_scene_image_fill(o);
+             evas_object_image_fill_set(o, 0, 0, ow, oh);
+             evas_object_image_smooth_scale_set(o, i & 1);
+             break;
+           case SCENE_TEXT:
+             o = evas_object_text_add(sc->evas);
+             evas_object_text_font_set(o, evas_bench_config.font, 10 + (i % 4) * 4);
+             evas_object_text_text_set(o, "The quick brown fox jumps over the lazy dog");
+             evas_object_color_set(o, 0, 0, 0, a);
+             break;
+           case SCENE_TEXTBLOCK:
+             {
+                Evas_Textblock_Style *st;
+
+                o = evas_object_textblock_add(sc->evas);
+                st = evas_textblock_style_new();
+                snprintf(buf, sizeof(buf),
+                         "DEFAULT='font=%s font_size=%i color=#000 wrap=word' "
+                         "br='\\n'",
+                         evas_bench_config.font, 10 + (i % 3) * 2);
+                evas_textblock_style_set(st, buf);
+                evas_object_textblock_style_set(o, st);
+                evas_textblock_style_free(st);
+                evas_object_textblock_text_markup_set
+                  (o, "Pack my box with five dozen liquor jugs.<br>"
+                   "The quick brown fox jumps over the lazy dog, "
+                   "again and again and again.");
+             }
+             break;
+           default:
+             break;
+          }
+        evas_object_move(o, x, y);
+        evas_object_resize(o, ow, oh);
+        evas_object_show(o);
+     }
+
+   /* first frame does all the loading and layouting, keep it untimed */
+   evas_render_updates_free(evas_render_updates(sc->evas));
+   return EINA_TRUE;
+}
+
+static int
+_bench_scene_run(Evas_Bench *b)
+{
+   Bench_Scene *sc = b->data;
+   int w = evas_bench_config.w, h = evas_bench_config.h;
+
+   evas_damage_rectangle_add(sc->evas, 0, 0, w, h);
+   evas_render_updates_free(evas_render_updates(sc->evas));
+   return w * h;
+}
+
+void
+evas_bench_scene_register(void)
+{
+   char buf[256];
+   unsigned int i;
+   int kind;
+
+   for (kind = 0; kind < SCENE_LAST; kind++)
+     {
+        for (i = 0; i < (sizeof(bench_scene_counts) / sizeof(bench_scene_counts[0])); i++)
+          {
+             snprintf(buf, sizeof(buf), "scene/%s/%i",
+                      bench_scene_names[kind], bench_scene_counts[i]);
+             evas_bench_add(buf, _bench_scene_setup, _bench_scene_run,
+                            _bench_scene_cleanup, kind, bench_scene_counts[i],
+                            0, 0);
+          }
+     }
+}
@@ -0,0 +1,224 @@
+#include "evas_simd_check.h"
+
+/* evas_simd_check - runs every sse4.1 and avx2 span function registered
+ * in the op tables against the C function of the same slot and wants the
+ * very same bytes out. spans are random, of every length up to a few
+ * vectors (so all the tails that are not a multiple of 4 or 8 get done),
+ * start at every alignment and are done with random, all 0 and all 255
+ * masks. the pixels after each span are checked to be left alone too.
+ * the exit status is non zero when anything differs. */
+
+#define LEN_MAX 1024
+#define GUARD 16
+
+typedef struct _Simd_Check_Op Simd_Check_Op;
+
+struct _Simd_Check_Op
+{
+   const char         *name;
+   Simd_Check_Table *(*table) (void);
+};
+
+static const Simd_Check_Op ops[] =
+{
+   { "copy", simd_check_copy_table },
+   { "copy_rel", simd_check_copy_rel_table },
+   { "blend", simd_check_blend_table },
+   { "blend_rel", simd_check_blend_rel_table },
+   { "add", simd_check_add_table },
+   { "add_rel", simd_check_add_rel_table },
+   { "sub", simd_check_sub_table },
+   { "sub_rel", simd_check_sub_rel_table },
+   { "mask", simd_check_mask_table },
+   { "mul", simd_check_mul_table },
+   { NULL, NULL }
+};
+
+static const struct
+{
+   const char  *name;
+   int          cpu;
+   unsigned int feature;
+} cpus[] =
+{
+   { "sse4", CPU_SSE4, CPU_FEATURE_SSE4_1 },
+   { "avx2", CPU_AVX2, CPU_FEATURE_AVX2 },
+   { NULL, 0, 0 }
+};
+
+enum
+{
+   MASK_RANDOM,
+   MASK_ZERO,
+   MASK_FULL,
+   MASK_LAST
+};
+
+static const char *mask_names[] = { "random", "all 0", "all 255" };
+
+static unsigned int seed = 0x12345678;
+
+static DATA32 src[LEN_MAX + 8 + GUARD];
+static DATA8  mask[LEN_MAX + 8 + GUARD];
+static DATA32 dst[LEN_MAX + 8 + GUARD];
+static DATA32 dst_c[LEN_MAX + 8 + GUARD];
+static DATA32 dst_v[LEN_MAX + 8 + GUARD];
+
+static unsigned int
+_rnd(void)
+{
+   /* xorshift, so a seed gives the same spans everywhere */
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   return seed;
+}
+
+/* a premultiplied pixel, alpha any, 255 or mostly 0 or 255 */
+static DATA32
+_pixel(int opaque, int sparse)
+{
+   DATA32 a, r, g, b;
+
+   a = _rnd() & 0xff;
+   if (opaque) a = 255;
+   else if ((sparse) && (_rnd() & 0x3)) a = (_rnd() & 0x1) ? 255 : 0;
+   r = _rnd() % (a + 1);
+   g = _rnd() % (a + 1);
+   b = _rnd() % (a + 1);
+   return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+static DATA32
+_color(int c)
+{
+   DATA32 a;
+
+   switch (c)
+     {
+      case SC_N:
+        return 0xffffffff;
+      case SC_AN:
+        return 0xff000000 | (_rnd() & 0xffffff);
+      case SC_AA:
+        a = _rnd() & 0xff;
+        return (a << 24) | (a << 16) | (a << 8) | a;
+      default:
+        return _pixel(0, 0);
+     }
+}
+
+static void
+_fill(int s, int m, int d, int mp)
+{
+   int i;
+
+   for (i = 0; i < (LEN_MAX + 8 + GUARD); i++)
+     {
+        src[i] = _pixel(s == SP_AN, s == SP_AS);
+        if (mp == MASK_ZERO) mask[i] = 0;
+        else if (mp == MASK_FULL) mask[i] = 255;
+        else if ((m == SM_AT) || ((m == SM_AS) && (_rnd() & 0x3)))
+          mask[i] = (_rnd() & 0x1) ? 255 : 0;
+        else
+          mask[i] = _rnd() & 0xff;
+        dst[i] = _pixel(d == DP_AN, 0);
+     }
+}
+
+static int
+_pow2(int n)
+{
+   return (n > 0) && (!(n & (n - 1)));
+}
+
+/* returns 1 if func did what ref did on every span */
+static int
+_slot_check(const char *op, const char *cpu, int s, int m, int c, int d,
+            RGBA_Gfx_Func ref, RGBA_Gfx_Func func)
+{
+   DATA32 col;
+   int mp, len, off, i, n;
+
+   n = (LEN_MAX + 8 + GUARD) * sizeof(DATA32);
+   for (mp = 0; mp < MASK_LAST; mp++)
+     {
+        for (len = 0; len <= LEN_MAX; len++)
+          {
+             /* every length up to a few vectors, then just around the
+              * bigger powers of 2 */
+             if ((len > 72) && (!_pow2(len - 1)) && (!_pow2(len)) &&
+                 (!_pow2(len + 1)))
+               continue;
+             _fill(s, m, d, mp);
+             col = _color(c);
+             for (off = 0; off < 8; off++)
+               {
+                  memcpy(dst_c, dst, n);
+                  memcpy(dst_v, dst, n);
+                  ref((s == SP_N) ? NULL : src + off,
+                      (m == SM_N) ? NULL : mask + off,
+                      col, dst_c + off, len);
+                  func((s == SP_N) ? NULL : src + off,
+                       (m == SM_N) ? NULL : mask + off,
+                       col, dst_v + off, len);
+                  if (!memcmp(dst_c, dst_v, n)) continue;
+                  for (i = 0; dst_c[i] == dst_v[i]; i++);
+                  printf("FAIL %s [sp %i][sm %i][sc %i][dp %i] %s: "
+                         "len %i at +%i, %s mask, color %08x: "
+                         "pixel %i is %08x, C has %08x\n",
+                         op, s, m, c, d, cpu, len, off, mask_names[mp], col,
+                         i - off, dst_v[i], dst_c[i]);
+                  return 0;
+               }
+          }
+     }
+   return 1;
+}
+
+int
+main(int argc, char **argv)
+{
+   int o, k, s, m, c, d;
+   int checked = 0, failed = 0, skipped = 0;
+
+   if (argc > 1) seed = strtoul(argv[1], NULL, 0);
+   if (!seed) seed = 1;
+   evas_common_cpu_init();
+   for (o = 0; ops[o].name; o++)
+     {
+        Simd_Check_Table *t = ops[o].table();
+
+        for (k = 0; cpus[k].name; k++)
+          for (s = 0; s < SP_LAST; s++)
+            for (m = 0; m < SM_LAST; m++)
+              for (c = 0; c < SC_LAST; c++)
+                for (d = 0; d < DP_LAST; d++)
+                  {
+                     RGBA_Gfx_Func func = (*t)[s][m][c][d][cpus[k].cpu];
+                     RGBA_Gfx_Func ref = (*t)[s][m][c][d][CPU_C];
+
+                     if (!func) continue;
+                     if (!evas_common_cpu_has_feature(cpus[k].feature))
+                       {
+                          skipped++;
+                          continue;
+                       }
+                     checked++;
+                     if (!ref)
+                       {
+                          printf("FAIL %s [sp %i][sm %i][sc %i][dp %i] %s: "
+                                 "no C function to check against\n",
+                                 ops[o].name, s, m, c, d, cpus[k].name);
+                          failed++;
+                          continue;
+                       }
+                     if (!_slot_check(ops[o].name, cpus[k].name,
+                                      s, m, c, d, ref, func))
+                       failed++;
+                  }
+     }
+   printf("%i functions checked, %i failed, %i skipped (cpu lacks them)\n",
+          checked, failed, skipped);
+   return failed ? 1 : 0;
+}
@@ -0,0 +1,36 @@
+#ifndef EVAS_SIMD_CHECK_H
+#define EVAS_SIMD_CHECK_H
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "evas_common.h"
+
+/* the span function table of one op, as its init fills it */
+typedef RGBA_Gfx_Func Simd_Check_Table[SP_LAST][SM_LAST][SC_LAST][DP_LAST][CPU_LAST];
+
+/* the tables are static in evas_op_*_main_.c, so each
+ * evas_simd_check_<op>.c includes that file and hands its tables out
+ * with this. the compositor getters of the included file are renamed
+ * first so they do not stand in for the ones in libevas */
+#define SIMD_CHECK_TABLE(name, init, table) \
+Simd_Check_Table * \
+simd_check_##name##_table(void) \
+{ \
+   init(); \
+   return &(table); \
+}
+
+Simd_Check_Table *simd_check_copy_table(void);
+Simd_Check_Table *simd_check_copy_rel_table(void);
+Simd_Check_Table *simd_check_blend_table(void);
+Simd_Check_Table *simd_check_blend_rel_table(void);
+Simd_Check_Table *simd_check_add_table(void);
+Simd_Check_Table *simd_check_add_rel_table(void);
+Simd_Check_Table *simd_check_sub_table(void);
+Simd_Check_Table *simd_check_sub_rel_table(void);
+Simd_Check_Table *simd_check_mask_table(void);
+Simd_Check_Table *simd_check_mul_table(void);
+
+#endif
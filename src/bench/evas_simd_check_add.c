@@ -0,0 +1,8 @@
+#include "evas_simd_check.h"
+
+#define evas_common_gfx_compositor_add_get simd_check_compositor_add_get
+#define evas_common_gfx_compositor_add_rel_get simd_check_compositor_add_rel_get
+#include "evas_op_add_main_.c"
+
+SIMD_CHECK_TABLE(add, op_add_init, op_add_span_funcs)
+SIMD_CHECK_TABLE(add_rel, op_add_rel_init, op_add_rel_span_funcs)
@@ -0,0 +1,8 @@
+#include "evas_simd_check.h"
+
+#define evas_common_gfx_compositor_blend_get simd_check_compositor_blend_get
+#define evas_common_gfx_compositor_blend_rel_get simd_check_compositor_blend_rel_get
+#include "evas_op_blend_main_.c"
+
+SIMD_CHECK_TABLE(blend, op_blend_init, op_blend_span_funcs)
+SIMD_CHECK_TABLE(blend_rel, op_blend_rel_init, op_blend_rel_span_funcs)
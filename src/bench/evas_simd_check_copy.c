@@ -0,0 +1,8 @@
+#include "evas_simd_check.h"
+
+#define evas_common_gfx_compositor_copy_get simd_check_compositor_copy_get
+#define evas_common_gfx_compositor_copy_rel_get simd_check_compositor_copy_rel_get
+#include "evas_op_copy_main_.c"
+
+SIMD_CHECK_TABLE(copy, op_copy_init, op_copy_span_funcs)
+SIMD_CHECK_TABLE(copy_rel, op_copy_rel_init, op_copy_rel_span_funcs)
@@ -0,0 +1,6 @@
+#include "evas_simd_check.h"
+
+#define evas_common_gfx_compositor_mask_get simd_check_compositor_mask_get
+#include "evas_op_mask_main_.c"
+
+SIMD_CHECK_TABLE(mask, op_mask_init, op_mask_span_funcs)
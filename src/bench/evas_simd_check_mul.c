@@ -0,0 +1,6 @@
+#include "evas_simd_check.h"
+
+#define evas_common_gfx_compositor_mul_get simd_check_compositor_mul_get
+#include "evas_op_mul_main_.c"
+
+SIMD_CHECK_TABLE(mul, op_mul_init, op_mul_span_funcs)
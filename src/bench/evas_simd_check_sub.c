@@ -0,0 +1,8 @@
+#include "evas_simd_check.h"
+
+#define evas_common_gfx_compositor_sub_get simd_check_compositor_sub_get
+#define evas_common_gfx_compositor_sub_rel_get simd_check_compositor_sub_rel_get
+#include "evas_op_sub_main_.c"
+
+SIMD_CHECK_TABLE(sub, op_sub_init, op_sub_span_funcs)
+SIMD_CHECK_TABLE(sub_rel, op_sub_rel_init, op_sub_rel_span_funcs)
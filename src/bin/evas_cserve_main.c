@@ -81,6 +81,8 @@ struct _Img
       Eina_Bool alpha : 1;
    } image;
    int incache;
+   Eina_List *loaders; // Load_Inf of every request waiting on the decode
+   Eina_Bool loading; // not a bitfield, it is under load_queue_lock too
    LK(lock);
    Eina_Bool dead : 1;
    Eina_Bool active : 1;
@@ -92,6 +94,7 @@ struct _Load_Inf
 {
    Img *img;
    Client *c;
+   double t; // when the request came in
 };
 
 // config
@@ -119,8 +122,16 @@ static int cache_item_timeout = -1;
 static int cache_item_timeout_check = -1;
 static Mem *stat_mem = NULL;
 static int _evas_cserve_bin_log_dom = -1;
+LK(stat_lock); // guards stat_mems
 static Eina_List *stat_mems = NULL;
 
+LK(latency_lock);
+static int latency[OP_INVALID][EVAS_CSERVE_LATENCY_BUCKETS];
+
+#ifdef BUILD_PTHREAD
+LK(load_queue_lock);
+#endif
+
 static void cache_clean(void);
 
 #ifndef _WIN32
@@ -252,6 +263,22 @@ stats_update(void)
    stats_dirty = 1;
 }
 
+static void
+latency_add(int opcode, double t)
+{
+   int us, b;
+
+   if ((opcode < 0) || (opcode >= OP_INVALID)) return;
+   us = (get_time() - t) * 1000000.0;
+   for (b = 0; b < (EVAS_CSERVE_LATENCY_BUCKETS - 1); b++)
+     {
+        if (us < (16 << b)) break;
+     }
+   LKL(latency_lock);
+   latency[opcode][b]++;
+   LKU(latency_lock);
+}
+
 static void
 stats_lifetime_update(Img *img)
 {
@@ -335,12 +362,14 @@ _img_surface_alloc(Image_Entry *ie, unsigned int w, unsigned int h)
 {
    Img *img = (Img *)ie;
 
-   img->mem = evas_cserve_mem_new(w * h * sizeof(DATA32), NULL);
+   img->mem = evas_cserve_mem_pool_alloc(w * h * sizeof(DATA32));
    if (!img->mem) return -1;
    img->image.data = img->mem->data + img->mem->offset;
    
+   LKL(stat_lock);
    stat_mems = eina_list_append(stat_mems, img->mem);
    stat_update(stat_mem);
+   LKU(stat_lock);
    return 0;
 }
 
@@ -351,8 +380,10 @@ _img_surface_delete(Image_Entry *ie)
 
    if (!img->mem) return;
    
+   LKL(stat_lock);
    stat_mems = eina_list_remove(stat_mems, img->mem);
    stat_update(stat_mem);
+   LKU(stat_lock);
    
    evas_cserve_mem_free(img->mem);
    img->mem = NULL;
@@ -461,6 +492,9 @@ img_init(void)
    cache = evas_cache_image_init(&cache_funcs);
    LKI(cache_lock);
    LKI(strshr_freeme_lock);
+   LKI(stat_lock);
+   LKI(latency_lock);
+   evas_common_image_disk_cache_init();
 }
 
 static void
@@ -471,6 +505,9 @@ img_shutdown(void)
    // FIXME: shutdown properly
    LKD(strshr_freeme_lock);
    LKI(cache_lock);
+   LKD(stat_lock);
+   LKD(latency_lock);
+   evas_common_image_disk_cache_shutdown();
 }
 
 static Img *
@@ -523,19 +560,23 @@ img_loaddata(Img *img)
    
    if (img->mem) return;
    t = get_time();
-   LKL(cache_lock);
+   // called with img->lock held. load_data on an entry that is never
+   // preloaded (cserve entries never are) only touches the entry itself,
+   // the loader module and the surface alloc, which is locked, so workers
+   // decode different images side by side without cache_lock. only the
+   // accounting below is shared
    evas_cache_image_load_data((Image_Entry *)img);
    t = get_time() - t;
    img->stats.load2 = t;
    if (img->image.data)
      msync(img->image.data, img->image.w * img->image.h * sizeof(DATA32), MS_SYNC | MS_INVALIDATE);
+   LKL(cache_lock);
    if (!img->active) cache_usage -= img->usage;
    img->usage += 
      (4096 * (((img->image.w * img->image.h * sizeof(DATA32)) + 4095) / 4096)) +
      sizeof(Mem);
    if (!img->active) cache_usage += img->usage;
    LKU(cache_lock);
-   cache_clean();
 }
 
 static void
@@ -848,8 +889,10 @@ img_unloaddata(Img *img)
           (4096 * (((img->image.w * img->image.h * sizeof(DATA32)) + 4095) / 4096)) +
           sizeof(Mem);
         if (!img->active) cache_usage += img->usage;
-        evas_cserve_mem_free(img->mem);
+        LKL(stat_lock);
         stat_mems = eina_list_remove(stat_mems, img->mem);
+        LKU(stat_lock);
+        evas_cserve_mem_free(img->mem);
         img->mem = NULL;
         img->image.data = NULL;
         img->dref = 0;
@@ -912,29 +955,11 @@ getinfo_hash_image_cb(const Eina_Hash *hash __UNUSED__,
    return 1;
 }
 
-#ifdef BUILD_PTHREAD
-static void *
-load_data_thread(void *data)
+static void
+loaddata_reply(Client *c, Img *img, double t)
 {
-   Load_Inf *li = data;
-   Img *img = li->img;
-   Client *c = li->c;
    Op_Loaddata_Reply msg;
 
-   free(li);
-   LKL(img->lock);
-   if (img->mem)
-     {
-        memset(&msg, 0, sizeof(msg));
-        msg.mem.id = img->mem->id;
-        msg.mem.offset = img->mem->offset;
-        msg.mem.size = img->mem->size;
-        DBG("... reply");
-        evas_cserve_client_send(c, OP_LOADDATA, sizeof(msg), (unsigned char *)(&msg));
-        LKU(c->lock);
-        return NULL;
-     }
-   img_loaddata(img);
    memset(&msg, 0, sizeof(msg));
    if (img->mem)
      {
@@ -944,11 +969,90 @@ load_data_thread(void *data)
      }
    else
      msg.mem.id = msg.mem.offset = msg.mem.size = 0;
-   LKU(img->lock);
    DBG("... reply");
    evas_cserve_client_send(c, OP_LOADDATA, sizeof(msg), (unsigned char *)(&msg));
+   latency_add(OP_LOADDATA, t);
+}
+
+#ifdef BUILD_PTHREAD
+/* decodes run as tasks on the evas thread pool. every OP_LOADDATA for an
+ * image whose decode is queued or running is only added to its loaders, so
+ * an image wanted by many clients at once is decoded once and they all get
+ * the reply as soon as it is done */
+static void
+load_do(void *data)
+{
+   Eina_List *loaders;
+   Load_Inf *li;
+   Img *img = data;
+
+   LKL(img->lock);
+   img_loaddata(img);
+   // loaders and loading are under load_queue_lock so a request
+   // coming in during the decode never waits for it. one coming in
+   // after this queues again and gets its reply right away
+   LKL(load_queue_lock);
+   loaders = img->loaders;
+   img->loaders = NULL;
+   img->loading = 0;
+   LKU(load_queue_lock);
+   EINA_LIST_FREE(loaders, li)
+     {
+        loaddata_reply(li->c, img, li->t);
+        LKL(li->c->lock);
+        li->c->pending--;
+        LKU(li->c->lock);
+        free(li);
+     }
+   LKU(img->lock);
+   cache_clean();
+}
+
+static Eina_Bool
+load_queue_add(Img *img, Client *c, double t)
+{
+   Load_Inf *li;
+   Eina_Bool start;
+
+   if (evas_common_thread_pool_threads_get() < 1) return 0;
+   li = calloc(1, sizeof(Load_Inf));
+   if (!li) return 0;
+   li->img = img;
+   li->c = c;
+   li->t = t;
+   LKL(c->lock);
+   c->pending++;
    LKU(c->lock);
-   return NULL;
+   LKL(load_queue_lock);
+   img->loaders = eina_list_append(img->loaders, li);
+   start = !img->loading;
+   img->loading = 1;
+   LKU(load_queue_lock);
+   if (start)
+     {
+        DBG("... queue load data %p", img);
+        // the pool is being shut down, answer them all here
+        if (!evas_common_thread_pool_task_add(load_do, img))
+          load_do(img);
+     }
+   else
+     DBG("... load data %p already on its way", img);
+   return 1;
+}
+
+static void
+load_workers_init(void)
+{
+   LKI(load_queue_lock);
+}
+
+static void
+load_workers_shutdown(void)
+{
+   // waits for the decodes being done, the queued ones are not going to
+   // be answered anyway
+   evas_common_thread_pool_shutdown();
+   LKD(load_queue_lock);
 }
 #endif
 
@@ -957,6 +1061,9 @@ message(void *fdata __UNUSED__, Server *s __UNUSED__, Client *c, int opcode, int
 {
    // copy data into  local aligned buffer... in case.
    unsigned char *tdata = alloca(size + 16);
+   double t = get_time();
+   Eina_Bool timed = 0;
+
    memcpy(tdata, data, size);
    
    t_now = time(NULL);
@@ -1105,40 +1212,17 @@ message(void *fdata __UNUSED__, Server *s __UNUSED__, Client *c, int opcode, int
                   else
                     {
 #ifdef BUILD_PTHREAD
-                       pthread_t tid;
-                       pthread_attr_t attr;
-                       Load_Inf *li;
-                       
-                       DBG("... load data %p", img);
-                       pthread_attr_init(&attr);
-                       li = calloc(1, sizeof(Load_Inf));
-                       if (li)
-                         {
-                            li->img= img;
-                            li->c = c;
-                            LKL(c->lock);
-                            if (pthread_create(&tid, &attr, load_data_thread, li))
-                              {
-                                 perror("pthread_create()");
-                              }
-                            else
-                              pthread_detach(tid);
-                         }
-                       pthread_attr_destroy(&attr);
-#else
-                       img_loaddata(img);
-                       memset(&msg, 0, sizeof(msg));
-                       if (img->mem)
+                       timed = load_queue_add(img, c, t);
+                       if (!timed)
+#endif
                          {
-                            msg.mem.id = img->mem->id;
-                            msg.mem.offset = img->mem->offset;
-                            msg.mem.size = img->mem->size;
+                            LKL(img->lock);
+                            img_loaddata(img);
+                            LKU(img->lock);
+                            cache_clean();
+                            loaddata_reply(c, img, t);
+                            timed = 1;
                          }
-                       else
-                         msg.mem.id = msg.mem.offset = msg.mem.size = 0;
-                       DBG("... reply");
-                       evas_cserve_client_send(c, OP_LOADDATA, sizeof(msg), (unsigned char *)(&msg));
-#endif
                     }
                }
              else
@@ -1270,6 +1354,7 @@ message(void *fdata __UNUSED__, Server *s __UNUSED__, Client *c, int opcode, int
              Op_Getstats_Reply msg;
 
              DBG("OP_GETSTATS %i", c->pid);
+             memset(&msg, 0, sizeof(msg));
              stats_calc();
              msg.saved_memory = saved_memory;
              msg.wasted_memory = (real_memory - alloced_memory);
@@ -1277,6 +1362,9 @@ message(void *fdata __UNUSED__, Server *s __UNUSED__, Client *c, int opcode, int
              msg.wasted_memory_peak = (real_memory_peak - alloced_memory_peak);
              msg.saved_time_image_header_load = saved_load_lifetime + saved_load_time;
              msg.saved_time_image_data_load = saved_loaddata_lifetime + saved_loaddata_time;
+             LKL(latency_lock);
+             memcpy(msg.latency, latency, sizeof(latency));
+             LKU(latency_lock);
              DBG("... reply");
              evas_cserve_client_send(c, OP_GETSTATS, sizeof(msg), (unsigned char *)(&msg));
           } 
@@ -1406,6 +1494,7 @@ message(void *fdata __UNUSED__, Server *s __UNUSED__, Client *c, int opcode, int
         DBG("OP_... UNKNOWN??? %i opcode: %i", c->pid, opcode);
         break;
      }
+   if (!timed) latency_add(opcode, t);
    return 0;
 }
 
@@ -1540,8 +1629,14 @@ main(int argc, char **argv)
 
    DBG("evas init...");
    evas_init();
+   DBG("mem pool init...");
+   evas_cserve_mem_pool_init();
    DBG("img init...");
    img_init();
+#ifdef BUILD_PTHREAD
+   DBG("load workers init...");
+   load_workers_init();
+#endif
    DBG("signal init...");
    signal_init();
    DBG("cserve add...");
@@ -1660,8 +1755,14 @@ main(int argc, char **argv)
      }
    DBG("signal shutdown...");
    signal_shutdown();
+#ifdef BUILD_PTHREAD
+   DBG("load workers shutdown...");
+   load_workers_shutdown();
+#endif
    DBG("img shutdown...");
    img_shutdown();
+   DBG("mem pool shutdown...");
+   evas_cserve_mem_pool_shutdown();
    if (stat_mem)
      {
         DBG("free stat mem...");
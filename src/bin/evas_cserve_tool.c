@@ -67,6 +67,7 @@ main(int argc, char **argv)
         else if ((!strcmp(argv[i], "getstats")))
           {
              Op_Getstats_Reply stats;
+             int j;
              
              if (!evas_cserve_raw_stats_get(&stats))
                {
@@ -80,6 +81,19 @@ main(int argc, char **argv)
              printf("wasted_memory_peak: %i Kb\n", stats.wasted_memory_peak / 1024);
              printf("saved_time_image_header_load: %1.3f sec\n", stats.saved_time_image_header_load);
              printf("saved_time_image_data_load: %1.3f sec\n", stats.saved_time_image_data_load);
+             for (j = 0; j < OP_INVALID; j++)
+               {
+                  int k, n = 0;
+
+                  for (k = 0; k < EVAS_CSERVE_LATENCY_BUCKETS; k++)
+                    n += stats.latency[j][k];
+                  if (n == 0) continue;
+                  // replies per 16 << n usec bucket
+                  printf("latency_op_%i:", j);
+                  for (k = 0; k < EVAS_CSERVE_LATENCY_BUCKETS; k++)
+                    printf(" %i", stats.latency[j][k]);
+                  printf("\n");
+               }
              printf("-OK-\n");
           }
         else if ((!strcmp(argv[i], "getinfo")))
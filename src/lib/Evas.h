@@ -163,6 +163,19 @@ typedef enum _Evas_Colorspace
    EVAS_COLORSPACE_YCBCR422P709_PL,/**< YCbCr 4:2:2 Planar, ITU.BT-709 specifications. The data poitned to is just an array of row pointer, pointing to the Y rows, then the Cb, then Cr rows */
    EVAS_COLORSPACE_RGB565_A5P, /**< 16bit rgb565 + Alpha plane at end - 5 bits of the 8 being used per alpha byte */
    EVAS_COLORSPACE_GRY8, /**< 8bit grayscale */
+   EVAS_COLORSPACE_YCBCR420PFULL_PL, /**< YCbCr 4:2:0 Planar, full range (JPEG) specifications. Same row pointer layout as EVAS_COLORSPACE_YCBCR422P601_PL */
+   EVAS_COLORSPACE_YCBCR422H601_PL, /**< YCbCr 4:2:2 Planar with full height chroma, ITU.BT-601 specifications. Row pointers to the Y rows, then as many Cb rows, then as many Cr rows */
+   EVAS_COLORSPACE_YCBCR422H709_PL, /**< YCbCr 4:2:2 Planar with full height chroma, ITU.BT-709 specifications. Same layout as EVAS_COLORSPACE_YCBCR422H601_PL */
+   EVAS_COLORSPACE_YCBCR422HFULL_PL, /**< YCbCr 4:2:2 Planar with full height chroma, full range specifications. Same layout as EVAS_COLORSPACE_YCBCR422H601_PL */
+   EVAS_COLORSPACE_YCBCR422601_PL, /**< YCbCr 4:2:2 packed (YUY2), ITU.BT-601 specifications. Row pointers to rows of Y, Cb, Y, Cr bytes */
+   EVAS_COLORSPACE_YCBCR422709_PL, /**< YCbCr 4:2:2 packed (YUY2), ITU.BT-709 specifications. Same layout as EVAS_COLORSPACE_YCBCR422601_PL */
+   EVAS_COLORSPACE_YCBCR422FULL_PL, /**< YCbCr 4:2:2 packed (YUY2), full range specifications. Same layout as EVAS_COLORSPACE_YCBCR422601_PL */
+   EVAS_COLORSPACE_YCBCR420NV12601_PL, /**< YCbCr 4:2:0 semi planar (NV12), ITU.BT-601 specifications. Row pointers to the Y rows, then the interleaved Cb, Cr rows */
+   EVAS_COLORSPACE_YCBCR420NV12709_PL, /**< YCbCr 4:2:0 semi planar (NV12), ITU.BT-709 specifications. Same layout as EVAS_COLORSPACE_YCBCR420NV12601_PL */
+   EVAS_COLORSPACE_YCBCR420NV12FULL_PL, /**< YCbCr 4:2:0 semi planar (NV12), full range specifications. Same layout as EVAS_COLORSPACE_YCBCR420NV12601_PL */
+   EVAS_COLORSPACE_YCBCR420NV21601_PL, /**< YCbCr 4:2:0 semi planar (NV21), ITU.BT-601 specifications. Like NV12 with Cr first in the interleaved rows */
+   EVAS_COLORSPACE_YCBCR420NV21709_PL, /**< YCbCr 4:2:0 semi planar (NV21), ITU.BT-709 specifications. Like NV12 with Cr first in the interleaved rows */
+   EVAS_COLORSPACE_YCBCR420NV21FULL_PL /**< YCbCr 4:2:0 semi planar (NV21), full range specifications. Like NV12 with Cr first in the interleaved rows */
 } Evas_Colorspace; /**< Colorspaces for pixel data supported by Evas */
 
 /**
@@ -199,6 +212,14 @@ typedef struct _Evas_Smart_Class             Evas_Smart_Class;
  */
 typedef struct _Evas_Smart_Cb_Description    Evas_Smart_Cb_Description;
 
+/**
+ * @typedef Evas_Smart_Cb_Id
+ * An interned smart callback event name
+ * @see evas_smart_callback_id_get()
+ * @ingroup Evas_Smart_Group
+ */
+typedef struct _Evas_Smart_Cb_Id             Evas_Smart_Cb_Id;
+
 /**
  * @typedef Evas_Map
  * An opaque handle to map points
@@ -430,6 +451,23 @@ typedef enum _Evas_Image_Content_Hint
    EVAS_IMAGE_CONTENT_HINT_STATIC = 2
 } Evas_Image_Content_Hint;
 
+typedef enum _Evas_Image_Preload_Priority
+{
+   EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE = 0, /**< on screen now, load first */
+   EVAS_IMAGE_PRELOAD_PRIORITY_SOON_VISIBLE = 1, /**< about to come on screen */
+   EVAS_IMAGE_PRELOAD_PRIORITY_SPECULATIVE = 2, /**< may be needed at some point */
+   EVAS_IMAGE_PRELOAD_PRIORITY_LAST
+} Evas_Image_Preload_Priority;
+
+typedef struct _Evas_Image_Preload_Stats
+{
+   unsigned int queued[EVAS_IMAGE_PRELOAD_PRIORITY_LAST]; /**< jobs waiting, per priority */
+   unsigned int running; /**< jobs being loaded right now */
+   unsigned int done; /**< jobs loaded since init */
+   double       wait_avg; /**< average time, in seconds, a job waited in queue */
+   double       wait_max; /**< longest time, in seconds, a job waited in queue */
+} Evas_Image_Preload_Stats;
+
 struct _Evas_Engine_Info /** Generic engine information. Generic info is useless */
 {
    int magic; /**< Magic number */
@@ -683,6 +721,7 @@ typedef void      (*Evas_Async_Events_Put_Cb)(void *target, Evas_Callback_Type t
    EAPI void             *evas_data_attach_get              (const Evas *e) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
 
    EAPI void              evas_damage_rectangle_add         (Evas *e, int x, int y, int w, int h) EINA_ARG_NONNULL(1);
+   EAPI void              evas_scroll_rectangle_add         (Evas *e, int x, int y, int w, int h, int dx, int dy) EINA_ARG_NONNULL(1);
    EAPI void              evas_obscured_rectangle_add       (Evas *e, int x, int y, int w, int h) EINA_ARG_NONNULL(1);
    EAPI void              evas_obscured_clear               (Evas *e) EINA_ARG_NONNULL(1);
    EAPI Eina_List        *evas_render_updates               (Evas *e) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1);
@@ -837,6 +876,7 @@ typedef void      (*Evas_Async_Events_Put_Cb)(void *target, Evas_Callback_Type t
    EAPI void              evas_image_cache_reload           (Evas *e) EINA_ARG_NONNULL(1);
    EAPI void              evas_image_cache_set              (Evas *e, int size) EINA_ARG_NONNULL(1);
    EAPI int               evas_image_cache_get              (const Evas *e) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
+   EAPI Eina_Bool         evas_image_preload_stats_get      (Evas_Image_Preload_Stats *stats);
 
 /**
  * @defgroup Evas_Font_Group Font Functions
@@ -1200,7 +1240,40 @@ typedef void (*Evas_Object_Intercept_Clip_Unset_Cb) (void *data, Evas_Object *ob
  *
  * EVAS_COLORSPACE_YCBCR422P709_PL:
  *
- * Not implemented yet.
+ * Exactly like EVAS_COLORSPACE_YCBCR422P601_PL, but using the itu709
+ * matrix. EVAS_COLORSPACE_YCBCR420PFULL_PL is the same layout again
+ * with full range (0 to 255) luma and chroma, as used by jpeg.
+ *
+ * EVAS_COLORSPACE_YCBCR422H601_PL, EVAS_COLORSPACE_YCBCR422H709_PL,
+ * EVAS_COLORSPACE_YCBCR422HFULL_PL:
+ *
+ * True 4:2:2 planar data. The pointer list holds N rows of pointers to
+ * the Y plane, then N pointers to U plane rows and N pointers to V
+ * plane rows. U and V planes are half the horizontal resolution, but
+ * the full vertical resolution of the Y plane.
+ *
+ * EVAS_COLORSPACE_YCBCR422601_PL, EVAS_COLORSPACE_YCBCR422709_PL,
+ * EVAS_COLORSPACE_YCBCR422FULL_PL:
+ *
+ * Packed 4:2:2 data (YUY2). The pointer list holds N row pointers,
+ * each row being Y0, U, Y1, V byte quadruples for every 2 pixels.
+ *
+ * EVAS_COLORSPACE_YCBCR420NV12601_PL, EVAS_COLORSPACE_YCBCR420NV12709_PL,
+ * EVAS_COLORSPACE_YCBCR420NV12FULL_PL:
+ *
+ * Semi planar 4:2:0 data (NV12). The pointer list holds N rows of
+ * pointers to the Y plane followed by N / 2 pointers to rows of
+ * interleaved U, V byte pairs, one pair for every 2x2 pixel block.
+ * The NV21 colorspaces are the same with V first in each pair.
+ *
+ * All YCbCr colorspaces need an even width. Images in these
+ * colorspaces are converted to ARGB8888 for rendering by the software
+ * engines. All YCbCr colorspaces other than
+ * EVAS_COLORSPACE_YCBCR422P601_PL and EVAS_COLORSPACE_YCBCR422P709_PL
+ * are unsupported by the GL, xrender, directfb, SDL and quartz
+ * engines: there evas_object_image_colorspace_set() leaves the image in
+ * its current colorspace and evas_object_image_colorspace_get() tells
+ * so.
  *
  * EVAS_COLORSPACE_RGB565_A5P:
  *
@@ -1268,6 +1341,8 @@ typedef void (*Evas_Object_Image_Pixels_Get_Cb) (void *data, Evas_Object *o);
    EAPI void                     evas_object_image_smooth_scale_set       (Evas_Object *obj, Eina_Bool smooth_scale) EINA_ARG_NONNULL(1);
    EAPI Eina_Bool                evas_object_image_smooth_scale_get       (const Evas_Object *obj) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
    EAPI void                     evas_object_image_preload                (Evas_Object *obj, Eina_Bool cancel) EINA_ARG_NONNULL(1);
+   EAPI void                     evas_object_image_preload_priority_set   (Evas_Object *obj, Evas_Image_Preload_Priority priority) EINA_ARG_NONNULL(1);
+   EAPI Evas_Image_Preload_Priority evas_object_image_preload_priority_get (const Evas_Object *obj) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
    EAPI void                     evas_object_image_reload                 (Evas_Object *obj) EINA_ARG_NONNULL(1);
    EAPI Eina_Bool                evas_object_image_save                   (const Evas_Object *obj, const char *file, const char *key, const char *flags)  EINA_ARG_NONNULL(1, 2);
    EAPI Eina_Bool                evas_object_image_pixels_import          (Evas_Object *obj, Evas_Pixel_Import_Source *pixels) EINA_ARG_NONNULL(1, 2);
@@ -1397,6 +1472,8 @@ typedef void (*Evas_Object_Image_Pixels_Get_Cb) (void *data, Evas_Object *o);
    EAPI const Evas_Textblock_Style  *evas_object_textblock_style_get(const Evas_Object *obj) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
    EAPI void                         evas_object_textblock_replace_char_set(Evas_Object *obj, const char *ch) EINA_ARG_NONNULL(1);
    EAPI const char                  *evas_object_textblock_replace_char_get(Evas_Object *obj) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
+   EAPI void                         evas_object_textblock_virtual_set(Evas_Object *obj, Eina_Bool virt) EINA_ARG_NONNULL(1);
+   EAPI Eina_Bool                    evas_object_textblock_virtual_get(const Evas_Object *obj) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
 
    EAPI void                         evas_object_textblock_text_markup_set(Evas_Object *obj, const char *text) EINA_ARG_NONNULL(1);
    EAPI void                         evas_object_textblock_text_markup_prepend(Evas_Textblock_Cursor *cur, const char *text) EINA_ARG_NONNULL(1, 2);
@@ -1763,6 +1840,7 @@ struct _Evas_Smart_Cb_Description
 
    EAPI void                            *evas_smart_data_get                 (const Evas_Smart *s) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1) EINA_PURE;
    EAPI const Evas_Smart_Cb_Description *evas_smart_callback_description_find(const Evas_Smart *s, const char *name) EINA_ARG_NONNULL(1, 2) EINA_PURE;
+   EAPI const Evas_Smart_Cb_Id          *evas_smart_callback_id_get          (const char *event) EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(1);
 
    EAPI Eina_Bool                        evas_smart_class_inherit_full       (Evas_Smart_Class *sc, const Evas_Smart_Class *parent_sc, unsigned int parent_sc_size) EINA_ARG_NONNULL(1, 2);
   /**
@@ -1804,6 +1882,7 @@ struct _Evas_Smart_Cb_Description
    EAPI void              evas_object_smart_callback_add    (Evas_Object *obj, const char *event, Evas_Smart_Cb func, const void *data) EINA_ARG_NONNULL(1, 2, 3);
    EAPI void             *evas_object_smart_callback_del    (Evas_Object *obj, const char *event, Evas_Smart_Cb func) EINA_ARG_NONNULL(1, 2, 3);
    EAPI void              evas_object_smart_callback_call   (Evas_Object *obj, const char *event, void *event_info) EINA_ARG_NONNULL(1, 2);
+   EAPI void              evas_object_smart_callback_call_by_id(Evas_Object *obj, const Evas_Smart_Cb_Id *id, void *event_info) EINA_ARG_NONNULL(1, 2);
 
    EAPI Eina_Bool         evas_object_smart_callbacks_descriptions_set(Evas_Object *obj, const Evas_Smart_Cb_Description *descriptions) EINA_ARG_NONNULL(1);
    EAPI void              evas_object_smart_callbacks_descriptions_get(const Evas_Object *obj, const Evas_Smart_Cb_Description ***class_descriptions, unsigned int *class_count, const Evas_Smart_Cb_Description ***instance_descriptions, unsigned int *instance_count) EINA_ARG_NONNULL(1);
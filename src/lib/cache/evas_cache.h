@@ -6,6 +6,7 @@ typedef struct _Evas_Cache_Image                Evas_Cache_Image;
 typedef struct _Evas_Cache_Image_Func           Evas_Cache_Image_Func;
 typedef struct _Evas_Cache_Engine_Image         Evas_Cache_Engine_Image;
 typedef struct _Evas_Cache_Engine_Image_Func    Evas_Cache_Engine_Image_Func;
+typedef struct _Evas_Cache_Image_Slot           Evas_Cache_Image_Slot;
 
 
 struct _Evas_Cache_Image_Func
@@ -42,6 +43,14 @@ struct _Evas_Cache_Image_Func
    void         (*debug)(const char *context, Image_Entry *im);
 };
 
+/* open addressing index over the cached (activ and inactiv) entries,
+ * keyed by file, key and load options */
+struct _Evas_Cache_Image_Slot
+{
+   unsigned int                  hash;
+   Image_Entry                  *ie;
+};
+
 struct _Evas_Cache_Image
 {
    Evas_Cache_Image_Func         func;
@@ -57,9 +66,14 @@ struct _Evas_Cache_Image
    Eina_Hash                    *activ;
    void                         *data;
 
+   Evas_Cache_Image_Slot        *index;
+   unsigned int                  index_size;
+   unsigned int                  index_count;
+
    int                           usage;
    unsigned int                  limit;
    int                           references;
+   int                           stat_gap; // seconds a hit trusts the last stat()
 #ifdef EVAS_FRAME_QUEUING
    LK(lock);
 #endif
@@ -86,6 +86,133 @@ _dump_cache(Evas_Cache_Image *cache)
 
 static void _evas_cache_image_entry_delete(Evas_Cache_Image *cache, Image_Entry *ie);
 
+#define INDEX_MIN_SIZE 64
+#define STAT_GAP 2
+
+static unsigned int
+_evas_cache_image_key_hash(const char *file, const char *key, const RGBA_Image_Loadopts *lo)
+{
+   unsigned int h, v[8];
+   int i;
+
+   h = eina_hash_superfast(file, strlen(file));
+   if (key) h = (h * 31) ^ eina_hash_superfast(key, strlen(key));
+   v[0] = lo->scale_down_by;
+   v[1] = (unsigned int)(lo->dpi * 1000.0);
+   v[2] = lo->w;
+   v[3] = lo->h;
+   v[4] = lo->region.x;
+   v[5] = lo->region.y;
+   v[6] = lo->region.w;
+   v[7] = lo->region.h;
+   for (i = 0; i < 8; i++)
+     h = (h ^ v[i]) * 0x01000193;
+   return h;
+}
+
+static Eina_Bool
+_evas_cache_image_key_match(const Image_Entry *ie, const char *file, const char *key, const RGBA_Image_Loadopts *lo)
+{
+   /* file and key of an entry are stringshares, most hits are pointer equal */
+   if (!ie->file) return EINA_FALSE;
+   if ((ie->file != file) && (strcmp(ie->file, file))) return EINA_FALSE;
+   if (ie->key != key)
+     {
+        if ((!ie->key) || (!key) || (strcmp(ie->key, key))) return EINA_FALSE;
+     }
+   return ((ie->load_opts.scale_down_by == lo->scale_down_by) &&
+           (ie->load_opts.dpi == lo->dpi) &&
+           (ie->load_opts.w == lo->w) &&
+           (ie->load_opts.h == lo->h) &&
+           (ie->load_opts.region.x == lo->region.x) &&
+           (ie->load_opts.region.y == lo->region.y) &&
+           (ie->load_opts.region.w == lo->region.w) &&
+           (ie->load_opts.region.h == lo->region.h));
+}
+
+static void
+_evas_cache_image_index_resize(Evas_Cache_Image *cache, unsigned int size)
+{
+   Evas_Cache_Image_Slot *index;
+   unsigned int i, j, mask;
+
+   index = calloc(size, sizeof (Evas_Cache_Image_Slot));
+   if (!index) return;
+   mask = size - 1;
+   for (i = 0; i < cache->index_size; i++)
+     {
+        if (!cache->index[i].ie) continue;
+        for (j = cache->index[i].hash & mask; index[j].ie; j = (j + 1) & mask);
+        index[j] = cache->index[i];
+     }
+   free(cache->index);
+   cache->index = index;
+   cache->index_size = size;
+}
+
+static void
+_evas_cache_image_index_add(Evas_Cache_Image *cache, Image_Entry *ie)
+{
+   unsigned int i, mask;
+
+   if ((cache->index_count + 1) * 4 > cache->index_size * 3)
+     _evas_cache_image_index_resize(cache, cache->index_size ?
+                                    cache->index_size * 2 : INDEX_MIN_SIZE);
+   /* still full if the table could not grow, the entry just won't be found */
+   if ((cache->index_count + 1) * 4 > cache->index_size * 3) return;
+   mask = cache->index_size - 1;
+   for (i = ie->cache_hash & mask; cache->index[i].ie; i = (i + 1) & mask);
+   cache->index[i].hash = ie->cache_hash;
+   cache->index[i].ie = ie;
+   cache->index_count++;
+}
+
+static void
+_evas_cache_image_index_del(Evas_Cache_Image *cache, Image_Entry *ie)
+{
+   unsigned int i, j, k, mask;
+
+   if (!cache->index_size) return;
+   mask = cache->index_size - 1;
+   for (i = ie->cache_hash & mask; cache->index[i].ie != ie; i = (i + 1) & mask)
+     if (!cache->index[i].ie) return;
+   /* shift the rest of the run back so probes never need tombstones */
+   for (j = i;;)
+     {
+        j = (j + 1) & mask;
+        if (!cache->index[j].ie) break;
+        k = cache->index[j].hash & mask;
+        if ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)))
+          continue;
+        cache->index[i] = cache->index[j];
+        i = j;
+     }
+   cache->index[i].ie = NULL;
+   cache->index_count--;
+}
+
+static Image_Entry *
+_evas_cache_image_index_find(Evas_Cache_Image *cache, unsigned int hash,
+                             const char *file, const char *key,
+                             const RGBA_Image_Loadopts *lo)
+{
+   Image_Entry *inactiv = NULL;
+   unsigned int i, mask;
+
+   if (!cache->index_size) return NULL;
+   mask = cache->index_size - 1;
+   for (i = hash & mask; cache->index[i].ie; i = (i + 1) & mask)
+     {
+        Image_Entry *ie = cache->index[i].ie;
+
+        if (cache->index[i].hash != hash) continue;
+        if (!_evas_cache_image_key_match(ie, file, key, lo)) continue;
+        if (ie->flags.activ) return ie;
+        if (!inactiv) inactiv = ie;
+     }
+   return inactiv;
+}
+
 static void
 _evas_cache_image_make_dirty(Evas_Cache_Image *cache, Image_Entry *im)
 {
@@ -124,6 +251,7 @@ _evas_cache_image_make_activ(Evas_Cache_Image *cache,
         LKL(cache->lock);
 #endif
 	eina_hash_direct_add(cache->activ, key, im);
+        _evas_cache_image_index_add(cache, im);
 #ifdef EVAS_FRAME_QUEUING
         LKU(cache->lock);
 #endif
@@ -147,6 +275,7 @@ _evas_cache_image_make_inactiv(Evas_Cache_Image *cache,
         LKL(cache->lock);
 #endif
 	eina_hash_direct_add(cache->inactiv, key, im);
+        _evas_cache_image_index_add(cache, im);
 	cache->lru = eina_inlist_prepend(cache->lru, EINA_INLIST_GET(im));
 	cache->usage += cache->func.mem_size_get(im);
 #ifdef EVAS_FRAME_QUEUING
@@ -202,6 +331,7 @@ _evas_cache_image_remove_activ(Evas_Cache_Image *cache, Image_Entry *ie)
              LKL(cache->lock);
 #endif
 	     eina_hash_del(cache->activ, ie->cache_key, ie);
+             _evas_cache_image_index_del(cache, ie);
 #ifdef EVAS_FRAME_QUEUING
              LKU(cache->lock);
 #endif
@@ -219,6 +349,7 @@ _evas_cache_image_remove_activ(Evas_Cache_Image *cache, Image_Entry *ie)
              else
                {
 		  eina_hash_del(cache->inactiv, ie->cache_key, ie);
+                  _evas_cache_image_index_del(cache, ie);
                   cache->lru = eina_inlist_remove(cache->lru, EINA_INLIST_GET(ie));
                   cache->usage -= cache->func.mem_size_get(ie);
                }
@@ -283,6 +414,7 @@ _evas_cache_image_entry_delete(Evas_Cache_Image *cache, Image_Entry *ie)
 static Image_Entry *
 _evas_cache_image_entry_new(Evas_Cache_Image *cache,
                             const char *hkey,
+                            unsigned int hash,
                             time_t timestamp,
                             const char *file,
                             const char *key,
@@ -304,8 +436,6 @@ _evas_cache_image_entry_new(Evas_Cache_Image *cache,
    ie->flags.loaded = 0;
    ie->flags.need_data = 1;
 
-   _evas_cache_image_make_activ(cache, ie, cache_key);
-
    ie->space = EVAS_COLORSPACE_ARGB8888;
    ie->w = -1;
    ie->h = -1;
@@ -344,6 +474,10 @@ _evas_cache_image_entry_new(Evas_Cache_Image *cache,
    if (lo)
      ie->load_opts = *lo;
 
+   /* file, key and load options make up the index key, set them first */
+   ie->cache_hash = hash;
+   _evas_cache_image_make_activ(cache, ie, cache_key);
+
    if (file)
      {
         *error = cache->func.constructor(ie);
@@ -496,15 +630,29 @@ static int
 _evas_cache_image_entry_preload_add(Image_Entry *ie, const void *target)
 {
    Evas_Cache_Target *tg;
+   Evas_Image_Preload_Priority priority = EVAS_IMAGE_PRELOAD_PRIORITY_LAST - 1;
+   Eina_Bool found = EINA_FALSE;
 
    if (ie->flags.preload_done) return 0;
 
-   tg = malloc(sizeof (Evas_Cache_Target));
-   if (!tg) return 0;
+   /* one load serves every target, it runs as urgently as the most
+    * urgent of them needs it */
+   EINA_INLIST_FOREACH(ie->targets, tg)
+     {
+        if (tg->target == target) found = EINA_TRUE;
+        priority = MIN(priority, evas_object_image_preload_priority_get((Evas_Object *)tg->target));
+     }
 
-   tg->target = target;
+   if (!found)
+     {
+        tg = malloc(sizeof (Evas_Cache_Target));
+        if (!tg) return 0;
 
-   ie->targets = (Evas_Cache_Target*) eina_inlist_append(EINA_INLIST_GET(ie->targets), EINA_INLIST_GET(tg));
+        tg->target = target;
+
+        ie->targets = (Evas_Cache_Target*) eina_inlist_append(EINA_INLIST_GET(ie->targets), EINA_INLIST_GET(tg));
+        priority = MIN(priority, evas_object_image_preload_priority_get((Evas_Object *)target));
+     }
 
    if (!ie->preload)
      {
@@ -514,8 +662,10 @@ _evas_cache_image_entry_preload_add(Image_Entry *ie, const void *target)
         ie->preload = evas_preload_thread_run(_evas_cache_image_async_heavy,
                                               _evas_cache_image_async_end,
                                               _evas_cache_image_async_cancel,
-                                              ie);
+                                              ie, priority);
      }
+   else if (!ie->flags.pending)
+     evas_preload_thread_priority_set(ie->preload, priority);
 
    return 1;
 }
@@ -604,6 +754,7 @@ EAPI Evas_Cache_Image *
 evas_cache_image_init(const Evas_Cache_Image_Func *cb)
 {
    Evas_Cache_Image *new;
+   const char *s;
 
    new = malloc(sizeof (Evas_Cache_Image));
    if (!new) return NULL;
@@ -619,6 +770,14 @@ evas_cache_image_init(const Evas_Cache_Image_Func *cb)
    new->inactiv = eina_hash_string_superfast_new(NULL);
    new->activ = eina_hash_string_superfast_new(NULL);
 
+   new->index = NULL;
+   new->index_size = 0;
+   new->index_count = 0;
+
+   new->stat_gap = STAT_GAP;
+   s = getenv("EVAS_IMAGE_CACHE_STAT_GAP");
+   if (s) new->stat_gap = atoi(s);
+
    new->references = 1;
 
    new->preload = NULL;
@@ -715,6 +874,7 @@ evas_cache_image_shutdown(Evas_Cache_Image *cache)
 
    eina_hash_free(cache->activ);
    eina_hash_free(cache->inactiv);
+   free(cache->index);
 
 #ifdef EVAS_FRAME_QUEUING
    LKU(cache->lock);
@@ -724,8 +884,6 @@ evas_cache_image_shutdown(Evas_Cache_Image *cache)
    free(cache);
 }
 
-#define STAT_GAP 2
-
 EAPI Image_Entry *
 evas_cache_image_request(Evas_Cache_Image *cache, const char *file, const char *key, RGBA_Image_Loadopts *lo, int *error)
 {
@@ -737,6 +895,7 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file, const char *
    int                   stat_done = 0;
    size_t                file_length;
    size_t                key_length;
+   unsigned int          hash;
    struct stat           st;
 
    assert(cache != NULL);
@@ -747,22 +906,6 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file, const char *
 	return NULL;
      }
 
-   file_length = strlen(file);
-   key_length = key ? strlen(key) : 6;
-
-   size = file_length + key_length + 128;
-   hkey = alloca(sizeof (char) * size);
-
-   memcpy(hkey, file, file_length);
-   size = file_length;
-
-   memcpy(hkey + size, "//://", 5);
-   size += 5;
-
-   if (key) ckey = key;
-   memcpy(hkey + size, ckey, key_length);
-   size += key_length;
-
    if ((!lo) ||
        (lo &&
         (lo->scale_down_by == 0) &&
@@ -770,73 +913,27 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file, const char *
         ((lo->w == 0) || (lo->h == 0)) &&
         ((lo->region.w == 0) || (lo->region.h == 0))
         ))
-     {
-        lo = &prevent;
-//        if (key)
-//          format = "%s//://%s";
-//        else
-//          format = "%s//://%p";
-     }
-   else
-     {
-	memcpy(hkey + size, "//@/", 4);
-	size += 4;
-
-	size += eina_convert_xtoa(lo->scale_down_by, hkey + size);
-
-	hkey[size] = '/';
-	size += 1;
-
-	size += eina_convert_dtoa(lo->dpi, hkey + size);
+     lo = &prevent;
 
-	hkey[size] = '/';
-	size += 1;
-
-	size += eina_convert_xtoa(lo->w, hkey + size);
-
-	hkey[size] = 'x';
-	size += 1;
-
-	size += eina_convert_xtoa(lo->h, hkey + size);
-        
-	hkey[size] = '/';
-	size += 1;
-
-	size += eina_convert_xtoa(lo->region.x, hkey + size);
-        
-	hkey[size] = '+';
-	size += 1;
-        
-	size += eina_convert_xtoa(lo->region.y, hkey + size);
-        
-	hkey[size] = '.';
-	size += 1;
-        
-	size += eina_convert_xtoa(lo->region.w, hkey + size);
-        
-	hkey[size] = 'x';
-	size += 1;
-        
-	size += eina_convert_xtoa(lo->region.h, hkey + size);
-     }
-
-   hkey[size] = '\0';
+   /* hits only cost a probe of the index, the string key is built for
+    * new entries only */
+   hash = _evas_cache_image_key_hash(file, key, lo);
 
 #ifdef EVAS_FRAME_QUEUING
    LKL(cache->lock);
 #endif
-   im = eina_hash_find(cache->activ, hkey);
+   im = _evas_cache_image_index_find(cache, hash, file, key, lo);
 #ifdef EVAS_FRAME_QUEUING
    LKU(cache->lock);
 #endif
-   if (im)
+   if ((im) && (im->flags.activ))
      {
         time_t t;
         int ok;
 
         ok = 1;
         t = time(NULL);
-        if ((t - im->laststat) > STAT_GAP)
+        if ((t - im->laststat) > cache->stat_gap)
           {
              stat_done = 1;
              if (stat(file, &st) < 0) goto on_stat_error;
@@ -848,16 +945,18 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file, const char *
 
         _evas_cache_image_remove_activ(cache, im);
 	_evas_cache_image_make_dirty(cache, im);
-     }
 
+        /* an inactiv copy may still be around */
 #ifdef EVAS_FRAME_QUEUING
-   LKL(cache->lock);
+        LKL(cache->lock);
 #endif
-   im = eina_hash_find(cache->inactiv, hkey);
+        im = _evas_cache_image_index_find(cache, hash, file, key, lo);
 #ifdef EVAS_FRAME_QUEUING
-   LKU(cache->lock);
+        LKU(cache->lock);
 #endif
-   if (im)
+     }
+
+   if ((im) && (!im->flags.activ))
      {
         int     ok;
 
@@ -867,7 +966,7 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file, const char *
              time_t  t;
 
              t = time(NULL);
-             if ((t - im->laststat) > STAT_GAP)
+             if ((t - im->laststat) > cache->stat_gap)
                {
                   stat_done = 1;
                   if (stat(file, &st) < 0) goto on_stat_error;
@@ -888,13 +987,75 @@ evas_cache_image_request(Evas_Cache_Image *cache, const char *file, const char *
 
         _evas_cache_image_entry_delete(cache, im);
      }
+   im = NULL;
 
    if (!stat_done)
      {
         if (stat(file, &st) < 0) goto on_stat_error;
      }
 
-   im = _evas_cache_image_entry_new(cache, hkey, st.st_mtime, file, key, lo, error);
+   file_length = strlen(file);
+   key_length = key ? strlen(key) : 6;
+
+   size = file_length + key_length + 128;
+   hkey = alloca(sizeof (char) * size);
+
+   memcpy(hkey, file, file_length);
+   size = file_length;
+
+   memcpy(hkey + size, "//://", 5);
+   size += 5;
+
+   if (key) ckey = key;
+   memcpy(hkey + size, ckey, key_length);
+   size += key_length;
+
+   if (lo != &prevent)
+     {
+	memcpy(hkey + size, "//@/", 4);
+	size += 4;
+
+	size += eina_convert_xtoa(lo->scale_down_by, hkey + size);
+
+	hkey[size] = '/';
+	size += 1;
+
+	size += eina_convert_dtoa(lo->dpi, hkey + size);
+
+	hkey[size] = '/';
+	size += 1;
+
+	size += eina_convert_xtoa(lo->w, hkey + size);
+
+	hkey[size] = 'x';
+	size += 1;
+
+	size += eina_convert_xtoa(lo->h, hkey + size);
+        
+	hkey[size] = '/';
+	size += 1;
+
+	size += eina_convert_xtoa(lo->region.x, hkey + size);
+        
+	hkey[size] = '+';
+	size += 1;
+        
+	size += eina_convert_xtoa(lo->region.y, hkey + size);
+        
+	hkey[size] = '.';
+	size += 1;
+        
+	size += eina_convert_xtoa(lo->region.w, hkey + size);
+        
+	hkey[size] = 'x';
+	size += 1;
+        
+	size += eina_convert_xtoa(lo->region.h, hkey + size);
+     }
+
+   hkey[size] = '\0';
+
+   im = _evas_cache_image_entry_new(cache, hkey, hash, st.st_mtime, file, key, lo, error);
    if (!im) return NULL;
 
    if (cache->func.debug)
@@ -1057,7 +1218,7 @@ evas_cache_image_dirty(Image_Entry *im, unsigned int x, unsigned int y, unsigned
              if (cache->func.debug)
                cache->func.debug("dirty-out", im_dirty);
 /*             
-             im_dirty = _evas_cache_image_entry_new(cache, NULL, im->timestamp, im->file, im->key, &im->load_opts, &error);
+             im_dirty = _evas_cache_image_entry_new(cache, NULL, 0, im->timestamp, im->file, im->key, &im->load_opts, &error);
              if (!im_dirty) goto on_error;
 
              if (cache->func.debug)
@@ -1139,7 +1300,7 @@ evas_cache_image_alone(Image_Entry *im)
         if (cache->func.debug)
           cache->func.debug("dirty-out", im_dirty);
 /*        
-        im_dirty = _evas_cache_image_entry_new(cache, NULL, im->timestamp, im->file, im->key, &im->load_opts, &error);
+        im_dirty = _evas_cache_image_entry_new(cache, NULL, 0, im->timestamp, im->file, im->key, &im->load_opts, &error);
         if (!im_dirty) goto on_error;
 
         if (cache->func.debug)
@@ -1176,11 +1337,10 @@ evas_cache_image_copied_data(Evas_Cache_Image *cache, unsigned int w, unsigned i
 
    assert(cache);
 
-   if ((cspace == EVAS_COLORSPACE_YCBCR422P601_PL) ||
-       (cspace == EVAS_COLORSPACE_YCBCR422P709_PL))
+   if (evas_common_convert_yuv_rows_get(cspace, 1))
      w &= ~0x1;
 
-   im = _evas_cache_image_entry_new(cache, NULL, 0, NULL, NULL, NULL, NULL);
+   im = _evas_cache_image_entry_new(cache, NULL, 0, 0, NULL, NULL, NULL, NULL);
    if (!im) return NULL;
 
    im->space = cspace;
@@ -1213,11 +1373,10 @@ evas_cache_image_data(Evas_Cache_Image *cache, unsigned int w, unsigned int h, D
 
    assert(cache);
 
-   if ((cspace == EVAS_COLORSPACE_YCBCR422P601_PL) ||
-       (cspace == EVAS_COLORSPACE_YCBCR422P709_PL))
+   if (evas_common_convert_yuv_rows_get(cspace, 1))
      w &= ~0x1;
 
-   im = _evas_cache_image_entry_new(cache, NULL, 0, NULL, NULL, NULL, NULL);
+   im = _evas_cache_image_entry_new(cache, NULL, 0, 0, NULL, NULL, NULL, NULL);
    im->w = w;
    im->h = h;
    im->flags.alpha = alpha;
@@ -1250,8 +1409,7 @@ evas_cache_image_surface_alloc(Image_Entry *im, unsigned int w, unsigned int h)
 
    cache = im->cache;
 
-   if ((im->space == EVAS_COLORSPACE_YCBCR422P601_PL) ||
-       (im->space == EVAS_COLORSPACE_YCBCR422P709_PL))
+   if (evas_common_convert_yuv_rows_get(im->space, 1))
      w &= ~0x1;
 
    _evas_cache_image_entry_surface_alloc(cache, im, w, h);
@@ -1277,8 +1435,7 @@ evas_cache_image_size_set(Image_Entry *im, unsigned int w, unsigned int h)
    LKU(im->lock_references);
 #endif
 
-   if ((im->space == EVAS_COLORSPACE_YCBCR422P601_PL) ||
-       (im->space == EVAS_COLORSPACE_YCBCR422P709_PL))
+   if (evas_common_convert_yuv_rows_get(im->space, 1))
      w &= ~0x1;
 
    if ((im->w == w) && (im->h == h))
@@ -1286,7 +1443,7 @@ evas_cache_image_size_set(Image_Entry *im, unsigned int w, unsigned int h)
 
    cache = im->cache;
 
-   new = _evas_cache_image_entry_new(cache, NULL, 0, NULL, NULL, NULL, &error);
+   new = _evas_cache_image_entry_new(cache, NULL, 0, 0, NULL, NULL, NULL, &error);
    if (!new) goto on_error;
 
    new->flags.alpha = im->flags.alpha;
@@ -1523,7 +1680,7 @@ evas_cache_image_empty(Evas_Cache_Image *cache)
 {
    Image_Entry *im;
 
-   im = _evas_cache_image_entry_new(cache, NULL, 0, NULL, NULL, NULL, NULL);
+   im = _evas_cache_image_entry_new(cache, NULL, 0, 0, NULL, NULL, NULL, NULL);
    if (!im) return NULL;
 
 #ifdef EVAS_FRAME_QUEUING
@@ -8,6 +8,7 @@
 
 #ifdef BUILD_ASYNC_PRELOAD
 # include <pthread.h>
+# include <sys/time.h>
 # ifdef __linux__
 # include <sys/syscall.h>
 # endif
@@ -21,8 +22,16 @@ static int _threads_max = 0;
 
 #ifdef BUILD_ASYNC_PRELOAD
 
+/* jobs are queued per worker and per priority class. a worker runs the
+ * most urgent job it can find, looking at its own queue first and then
+ * stealing from the other workers, so a visible image never waits behind
+ * a speculative one. */
+
+#define PRELOAD_PRIORITIES EVAS_IMAGE_PRELOAD_PRIORITY_LAST
+
 typedef struct _Evas_Preload_Pthread_Worker Evas_Preload_Pthread_Worker;
 typedef struct _Evas_Preload_Pthread_Data Evas_Preload_Pthread_Data;
+typedef struct _Evas_Preload_Pthread_Queue Evas_Preload_Pthread_Queue;
 
 typedef void (*_evas_preload_pthread_func)(void *data);
 
@@ -34,18 +43,46 @@ struct _Evas_Preload_Pthread_Worker
    _evas_preload_pthread_func func_end;
    _evas_preload_pthread_func func_cancel;
    void *data;
+   Evas_Preload_Pthread_Queue *queue; // queue it waits in, NULL once taken
+   double queued_at;
+   int priority;
    Eina_Bool cancel : 1;
 };
 
+struct _Evas_Preload_Pthread_Queue
+{
+   LK(lock);
+   Eina_Inlist *jobs[PRELOAD_PRIORITIES];
+   Eina_Bool running : 1;
+};
+
 struct _Evas_Preload_Pthread_Data
 {
    pthread_t thread;
+   Evas_Preload_Pthread_Queue *queue;
 };
 
-static int _threads_count = 0;
-static Evas_Preload_Pthread_Worker *_workers = NULL;
+static Evas_Preload_Pthread_Queue *_queues = NULL;
+static int _queue_next = 0;
 
-static LK(_mutex) = PTHREAD_MUTEX_INITIALIZER;
+static struct {
+   unsigned int queued[PRELOAD_PRIORITIES];
+   unsigned int running;
+   unsigned int done;
+   double       wait_total;
+   double       wait_max;
+} _stats;
+
+static LK(_stats_mutex);
+
+static double
+_evas_preload_time_get(void)
+{
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return (double)tv.tv_sec + ((double)tv.tv_usec / 1000000.0);
+}
 
 static void
 _evas_preload_thread_end(void *data)
@@ -53,7 +90,7 @@ _evas_preload_thread_end(void *data)
    Evas_Preload_Pthread_Data *pth = data;
    Evas_Preload_Pthread_Data *p = NULL;
 
-   if (pthread_join(pth->thread, (void **)&p) != 0) free(p);
+   if (pthread_join(pth->thread, (void **)&p) == 0) free(pth);
 }
 
 static void
@@ -69,44 +106,100 @@ _evas_preload_thread_done(void *target __UNUSED__, Evas_Callback_Type type __UNU
    free(work);
 }
 
+/* caller holds q->lock */
+static Evas_Preload_Pthread_Worker *
+_evas_preload_queue_pop(Evas_Preload_Pthread_Queue *q, int prio)
+{
+   Evas_Preload_Pthread_Worker *work;
+
+   if (!q->jobs[prio]) return NULL;
+   work = EINA_INLIST_CONTAINER_GET(q->jobs[prio], Evas_Preload_Pthread_Worker);
+   q->jobs[prio] = eina_inlist_remove(q->jobs[prio], q->jobs[prio]);
+   work->queue = NULL;
+   return work;
+}
+
+static Eina_Bool
+_evas_preload_queue_empty(const Evas_Preload_Pthread_Queue *q)
+{
+   int prio;
+
+   for (prio = 0; prio < PRELOAD_PRIORITIES; prio++)
+     if (q->jobs[prio]) return EINA_FALSE;
+   return EINA_TRUE;
+}
+
+static Evas_Preload_Pthread_Worker *
+_evas_preload_job_get(Evas_Preload_Pthread_Queue *own)
+{
+   Evas_Preload_Pthread_Worker *work = NULL;
+   int prio, i;
+
+   for (prio = 0; (prio < PRELOAD_PRIORITIES) && (!work); prio++)
+     {
+        LKL(own->lock);
+        work = _evas_preload_queue_pop(own, prio);
+        LKU(own->lock);
+        for (i = 0; (i < _threads_max) && (!work); i++)
+          {
+             Evas_Preload_Pthread_Queue *q = _queues + i;
+
+             if (q == own) continue;
+             LKL(q->lock);
+             work = _evas_preload_queue_pop(q, prio);
+             LKU(q->lock);
+          }
+     }
+   if (work)
+     {
+        double wait;
+
+        wait = _evas_preload_time_get() - work->queued_at;
+        LKL(_stats_mutex);
+        _stats.queued[work->priority]--;
+        _stats.running++;
+        _stats.wait_total += wait;
+        if (wait > _stats.wait_max) _stats.wait_max = wait;
+        LKU(_stats_mutex);
+     }
+   return work;
+}
+
 static void *
 _evas_preload_thread_worker(void *data)
 {
    Evas_Preload_Pthread_Data *pth = data;
+   Evas_Preload_Pthread_Queue *own = pth->queue;
    Evas_Preload_Pthread_Worker *work;
    
    eina_sched_prio_drop();
    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
-on_error:
    for (;;)
      {
-	LKL(_mutex);
-	if (!_workers)
-	  {
-	     LKU(_mutex);
-	     break;
-	  }
-
-	work = _workers;
-        _workers = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers),
-                                                                EINA_INLIST_GET(_workers)),
-                                             Evas_Preload_Pthread_Worker);
-	LKU(_mutex);
+        work = _evas_preload_job_get(own);
+        if (!work)
+          {
+             /* only our own queue can get new jobs without us being woken */
+             LKL(own->lock);
+             if (!_evas_preload_queue_empty(own))
+               {
+                  LKU(own->lock);
+                  continue;
+               }
+             own->running = 0;
+             LKU(own->lock);
+             break;
+          }
 
 	if (work->func_heavy) work->func_heavy(work->data);
+        LKL(_stats_mutex);
+        _stats.running--;
+        _stats.done++;
+        LKU(_stats_mutex);
 	evas_async_events_put(pth, 0, work, _evas_preload_thread_done);
      }
 
-   LKL(_mutex);
-   if (_workers)
-     {
-	LKU(_mutex);
-	goto on_error;
-     }
-   _threads_count--;
-   LKU(_mutex);
-
    // dummy worker to wake things up
    work = malloc(sizeof(Evas_Preload_Pthread_Worker));
    if (!work) return NULL;
@@ -120,6 +213,18 @@ on_error:
    evas_async_events_put(pth, 0, work, _evas_preload_thread_done);
    return pth;
 }
+
+static Evas_Preload_Pthread_Queue *
+_evas_preload_queue_pick(void)
+{
+   int i;
+
+   /* an idle worker first, it is the one that gets a thread started */
+   for (i = 0; i < _threads_max; i++)
+     if (!_queues[i].running) return _queues + i;
+   _queue_next = (_queue_next + 1) % _threads_max;
+   return _queues + _queue_next;
+}
 #endif
 
 void
@@ -127,6 +232,19 @@ _evas_preload_thread_init(void)
 {
    _threads_max = eina_cpu_count();
    if (_threads_max < 1) _threads_max = 1;
+#ifdef BUILD_ASYNC_PRELOAD
+   if (!_queues)
+     {
+        int i;
+
+        _queues = calloc(_threads_max, sizeof(Evas_Preload_Pthread_Queue));
+        if (!_queues) _threads_max = 0;
+        for (i = 0; i < _threads_max; i++)
+          LKI(_queues[i].lock);
+        LKI(_stats_mutex);
+     }
+   memset(&_stats, 0, sizeof(_stats));
+#endif
 }
 
 void
@@ -135,20 +253,25 @@ _evas_preload_thread_shutdown(void)
    /* FIXME: If function are still running in the background, should we kill them ? */
 #ifdef BUILD_ASYNC_PRELOAD
    Evas_Preload_Pthread_Worker *work;
+   int i, prio;
 
    /* Force processing of async events. */
    evas_async_events_process();
-   LKL(_mutex);
-   while (_workers)
+   for (i = 0; i < _threads_max; i++)
      {
-        work = _workers;
-        _workers = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers),
-                                                                EINA_INLIST_GET(_workers)),
-                                             Evas_Preload_Pthread_Worker);
-        if (work->func_cancel) work->func_cancel(work->data);
-	free(work);
+        Evas_Preload_Pthread_Queue *q = _queues + i;
+
+        LKL(q->lock);
+        for (prio = 0; prio < PRELOAD_PRIORITIES; prio++)
+          {
+             while ((work = _evas_preload_queue_pop(q, prio)))
+               {
+                  if (work->func_cancel) work->func_cancel(work->data);
+                  free(work);
+               }
+          }
+        LKU(q->lock);
      }
-   LKU(_mutex);
 #endif
 }
 
@@ -156,15 +279,23 @@ Evas_Preload_Pthread *
 evas_preload_thread_run(void (*func_heavy) (void *data),
 			void (*func_end) (void *data),
 			void (*func_cancel) (void *data),
-			const void *data)
+			const void *data,
+			Evas_Image_Preload_Priority priority)
 {
 #ifdef BUILD_ASYNC_PRELOAD
    Evas_Preload_Pthread_Worker *work;
    Evas_Preload_Pthread_Data *pth;
+   Evas_Preload_Pthread_Queue *q;
+   Eina_Bool start;
+   int i;
+
+   if ((int)priority < 0) priority = 0;
+   if ((int)priority >= PRELOAD_PRIORITIES) priority = PRELOAD_PRIORITIES - 1;
 
    work = malloc(sizeof(Evas_Preload_Pthread_Worker));
-   if (!work)
+   if ((!work) || (!_queues))
      {
+        free(work);
 	func_cancel((void *)data);
 	return NULL;
      }
@@ -174,44 +305,47 @@ evas_preload_thread_run(void (*func_heavy) (void *data),
    work->func_cancel = func_cancel;
    work->cancel = EINA_FALSE;
    work->data = (void *)data;
-
-   LKL(_mutex);
-   _workers = (Evas_Preload_Pthread_Worker *)eina_inlist_append(EINA_INLIST_GET(_workers), EINA_INLIST_GET(work));
-   if (_threads_count == _threads_max)
-     {
-	LKU(_mutex);
-	return (Evas_Preload_Pthread *)work;
-     }
-   LKU(_mutex);
+   work->priority = priority;
+   work->queued_at = _evas_preload_time_get();
+
+   LKL(_stats_mutex);
+   _stats.queued[priority]++;
+   LKU(_stats_mutex);
+
+   q = _evas_preload_queue_pick();
+   LKL(q->lock);
+   q->jobs[priority] = eina_inlist_append(q->jobs[priority], EINA_INLIST_GET(work));
+   work->queue = q;
+   start = !q->running;
+   q->running = 1;
+   LKU(q->lock);
+   if (!start) return (Evas_Preload_Pthread *)work;
 
    /* One more thread could be created. */
    pth = malloc(sizeof(Evas_Preload_Pthread_Data));
-   if (!pth) goto on_error;
-   
-   if (pthread_create(&pth->thread, NULL, _evas_preload_thread_worker, pth) == 0)
+   if (pth)
      {
-	LKL(_mutex);
-	_threads_count++;
-	LKU(_mutex);
-	return (Evas_Preload_Pthread*)work;
+        pth->queue = q;
+        if (pthread_create(&pth->thread, NULL, _evas_preload_thread_worker, pth) == 0)
+          return (Evas_Preload_Pthread *)work;
+        free(pth);
      }
 
- on_error:
-   LKL(_mutex);
-   if (_threads_count == 0)
-     {
-	LKU(_mutex);
-	if (work->func_cancel) work->func_cancel(work->data);
-	free(work);
-        return NULL;
-     }
-   LKU(_mutex);
-   return NULL;
+   LKL(q->lock);
+   q->running = 0;
+   LKU(q->lock);
+   /* a running worker will steal the job, give up only if there is none */
+   for (i = 0; i < _threads_max; i++)
+     if (_queues[i].running) return (Evas_Preload_Pthread *)work;
+   if (evas_preload_thread_cancel((Evas_Preload_Pthread *)work))
+     return NULL;
+   return (Evas_Preload_Pthread *)work;
 #else
    /*
     If no thread and as we don't want to break app that rely on this
     facility, we will lock the interface until we are done.
     */
+   (void)priority;
    func_heavy((void *)data);
    func_end((void *)data);
    return (void *)1;
@@ -223,29 +357,100 @@ evas_preload_thread_cancel(Evas_Preload_Pthread *thread)
 {
 #ifdef BUILD_ASYNC_PRELOAD
    Evas_Preload_Pthread_Worker *work;
+   Evas_Preload_Pthread_Queue *q;
 
    if (!thread) return EINA_TRUE;
-   LKL(_mutex);
-   EINA_INLIST_FOREACH(_workers, work)
+   work = (Evas_Preload_Pthread_Worker *)thread;
+   q = work->queue;
+   if (q)
      {
-        if (work == (Evas_Preload_Pthread_Worker *)thread)
+        LKL(q->lock);
+        if (work->queue == q)
           {
-             _workers = EINA_INLIST_CONTAINER_GET(eina_inlist_remove(EINA_INLIST_GET(_workers),
-                                                                     EINA_INLIST_GET(work)),
-                                                  Evas_Preload_Pthread_Worker);
-             LKU(_mutex);
+             q->jobs[work->priority] = eina_inlist_remove(q->jobs[work->priority],
+                                                          EINA_INLIST_GET(work));
+             work->queue = NULL;
+             LKU(q->lock);
+             LKL(_stats_mutex);
+             _stats.queued[work->priority]--;
+             LKU(_stats_mutex);
              if (work->func_cancel) work->func_cancel(work->data);
              free(work);
              return EINA_TRUE;
           }
+        LKU(q->lock);
      }
-   LKU(_mutex);
    
    /* Delay the destruction */
-   work = (Evas_Preload_Pthread_Worker *)thread;
    work->cancel = EINA_TRUE;
    return EINA_FALSE;
 #else
    return EINA_TRUE;
 #endif
 }
+
+void
+evas_preload_thread_priority_set(Evas_Preload_Pthread *thread, Evas_Image_Preload_Priority priority)
+{
+#ifdef BUILD_ASYNC_PRELOAD
+   Evas_Preload_Pthread_Worker *work;
+   Evas_Preload_Pthread_Queue *q;
+
+   if (!thread) return;
+   if (((int)priority < 0) || ((int)priority >= PRELOAD_PRIORITIES)) return;
+   work = (Evas_Preload_Pthread_Worker *)thread;
+   q = work->queue;
+   /* too late once a worker took it */
+   if ((!q) || (work->priority == (int)priority)) return;
+   LKL(q->lock);
+   if (work->queue == q)
+     {
+        q->jobs[work->priority] = eina_inlist_remove(q->jobs[work->priority],
+                                                     EINA_INLIST_GET(work));
+        q->jobs[priority] = eina_inlist_append(q->jobs[priority],
+                                               EINA_INLIST_GET(work));
+        LKL(_stats_mutex);
+        _stats.queued[work->priority]--;
+        _stats.queued[priority]++;
+        LKU(_stats_mutex);
+        work->priority = priority;
+     }
+   LKU(q->lock);
+#else
+   (void)thread;
+   (void)priority;
+#endif
+}
+
+/**
+ * Get statistics about asynchronous image preloading.
+ *
+ * @param stats where to store the queue depth per priority, the jobs
+ *        being loaded and done, and how long jobs waited in queue.
+ * @return @c EINA_TRUE if @p stats was filled, @c EINA_FALSE if Evas
+ *         was built without asynchronous preload.
+ * @ingroup Evas_Image_Group
+ */
+EAPI Eina_Bool
+evas_image_preload_stats_get(Evas_Image_Preload_Stats *stats)
+{
+#ifdef BUILD_ASYNC_PRELOAD
+   int prio;
+
+   if (!stats) return EINA_FALSE;
+   LKL(_stats_mutex);
+   for (prio = 0; prio < PRELOAD_PRIORITIES; prio++)
+     stats->queued[prio] = _stats.queued[prio];
+   stats->running = _stats.running;
+   stats->done = _stats.done;
+   stats->wait_avg = 0.0;
+   if ((_stats.done + _stats.running) > 0)
+     stats->wait_avg = _stats.wait_total / (double)(_stats.done + _stats.running);
+   stats->wait_max = _stats.wait_max;
+   LKU(_stats_mutex);
+   return EINA_TRUE;
+#else
+   (void)stats;
+   return EINA_FALSE;
+#endif
+}
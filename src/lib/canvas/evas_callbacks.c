@@ -41,22 +41,45 @@ _evas_post_event_callback_free(Evas *e)
 }
 
 void
-evas_event_callback_list_post_free(Eina_Inlist **list)
+evas_event_callback_list_post_free(Evas_Callbacks *cbs)
 {
    Eina_Inlist *l;
+   int type;
 
    /* MEM OK */
-   for (l = *list; l;)
+   for (type = 0; type < EVAS_CALLBACK_LAST; type++)
      {
-	Evas_Func_Node *fn;
+        Eina_Inlist **list;
 
-	fn = (Evas_Func_Node *)l;
-	l = l->next;
-	if (fn->delete_me)
-	  {
-             *list = eina_inlist_remove(*list, EINA_INLIST_GET(fn));
-             EVAS_MEMPOOL_FREE(_mp_fn, fn);
-	  }
+        if (!(cbs->mask & (1 << type))) continue;
+        list = &(cbs->callbacks[type]);
+        for (l = *list; l;)
+          {
+             Evas_Func_Node *fn;
+
+             fn = (Evas_Func_Node *)l;
+             l = l->next;
+             if (fn->delete_me)
+               {
+                  *list = eina_inlist_remove(*list, EINA_INLIST_GET(fn));
+                  EVAS_MEMPOOL_FREE(_mp_fn, fn);
+               }
+          }
+        if (!*list) cbs->mask &= ~(1 << type);
+     }
+}
+
+static void
+evas_event_callback_list_all_del(Evas_Callbacks *cbs)
+{
+   Evas_Func_Node *fn;
+   int type;
+
+   for (type = 0; type < EVAS_CALLBACK_LAST; type++)
+     {
+        if (!(cbs->mask & (1 << type))) continue;
+        EINA_INLIST_FOREACH(cbs->callbacks[type], fn)
+          fn->delete_me = 1;
      }
 }
 
@@ -66,8 +89,8 @@ evas_object_event_callback_clear(Evas_Object *obj)
    if (!obj->callbacks) return;
    if (!obj->callbacks->deletions_waiting) return;
    obj->callbacks->deletions_waiting = 0;
-   evas_event_callback_list_post_free(&obj->callbacks->callbacks);
-   if (!obj->callbacks->callbacks)
+   evas_event_callback_list_post_free(obj->callbacks);
+   if (!obj->callbacks->mask)
      {
         EVAS_MEMPOOL_FREE(_mp_cb, obj->callbacks);
 	obj->callbacks = NULL;
@@ -80,8 +103,8 @@ evas_event_callback_clear(Evas *e)
    if (!e->callbacks) return;
    if (!e->callbacks->deletions_waiting) return;
    e->callbacks->deletions_waiting = 0;
-   evas_event_callback_list_post_free(&e->callbacks->callbacks);
-   if (!e->callbacks->callbacks)
+   evas_event_callback_list_post_free(e->callbacks);
+   if (!e->callbacks->mask)
      {
         EVAS_MEMPOOL_FREE(_mp_cb, e->callbacks);
 	e->callbacks = NULL;
@@ -91,11 +114,8 @@ evas_event_callback_clear(Evas *e)
 void
 evas_object_event_callback_all_del(Evas_Object *obj)
 {
-   Evas_Func_Node *fn;
-
    if (!obj->callbacks) return;
-   EINA_INLIST_FOREACH(obj->callbacks->callbacks, fn)
-     fn->delete_me = 1;
+   evas_event_callback_list_all_del(obj->callbacks);
 }
 
 void
@@ -103,7 +123,7 @@ evas_object_event_callback_cleanup(Evas_Object *obj)
 {
    /* MEM OK */
    if (!obj->callbacks) return;
-   evas_event_callback_list_post_free(&obj->callbacks->callbacks);
+   evas_event_callback_list_post_free(obj->callbacks);
    EVAS_MEMPOOL_FREE(_mp_cb, obj->callbacks);
    obj->callbacks = NULL;
 }
@@ -111,11 +131,8 @@ evas_object_event_callback_cleanup(Evas_Object *obj)
 void
 evas_event_callback_all_del(Evas *e)
 {
-   Evas_Func_Node *fn;
-
    if (!e->callbacks) return;
-   EINA_INLIST_FOREACH(e->callbacks->callbacks, fn)
-     fn->delete_me = 1;
+   evas_event_callback_list_all_del(e->callbacks);
 }
 
 void
@@ -123,7 +140,7 @@ evas_event_callback_cleanup(Evas *e)
 {
    /* MEM OK */
    if (!e->callbacks) return;
-   evas_event_callback_list_post_free(&e->callbacks->callbacks);
+   evas_event_callback_list_post_free(e->callbacks);
    EVAS_MEMPOOL_FREE(_mp_cb, e->callbacks);
    e->callbacks = NULL;
 }
@@ -133,17 +150,18 @@ evas_event_callback_call(Evas *e, Evas_Callback_Type type, void *event_info)
 {
    Eina_Inlist **l_mod = NULL, *l;
 
+   if ((!e->callbacks) || (!(e->callbacks->mask & (1 << type)))) return;
    _evas_walk(e);
    if (e->callbacks)
      {
-	l_mod = &e->callbacks->callbacks;
+	l_mod = &e->callbacks->callbacks[type];
         e->callbacks->walking_list++;
         for (l = *l_mod; l; l = l->next)
           {
 	     Evas_Func_Node *fn;
 
 	     fn = (Evas_Func_Node *)l;
-	     if ((fn->type == type) && (!fn->delete_me))
+	     if (!fn->delete_me)
 	       {
 		  Evas_Event_Cb func = fn->func;
 	          if (func)
@@ -175,9 +193,10 @@ evas_object_event_callback_call(Evas_Object *obj, Evas_Callback_Type type, void
    if (!(e = obj->layer->evas)) return;
 
    _evas_walk(e);
-   if (obj->callbacks)
+   /* one bit test when nobody listens for this type */
+   if ((obj->callbacks) && (obj->callbacks->mask & (1 << type)))
      {
-	l_mod = &obj->callbacks->callbacks;
+	l_mod = &obj->callbacks->callbacks[type];
         switch (type)
           {
              case EVAS_CALLBACK_MOUSE_DOWN:
@@ -215,7 +234,7 @@ evas_object_event_callback_call(Evas_Object *obj, Evas_Callback_Type type, void
 	     Evas_Func_Node *fn;
 
 	     fn = (Evas_Func_Node *)l;
-	     if ((fn->type == type) && (!fn->delete_me))
+	     if (!fn->delete_me)
 	       {
 		  Evas_Object_Event_Cb func = fn->func;
 	          if (func)
@@ -443,6 +462,7 @@ evas_object_event_callback_add(Evas_Object *obj, Evas_Callback_Type type, Evas_O
    MAGIC_CHECK_END();
 
    if (!func) return;
+   if ((unsigned int)type >= EVAS_CALLBACK_LAST) return;
 
    if (!obj->callbacks)
      {
@@ -460,8 +480,9 @@ evas_object_event_callback_add(Evas_Object *obj, Evas_Callback_Type type, Evas_O
    fn->data = (void *)data;
    fn->type = type;
 
-   obj->callbacks->callbacks =
-     eina_inlist_prepend(obj->callbacks->callbacks, EINA_INLIST_GET(fn));
+   obj->callbacks->callbacks[type] =
+     eina_inlist_prepend(obj->callbacks->callbacks[type], EINA_INLIST_GET(fn));
+   obj->callbacks->mask |= (1 << type);
 }
 
 /**
@@ -501,10 +522,11 @@ evas_object_event_callback_del(Evas_Object *obj, Evas_Callback_Type type, Evas_O
    if (!func) return NULL;
 
    if (!obj->callbacks) return NULL;
+   if ((unsigned int)type >= EVAS_CALLBACK_LAST) return NULL;
 
-   EINA_INLIST_FOREACH(obj->callbacks->callbacks, fn)
+   EINA_INLIST_FOREACH(obj->callbacks->callbacks[type], fn)
      {
-	if ((fn->func == func) && (fn->type == type) && (!fn->delete_me))
+	if ((fn->func == func) && (!fn->delete_me))
 	  {
 	     void *data;
 
@@ -558,10 +580,11 @@ evas_object_event_callback_del_full(Evas_Object *obj, Evas_Callback_Type type, E
    if (!func) return NULL;
 
    if (!obj->callbacks) return NULL;
+   if ((unsigned int)type >= EVAS_CALLBACK_LAST) return NULL;
 
-   EINA_INLIST_FOREACH(obj->callbacks->callbacks, fn)
+   EINA_INLIST_FOREACH(obj->callbacks->callbacks[type], fn)
      {
-	if ((fn->func == func) && (fn->type == type) && (fn->data == data) && (!fn->delete_me))
+	if ((fn->func == func) && (fn->data == data) && (!fn->delete_me))
 	  {
 	     void *data;
 
@@ -654,6 +677,7 @@ evas_event_callback_add(Evas *e, Evas_Callback_Type type, Evas_Event_Cb func, co
    MAGIC_CHECK_END();
 
    if (!func) return;
+   if ((unsigned int)type >= EVAS_CALLBACK_LAST) return;
 
    if (!e->callbacks)
      {
@@ -671,8 +695,9 @@ evas_event_callback_add(Evas *e, Evas_Callback_Type type, Evas_Event_Cb func, co
    fn->data = (void *)data;
    fn->type = type;
 
-   e->callbacks->callbacks =
-     eina_inlist_prepend(e->callbacks->callbacks, EINA_INLIST_GET(fn));
+   e->callbacks->callbacks[type] =
+     eina_inlist_prepend(e->callbacks->callbacks[type], EINA_INLIST_GET(fn));
+   e->callbacks->mask |= (1 << type);
 }
 
 /**
@@ -712,10 +737,11 @@ evas_event_callback_del(Evas *e, Evas_Callback_Type type, Evas_Event_Cb func)
    if (!func) return NULL;
 
    if (!e->callbacks) return NULL;
+   if ((unsigned int)type >= EVAS_CALLBACK_LAST) return NULL;
 
-   EINA_INLIST_FOREACH(e->callbacks->callbacks, fn)
+   EINA_INLIST_FOREACH(e->callbacks->callbacks[type], fn)
      {
-	if ((fn->func == func) && (fn->type == type) && (!fn->delete_me))
+	if ((fn->func == func) && (!fn->delete_me))
 	  {
 	     void *data;
 
@@ -769,10 +795,11 @@ evas_event_callback_del_full(Evas *e, Evas_Callback_Type type, Evas_Event_Cb fun
    if (!func) return NULL;
 
    if (!e->callbacks) return NULL;
+   if ((unsigned int)type >= EVAS_CALLBACK_LAST) return NULL;
 
-   EINA_INLIST_FOREACH(e->callbacks->callbacks, fn)
+   EINA_INLIST_FOREACH(e->callbacks->callbacks[type], fn)
      {
-	if ((fn->func == func) && (fn->type == type) && (fn->data == data) && (!fn->delete_me))
+	if ((fn->func == func) && (fn->data == data) && (!fn->delete_me))
 	  {
 	     void *data;
 
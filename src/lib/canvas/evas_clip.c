@@ -8,6 +8,7 @@ evas_object_clip_dirty(Evas_Object *obj)
    Evas_Object *data;
 
    obj->cur.cache.clip.dirty = 1;
+   evas_object_index_clip_dirty(obj);
    EINA_LIST_FOREACH(obj->clip.clipees, l, data)
      evas_object_clip_dirty(data);
 }
@@ -255,6 +256,7 @@ evas_object_clip_set(Evas_Object *obj, Evas_Object *clip)
      {
 	/* Basically it just went invisible */
 	clip->changed = 1;
+	clip->changed_move = 0;
 	clip->layer->evas->changed = 1;
 	evas_damage_rectangle_add(clip->layer->evas,
 				  clip->cur.geometry.x, clip->cur.geometry.y,
@@ -113,6 +113,78 @@ _evas_event_object_list_in_get(Evas *e, Eina_List *in,
    return in;
 }
 
+/* members of a mapped smart object are reached through their parent only,
+ * as their clip geometry is not in canvas coordinates */
+static Eina_Bool
+_evas_event_object_index_reachable(Evas_Object *obj)
+{
+   Evas_Object *par;
+
+   for (par = obj->smart.parent; par; par = par->smart.parent)
+     {
+        if ((par->cur.map) && (par->cur.map->count == 4) && (par->cur.usemap))
+          return EINA_FALSE;
+        if ((!par->cur.visible) || (par->delete_me) || (par->clip.clipees) ||
+            (!evas_object_clippers_is_visible(par)))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+static Eina_List *
+_evas_event_objects_index_list(Evas *e, int x, int y)
+{
+   Eina_Array_Iterator it;
+   Evas_Object *obj;
+   Eina_List *in = NULL;
+   unsigned int i;
+
+   evas_object_index_query(e, &e->index.query, x, y, 1, 1);
+   EINA_ARRAY_ITER_NEXT(&e->index.query, i, obj, it)
+     {
+        int mapped;
+
+	if (evas_event_passes_through(obj)) continue;
+        if ((!obj->cur.visible) || (obj->delete_me) ||
+            (obj->clip.clipees) ||
+            (!evas_object_clippers_is_visible(obj)))
+          continue;
+        if (!_evas_event_object_index_reachable(obj)) continue;
+        mapped = ((obj->cur.map) && (obj->cur.map->count == 4) && (obj->cur.usemap));
+        if (obj->smart.smart)
+          {
+             int norep = 0;
+
+             /* plain smart objects are covered by their members */
+             if (!mapped) continue;
+             if (!evas_map_coords_get(obj->cur.map, x, y,
+                                      &(obj->cur.map->mx),
+                                      &(obj->cur.map->my), 0))
+               continue;
+             in = _evas_event_object_list_in_get
+                (e, in, evas_object_smart_members_get_direct(obj), NULL,
+                 obj->cur.geometry.x + obj->cur.map->mx,
+                 obj->cur.geometry.y + obj->cur.map->my, &norep);
+             if (norep) break;
+          }
+        else
+          {
+             if ((mapped) &&
+                 (!evas_map_coords_get(obj->cur.map, x, y,
+                                       &(obj->cur.map->mx),
+                                       &(obj->cur.map->my), 0)))
+               continue;
+             if ((!obj->precise_is_inside) || (evas_object_is_inside(obj, x, y)))
+               {
+                  in = eina_list_append(in, obj);
+                  if (!obj->repeat_events) break;
+               }
+          }
+     }
+   eina_array_clean(&e->index.query);
+   return in;
+}
+
 Eina_List *
 evas_event_objects_event_list(Evas *e, Evas_Object *stop, int x, int y)
 {
@@ -120,6 +192,7 @@ evas_event_objects_event_list(Evas *e, Evas_Object *stop, int x, int y)
    Eina_List *in = NULL;
 
    if (!e->layers) return NULL;
+   if (!stop) return _evas_event_objects_index_list(e, x, y);
    EINA_INLIST_REVERSE_FOREACH((EINA_INLIST_GET(e->layers)), lay)
      {
 	int norep;
@@ -168,6 +168,9 @@ evas_new(void)
    EVAS_ARRAY_SET(e, temporary_objects);
    EVAS_ARRAY_SET(e, calculate_objects);
    EVAS_ARRAY_SET(e, clip_changes);
+   EVAS_ARRAY_SET(e, pre_render_objects);
+   EVAS_ARRAY_SET(e, index.pending);
+   EVAS_ARRAY_SET(e, index.query);
 
 #undef EVAS_ARRAY_SET
 
@@ -188,6 +191,7 @@ EAPI void
 evas_free(Evas *e)
 {
    Eina_Rectangle *r;
+   Evas_Scroll *sc;
    Evas_Layer *lay;
    int i;
    int del;
@@ -209,8 +213,8 @@ evas_free(Evas *e)
 	if (e->callbacks->deletions_waiting) return;
 
 	e->callbacks->deletions_waiting = 0;
-	evas_event_callback_list_post_free(&e->callbacks->callbacks);
-	if (!e->callbacks->callbacks)
+	evas_event_callback_list_post_free(e->callbacks);
+	if (!e->callbacks->mask)
 	  {
 	     free(e->callbacks);
 	     e->callbacks = NULL;
@@ -261,6 +265,8 @@ evas_free(Evas *e)
      eina_rectangle_free(r);
    EINA_LIST_FREE(e->obscures, r)
      eina_rectangle_free(r);
+   EINA_LIST_FREE(e->scrolls, sc)
+     free(sc);
 
    evas_fonts_zero_free(e);
    
@@ -293,6 +299,9 @@ evas_free(Evas *e)
    eina_array_flush(&e->temporary_objects);
    eina_array_flush(&e->calculate_objects);
    eina_array_flush(&e->clip_changes);
+   eina_array_flush(&e->pre_render_objects);
+   evas_object_index_free(e);
+   evas_render_bins_free(e);
 
    e->magic = 0;
    free(e);
@@ -156,9 +156,29 @@ _evas_map_free(Evas_Object *obj, Evas_Map *m)
           obj->layer->evas->engine.func->image_map_surface_free
           (obj->layer->evas->engine.data.output, m->surface);
      }
+   if (m->damage) evas_common_tilebuf_free(m->damage);
    free(m);
 }
 
+/* the map surface of obj, or of the nearest smart parent with a map in
+ * use, no longer holds what its members would draw. drop its damage so it
+ * is redrawn in full next time. disabled maps are skipped, the members go
+ * through them to the surface above */
+void
+evas_object_map_surface_invalidate(Evas_Object *obj)
+{
+   for (; obj; obj = obj->smart.parent)
+     {
+        if ((!obj->cur.map) || (!obj->cur.usemap)) continue;
+        if (obj->cur.map->damage)
+          {
+             evas_common_tilebuf_free(obj->cur.map->damage);
+             obj->cur.map->damage = NULL;
+          }
+        return;
+     }
+}
+
 Eina_Bool
 evas_map_coords_get(const Evas_Map *m, Evas_Coord x, Evas_Coord y,
                     Evas_Coord *mx, Evas_Coord *my, int grab)
@@ -344,6 +364,8 @@ evas_object_map_enable_set(Evas_Object *obj, Eina_Bool enabled)
           }
      }
    _evas_map_calc_map_geometry(obj);
+   /* members were drawn straight to the canvas meanwhile */
+   if (obj->cur.map) evas_object_map_surface_invalidate(obj);
    /* This is a bit heavy handed, but it fixes the case of same geometry, but
     * changed colour or UV settings. */
    evas_object_change(obj);
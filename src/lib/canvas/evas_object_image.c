@@ -60,6 +60,7 @@ struct _Evas_Object_Image
 
    Evas_Image_Scale_Hint   scale_hint;
    Evas_Image_Content_Hint content_hint;
+   Evas_Image_Preload_Priority preload_priority;
 
    void             *engine_data;
 
@@ -1161,6 +1162,57 @@ evas_object_image_preload(Evas_Object *obj, Eina_Bool cancel)
 							       obj);
 }
 
+/**
+ * Set how urgently the image of a given object should be preloaded.
+ *
+ * Preloads of visible images are served before those of images about
+ * to become visible, which are served before speculative ones. If the
+ * preload is still waiting in the queue, calling
+ * evas_object_image_preload() again with @c cancel set to 0 moves it to
+ * the new priority instead of queueing it twice.
+ *
+ * @param obj The given image object.
+ * @param priority The preload priority, EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE
+ *        by default.
+ */
+EAPI void
+evas_object_image_preload_priority_set(Evas_Object *obj, Evas_Image_Preload_Priority priority)
+{
+   Evas_Object_Image *o;
+
+   MAGIC_CHECK(obj, Evas_Object, MAGIC_OBJ);
+   return;
+   MAGIC_CHECK_END();
+   o = (Evas_Object_Image *)(obj->object_data);
+   MAGIC_CHECK(o, Evas_Object_Image, MAGIC_OBJ_IMAGE);
+   return;
+   MAGIC_CHECK_END();
+   if (((int)priority < 0) || (priority >= EVAS_IMAGE_PRELOAD_PRIORITY_LAST))
+     return;
+   o->preload_priority = priority;
+}
+
+/**
+ * Get the preload priority of a given image object.
+ *
+ * @param obj The given image object.
+ * @return The preload priority.
+ */
+EAPI Evas_Image_Preload_Priority
+evas_object_image_preload_priority_get(const Evas_Object *obj)
+{
+   Evas_Object_Image *o;
+
+   MAGIC_CHECK(obj, Evas_Object, MAGIC_OBJ);
+   return EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE;
+   MAGIC_CHECK_END();
+   o = (Evas_Object_Image *)(obj->object_data);
+   MAGIC_CHECK(o, Evas_Object_Image, MAGIC_OBJ_IMAGE);
+   return EVAS_IMAGE_PRELOAD_PRIORITY_VISIBLE;
+   MAGIC_CHECK_END();
+   return o->preload_priority;
+}
+
 /**
  * Replaces the raw image data of the given image object.
  *
@@ -1937,9 +1989,14 @@ evas_object_image_colorspace_set(Evas_Object *obj, Evas_Colorspace cspace)
 
    o->cur.cspace = cspace;
    if (o->engine_data)
-     obj->layer->evas->engine.func->image_colorspace_set(obj->layer->evas->engine.data.output,
-							 o->engine_data,
-							 cspace);
+     {
+	obj->layer->evas->engine.func->image_colorspace_set(obj->layer->evas->engine.data.output,
+							    o->engine_data,
+							    cspace);
+	/* engines leave images alone in colorspaces they do not support */
+	o->cur.cspace = obj->layer->evas->engine.func->image_colorspace_get(obj->layer->evas->engine.data.output,
+									    o->engine_data);
+     }
 }
 
 /**
@@ -2345,26 +2402,147 @@ _proxy_error(Evas_Object *proxy, void *context, void *output, void *surface,
    return;
 }
 
+/* proxy surfaces belong to the source and are shared by all its proxies.
+ * they keep their content between renders and only the parts damaged by
+ * changes of the source members are drawn again. each member drawn in a
+ * proxy surface remembers where it went (proxy_drawn, canvas coords): a
+ * change damages that rect in the surface of every source above it right
+ * away, and the next redraw of each source adds where the members changed
+ * since that source last looked are now */
+static unsigned int _proxy_stamp = 0;
+
+void
+evas_object_proxy_change(Evas_Object *obj)
+{
+   Evas_Object *src;
+   Eina_Bool found = EINA_FALSE;
+
+   if (obj->smart.smart) return;
+   for (src = obj->smart.parent; src; src = src->smart.parent)
+     {
+        if (!src->proxy.proxies) continue;
+        found = EINA_TRUE;
+        if ((!src->proxy.damage) || (!obj->proxy_drawn.valid)) continue;
+        evas_common_tilebuf_add_redraw(src->proxy.damage,
+                                       obj->proxy_drawn.x - src->proxy.x,
+                                       obj->proxy_drawn.y - src->proxy.y,
+                                       obj->proxy_drawn.w, obj->proxy_drawn.h);
+     }
+   if (found) obj->proxy_drawn.stamp = ++_proxy_stamp;
+}
+
+/* members came or went without being changed, redraw the surfaces of all
+ * the sources from obj up in full */
+void
+evas_object_proxy_invalidate(Evas_Object *obj)
+{
+   for (; obj; obj = obj->smart.parent)
+     {
+        if (!obj->proxy.damage) continue;
+        evas_common_tilebuf_free(obj->proxy.damage);
+        obj->proxy.damage = NULL;
+     }
+}
+
+void
+evas_object_proxy_surface_free(Evas_Object *obj)
+{
+   if (obj->proxy.surface)
+     {
+        obj->layer->evas->engine.func->image_map_surface_free
+          (obj->layer->evas->engine.data.output, obj->proxy.surface);
+        obj->proxy.surface = NULL;
+     }
+   if (obj->proxy.damage)
+     {
+        evas_common_tilebuf_free(obj->proxy.damage);
+        obj->proxy.damage = NULL;
+     }
+}
+
+/* the surface needs no alpha if one member paints all of it. what a
+ * member paints is bounded by its clip, which its clippers go into */
+static Eina_Bool
+_proxy_source_opaque_get(Evas_Object *source, Evas_Object *obj)
+{
+   Evas_Object *obj2;
+
+   if (!obj->smart.smart)
+     {
+        evas_object_clip_recalc(obj);
+        return ((evas_object_is_visible(obj)) &&
+                (evas_object_is_opaque(obj)) &&
+                (obj->cur.cache.clip.x <= source->cur.geometry.x) &&
+                (obj->cur.cache.clip.y <= source->cur.geometry.y) &&
+                ((obj->cur.cache.clip.x + obj->cur.cache.clip.w) >=
+                 (source->cur.geometry.x + source->cur.geometry.w)) &&
+                ((obj->cur.cache.clip.y + obj->cur.cache.clip.h) >=
+                 (source->cur.geometry.y + source->cur.geometry.h)));
+     }
+   EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(obj), obj2)
+     {
+        if ((obj2->clip.clipees) || (!evas_object_is_visible(obj2)))
+          continue;
+        if (_proxy_source_opaque_get(source, obj2)) return EINA_TRUE;
+     }
+   return EINA_FALSE;
+}
+
+/* brings the drawn rects of the members of source up to date, damaging
+ * tb (when not redrawing in full) where those changed since last time */
+static void
+_proxy_damage_collect(Evas_Object *source, Evas_Object *obj, Tilebuf *tb)
+{
+   Evas_Object *obj2;
+
+   EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(obj), obj2)
+     {
+        if (obj2->smart.smart)
+          {
+             _proxy_damage_collect(source, obj2, tb);
+             continue;
+          }
+        obj2->proxy_drawn.valid = 0;
+        if ((obj2->cur.geometry.w <= 0) || (obj2->cur.geometry.h <= 0))
+          continue;
+        obj2->proxy_drawn.x = obj2->cur.geometry.x;
+        obj2->proxy_drawn.y = obj2->cur.geometry.y;
+        obj2->proxy_drawn.w = obj2->cur.geometry.w;
+        obj2->proxy_drawn.h = obj2->cur.geometry.h;
+        obj2->proxy_drawn.valid = 1;
+        if ((tb) && (obj2->proxy_drawn.stamp > source->proxy.stamp))
+          evas_common_tilebuf_add_redraw(tb,
+                                         obj2->proxy_drawn.x - source->cur.geometry.x,
+                                         obj2->proxy_drawn.y - source->cur.geometry.y,
+                                         obj2->proxy_drawn.w, obj2->proxy_drawn.h);
+     }
+}
+
 static void
 _proxy_subrender_recurse(Evas_Object *obj, void *output, void *surface, void *ctx, int x, int y){
      Evas_Object *obj2;
      Evas *e;
+     int cx, cy, cw, ch;
+     void *ctx2;
      e = obj->layer->evas;
      if (obj->clip.clipees) return;
      if (!evas_object_is_visible(obj)) return;
      obj->pre_render_done = 1;
-     ctx = e->engine.func->context_new(output);
+     ctx2 = e->engine.func->context_new(output);
+     /* only the damaged part of the surface is redrawn */
+     if (e->engine.func->context_clip_get(output, ctx, &cx, &cy, &cw, &ch))
+       e->engine.func->context_clip_set(output, ctx2, cx, cy, cw, ch);
      if (obj->smart.smart)
        {
           EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(obj), obj2){
-               _proxy_subrender_recurse(obj2, output, surface, ctx, x,y);
+               _proxy_subrender_recurse(obj2, output, surface, ctx2, x,y);
           }
        }
      else
        {
-          obj->func->render(obj, output, ctx, surface,x,y);
+          obj->func->render(obj, output, ctx2, surface,x,y);
        }
-     e->engine.func->context_free(output, ctx);
+     e->engine.func->context_free(output, ctx2);
 }
 
 
@@ -2373,12 +2551,15 @@ _proxy_subrender_recurse(Evas_Object *obj, void *output, void *surface, void *ct
  * Render the source object when a proxy is set.
  *
  * Used to force a draw if necessary, else just makes sures it's available.
+ * Only what changed in the source since the last call is drawn again.
  */
 static void
 _proxy_subrender(Evas *e, Evas_Object *source)
 {
    void *ctx;
    Evas_Object *obj2;
+   Tilebuf_Rect whole, *rects, *r;
+   Eina_Bool alpha, full = EINA_FALSE;
    int w,h;
 
    if (!source) return;
@@ -2388,54 +2569,100 @@ _proxy_subrender(Evas *e, Evas_Object *source)
 
    source->proxy.redraw = EINA_FALSE;
 
+   alpha = !_proxy_source_opaque_get(source, source);
+
    /* We need to redraw surface then */
-   if (source->proxy.surface && (source->proxy.w != w || source->proxy.h != h))
-     {
-        e->engine.func->image_map_surface_free(e->engine.data.output,
-                                               source->proxy.surface);
-        source->proxy.surface = NULL;
-     }
+   if (source->proxy.surface &&
+       (source->proxy.w != w || source->proxy.h != h ||
+        source->proxy.alpha != alpha))
+     evas_object_proxy_surface_free(source);
 
-   /* FIXME: Hardcoded alpha 'on' */
-   /* FIXME (cont): Should see if the object has alpha */
    if (!source->proxy.surface)
      {
         source->proxy.surface = e->engine.func->image_map_surface_new(
-           e->engine.data.output, w, h, 1);
+           e->engine.data.output, w, h, alpha);
         source->proxy.w = w;
         source->proxy.h = h;
+        source->proxy.alpha = alpha;
+        full = EINA_TRUE;
      }
+   if (!source->proxy.surface) return;
 
-   ctx = e->engine.func->context_new(e->engine.data.output);
-   e->engine.func->context_color_set(e->engine.data.output, ctx, 0, 0, 0, 0);
-   e->engine.func->context_render_op_set(e->engine.data.output, ctx, EVAS_RENDER_COPY);
-   e->engine.func->rectangle_draw(e->engine.data.output, ctx,
-                                  source->proxy.surface, 0, 0, w, h);
-   e->engine.func->context_free(e->engine.data.output, ctx);
-
-   ctx = e->engine.func->context_new(e->engine.data.output);
    if (source->smart.smart)
      {
-        EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(source), obj2){
-             _proxy_subrender_recurse(obj2, e->engine.data.output,
-                                      source->proxy.surface,
-                                      ctx,
-                                      -source->cur.geometry.x,
-                                      -source->cur.geometry.y);
-        }
+        if (!source->proxy.damage)
+          {
+             source->proxy.damage = evas_common_tilebuf_new(w, h);
+             if (source->proxy.damage)
+               evas_common_tilebuf_set_tile_size(source->proxy.damage,
+                                                 TILESIZE, TILESIZE);
+             full = EINA_TRUE;
+          }
+        /* members were not necessarily moved along */
+        if ((source->proxy.x != source->cur.geometry.x) ||
+            (source->proxy.y != source->cur.geometry.y))
+          full = EINA_TRUE;
+        _proxy_damage_collect(source, source,
+                              full ? NULL : source->proxy.damage);
+        source->proxy.x = source->cur.geometry.x;
+        source->proxy.y = source->cur.geometry.y;
+        source->proxy.stamp = _proxy_stamp;
      }
    else
+     full = EINA_TRUE;
+
+   if ((full) || (!source->proxy.damage))
      {
-        source->func->render(source, e->engine.data.output, ctx,
-                                    source->proxy.surface,
-                                    -source->cur.geometry.x,
-                                    -source->cur.geometry.y);
+        memset(&whole, 0, sizeof(whole));
+        whole.w = w;
+        whole.h = h;
+        rects = &whole;
      }
+   else
+     rects = evas_common_tilebuf_get_render_rects(source->proxy.damage);
 
-   e->engine.func->context_free(e->engine.data.output, ctx);
-   source->proxy.surface = e->engine.func->image_dirty_region(
-               e->engine.data.output, source->proxy.surface, 0,0,w,h);
+   EINA_INLIST_FOREACH(EINA_INLIST_GET(rects), r)
+     {
+        if (alpha)
+          {
+             ctx = e->engine.func->context_new(e->engine.data.output);
+             e->engine.func->context_color_set(e->engine.data.output, ctx, 0, 0, 0, 0);
+             e->engine.func->context_render_op_set(e->engine.data.output, ctx, EVAS_RENDER_COPY);
+             e->engine.func->rectangle_draw(e->engine.data.output, ctx,
+                                            source->proxy.surface,
+                                            r->x, r->y, r->w, r->h);
+             e->engine.func->context_free(e->engine.data.output, ctx);
+          }
 
+        ctx = e->engine.func->context_new(e->engine.data.output);
+        e->engine.func->context_clip_set(e->engine.data.output, ctx,
+                                         r->x, r->y, r->w, r->h);
+        if (source->smart.smart)
+          {
+             EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(source), obj2){
+                  _proxy_subrender_recurse(obj2, e->engine.data.output,
+                                           source->proxy.surface,
+                                           ctx,
+                                           -source->cur.geometry.x,
+                                           -source->cur.geometry.y);
+             }
+          }
+        else
+          {
+             source->func->render(source, e->engine.data.output, ctx,
+                                         source->proxy.surface,
+                                         -source->cur.geometry.x,
+                                         -source->cur.geometry.y);
+          }
+
+        e->engine.func->context_free(e->engine.data.output, ctx);
+        source->proxy.surface = e->engine.func->image_dirty_region(
+                    e->engine.data.output, source->proxy.surface,
+                    r->x, r->y, r->w, r->h);
+     }
+   if (rects != &whole) evas_common_tilebuf_free_render_rects(rects);
+   if (source->proxy.damage)
+     evas_common_tilebuf_clear(source->proxy.damage);
 }
 
 static void
@@ -3001,6 +3228,7 @@ evas_object_image_render_pre(Evas_Object *obj)
      {
         /* XXX: Do I need to sort out the map here? */
         obj->changed = 1;
+        obj->changed_move = 0;
         evas_add_rect(&e->clip_changes,
                       obj->cur.geometry.x, obj->cur.geometry.y,
                       obj->cur.geometry.w, obj->cur.geometry.h);
@@ -0,0 +1,357 @@
+#include "evas_common.h"
+#include "evas_private.h"
+
+/* spatial index for hit-testing.
+ *
+ * every object of a canvas is filed in a uniform grid of INDEX_CELL pixel
+ * cells, keyed on its cur.cache.clip rectangle. the grid is kept in step
+ * with the clip cache from evas_object_clip_recalc(), so it always answers
+ * exactly what a full walk of the cached geometry would. objects spanning
+ * more than INDEX_BIG cells go to a single overflow cell that every query
+ * looks at.
+ *
+ * the grid is canvas wide rather than per layer: smart members keep the
+ * layer pointer they were created with even if their parent changes layer,
+ * so layer order is folded into the stacking order key instead. that key is
+ * a depth-first number over layers, objects and smart members, recomputed
+ * lazily after any restack.
+ */
+
+#define INDEX_SHIFT 6
+#define INDEX_CELL  (1 << INDEX_SHIFT)
+#define INDEX_BIG   64
+
+static void
+_evas_object_index_cell_add(Evas_Object_Index_Cell *cell, Evas_Object *obj)
+{
+   if (cell->count == cell->alloc)
+     {
+        Evas_Object **objs;
+        int alloc;
+
+        alloc = cell->alloc ? cell->alloc * 2 : 8;
+        objs = realloc(cell->objs, alloc * sizeof(Evas_Object *));
+        if (!objs) return;
+        cell->objs = objs;
+        cell->alloc = alloc;
+     }
+   cell->objs[cell->count++] = obj;
+}
+
+static void
+_evas_object_index_cell_del(Evas_Object_Index_Cell *cell, Evas_Object *obj)
+{
+   int i;
+
+   for (i = 0; i < cell->count; i++)
+     {
+        if (cell->objs[i] == obj)
+          {
+             cell->objs[i] = cell->objs[--cell->count];
+             return;
+          }
+     }
+}
+
+static void
+_evas_object_index_cell_flush(Evas_Object_Index_Cell *cell)
+{
+   free(cell->objs);
+   cell->objs = NULL;
+   cell->count = 0;
+   cell->alloc = 0;
+}
+
+static void
+_evas_object_index_span_get(Evas_Object_Index *idx, int x, int y, int w, int h,
+                            int *cx1, int *cy1, int *cx2, int *cy2)
+{
+   *cx1 = x >> INDEX_SHIFT;
+   *cy1 = y >> INDEX_SHIFT;
+   *cx2 = (x + w - 1) >> INDEX_SHIFT;
+   *cy2 = (y + h - 1) >> INDEX_SHIFT;
+   /* anything off the output lands in the border cells */
+   if (*cx1 < 0) *cx1 = 0;
+   else if (*cx1 >= idx->w) *cx1 = idx->w - 1;
+   if (*cy1 < 0) *cy1 = 0;
+   else if (*cy1 >= idx->h) *cy1 = idx->h - 1;
+   if (*cx2 < 0) *cx2 = 0;
+   else if (*cx2 >= idx->w) *cx2 = idx->w - 1;
+   if (*cy2 < 0) *cy2 = 0;
+   else if (*cy2 >= idx->h) *cy2 = idx->h - 1;
+}
+
+static void
+_evas_object_index_file(Evas_Object_Index *idx, Evas_Object *obj)
+{
+   int cx1, cy1, cx2, cy2, cx, cy;
+
+   obj->index.x = obj->cur.cache.clip.x;
+   obj->index.y = obj->cur.cache.clip.y;
+   obj->index.w = obj->cur.cache.clip.w;
+   obj->index.h = obj->cur.cache.clip.h;
+   obj->index.big = 0;
+   /* empty geometry can never be hit - keep it out of the cells */
+   if ((obj->index.w <= 0) || (obj->index.h <= 0))
+     {
+        obj->index.cx1 = 0;
+        obj->index.cx2 = -1;
+        return;
+     }
+   _evas_object_index_span_get(idx, obj->index.x, obj->index.y,
+                               obj->index.w, obj->index.h,
+                               &cx1, &cy1, &cx2, &cy2);
+   obj->index.cx1 = cx1;
+   obj->index.cy1 = cy1;
+   obj->index.cx2 = cx2;
+   obj->index.cy2 = cy2;
+   if (((cx2 - cx1 + 1) * (cy2 - cy1 + 1)) > INDEX_BIG)
+     {
+        obj->index.big = 1;
+        _evas_object_index_cell_add(&(idx->big), obj);
+        return;
+     }
+   for (cy = cy1; cy <= cy2; cy++)
+     for (cx = cx1; cx <= cx2; cx++)
+       _evas_object_index_cell_add(&(idx->cells[(cy * idx->w) + cx]), obj);
+}
+
+static void
+_evas_object_index_unfile(Evas_Object_Index *idx, Evas_Object *obj)
+{
+   int cx, cy;
+
+   if (obj->index.big)
+     {
+        _evas_object_index_cell_del(&(idx->big), obj);
+        obj->index.big = 0;
+        return;
+     }
+   for (cy = obj->index.cy1; cy <= obj->index.cy2; cy++)
+     for (cx = obj->index.cx1; cx <= obj->index.cx2; cx++)
+       _evas_object_index_cell_del(&(idx->cells[(cy * idx->w) + cx]), obj);
+   obj->index.cx2 = -1;
+}
+
+/* (re)size the grid to the output, refiling everything when it changes */
+static Eina_Bool
+_evas_object_index_grid_check(Evas *e)
+{
+   Evas_Object_Index *idx = &(e->index);
+   Evas_Object_Index_Cell *cells;
+   Evas_Object *obj;
+   Eina_List *l;
+   int w, h, i;
+
+   w = (e->output.w + INDEX_CELL - 1) >> INDEX_SHIFT;
+   h = (e->output.h + INDEX_CELL - 1) >> INDEX_SHIFT;
+   if (w < 1) w = 1;
+   if (h < 1) h = 1;
+   if ((idx->cells) && (w == idx->w) && (h == idx->h)) return EINA_TRUE;
+
+   cells = calloc(w * h, sizeof(Evas_Object_Index_Cell));
+   if (!cells) return EINA_FALSE;
+   for (i = 0; i < (idx->w * idx->h); i++)
+     _evas_object_index_cell_flush(&(idx->cells[i]));
+   free(idx->cells);
+   _evas_object_index_cell_flush(&(idx->big));
+   idx->cells = cells;
+   idx->w = w;
+   idx->h = h;
+   EINA_LIST_FOREACH(idx->objects, l, obj)
+     _evas_object_index_file(idx, obj);
+   return EINA_TRUE;
+}
+
+void
+evas_object_index_update(Evas_Object *obj)
+{
+   Evas *e;
+
+   if (!obj->layer) return;
+   e = obj->layer->evas;
+   if (!_evas_object_index_grid_check(e)) return;
+   if (obj->index.node)
+     {
+        if ((obj->index.x == obj->cur.cache.clip.x) &&
+            (obj->index.y == obj->cur.cache.clip.y) &&
+            (obj->index.w == obj->cur.cache.clip.w) &&
+            (obj->index.h == obj->cur.cache.clip.h))
+          return;
+        _evas_object_index_unfile(&(e->index), obj);
+     }
+   else
+     {
+        e->index.objects = eina_list_prepend(e->index.objects, obj);
+        obj->index.node = e->index.objects;
+     }
+   _evas_object_index_file(&(e->index), obj);
+}
+
+static Eina_Bool
+_evas_object_index_pending_keep(void *data, void *gdata)
+{
+   Evas_Object *obj = data;
+   Evas_Object *del = gdata;
+
+   if (obj == del)
+     {
+        obj->index.pending = 0;
+        return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+void
+evas_object_index_del(Evas_Object *obj)
+{
+   Evas *e;
+
+   if (!obj->layer) return;
+   e = obj->layer->evas;
+   if (obj->index.pending)
+     eina_array_remove(&(e->index.pending), _evas_object_index_pending_keep, obj);
+   if (!obj->index.node) return;
+   _evas_object_index_unfile(&(e->index), obj);
+   e->index.objects = eina_list_remove_list(e->index.objects, obj->index.node);
+   obj->index.node = NULL;
+}
+
+void
+evas_object_index_clip_dirty(Evas_Object *obj)
+{
+   if ((!obj->layer) || (obj->index.pending)) return;
+   obj->index.pending = 1;
+   eina_array_push(&(obj->layer->evas->index.pending), obj);
+}
+
+void
+evas_object_index_order_dirty(Evas_Object *obj)
+{
+   if (!obj->layer) return;
+   obj->layer->evas->index.order_dirty = 1;
+}
+
+void
+evas_object_index_free(Evas *e)
+{
+   Evas_Object_Index *idx = &(e->index);
+   int i;
+
+   for (i = 0; i < (idx->w * idx->h); i++)
+     _evas_object_index_cell_flush(&(idx->cells[i]));
+   free(idx->cells);
+   idx->cells = NULL;
+   idx->w = 0;
+   idx->h = 0;
+   _evas_object_index_cell_flush(&(idx->big));
+   idx->objects = eina_list_free(idx->objects);
+   eina_array_flush(&(idx->pending));
+   eina_array_flush(&(idx->query));
+}
+
+static unsigned int
+_evas_object_index_order_set(const Eina_Inlist *list, unsigned int order)
+{
+   Evas_Object *obj;
+
+   EINA_INLIST_FOREACH(list, obj)
+     {
+        obj->index.order = order++;
+        if (obj->smart.smart)
+          order = _evas_object_index_order_set
+            (evas_object_smart_members_get_direct(obj), order);
+     }
+   return order;
+}
+
+static void
+_evas_object_index_order_check(Evas *e)
+{
+   Evas_Layer *lay;
+   unsigned int order = 0;
+
+   if (!e->index.order_dirty) return;
+   EINA_INLIST_FOREACH(e->layers, lay)
+     order = _evas_object_index_order_set(EINA_INLIST_GET(lay->objects), order);
+   e->index.order_dirty = 0;
+}
+
+static Eina_Bool
+_evas_object_index_pending_recalc(void *data, void *gdata __UNUSED__)
+{
+   Evas_Object *obj = data;
+
+   if (obj->cur.cache.clip.dirty)
+     {
+        /* members are left to render, like the walks this replaces did */
+        if (obj->smart.parent) return EINA_TRUE;
+        if (!obj->delete_me) evas_object_clip_recalc(obj);
+        /* still dirty if events are frozen - try again next time */
+        if (obj->cur.cache.clip.dirty) return EINA_TRUE;
+     }
+   obj->index.pending = 0;
+   return EINA_FALSE;
+}
+
+void
+evas_object_index_top_level_recalc(Evas *e)
+{
+   if (eina_array_count_get(&(e->index.pending)) == 0) return;
+   eina_array_remove(&(e->index.pending), _evas_object_index_pending_recalc, NULL);
+}
+
+static int
+_evas_object_index_order_cmp(const void *a, const void *b)
+{
+   const Evas_Object *o1 = *((const Evas_Object **)a);
+   const Evas_Object *o2 = *((const Evas_Object **)b);
+
+   /* topmost first */
+   if (o1->index.order > o2->index.order) return -1;
+   if (o1->index.order < o2->index.order) return 1;
+   return 0;
+}
+
+static void
+_evas_object_index_cell_collect(Eina_Array *res, Evas_Object_Index_Cell *cell,
+                                unsigned int stamp, int x, int y, int w, int h)
+{
+   int i;
+
+   for (i = 0; i < cell->count; i++)
+     {
+        Evas_Object *obj = cell->objs[i];
+
+        if (obj->index.stamp == stamp) continue;
+        obj->index.stamp = stamp;
+        if (RECTS_INTERSECT(x, y, w, h,
+                            obj->index.x, obj->index.y,
+                            obj->index.w, obj->index.h))
+          eina_array_push(res, obj);
+     }
+}
+
+/**
+ * Fill @p res with every object whose cached clip geometry intersects the
+ * given rectangle, topmost first.
+ */
+void
+evas_object_index_query(Evas *e, Eina_Array *res, int x, int y, int w, int h)
+{
+   Evas_Object_Index *idx = &(e->index);
+   int cx1, cy1, cx2, cy2, cx, cy;
+
+   if (!_evas_object_index_grid_check(e)) return;
+   _evas_object_index_order_check(e);
+   idx->stamp++;
+   _evas_object_index_span_get(idx, x, y, w, h, &cx1, &cy1, &cx2, &cy2);
+   for (cy = cy1; cy <= cy2; cy++)
+     for (cx = cx1; cx <= cx2; cx++)
+       _evas_object_index_cell_collect(res, &(idx->cells[(cy * idx->w) + cx]),
+                                       idx->stamp, x, y, w, h);
+   _evas_object_index_cell_collect(res, &(idx->big), idx->stamp, x, y, w, h);
+   if (eina_array_count_get(res) > 1)
+     qsort(res->data, eina_array_count_get(res), sizeof(void *),
+           _evas_object_index_order_cmp);
+}
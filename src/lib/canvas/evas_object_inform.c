@@ -21,39 +21,54 @@ evas_object_inform_call_hide(Evas_Object *obj)
    _evas_post_event_callback_call(obj->layer->evas);
 }
 
+/* geometry and stacking events never propagate to the smart parent, so
+ * they are not even built when the object has no listener for them. post
+ * event callbacks queued meanwhile still go out right away */
 void
 evas_object_inform_call_move(Evas_Object *obj)
 {
-   _evas_object_event_new();
+   if (evas_object_event_callback_listened(obj, EVAS_CALLBACK_MOVE))
+     {
+        _evas_object_event_new();
 
-   evas_object_event_callback_call(obj, EVAS_CALLBACK_MOVE, NULL);
+        evas_object_event_callback_call(obj, EVAS_CALLBACK_MOVE, NULL);
+     }
    _evas_post_event_callback_call(obj->layer->evas);
 }
 
 void
 evas_object_inform_call_resize(Evas_Object *obj)
 {
-   _evas_object_event_new();
+   if (evas_object_event_callback_listened(obj, EVAS_CALLBACK_RESIZE))
+     {
+        _evas_object_event_new();
 
-   evas_object_event_callback_call(obj, EVAS_CALLBACK_RESIZE, NULL);
+        evas_object_event_callback_call(obj, EVAS_CALLBACK_RESIZE, NULL);
+     }
    _evas_post_event_callback_call(obj->layer->evas);
 }
 
 void
 evas_object_inform_call_restack(Evas_Object *obj)
 {
-   _evas_object_event_new();
+   if (evas_object_event_callback_listened(obj, EVAS_CALLBACK_RESTACK))
+     {
+        _evas_object_event_new();
 
-   evas_object_event_callback_call(obj, EVAS_CALLBACK_RESTACK, NULL);
+        evas_object_event_callback_call(obj, EVAS_CALLBACK_RESTACK, NULL);
+     }
    _evas_post_event_callback_call(obj->layer->evas);
 }
 
 void
 evas_object_inform_call_changed_size_hints(Evas_Object *obj)
 {
-   _evas_object_event_new();
+   if (evas_object_event_callback_listened(obj, EVAS_CALLBACK_CHANGED_SIZE_HINTS))
+     {
+        _evas_object_event_new();
 
-   evas_object_event_callback_call(obj, EVAS_CALLBACK_CHANGED_SIZE_HINTS, NULL);
+        evas_object_event_callback_call(obj, EVAS_CALLBACK_CHANGED_SIZE_HINTS, NULL);
+     }
    _evas_post_event_callback_call(obj->layer->evas);
 }
 
@@ -4,13 +4,6 @@
 EVAS_MEMPOOL(_mp_obj);
 EVAS_MEMPOOL(_mp_sh);
 
-static Eina_Inlist *
-get_layer_objects(Evas_Layer *l)
-{
-   if ((!l) || (!l->objects)) return NULL;
-   return (EINA_INLIST_GET(l->objects));
-}
-
 /* evas internal stuff */
 Evas_Object *
 evas_object_new(Evas *e __UNUSED__)
@@ -33,11 +26,13 @@ evas_object_free(Evas_Object *obj, int clean_layer)
    int was_smart_child = 0;
 
    evas_object_map_set(obj, NULL);
+   evas_object_proxy_surface_free(obj);
    evas_object_grabs_cleanup(obj);
    evas_object_intercept_cleanup(obj);
    if (obj->smart.parent) was_smart_child = 1;
    evas_object_smart_cleanup(obj);
    obj->func->free(obj);
+   evas_object_index_del(obj);
    if (!was_smart_child) evas_object_release(obj, clean_layer);
    if (obj->clip.clipees)
      eina_list_free(obj->clip.clipees);
@@ -74,6 +69,9 @@ evas_object_change(Evas_Object *obj)
 //   else
 //      printf("ch %p\n", obj);
    obj->layer->evas->changed = 1;
+   /* not a plain move anymore, evas_object_move() sets it back if it is */
+   obj->changed_move = 0;
+   evas_object_proxy_change(obj);
    if (obj->changed) return;
 //   obj->changed = 1;
    evas_render_object_recalc(obj);
@@ -200,6 +198,55 @@ evas_object_clip_changes_clean(Evas_Object *obj)
    EINA_LIST_FREE(obj->clip.changes, r) eina_rectangle_free(r);
 }
 
+/* add an update rect of obj, clipped to its current and previous clip */
+static void
+_evas_object_render_pre_redraws_add(Evas_Object *obj, const Eina_Rectangle *r)
+{
+   Evas *e = obj->layer->evas;
+   int x, y, w, h;
+
+   /* get updates and clip to current clip */
+   x = r->x;
+   y = r->y;
+   w = r->w;
+   h = r->h;
+   RECTS_CLIP_TO_RECT(x, y, w, h,
+                      obj->cur.cache.clip.x,
+                      obj->cur.cache.clip.y,
+                      obj->cur.cache.clip.w,
+                      obj->cur.cache.clip.h);
+   if ((w > 0) && (h > 0))
+     {
+#ifdef EVAS_RENDER_PRE_THREADS
+        if (evas_render_pre_threaded())
+          evas_render_pre_redraw_add(x, y, w, h);
+        else
+#endif
+        e->engine.func->output_redraws_rect_add(e->engine.data.output,
+                                                x, y, w, h);
+     }
+   /* get updates and clip to previous clip */
+   x = r->x;
+   y = r->y;
+   w = r->w;
+   h = r->h;
+   RECTS_CLIP_TO_RECT(x, y, w, h,
+                      obj->prev.cache.clip.x,
+                      obj->prev.cache.clip.y,
+                      obj->prev.cache.clip.w,
+                      obj->prev.cache.clip.h);
+   if ((w > 0) && (h > 0))
+     {
+#ifdef EVAS_RENDER_PRE_THREADS
+        if (evas_render_pre_threaded())
+          evas_render_pre_redraw_add(x, y, w, h);
+        else
+#endif
+        e->engine.func->output_redraws_rect_add(e->engine.data.output,
+                                                x, y, w, h);
+     }
+}
+
 void
 evas_object_render_pre_effect_updates(Eina_Array *rects, Evas_Object *obj, int is_v, int was_v)
 {
@@ -208,42 +255,27 @@ evas_object_render_pre_effect_updates(Eina_Array *rects, Evas_Object *obj, int i
    Eina_List *l;
    unsigned int i;
    Eina_Array_Iterator it;
-   int x, y, w, h;
 
    if (obj->smart.smart) goto end;
    /* FIXME: was_v isn't used... why? */
    was_v = 0;
    if (!obj->clip.clipees)
      {
+#ifdef EVAS_RENDER_PRE_THREADS
+        /* threaded render_pre keeps its rects with the thread */
+        if (evas_render_pre_threaded())
+          {
+             Eina_Rectangle *pend;
+             int n;
+
+             n = evas_render_pre_rects_take(&pend);
+             while (n-- > 0)
+               _evas_object_render_pre_redraws_add(obj, pend++);
+          }
+        else
+#endif
 	EINA_ARRAY_ITER_NEXT(rects, i, r, it)
-	  {
-	     /* get updates and clip to current clip */
-	     x = r->x;
-	     y = r->y;
-	     w = r->w;
-	     h = r->h;
-	     RECTS_CLIP_TO_RECT(x, y, w, h,
-				obj->cur.cache.clip.x,
-				obj->cur.cache.clip.y,
-				obj->cur.cache.clip.w,
-				obj->cur.cache.clip.h);
-	     if ((w > 0) && (h > 0))
-	       obj->layer->evas->engine.func->output_redraws_rect_add(obj->layer->evas->engine.data.output,
-								      x, y, w, h);
-	     /* get updates and clip to previous clip */
-	     x = r->x;
-	     y = r->y;
-	     w = r->w;
-	     h = r->h;
-	     RECTS_CLIP_TO_RECT(x, y, w, h,
-				obj->prev.cache.clip.x,
-				obj->prev.cache.clip.y,
-				obj->prev.cache.clip.w,
-				obj->prev.cache.clip.h);
-	     if ((w > 0) && (h > 0))
-	       obj->layer->evas->engine.func->output_redraws_rect_add(obj->layer->evas->engine.data.output,
-								      x, y, w, h);
-	  }
+	  _evas_object_render_pre_redraws_add(obj, r);
 	/* if the object is actually visible, take any parent clip changes */
 	if (is_v)
 	  {
@@ -251,31 +283,14 @@ evas_object_render_pre_effect_updates(Eina_Array *rects, Evas_Object *obj, int i
 	     while (clipper)
 	       {
 		  EINA_LIST_FOREACH(clipper->clip.changes, l, r)
-		    {
-		       /* get updates and clip to current clip */
-		       x = r->x; y = r->y; w = r->w; h = r->h;
-		       RECTS_CLIP_TO_RECT(x, y, w, h,
-					  obj->cur.cache.clip.x,
-					  obj->cur.cache.clip.y,
-					  obj->cur.cache.clip.w,
-					  obj->cur.cache.clip.h);
-		       if ((w > 0) && (h > 0))
-			 obj->layer->evas->engine.func->output_redraws_rect_add(obj->layer->evas->engine.data.output,
-										x, y, w, h);
-		       /* get updates and clip to previous clip */
-		       x = r->x; y = r->y; w = r->w; h = r->h;
-		       RECTS_CLIP_TO_RECT(x, y, w, h,
-					  obj->prev.cache.clip.x,
-					  obj->prev.cache.clip.y,
-					  obj->prev.cache.clip.w,
-					  obj->prev.cache.clip.h);
-		       if ((w > 0) && (h > 0))
-			 obj->layer->evas->engine.func->output_redraws_rect_add(obj->layer->evas->engine.data.output,
-										x, y, w, h);
-		    }
+		    _evas_object_render_pre_redraws_add(obj, r);
 		  clipper = clipper->cur.clipper;
 	       }
 	  }
+#ifdef EVAS_RENDER_PRE_THREADS
+        /* rects is the canvas', leave it alone */
+        if (evas_render_pre_threaded()) return;
+#endif
      }
    else
      {
@@ -408,6 +423,7 @@ EAPI void
 evas_object_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
 {
    int is, was = 0, pass = 0;
+   Eina_Bool move_only;
 
    MAGIC_CHECK(obj, Evas_Object, MAGIC_OBJ);
    return;
@@ -434,10 +450,12 @@ evas_object_move(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
        if (obj->smart.smart->smart_class->move)
 	  obj->smart.smart->smart_class->move(obj, x, y);
      }
+   move_only = (!obj->changed) || (obj->changed_move);
    obj->cur.geometry.x = x;
    obj->cur.geometry.y = y;
 ////   obj->cur.cache.geometry.validity = 0;
    evas_object_change(obj);
+   obj->changed_move = move_only;
    evas_object_clip_dirty(obj);
    obj->doing.in_move--;
    if (obj->layer->evas->events_frozen <= 0)
@@ -1384,6 +1402,30 @@ evas_object_evas_get(const Evas_Object *obj)
    return obj->layer->evas;
 }
 
+static Eina_List *
+_evas_objects_index_list(Evas *e, int x, int y, int w, int h, Eina_Bool include_pass_events_objects, Eina_Bool include_hidden_objects, Eina_Bool top)
+{
+   Eina_Array_Iterator it;
+   Evas_Object *obj;
+   Eina_List *in = NULL;
+   unsigned int i;
+
+   evas_object_index_top_level_recalc(e);
+   evas_object_index_query(e, &e->index.query, x, y, w, h);
+   EINA_ARRAY_ITER_NEXT(&e->index.query, i, obj, it)
+     {
+        if (obj->smart.parent) continue;
+        if (obj->delete_me) continue;
+        if ((!include_pass_events_objects) && (evas_event_passes_through(obj))) continue;
+        if ((!include_hidden_objects) && (!obj->cur.visible)) continue;
+        if (obj->clip.clipees) continue;
+        in = eina_list_prepend(in, obj);
+        if (top) break;
+     }
+   eina_array_clean(&e->index.query);
+   return in;
+}
+
 /**
  * @addtogroup Evas_Object_Group_Find
  * @{
@@ -1402,7 +1444,8 @@ evas_object_evas_get(const Evas_Object *obj)
 EAPI Evas_Object *
 evas_object_top_at_xy_get(const Evas *e, Evas_Coord x, Evas_Coord y, Eina_Bool include_pass_events_objects, Eina_Bool include_hidden_objects)
 {
-   Evas_Layer *lay;
+   Evas_Object *obj;
+   Eina_List *in;
    int xx, yy;
 
    MAGIC_CHECK(e, Evas, MAGIC_EVAS);
@@ -1412,22 +1455,13 @@ evas_object_top_at_xy_get(const Evas *e, Evas_Coord x, Evas_Coord y, Eina_Bool i
    yy = y;
 ////   xx = evas_coord_world_x_to_screen(e, x);
 ////   yy = evas_coord_world_y_to_screen(e, y);
-   EINA_INLIST_REVERSE_FOREACH((EINA_INLIST_GET(e->layers)), lay)
-     {
-	Evas_Object *obj;
-
-	EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
-	  {
-	     if (obj->delete_me) continue;
-	     if ((!include_pass_events_objects) && (evas_event_passes_through(obj))) continue;
-	     if ((!include_hidden_objects) && (!obj->cur.visible)) continue;
-	     evas_object_clip_recalc(obj);
-	     if ((evas_object_is_in_output_rect(obj, xx, yy, 1, 1)) &&
-		 (!obj->clip.clipees))
-	       return obj;
-	  }
-     }
-   return NULL;
+   in = _evas_objects_index_list((Evas *)e, xx, yy, 1, 1,
+                                 include_pass_events_objects,
+                                 include_hidden_objects, EINA_TRUE);
+   if (!in) return NULL;
+   obj = in->data;
+   eina_list_free(in);
+   return obj;
 }
 
 /**
@@ -1458,7 +1492,8 @@ evas_object_top_at_pointer_get(const Evas *e)
 EAPI Evas_Object *
 evas_object_top_in_rectangle_get(const Evas *e, Evas_Coord x, Evas_Coord y, Evas_Coord w, Evas_Coord h, Eina_Bool include_pass_events_objects, Eina_Bool include_hidden_objects)
 {
-   Evas_Layer *lay;
+   Evas_Object *obj;
+   Eina_List *in;
    int xx, yy, ww, hh;
 
    MAGIC_CHECK(e, Evas, MAGIC_EVAS);
@@ -1474,22 +1509,13 @@ evas_object_top_in_rectangle_get(const Evas *e, Evas_Coord x, Evas_Coord y, Evas
 ////   hh = evas_coord_world_y_to_screen(e, h);
    if (ww < 1) ww = 1;
    if (hh < 1) hh = 1;
-   EINA_INLIST_REVERSE_FOREACH((EINA_INLIST_GET(e->layers)), lay)
-     {
-	Evas_Object *obj;
-
-	EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
-	  {
-	     if (obj->delete_me) continue;
-	     if ((!include_pass_events_objects) && (evas_event_passes_through(obj))) continue;
-	     if ((!include_hidden_objects) && (!obj->cur.visible)) continue;
-	     evas_object_clip_recalc(obj);
-	     if ((evas_object_is_in_output_rect(obj, xx, yy, ww, hh)) &&
-		 (!obj->clip.clipees))
-	       return obj;
-	  }
-     }
-   return NULL;
+   in = _evas_objects_index_list((Evas *)e, xx, yy, ww, hh,
+                                 include_pass_events_objects,
+                                 include_hidden_objects, EINA_TRUE);
+   if (!in) return NULL;
+   obj = in->data;
+   eina_list_free(in);
+   return obj;
 }
 
 /**
@@ -1506,8 +1532,6 @@ evas_object_top_in_rectangle_get(const Evas *e, Evas_Coord x, Evas_Coord y, Evas
 EAPI Eina_List *
 evas_objects_at_xy_get(const Evas *e, Evas_Coord x, Evas_Coord y, Eina_Bool include_pass_events_objects, Eina_Bool include_hidden_objects)
 {
-   Eina_List *in = NULL;
-   Evas_Layer *lay;
    int xx, yy;
 
    MAGIC_CHECK(e, Evas, MAGIC_EVAS);
@@ -1517,22 +1541,9 @@ evas_objects_at_xy_get(const Evas *e, Evas_Coord x, Evas_Coord y, Eina_Bool incl
    yy = y;
 ////   xx = evas_coord_world_x_to_screen(e, x);
 ////   yy = evas_coord_world_y_to_screen(e, y);
-   EINA_INLIST_REVERSE_FOREACH((EINA_INLIST_GET(e->layers)), lay)
-     {
-	Evas_Object *obj;
-
-	EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
-	  {
-	     if (obj->delete_me) continue;
-	     if ((!include_pass_events_objects) && (evas_event_passes_through(obj))) continue;
-	     if ((!include_hidden_objects) && (!obj->cur.visible)) continue;
-	     evas_object_clip_recalc(obj);
-	     if ((evas_object_is_in_output_rect(obj, xx, yy, 1, 1)) &&
-		 (!obj->clip.clipees))
-	       in = eina_list_prepend(in, obj);
-	  }
-     }
-   return in;
+   return _evas_objects_index_list((Evas *)e, xx, yy, 1, 1,
+                                   include_pass_events_objects,
+                                   include_hidden_objects, EINA_FALSE);
 }
 
 /**
@@ -1555,8 +1566,6 @@ evas_objects_at_xy_get(const Evas *e, Evas_Coord x, Evas_Coord y, Eina_Bool incl
 EAPI Eina_List *
 evas_objects_in_rectangle_get(const Evas *e, Evas_Coord x, Evas_Coord y, Evas_Coord w, Evas_Coord h, Eina_Bool include_pass_events_objects, Eina_Bool include_hidden_objects)
 {
-   Eina_List *in = NULL;
-   Evas_Layer *lay;
    int xx, yy, ww, hh;
 
    MAGIC_CHECK(e, Evas, MAGIC_EVAS);
@@ -1572,22 +1581,9 @@ evas_objects_in_rectangle_get(const Evas *e, Evas_Coord x, Evas_Coord y, Evas_Co
 ////   hh = evas_coord_world_y_to_screen(e, h);
    if (ww < 1) ww = 1;
    if (hh < 1) hh = 1;
-   EINA_INLIST_REVERSE_FOREACH((EINA_INLIST_GET(e->layers)), lay)
-     {
-	Evas_Object *obj;
-
-	EINA_INLIST_REVERSE_FOREACH(get_layer_objects(lay), obj)
-	  {
-	     if (obj->delete_me) continue;
-	     if ((!include_pass_events_objects) && (evas_event_passes_through(obj))) continue;
-	     if ((!include_hidden_objects) && (!obj->cur.visible)) continue;
-	     evas_object_clip_recalc(obj);
-	     if ((evas_object_is_in_output_rect(obj, xx, yy, ww, hh)) &&
-		 (!obj->clip.clipees))
-	       in = eina_list_prepend(in, obj);
-	  }
-     }
-   return in;
+   return _evas_objects_index_list((Evas *)e, xx, yy, ww, hh,
+                                   include_pass_events_objects,
+                                   include_hidden_objects, EINA_FALSE);
 }
 
 /**
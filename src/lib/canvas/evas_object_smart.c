@@ -3,13 +3,15 @@
 
 typedef struct _Evas_Object_Smart      Evas_Object_Smart;
 typedef struct _Evas_Smart_Callback    Evas_Smart_Callback;
+typedef struct _Evas_Smart_Callback_Slot Evas_Smart_Callback_Slot;
 
 struct _Evas_Object_Smart
 {
    DATA32            magic;
    void             *engine_data;
    void             *data;
-   Eina_List        *callbacks;
+   Evas_Smart_Callback_Slot *slots;
+   int               slots_count, slots_alloc;
    Eina_Inlist *contained;
    Evas_Smart_Cb_Description_Array callbacks_descriptions;
    int               walking_list;
@@ -17,6 +19,13 @@ struct _Evas_Object_Smart
    Eina_Bool         need_recalculate : 1;
 };
 
+/* all callbacks of one event, keyed by the event's stringshare */
+struct _Evas_Smart_Callback_Slot
+{
+   const char *event;
+   Eina_List  *callbacks;
+};
+
 struct _Evas_Smart_Callback
 {
    const char *event;
@@ -27,6 +36,8 @@ struct _Evas_Smart_Callback
 
 /* private methods for smart objects */
 static void evas_object_smart_callbacks_clear(Evas_Object *obj);
+static Evas_Smart_Callback_Slot *evas_object_smart_callback_slot_find(Evas_Object_Smart *o, const char *event);
+static void evas_object_smart_callback_slot_call(Evas_Object *obj, Evas_Object_Smart *o, Evas_Smart_Callback_Slot *slot, void *event_info);
 static void evas_object_smart_init(Evas_Object *obj);
 static void *evas_object_smart_new(void);
 static void evas_object_smart_render(Evas_Object *obj, void *output, void *context, void *surface, int x, int y);
@@ -201,6 +212,13 @@ evas_object_smart_member_add(Evas_Object *obj, Evas_Object *smart_obj)
    obj->layer->usage++;
    obj->smart.parent = smart_obj;
    o->contained = eina_inlist_append(o->contained, EINA_INLIST_GET(obj));
+   /* its members need not be changed to show up in a map surface above */
+   if (obj->smart.smart)
+     {
+        evas_object_map_surface_invalidate(smart_obj);
+        evas_object_proxy_invalidate(smart_obj);
+     }
+   evas_object_index_order_dirty(obj);
    evas_object_smart_member_cache_invalidate(obj);
    obj->restack = 1;
    evas_object_change(obj);
@@ -233,6 +251,9 @@ evas_object_smart_member_del(Evas_Object *obj)
    if (!obj->smart.parent) return;
 
    smart_obj = obj->smart.parent;
+   /* what it drew in a map or proxy surface above has to be wiped */
+   evas_object_map_surface_invalidate(smart_obj);
+   evas_object_proxy_invalidate(smart_obj);
    if (smart_obj->smart.smart->smart_class->member_del)
      smart_obj->smart.smart->smart_class->member_del(smart_obj, obj);
 
@@ -420,6 +441,7 @@ EAPI void
 evas_object_smart_callback_add(Evas_Object *obj, const char *event, void (*func) (void *data, Evas_Object *obj, void *event_info), const void *data)
 {
    Evas_Object_Smart *o;
+   Evas_Smart_Callback_Slot *slot;
    Evas_Smart_Callback *cb;
 
    MAGIC_CHECK(obj, Evas_Object, MAGIC_OBJ);
@@ -438,7 +460,30 @@ evas_object_smart_callback_add(Evas_Object *obj, const char *event, void (*func)
    cb->event = eina_stringshare_add(event);
    cb->func = func;
    cb->func_data = (void *)data;
-   o->callbacks = eina_list_prepend(o->callbacks, cb);
+   slot = evas_object_smart_callback_slot_find(o, cb->event);
+   if (!slot)
+     {
+        if (o->slots_count == o->slots_alloc)
+          {
+             Evas_Smart_Callback_Slot *slots;
+             int alloc;
+
+             alloc = o->slots_alloc ? o->slots_alloc * 2 : 4;
+             slots = realloc(o->slots, alloc * sizeof(Evas_Smart_Callback_Slot));
+             if (!slots)
+               {
+                  eina_stringshare_del(cb->event);
+                  EVAS_MEMPOOL_FREE(_mp_cb, cb);
+                  return;
+               }
+             o->slots = slots;
+             o->slots_alloc = alloc;
+          }
+        slot = &(o->slots[o->slots_count++]);
+        slot->event = cb->event;
+        slot->callbacks = NULL;
+     }
+   slot->callbacks = eina_list_prepend(slot->callbacks, cb);
 }
 
 /**
@@ -456,6 +501,7 @@ EAPI void *
 evas_object_smart_callback_del(Evas_Object *obj, const char *event, void (*func) (void *data, Evas_Object *obj, void *event_info))
 {
    Evas_Object_Smart *o;
+   Evas_Smart_Callback_Slot *slot;
    Eina_List *l;
    Evas_Smart_Callback *cb;
 
@@ -467,9 +513,11 @@ evas_object_smart_callback_del(Evas_Object *obj, const char *event, void (*func)
    return NULL;
    MAGIC_CHECK_END();
    if (!event) return NULL;
-   EINA_LIST_FOREACH(o->callbacks, l, cb)
+   slot = evas_object_smart_callback_slot_find(o, event);
+   if (!slot) return NULL;
+   EINA_LIST_FOREACH(slot->callbacks, l, cb)
      {
-	if ((!strcmp(cb->event, event)) && (cb->func == func))
+	if ((!cb->delete_me) && (cb->func == func))
 	  {
 	     void *data;
 
@@ -500,9 +548,6 @@ EAPI void
 evas_object_smart_callback_call(Evas_Object *obj, const char *event, void *event_info)
 {
    Evas_Object_Smart *o;
-   Eina_List *l;
-   Evas_Smart_Callback *cb;
-   const char *strshare;
 
    MAGIC_CHECK(obj, Evas_Object, MAGIC_OBJ);
    return;
@@ -513,21 +558,46 @@ evas_object_smart_callback_call(Evas_Object *obj, const char *event, void *event
    MAGIC_CHECK_END();
    if (!event) return;
    if (obj->delete_me) return;
-   o->walking_list++;
-   strshare = eina_stringshare_add(event);
-   EINA_LIST_FOREACH(o->callbacks, l, cb)
+   evas_object_smart_callback_slot_call
+     (obj, o, evas_object_smart_callback_slot_find(o, event), event_info);
+}
+
+/**
+ * Call any smart callbacks on @p obj for the event identified by @p id.
+ *
+ * @param obj the smart object
+ * @param id the event id, as returned by evas_smart_callback_id_get()
+ * @param event_info an event specific struct of info to pass to the callback
+ *
+ * This is the same as evas_object_smart_callback_call() but skips the
+ * event name comparisons, so smart objects emitting a signal very often
+ * should resolve its id once and use this instead.
+ *
+ * @ingroup Evas_Smart_Object_Group
+ */
+EAPI void
+evas_object_smart_callback_call_by_id(Evas_Object *obj, const Evas_Smart_Cb_Id *id, void *event_info)
+{
+   Evas_Object_Smart *o;
+   int i;
+
+   MAGIC_CHECK(obj, Evas_Object, MAGIC_OBJ);
+   return;
+   MAGIC_CHECK_END();
+   o = (Evas_Object_Smart *)(obj->object_data);
+   MAGIC_CHECK(o, Evas_Object_Smart, MAGIC_OBJ_SMART);
+   return;
+   MAGIC_CHECK_END();
+   if (!id) return;
+   if (obj->delete_me) return;
+   for (i = 0; i < o->slots_count; i++)
      {
-	if (!cb->delete_me)
-	  {
-	     if (cb->event == strshare)
-	       cb->func(cb->func_data, obj, event_info);
-	  }
-	if (obj->delete_me)
-	  break;
+        if (o->slots[i].event == (const char *)id)
+          {
+             evas_object_smart_callback_slot_call(obj, o, &(o->slots[i]), event_info);
+             return;
+          }
      }
-   eina_stringshare_del(strshare);
-   o->walking_list--;
-   evas_object_smart_callbacks_clear(obj);
 }
 
 /**
@@ -874,27 +944,74 @@ evas_object_smart_changed(Evas_Object *obj)
 }
 
 /* internal calls */
+static Evas_Smart_Callback_Slot *
+evas_object_smart_callback_slot_find(Evas_Object_Smart *o, const char *event)
+{
+   int i;
+
+   /* interned names match by pointer, anything else falls back to strcmp */
+   for (i = 0; i < o->slots_count; i++)
+     {
+        if ((o->slots[i].event == event) || (!strcmp(o->slots[i].event, event)))
+          return &(o->slots[i]);
+     }
+   return NULL;
+}
+
+static void
+evas_object_smart_callback_slot_call(Evas_Object *obj, Evas_Object_Smart *o, Evas_Smart_Callback_Slot *slot, void *event_info)
+{
+   Eina_List *l;
+   Evas_Smart_Callback *cb;
+
+   if (!slot) return;
+   /* the slot array may move if a callback adds a new event, so only hold
+    * on to the list itself */
+   o->walking_list++;
+   EINA_LIST_FOREACH(slot->callbacks, l, cb)
+     {
+	if (!cb->delete_me)
+	  cb->func(cb->func_data, obj, event_info);
+	if (obj->delete_me)
+	  break;
+     }
+   o->walking_list--;
+   evas_object_smart_callbacks_clear(obj);
+}
+
 static void
 evas_object_smart_callbacks_clear(Evas_Object *obj)
 {
    Evas_Object_Smart *o;
    Eina_List *l;
    Evas_Smart_Callback *cb;
+   int i;
 
    o = (Evas_Object_Smart *)(obj->object_data);
 
    if (o->walking_list) return;
    if (!o->deletions_waiting) return;
-   for (l = o->callbacks; l;)
+   o->deletions_waiting = 0;
+   for (i = 0; i < o->slots_count;)
      {
-	cb = eina_list_data_get(l);
-	l = eina_list_next(l);
-	if (cb->delete_me)
-	  {
-	     o->callbacks = eina_list_remove(o->callbacks, cb);
-	     if (cb->event) eina_stringshare_del(cb->event);
-             EVAS_MEMPOOL_FREE(_mp_cb, cb);
-	  }
+        Evas_Smart_Callback_Slot *slot = &(o->slots[i]);
+
+        for (l = slot->callbacks; l;)
+          {
+             cb = eina_list_data_get(l);
+             l = eina_list_next(l);
+             if (cb->delete_me)
+               {
+                  slot->callbacks = eina_list_remove(slot->callbacks, cb);
+                  if (cb->event) eina_stringshare_del(cb->event);
+                  EVAS_MEMPOOL_FREE(_mp_cb, cb);
+               }
+          }
+        /* drop empty slots so a signal nobody listens to costs nothing */
+        if (!slot->callbacks)
+          o->slots[i] = o->slots[--o->slots_count];
+        else
+          i++;
      }
 }
 
@@ -924,15 +1041,21 @@ evas_object_smart_cleanup(Evas_Object *obj)
 	while (o->contained)
 	  evas_object_smart_member_del((Evas_Object *)o->contained);
 
-	while (o->callbacks)
+	while (o->slots_count > 0)
 	  {
+	     Evas_Smart_Callback_Slot *slot;
 	     Evas_Smart_Callback *cb;
 
-	     cb = o->callbacks->data;
-	     o->callbacks = eina_list_remove(o->callbacks, cb);
-	     if (cb->event) eina_stringshare_del(cb->event);
-             EVAS_MEMPOOL_FREE(_mp_cb, cb);
+	     slot = &(o->slots[--o->slots_count]);
+	     EINA_LIST_FREE(slot->callbacks, cb)
+	       {
+		  if (cb->event) eina_stringshare_del(cb->event);
+		  EVAS_MEMPOOL_FREE(_mp_cb, cb);
+	       }
 	  }
+	free(o->slots);
+	o->slots = NULL;
+	o->slots_alloc = 0;
 
 	evas_smart_cb_descriptions_resize(&o->callbacks_descriptions, 0);
 	o->data = NULL;
@@ -969,6 +1092,7 @@ evas_object_smart_member_raise(Evas_Object *member)
 
    o = (Evas_Object_Smart *)(member->smart.parent->object_data);
    o->contained = eina_inlist_demote(o->contained, EINA_INLIST_GET(member));
+   evas_object_index_order_dirty(member);
 }
 
 void
@@ -978,6 +1102,7 @@ evas_object_smart_member_lower(Evas_Object *member)
 
    o = (Evas_Object_Smart *)(member->smart.parent->object_data);
    o->contained = eina_inlist_promote(o->contained, EINA_INLIST_GET(member));
+   evas_object_index_order_dirty(member);
 }
 
 void
@@ -988,6 +1113,7 @@ evas_object_smart_member_stack_above(Evas_Object *member, Evas_Object *other)
    o = (Evas_Object_Smart *)(member->smart.parent->object_data);
    o->contained = eina_inlist_remove(o->contained, EINA_INLIST_GET(member));
    o->contained = eina_inlist_append_relative(o->contained, EINA_INLIST_GET(member), EINA_INLIST_GET(other));
+   evas_object_index_order_dirty(member);
 }
 
 void
@@ -998,6 +1124,7 @@ evas_object_smart_member_stack_below(Evas_Object *member, Evas_Object *other)
    o = (Evas_Object_Smart *)(member->smart.parent->object_data);
    o->contained = eina_inlist_remove(o->contained, EINA_INLIST_GET(member));
    o->contained = eina_inlist_prepend_relative(o->contained, EINA_INLIST_GET(member), EINA_INLIST_GET(other));
+   evas_object_index_order_dirty(member);
 }
 
 /* all nice and private */
@@ -34,6 +34,15 @@ struct _Evas_Object_Text
 
    void                *engine_data;
 
+   /* soft styles are drawn from the text's shape, rendered once */
+   struct {
+      void                *blur, *ring;
+      const Eina_Unicode  *text;
+      void                *font;
+      int                  w, h;
+      unsigned char        style;
+   } effect;
+
    char                 changed : 1;
 };
 
@@ -52,6 +61,8 @@ static void *evas_object_text_engine_data_get(Evas_Object *obj);
 static int evas_object_text_is_opaque(Evas_Object *obj);
 static int evas_object_text_was_opaque(Evas_Object *obj);
 
+static void _evas_object_text_effect_free(Evas_Object *obj, Evas_Object_Text *o);
+
 static void evas_object_text_scale_update(Evas_Object *obj);
 
 static const Evas_Object_Func object_func =
@@ -217,6 +228,7 @@ evas_object_text_font_set(Evas_Object *obj, const char *font, Evas_Font_Size siz
 #endif
 
    /* DO IT */
+   _evas_object_text_effect_free(obj, o);
    if (o->engine_data)
      {
 	evas_font_free(obj->layer->evas, o->engine_data);
@@ -365,6 +377,7 @@ evas_object_text_text_set(Evas_Object *obj, const char *_text)
    o->cur.intl_props.props = evas_bidi_paragraph_props_get(text);
    evas_bidi_shape_string(text, &o->cur.intl_props, len);
 #endif
+   _evas_object_text_effect_free(obj, o);
    if (o->cur.text) eina_ustringshare_del(o->cur.text);
    if (o->cur.utf8_text) eina_stringshare_del(o->cur.utf8_text);
 
@@ -1547,6 +1560,7 @@ evas_object_text_free(Evas_Object *obj)
    if (o->cur.utf8_text) eina_stringshare_del(o->cur.utf8_text);
    if (o->cur.font) eina_stringshare_del(o->cur.font);
    if (o->cur.source) eina_stringshare_del(o->cur.source);
+   _evas_object_text_effect_free(obj, o);
    if (o->engine_data) evas_font_free(obj->layer->evas, o->engine_data);
 #ifdef BIDI_SUPPORT
    evas_bidi_props_clean(&o->cur.intl_props);
@@ -1555,6 +1569,179 @@ evas_object_text_free(Evas_Object *obj)
    EVAS_MEMPOOL_FREE(_mp_obj, o);
 }
 
+/* how far the effects reach out of the text */
+#define EFFECT_PAD 2
+
+static void
+_evas_object_text_effect_free(Evas_Object *obj, Evas_Object_Text *o)
+{
+#ifdef EVAS_FRAME_QUEUING
+   if (o->effect.blur) evas_common_pipe_op_image_flush(o->effect.blur);
+   if (o->effect.ring) evas_common_pipe_op_image_flush(o->effect.ring);
+#endif
+   if (o->effect.blur) ENFN->image_free(ENDT, o->effect.blur);
+   if (o->effect.ring) ENFN->image_free(ENDT, o->effect.ring);
+   o->effect.blur = NULL;
+   o->effect.ring = NULL;
+   o->effect.text = NULL;
+   o->effect.font = NULL;
+}
+
+/* the 5x5 soft kernel the styles used to be drawn with is close to the
+ * outer product of 1 3 4 3 1 with itself times 5/16, so it is run as a
+ * horizontal and a vertical pass. each tap was drawn at 50/255 of the
+ * color, which folds into one scale at the end. m is the mask with 2
+ * pixels more on each side than the w x h result */
+static void
+_evas_object_text_effect_blur(const DATA8 *m, DATA16 *tmp, DATA32 *dst, int w, int h, Eina_Bool hollow)
+{
+   int x, y, mw = w + 4;
+
+   for (y = 0; y < (h + 4); y++)
+     {
+        const DATA8 *s = m + (y * mw);
+        DATA16 *d = tmp + (y * w);
+
+        for (x = 0; x < w; x++)
+          d[x] = s[x] + (3 * s[x + 1]) + (4 * s[x + 2]) + (3 * s[x + 3]) + s[x + 4];
+     }
+   for (y = 0; y < h; y++)
+     {
+        const DATA16 *s = tmp + (y * w);
+        const DATA8 *c = m + ((y + 2) * mw) + 2;
+        DATA32 *d = dst + (y * w);
+
+        for (x = 0; x < w; x++)
+          {
+             int v;
+
+             v = s[x] + (3 * s[x + w]) + (4 * s[x + (2 * w)]) +
+               (3 * s[x + (3 * w)]) + s[x + (4 * w)];
+             /* the soft outline leaves out the middle tap */
+             if (hollow) v -= 16 * c[x];
+             v = (v * 25) / 408;
+             if (v > 255) v = 255;
+             d[x] = ((DATA32)v << 24) | (v << 16) | (v << 8) | v;
+          }
+     }
+}
+
+/* the text drawn 1 pixel left, right, up and down, one over the other */
+static void
+_evas_object_text_effect_ring(const DATA8 *m, DATA32 *dst, int w, int h)
+{
+   int x, y, mw = w + 4;
+
+   for (y = 0; y < h; y++)
+     {
+        const DATA8 *c = m + ((y + 2) * mw) + 2;
+        DATA32 *d = dst + (y * w);
+
+        for (x = 0; x < w; x++)
+          {
+             int v;
+
+             v = ((255 - c[x - 1]) * (255 - c[x + 1])) / 255;
+             v = (v * (255 - c[x - mw])) / 255;
+             v = (v * (255 - c[x + mw])) / 255;
+             v = 255 - v;
+             d[x] = ((DATA32)v << 24) | (v << 16) | (v << 8) | v;
+          }
+     }
+}
+
+/* makes sure the effect images are there for the current text, font and
+ * style. returns EINA_FALSE if the style has to be drawn tap by tap */
+static Eina_Bool
+_evas_object_text_effect_update(Evas_Object *obj, Evas_Object_Text *o, void *output)
+{
+   Eina_Bool blur = EINA_FALSE, ring = EINA_FALSE;
+   DATA8 *mask = NULL;
+   DATA16 *tmp = NULL;
+   DATA32 *pix = NULL;
+   int w, h, sl = 0, st = 0;
+
+   switch (o->cur.style)
+     {
+      case EVAS_TEXT_STYLE_SOFT_SHADOW:
+      case EVAS_TEXT_STYLE_FAR_SOFT_SHADOW:
+      case EVAS_TEXT_STYLE_SOFT_OUTLINE:
+        blur = EINA_TRUE;
+        break;
+      case EVAS_TEXT_STYLE_GLOW:
+      case EVAS_TEXT_STYLE_OUTLINE_SOFT_SHADOW:
+        blur = EINA_TRUE;
+        ring = EINA_TRUE;
+        break;
+      case EVAS_TEXT_STYLE_OUTLINE:
+      case EVAS_TEXT_STYLE_OUTLINE_SHADOW:
+        ring = EINA_TRUE;
+        break;
+      default:
+        break;
+     }
+   if ((!blur) && (!ring)) return EINA_FALSE;
+   if ((!o->engine_data) || (!o->cur.text) || (!ENFN->font_mask_draw))
+     return EINA_FALSE;
+
+   w = obj->cur.geometry.w + (2 * EFFECT_PAD);
+   h = obj->cur.geometry.h + (2 * EFFECT_PAD);
+   if ((o->effect.text == o->cur.text) && (o->effect.font == o->engine_data) &&
+       (o->effect.style == o->cur.style) &&
+       (o->effect.w == w) && (o->effect.h == h))
+     return ((!blur) || (o->effect.blur)) && ((!ring) || (o->effect.ring));
+
+   _evas_object_text_effect_free(obj, o);
+   o->effect.text = o->cur.text;
+   o->effect.font = o->engine_data;
+   o->effect.style = o->cur.style;
+   o->effect.w = w;
+   o->effect.h = h;
+
+   mask = calloc(1, (w + 4) * (h + 4));
+   pix = malloc(w * h * sizeof(DATA32));
+   if (blur) tmp = malloc(w * (h + 4) * sizeof(DATA16));
+   if ((!mask) || (!pix) || ((blur) && (!tmp))) goto end;
+   evas_text_style_pad_get(o->cur.style, &sl, NULL, &st, NULL);
+   if (!ENFN->font_mask_draw(output, o->engine_data, mask, w + 4, h + 4,
+                             sl + EFFECT_PAD + 2,
+                             st + EFFECT_PAD + 2 + (int)(o->max_ascent - 0.5),
+                             o->cur.text, &o->cur.intl_props))
+     goto end;
+   if (blur)
+     {
+        _evas_object_text_effect_blur(mask, tmp, pix, w, h,
+              (o->cur.style == EVAS_TEXT_STYLE_SOFT_OUTLINE));
+        o->effect.blur = ENFN->image_new_from_copied_data
+           (output, w, h, pix, 1, EVAS_COLORSPACE_ARGB8888);
+     }
+   if (ring)
+     {
+        _evas_object_text_effect_ring(mask, pix, w, h);
+        o->effect.ring = ENFN->image_new_from_copied_data
+           (output, w, h, pix, 1, EVAS_COLORSPACE_ARGB8888);
+     }
+end:
+   free(mask);
+   free(tmp);
+   free(pix);
+   return ((!blur) || (o->effect.blur)) && ((!ring) || (o->effect.ring));
+}
+
+static void
+_evas_object_text_effect_draw(Evas_Object *obj, void *output, void *context, void *surface, void *im, int r, int g, int b, int a, int x, int y)
+{
+   Evas_Object_Text *o = (Evas_Object_Text *)(obj->object_data);
+
+   ENFN->context_color_set(output, context, 255, 255, 255, 255);
+   ENFN->context_multiplier_set(output, context, r, g, b, a);
+   ENFN->image_draw(output, context, surface, im,
+                    0, 0, o->effect.w, o->effect.h,
+                    x - EFFECT_PAD, y - EFFECT_PAD, o->effect.w, o->effect.h,
+                    0);
+   ENFN->context_multiplier_unset(output, context);
+}
+
 static void
 evas_object_text_render(Evas_Object *obj, void *output, void *context, void *surface, int x, int y)
 {
@@ -1569,10 +1756,12 @@ evas_object_text_render(Evas_Object *obj, void *output, void *context, void *sur
 	{0, 1, 2, 1, 0}
      };
    int sl = 0, st = 0;
+   Eina_Bool effect;
 
    /* render object to surface with context, and offxet by x,y */
    o = (Evas_Object_Text *)(obj->object_data);
    evas_text_style_pad_get(o->cur.style, &sl, NULL, &st, NULL);
+   effect = _evas_object_text_effect_update(obj, o, output);
    ENFN->context_multiplier_unset(output, context);
    ENFN->context_render_op_set(output, context, obj->cur.render_op);
 /*
@@ -1637,6 +1826,22 @@ evas_object_text_render(Evas_Object *obj, void *output, void *context, void *sur
 		     obj->cur.geometry.w, \
 		     obj->cur.geometry.h, \
 		     o->cur.text, &o->cur.intl_props);
+#define DRAW_EFFECT(im, col, ox, oy) \
+   if (obj->cur.clipper) \
+     _evas_object_text_effect_draw(obj, output, context, surface, o->effect.im, \
+				   ((int)o->cur.col.r * ((int)obj->cur.clipper->cur.cache.clip.r + 1)) >> 8, \
+				   ((int)o->cur.col.g * ((int)obj->cur.clipper->cur.cache.clip.g + 1)) >> 8, \
+				   ((int)o->cur.col.b * ((int)obj->cur.clipper->cur.cache.clip.b + 1)) >> 8, \
+				   ((int)o->cur.col.a * ((int)obj->cur.clipper->cur.cache.clip.a + 1)) >> 8, \
+				   obj->cur.geometry.x + x + ox, \
+				   obj->cur.geometry.y + y + oy); \
+   else \
+     _evas_object_text_effect_draw(obj, output, context, surface, o->effect.im, \
+				   o->cur.col.r, o->cur.col.g, \
+				   o->cur.col.b, o->cur.col.a, \
+				   obj->cur.geometry.x + x + ox, \
+				   obj->cur.geometry.y + y + oy);
+
 #if 0
 #define DRAW_TEXT(ox, oy) \
    if ((o->engine_data) && (o->cur.text)) \
@@ -1666,6 +1871,11 @@ evas_object_text_render(Evas_Object *obj, void *output, void *context, void *sur
 	COLOR_SET(o, cur, shadow);
         DRAW_TEXT(2, 2);
      }
+   else if (((o->cur.style == EVAS_TEXT_STYLE_OUTLINE_SOFT_SHADOW) ||
+	     (o->cur.style == EVAS_TEXT_STYLE_FAR_SOFT_SHADOW)) && (effect))
+     {
+	DRAW_EFFECT(blur, shadow, 2, 2);
+     }
    else if ((o->cur.style == EVAS_TEXT_STYLE_OUTLINE_SOFT_SHADOW) ||
 	    (o->cur.style == EVAS_TEXT_STYLE_FAR_SOFT_SHADOW))
      {
@@ -1681,6 +1891,10 @@ evas_object_text_render(Evas_Object *obj, void *output, void *context, void *sur
 	       }
 	  }
      }
+   else if ((o->cur.style == EVAS_TEXT_STYLE_SOFT_SHADOW) && (effect))
+     {
+	DRAW_EFFECT(blur, shadow, 1, 1);
+     }
    else if (o->cur.style == EVAS_TEXT_STYLE_SOFT_SHADOW)
      {
 	for (j = 0; j < 5; j++)
@@ -1697,7 +1911,12 @@ evas_object_text_render(Evas_Object *obj, void *output, void *context, void *sur
      }
 
    /* glows */
-   if (o->cur.style == EVAS_TEXT_STYLE_GLOW)
+   if ((o->cur.style == EVAS_TEXT_STYLE_GLOW) && (effect))
+     {
+	DRAW_EFFECT(blur, glow, 0, 0);
+	DRAW_EFFECT(ring, glow2, 0, 0);
+     }
+   else if (o->cur.style == EVAS_TEXT_STYLE_GLOW)
      {
 	for (j = 0; j < 5; j++)
 	  {
@@ -1718,7 +1937,13 @@ evas_object_text_render(Evas_Object *obj, void *output, void *context, void *sur
      }
 
    /* outlines */
-   if ((o->cur.style == EVAS_TEXT_STYLE_OUTLINE) ||
+   if (((o->cur.style == EVAS_TEXT_STYLE_OUTLINE) ||
+        (o->cur.style == EVAS_TEXT_STYLE_OUTLINE_SHADOW) ||
+        (o->cur.style == EVAS_TEXT_STYLE_OUTLINE_SOFT_SHADOW)) && (effect))
+     {
+	DRAW_EFFECT(ring, outline, 0, 0);
+     }
+   else if ((o->cur.style == EVAS_TEXT_STYLE_OUTLINE) ||
        (o->cur.style == EVAS_TEXT_STYLE_OUTLINE_SHADOW) ||
        (o->cur.style == EVAS_TEXT_STYLE_OUTLINE_SOFT_SHADOW))
      {
@@ -1728,6 +1953,10 @@ evas_object_text_render(Evas_Object *obj, void *output, void *context, void *sur
 	DRAW_TEXT(0, -1);
 	DRAW_TEXT(0, 1);
      }
+   else if ((o->cur.style == EVAS_TEXT_STYLE_SOFT_OUTLINE) && (effect))
+     {
+	DRAW_EFFECT(blur, outline, 0, 0);
+     }
    else if (o->cur.style == EVAS_TEXT_STYLE_SOFT_OUTLINE)
      {
 	for (j = 0; j < 5; j++)
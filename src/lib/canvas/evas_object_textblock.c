@@ -145,6 +145,14 @@ static const char o_type[] = "textblock";
 /* The char to be inserted instead of visible formats */
 #define EVAS_TEXTBLOCK_REPLACEMENT_CHAR 0xFFFC
 
+/* glyphs can only be looked up from several threads at once when the font
+ * engine does its locking */
+#if defined(BUILD_PTHREAD) && (defined(EVAS_FRAME_QUEUING) || defined(BUILD_PIPE_RENDER))
+# define LAYOUT_THREADS 1
+/* below that many paragraphs to lay out it's not worth using the threads */
+# define LAYOUT_THREADS_MIN_PARAGRAPHS 64
+#endif
+
 /* private struct for textblock object internal data */
 /**
  * @internal
@@ -235,6 +243,9 @@ struct _Evas_Object_Textblock_Node_Text
    char                               *utf8;
    Evas_Object_Textblock_Node_Format  *format_node;
    Evas_BiDi_Paragraph_Props          *bidi_props;
+   Evas_Object_Textblock_Paragraph    *par; /* last layout of this node */
+   Eina_Bool                           dirty; /* changed since laid out */
+   Eina_Bool                           exact; /* laid out even off screen */
 };
 
 struct _Evas_Object_Textblock_Node_Format
@@ -263,8 +274,16 @@ struct _Evas_Object_Textblock_Paragraph
 {
    EINA_INLIST;
    Evas_Object_Textblock_Line        *lines;
+   Evas_Object_Textblock_Node_Text   *text_node;
+   Eina_List                         *format_stack; /* formats at the start */
+   Eina_List                         *format_stack_end; /* formats at the end */
    int                                x, y, w, h;
    int                                par_no;
+   int                                line_no, lines_num; /* if estimated */
+   struct {
+      int                             l, r, t, b;
+   } style_pad;
+   Eina_Bool                          estimated; /* no lines, guessed size */
 };
 
 struct _Evas_Object_Textblock_Line
@@ -364,10 +383,14 @@ struct _Evas_Object_Textblock
    Evas_Object_Textblock_Node_Text    *text_nodes;
    Evas_Object_Textblock_Node_Format  *format_nodes;
    Evas_Object_Textblock_Paragraph    *paragraphs;
-   int                                 last_w;
+   int                                 last_w, last_h;
    struct {
       int                              l, r, t, b;
    } style_pad;
+   struct {
+      int                              y0, y1; /* laid out exactly */
+      int                              char_w; /* average, for guessing */
+   } viewport;
    char                               *markup_text;
    void                               *engine_data;
    const char                         *repch;
@@ -377,6 +400,7 @@ struct _Evas_Object_Textblock
    } formatted, native;
    unsigned char                       redraw : 1;
    unsigned char                       changed : 1;
+   unsigned char                       virt : 1;
 };
 
 /* private methods for textblock objects */
@@ -458,6 +482,7 @@ static void _evas_textblock_node_format_remove(Evas_Object_Textblock *o, Evas_Ob
 static void _evas_textblock_node_format_free(Evas_Object_Textblock_Node_Format *n);
 static void _evas_textblock_node_text_free(Evas_Object_Textblock_Node_Text *n);
 static void _evas_textblock_changed(Evas_Object_Textblock *o, Evas_Object *obj);
+static void _evas_textblock_nodes_dirty_all(Evas_Object_Textblock *o);
 static void _evas_textblock_cursors_update_offset(const Evas_Textblock_Cursor *cur, const Evas_Object_Textblock_Node_Text *n, size_t start, int offset);
 static void _evas_textblock_cursors_set_node(Evas_Object_Textblock *o, const Evas_Object_Textblock_Node_Text *n, Evas_Object_Textblock_Node_Text *new_node);
 
@@ -1683,6 +1708,8 @@ struct _Ctxt
    Evas_Object_Textblock_Paragraph *paragraphs;
    Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
+   /* the previous layout, paragraphs of unchanged nodes are taken from it */
+   Evas_Object_Textblock_Paragraph *old_paragraphs;
 
    Eina_List *format_stack;
 
@@ -1696,6 +1723,14 @@ struct _Ctxt
    int have_underline, have_underline2;
    double align;
    Eina_Bool align_auto;
+   Eina_Bool cache; /* the layout is kept, remember how it was made */
+   Eina_Bool reuse; /* old paragraphs fit the current size */
+   /* virtual layout, only the paragraphs in vy0-vy1 are laid out */
+   Eina_Bool virt;
+   Eina_Bool estimate; /* only follow the formats */
+   int vy0, vy1;
+   int est_breaks;
+   int est_w, est_chars;
 };
 
 /**
@@ -1770,19 +1805,222 @@ _layout_line_new(Ctxt *c, Evas_Object_Textblock_Format *fmt)
    _layout_format_ascent_descent_adjust(c, fmt);
 }
 
+/**
+ * @internal
+ * Take a reference to all the formats of a format stack.
+ *
+ * @param stack the format stack to copy.
+ * @return a copy of the stack.
+ */
+static Eina_List *
+_format_stack_ref(const Eina_List *stack)
+{
+   Evas_Object_Textblock_Format *fmt;
+   Eina_List *copy = NULL;
+   const Eina_List *l;
+
+   EINA_LIST_FOREACH(stack, l, fmt)
+     {
+        fmt->ref++;
+        copy = eina_list_append(copy, fmt);
+     }
+   return copy;
+}
+
+/**
+ * @internal
+ * Drop a format stack taken with _format_stack_ref().
+ *
+ * @param obj the evas object - Not NULL.
+ * @param stack the format stack to free.
+ */
+static void
+_format_stack_unref(const Evas_Object *obj, Eina_List *stack)
+{
+   Evas_Object_Textblock_Format *fmt;
+
+   EINA_LIST_FREE(stack, fmt)
+      _format_unref_free(obj, fmt);
+}
+
+/**
+ * @internal
+ * Check if two formats format text the same way. The font handles are not
+ * compared, the same font description always loads the same font. The
+ * font strings are stringshared, so they are compared by pointer.
+ *
+ * @return EINA_TRUE if the formats are equal, EINA_FALSE otherwise.
+ */
+static Eina_Bool
+_format_equal(const Evas_Object_Textblock_Format *fmt1, const Evas_Object_Textblock_Format *fmt2)
+{
+   if (fmt1 == fmt2) return EINA_TRUE;
+   /* the colors are all unsigned chars, so they have no padding */
+   return ((fmt1->halign == fmt2->halign) &&
+           (fmt1->halign_auto == fmt2->halign_auto) &&
+           (fmt1->valign == fmt2->valign) &&
+           (fmt1->font.name == fmt2->font.name) &&
+           (fmt1->font.source == fmt2->font.source) &&
+           (fmt1->font.fallbacks == fmt2->font.fallbacks) &&
+           (fmt1->font.size == fmt2->font.size) &&
+           (!memcmp(&fmt1->color, &fmt2->color, sizeof(fmt1->color))) &&
+           (fmt1->margin.l == fmt2->margin.l) &&
+           (fmt1->margin.r == fmt2->margin.r) &&
+           (fmt1->tabstops == fmt2->tabstops) &&
+           (fmt1->linesize == fmt2->linesize) &&
+           (fmt1->linerelsize == fmt2->linerelsize) &&
+           (fmt1->linegap == fmt2->linegap) &&
+           (fmt1->linerelgap == fmt2->linerelgap) &&
+           (fmt1->linefill == fmt2->linefill) &&
+           (fmt1->style == fmt2->style) &&
+           (fmt1->wrap_word == fmt2->wrap_word) &&
+           (fmt1->wrap_char == fmt2->wrap_char) &&
+           (fmt1->underline == fmt2->underline) &&
+           (fmt1->underline2 == fmt2->underline2) &&
+           (fmt1->strikethrough == fmt2->strikethrough) &&
+           (fmt1->backing == fmt2->backing));
+}
+
+/**
+ * @internal
+ * Check if two format stacks are equal, format by format.
+ */
+static Eina_Bool
+_format_stack_equal(const Eina_List *stack1, const Eina_List *stack2)
+{
+   while ((stack1) && (stack2))
+     {
+        if (!_format_equal(stack1->data, stack2->data)) return EINA_FALSE;
+        stack1 = stack1->next;
+        stack2 = stack2->next;
+     }
+   return (!stack1) && (!stack2);
+}
+
 /**
  * @internal
  * Create a new layout paragraph.
  *
  * @param c The context to work on - Not NULL.
+ * @param n The text node the paragraph is made of, NULL if none.
  */
 static void
-_layout_paragraph_new(Ctxt *c)
+_layout_paragraph_new(Ctxt *c, Evas_Object_Textblock_Node_Text *n)
 {
    c->par = calloc(1, sizeof(Evas_Object_Textblock_Paragraph));
    c->paragraphs = (Evas_Object_Textblock_Paragraph *)eina_inlist_append(EINA_INLIST_GET(c->paragraphs), EINA_INLIST_GET(c->par));
    c->x = 0;
    c->par->par_no= -1;
+   c->par->y = c->y + c->o->style_pad.t;
+   c->wmax = 0;
+   /* only a paragraph that starts on a line of its own can be reused */
+   if ((c->cache) && (n) && (!c->ln))
+     {
+        c->par->text_node = n;
+        c->par->format_stack = _format_stack_ref(c->format_stack);
+     }
+}
+
+/**
+ * @internal
+ * Finish the current layout paragraph and remember how it was made, so the
+ * next layout can take it as is if its text node doesn't change.
+ *
+ * @param c The context to work on - Not NULL.
+ */
+static void
+_layout_paragraph_finish(Ctxt *c)
+{
+   Evas_Object_Textblock_Paragraph *par = c->par;
+   Evas_Object_Textblock_Line *ln = c->ln;
+
+   /* drop the empty line the last line advance left behind */
+   if ((ln) && (ln->line_no == -1) && (!ln->items) && (!ln->format_items) &&
+       (par->lines) && (EINA_INLIST_GET(par->lines)->last == EINA_INLIST_GET(ln)))
+     {
+        par->lines = (Evas_Object_Textblock_Line *)eina_inlist_remove(EINA_INLIST_GET(par->lines), EINA_INLIST_GET(ln));
+        _line_free(c->obj, ln);
+        c->ln = NULL;
+     }
+   par->h = c->y + c->o->style_pad.t - par->y;
+   par->w = c->wmax;
+   if (!par->text_node) return;
+   if ((c->virt) && (!par->estimated))
+     {
+        /* learn how wide text is to guess the size of the rest */
+        EINA_INLIST_FOREACH(par->lines, ln)
+           c->est_w += ln->w;
+        c->est_chars += eina_ustrbuf_length_get(par->text_node->unicode);
+     }
+   if (c->ln)
+     {
+        /* the next node continues on our last line */
+        _format_stack_unref(c->obj, par->format_stack);
+        par->format_stack = NULL;
+        par->text_node = NULL;
+        return;
+     }
+   par->format_stack_end = _format_stack_ref(c->format_stack);
+   par->text_node->par = par;
+   par->text_node->dirty = EINA_FALSE;
+}
+
+/**
+ * @internal
+ * Take the paragraph of the previous layout for the text node n if the node
+ * didn't change since and the formats in effect are still the same. The
+ * paragraph's lines are moved in place and the context continues after it.
+ *
+ * @param c The context to work on - Not NULL.
+ * @param n The text node to lay out - Not NULL.
+ * @param _fmt the current format, updated to the one the paragraph ends with.
+ * @param exact EINA_TRUE if an estimated paragraph won't do.
+ * @return EINA_TRUE if the paragraph was reused, EINA_FALSE otherwise.
+ */
+static Eina_Bool
+_layout_paragraph_reuse(Ctxt *c, Evas_Object_Textblock_Node_Text *n, Evas_Object_Textblock_Format **_fmt, Eina_Bool exact)
+{
+   Evas_Object_Textblock_Paragraph *par = n->par;
+   Evas_Object_Textblock_Line *ln;
+   int dy, dno;
+
+   if ((!c->reuse) || (!par) || (n->dirty) || (c->ln)) return EINA_FALSE;
+   if ((exact) && (par->estimated)) return EINA_FALSE;
+   if (!_format_stack_equal(par->format_stack, c->format_stack))
+     return EINA_FALSE;
+
+   c->old_paragraphs = (Evas_Object_Textblock_Paragraph *)eina_inlist_remove(EINA_INLIST_GET(c->old_paragraphs), EINA_INLIST_GET(par));
+   c->paragraphs = (Evas_Object_Textblock_Paragraph *)eina_inlist_append(EINA_INLIST_GET(c->paragraphs), EINA_INLIST_GET(par));
+   c->par = par;
+
+   /* only the position changes, if anything above it did */
+   dy = c->y + c->o->style_pad.t - par->y;
+   if (par->lines) dno = c->line_no - par->lines->line_no;
+   else dno = c->line_no - par->line_no;
+   if ((dy) || (dno))
+     {
+        EINA_INLIST_FOREACH(par->lines, ln)
+          {
+             ln->y += dy;
+             ln->line_no += dno;
+          }
+     }
+   par->y += dy;
+   par->line_no += dno;
+   c->y += par->h;
+   if (par->lines)
+     {
+        ln = (Evas_Object_Textblock_Line *)EINA_INLIST_GET(par->lines)->last;
+        c->line_no = ln->line_no + 1;
+     }
+   else
+     c->line_no += par->lines_num;
+
+   /* carry on with the formats the paragraph ended with */
+   _format_stack_unref(c->obj, c->format_stack);
+   c->format_stack = _format_stack_ref(par->format_stack_end);
+   *_fmt = c->format_stack->data;
+   return EINA_TRUE;
 }
 
 /**
@@ -1800,6 +2038,10 @@ _paragraph_free(const Evas_Object *obj, Evas_Object_Textblock_Paragraph *par)
         par->lines = (Evas_Object_Textblock_Line *)eina_inlist_remove(EINA_INLIST_GET(par->lines), EINA_INLIST_GET(par->lines));
         _line_free(obj, ln);
      }
+   if ((par->text_node) && (par->text_node->par == par))
+     par->text_node->par = NULL;
+   _format_stack_unref(obj, par->format_stack);
+   _format_stack_unref(obj, par->format_stack_end);
    free(par);
 }
 
@@ -2622,7 +2864,10 @@ _layout_do_format(const Evas_Object *obj, Ctxt *c,
    int handled = 0;
 
    s = eina_strbuf_string_get(n->format);
-   if (!strncmp(s, "+ item ", 7))
+   /* when estimating items take no room */
+   if ((c->estimate) && (!strncmp(s, "+ item ", 7)))
+     handled = 1;
+   else if (!strncmp(s, "+ item ", 7))
      {
         // one of:
         //   item size=20x10 href=name
@@ -2743,8 +2988,23 @@ _layout_do_format(const Evas_Object *obj, Ctxt *c,
              tmp[s - item] = '\0';
              if (_format_is_param(item))
                {
+                  /* don't change text laid out before, or a paragraph
+                   * kept for reuse, under their feet */
+                  if (fmt->ref > 1)
+                    {
+                       Evas_Object_Textblock_Format *fmt2;
+
+                       fmt2 = _format_dup(c->obj, fmt);
+                       c->format_stack->data = fmt2;
+                       _format_unref_free(c->obj, fmt);
+                       fmt = fmt2;
+                    }
                   _layout_format_value_handle(c, fmt, item);
                }
+             else if (c->estimate)
+               {
+                  if (_IS_LINE_SEPARATOR(item)) c->est_breaks++;
+               }
              else
                {
                   if (_IS_PARAGRAPH_SEPARATOR(item))
@@ -2807,6 +3067,266 @@ _layout_do_format(const Evas_Object *obj, Ctxt *c,
    *_fmt = fmt;
 }
 
+/**
+ * @internal
+ * Guess the size of the text of a node without laying it out, from the
+ * height of its starting font and the average width of the text laid out
+ * so far.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param fmt the format the node starts with - Not NULL.
+ * @param n the text node - Not NULL.
+ * @param[out] line_h the height of a line.
+ * @param[out] w the width of the paragraph.
+ * @return the number of lines.
+ */
+static int
+_layout_paragraph_guess(Ctxt *c, Evas_Object_Textblock_Format *fmt, Evas_Object_Textblock_Node_Text *n, int *line_h, int *w)
+{
+   int avail, char_w, lines = 1;
+
+   c->maxascent = c->maxdescent = 0;
+   _layout_format_ascent_descent_adjust(c, fmt);
+   *line_h = c->maxascent + c->maxdescent;
+   char_w = c->o->viewport.char_w;
+   if (char_w <= 0) char_w = (*line_h / 2) + 1;
+   *w = eina_ustrbuf_length_get(n->unicode) * char_w;
+   avail = c->w - c->o->style_pad.l - c->o->style_pad.r -
+      fmt->margin.l - fmt->margin.r;
+   if ((c->w > 0) && (avail > 0) && ((fmt->wrap_word) || (fmt->wrap_char)))
+     {
+        lines += *w / avail;
+        if (*w > avail) *w = avail;
+     }
+   return lines;
+}
+
+/**
+ * @internal
+ * Check if the node has to be laid out exactly: always unless the layout is
+ * virtual, and then only when the node is around the viewport or someone
+ * asked for its lines.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param fmt the current format - Not NULL.
+ * @param n the text node - Not NULL.
+ */
+static Eina_Bool
+_layout_paragraph_wanted(Ctxt *c, Evas_Object_Textblock_Format *fmt, Evas_Object_Textblock_Node_Text *n)
+{
+   int h, line_h, w;
+
+   if ((!c->virt) || (n->exact) || (c->ln)) return EINA_TRUE;
+   if (n->par) h = n->par->h;
+   else h = _layout_paragraph_guess(c, fmt, n, &line_h, &w) * line_h;
+   return ((c->y < c->vy1) && ((c->y + h) > c->vy0));
+}
+
+/**
+ * @internal
+ * Make an estimated paragraph for the node. Nothing is laid out, only the
+ * formats of the node are followed so the next paragraph starts right.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param n the text node - Not NULL.
+ * @param _fmt the current format, updated to the one the node ends with.
+ */
+static void
+_layout_paragraph_estimate(Ctxt *c, Evas_Object_Textblock_Node_Text *n, Evas_Object_Textblock_Format **_fmt)
+{
+   Evas_Object_Textblock_Node_Format *fnode;
+   int lines, line_h, w;
+
+   _layout_paragraph_new(c, n);
+   c->par->estimated = EINA_TRUE;
+   c->par->line_no = c->line_no;
+   lines = _layout_paragraph_guess(c, *_fmt, n, &line_h, &w);
+
+   c->estimate = EINA_TRUE;
+   c->est_breaks = 0;
+   for (fnode = n->format_node ; fnode && (fnode->text_node == n) ;
+         fnode = _NODE_FORMAT(EINA_INLIST_GET(fnode)->next))
+     {
+        _layout_do_format(c->obj, c, _fmt, fnode,
+              &c->par->style_pad.l, &c->par->style_pad.r,
+              &c->par->style_pad.t, &c->par->style_pad.b);
+     }
+   c->estimate = EINA_FALSE;
+   c->have_underline = 0;
+   c->have_underline2 = 0;
+
+   lines += c->est_breaks;
+   c->par->lines_num = lines;
+   c->line_no += lines;
+   c->y += lines * line_h;
+   c->wmax = w;
+   _layout_paragraph_finish(c);
+}
+
+/**
+ * @internal
+ * Lay out the text and formats of the node on the current paragraph.
+ *
+ * For each text node to thorugh all of it's format nodes
+ * append text from the start to the offset of the next format
+ * using the last format got. if needed it also creates format items
+ * this is the core algorithm of the layout mechanism.
+ * Skip the unicode replacement chars when there are because
+ * we don't want to print them.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param n the text node - Not NULL.
+ * @param _fmt the current format, updated to the one the node ends with.
+ */
+static void
+_layout_paragraph_text(Ctxt *c, Evas_Object_Textblock_Node_Text *n, Evas_Object_Textblock_Format **_fmt)
+{
+   Evas_Object_Textblock_Node_Format *fnode;
+   size_t start;
+   int off;
+
+   fnode = n->format_node;
+   start = off = 0;
+   while (fnode && (fnode->text_node == n))
+     {
+        off += fnode->offset;
+        /* No need to skip on the first run, or a non-visible one */
+        _layout_text_append(c, *_fmt, n, start, off, c->o->repch);
+        _layout_do_format(c->obj, c, _fmt, fnode,
+              &c->par->style_pad.l, &c->par->style_pad.r,
+              &c->par->style_pad.t, &c->par->style_pad.b);
+        if ((c->have_underline2) || (c->have_underline))
+          {
+             if (c->par->style_pad.b < c->underline_extend)
+               c->par->style_pad.b = c->underline_extend;
+             c->have_underline = 0;
+             c->have_underline2 = 0;
+             c->underline_extend = 0;
+          }
+        start += off;
+        if (fnode->visible)
+          {
+             off = -1;
+             start++;
+          }
+        else
+          {
+             off = 0;
+          }
+        fnode = _NODE_FORMAT(EINA_INLIST_GET(fnode)->next);
+     }
+   _layout_text_append(c, *_fmt, n, start, -1, c->o->repch);
+}
+
+/**
+ * @internal
+ * Get the part of the object that is laid out exactly when the layout is
+ * virtual: what is visible of it, and as much again above and below so
+ * scrolling a bit doesn't need a new layout.
+ *
+ * @param obj the evas object - Not NULL.
+ * @param[out] y0 the top of the range, in layout coordinates.
+ * @param[out] y1 the bottom of the range, in layout coordinates.
+ * @return EINA_FALSE if nothing of the object is visible.
+ */
+static Eina_Bool
+_layout_viewport_get(const Evas_Object *obj, int *y0, int *y1)
+{
+   Evas *e = obj->layer->evas;
+   int vy0, vy1;
+
+   vy0 = obj->cur.cache.clip.y;
+   vy1 = vy0 + obj->cur.cache.clip.h;
+   if (vy0 < e->viewport.y) vy0 = e->viewport.y;
+   if (vy1 > (e->viewport.y + e->viewport.h)) vy1 = e->viewport.y + e->viewport.h;
+   *y0 = vy0 - obj->cur.geometry.y;
+   *y1 = vy1 - obj->cur.geometry.y;
+   return (vy1 > vy0);
+}
+
+#ifdef LAYOUT_THREADS
+typedef struct _Layout_Measure Layout_Measure;
+
+struct _Layout_Measure
+{
+   const Evas_Object *obj;
+   Evas_Object_Textblock_Node_Text **nodes;
+   void **fonts;
+   int count;
+};
+
+static void
+_layout_measure_worker(void *data, int i)
+{
+   Layout_Measure *lm = data;
+   const Evas_Object *obj = lm->obj;
+   Evas_Object_Textblock_Node_Text *n = lm->nodes[i];
+   Evas_BiDi_Props props;
+   int tw, th;
+
+   props.props = n->bidi_props;
+   props.start = 0;
+   ENFN->font_string_size_get(ENDT, lm->fonts[i],
+         eina_ustrbuf_string_get(n->unicode), &props, &tw, &th);
+}
+
+/**
+ * @internal
+ * Measure the text of all the paragraphs that are about to be laid out on
+ * the thread pool. Line breaking has to go paragraph after paragraph as
+ * the formats flow from one to the next, but shaping and rasterizing the
+ * glyphs doesn't, and then the real layout finds them all cached.
+ * Each paragraph is measured with the font it started with the last time,
+ * or the base one, which is right for everything but the odd styled run.
+ *
+ * @param c the context to work on - Not NULL.
+ * @param fmt the base format - Not NULL.
+ */
+static void
+_layout_paragraphs_premeasure(Ctxt *c, Evas_Object_Textblock_Format *fmt)
+{
+   Evas_Object_Textblock_Node_Text *n;
+   Layout_Measure lm;
+   int i, count = 0;
+
+   if (c->o->repch) return;
+   if (evas_common_thread_pool_threads_get() < 1) return;
+   EINA_INLIST_FOREACH(c->o->text_nodes, n)
+     {
+        if ((c->reuse) && (n->par) && (!n->dirty)) continue;
+        count++;
+     }
+   if (count < LAYOUT_THREADS_MIN_PARAGRAPHS) return;
+
+   lm.obj = c->obj;
+   lm.nodes = malloc(count * sizeof(Evas_Object_Textblock_Node_Text *));
+   lm.fonts = malloc(count * sizeof(void *));
+   lm.count = 0;
+   if ((!lm.nodes) || (!lm.fonts)) goto end;
+   EINA_INLIST_FOREACH(c->o->text_nodes, n)
+     {
+        Evas_Object_Textblock_Format *pfmt = fmt;
+
+        if ((c->reuse) && (n->par) && (!n->dirty)) continue;
+        if ((n->par) && (n->par->format_stack))
+          pfmt = n->par->format_stack->data;
+        if (!pfmt->font.font) continue;
+        lm.nodes[lm.count] = n;
+        lm.fonts[lm.count] = pfmt->font.font;
+        lm.count++;
+     }
+
+   if (!evas_common_thread_pool_run(_layout_measure_worker, &lm, lm.count))
+     {
+        for (i = 0; i < lm.count; i++)
+          _layout_measure_worker(&lm, i);
+     }
+end:
+   free(lm.nodes);
+   free(lm.fonts);
+}
+#endif
+
 /**
  * @internal
  * Create the layout from the nodes.
@@ -2825,7 +3345,7 @@ _layout(const Evas_Object *obj, int calc_only, int w, int h, int *w_ret, int *h_
    Ctxt ctxt, *c;
    Evas_Object_Textblock_Line *ln;
    Evas_Object_Textblock_Node_Text *n;
-   Eina_List *removes = NULL;
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Format *fmt = NULL;
    int style_pad_l = 0, style_pad_r = 0, style_pad_t = 0, style_pad_b = 0;
 
@@ -2835,6 +3355,7 @@ _layout(const Evas_Object *obj, int calc_only, int w, int h, int *w_ret, int *h_
    c->obj = (Evas_Object *)obj;
    c->o = o;
    c->paragraphs = c->par = NULL;
+   c->old_paragraphs = NULL;
    c->format_stack = NULL;
    c->x = c->y = 0;
    c->w = w;
@@ -2849,6 +3370,29 @@ _layout(const Evas_Object *obj, int calc_only, int w, int h, int *w_ret, int *h_
    c->align = 0.0;
    c->align_auto = EINA_TRUE;
    c->ln = NULL;
+   c->cache = !calc_only;
+   c->reuse = EINA_FALSE;
+   c->virt = (!calc_only) && (o->virt);
+   c->estimate = EINA_FALSE;
+   c->est_breaks = c->est_w = c->est_chars = 0;
+   if (!calc_only)
+     {
+        /* the old layout is freed only when done, so fonts stay loaded */
+        c->old_paragraphs = o->paragraphs;
+        o->paragraphs = NULL;
+        c->reuse = (c->old_paragraphs) && (w == o->last_w) && (h == o->last_h);
+     }
+   if (c->virt)
+     {
+        int vh;
+
+        if (!_layout_viewport_get(obj, &c->vy0, &c->vy1)) c->vy1 = c->vy0;
+        vh = c->vy1 - c->vy0;
+        c->vy0 -= vh;
+        c->vy1 += vh;
+        o->viewport.y0 = c->vy0;
+        o->viewport.y1 = c->vy1;
+     }
 
    /* setup default base style */
    if ((c->o->style) && (c->o->style->default_tag))
@@ -2858,6 +3402,7 @@ _layout(const Evas_Object *obj, int calc_only, int w, int h, int *w_ret, int *h_
      }
    if (!fmt)
      {
+        if (c->old_paragraphs) _paragraphs_clear(obj, c->old_paragraphs);
         if (w_ret) *w_ret = 0;
         if (h_ret) *h_ret = 0;
         return;
@@ -2868,67 +3413,43 @@ _layout(const Evas_Object *obj, int calc_only, int w, int h, int *w_ret, int *h_
         /* If there are no nodes and lines, do the initial creation. */
         if (!c->par && !c->ln)
           {
-             _layout_paragraph_new(c);
+             _layout_paragraph_new(c, NULL);
              _layout_line_new(c, fmt);
              _layout_text_append(c, fmt, NULL, 0, 0, NULL);
              _layout_line_advance(c, fmt);
           }
      }
+#ifdef LAYOUT_THREADS
+   else if (!c->virt)
+     _layout_paragraphs_premeasure(c, fmt);
+#endif
 
    /* Go through all the text nodes to create the layout from */
    EINA_INLIST_FOREACH(c->o->text_nodes, n)
      {
-        Evas_Object_Textblock_Node_Format *fnode;
-        size_t start;
-        int off;
+        Eina_Bool exact;
 
-        /*FIXME-tom: A hack, so we'll only have one paragraph
-         * until full support is implemented */
-        if (!c->par)
+        /* Each node is a paragraph, unchanged ones are not laid out again */
+        exact = _layout_paragraph_wanted(c, fmt, n);
+        if (_layout_paragraph_reuse(c, n, &fmt, exact)) continue;
+        if (!exact)
           {
-             _layout_paragraph_new(c); /* Each node is a paragraph */
+             _layout_paragraph_estimate(c, n, &fmt);
+             continue;
           }
+        _layout_paragraph_new(c, n);
         if (!c->ln) _layout_line_new(c, fmt);
-
-        /* For each text node to thorugh all of it's format nodes
-         * append text from the start to the offset of the next format
-         * using the last format got. if needed it also creates format items
-         * this is the core algorithm of the layout mechanism.
-         * Skip the unicode replacement chars when there are because
-         * we don't want to print them. */
-        fnode = n->format_node;
-        start = off = 0;
-        while (fnode && (fnode->text_node == n))
-          {
-             off += fnode->offset;
-             /* No need to skip on the first run, or a non-visible one */
-             _layout_text_append(c, fmt, n, start, off, o->repch);
-             _layout_do_format(obj, c, &fmt, fnode, &style_pad_l, &style_pad_r, &style_pad_t, &style_pad_b);
-             if ((c->have_underline2) || (c->have_underline))
-               {
-                  if (style_pad_b < c->underline_extend)
-                    style_pad_b = c->underline_extend;
-                  c->have_underline = 0;
-                  c->have_underline2 = 0;
-                  c->underline_extend = 0;
-               }
-             start += off;
-             if (fnode->visible)
-               {
-                  off = -1;
-                  start++;
-               }
-             else
-               {
-                  off = 0;
-               }
-             fnode = _NODE_FORMAT(EINA_INLIST_GET(fnode)->next);
-          }
-        _layout_text_append(c, fmt, n, start, -1, o->repch);
+        _layout_paragraph_text(c, n, &fmt);
+        /* the last paragraph is finished once its last line is */
+        if (EINA_INLIST_GET(n)->next) _layout_paragraph_finish(c);
+     }
+   if (c->ln)
+     {
+        /* Advance the line so it'll calculate the size */
+        if ((c->ln->items || c->ln->format_items) && (fmt))
+          _layout_line_advance(c, fmt);
+        _layout_paragraph_finish(c);
      }
-   /* Advance the line so it'll calculate the size */
-   if ((c->ln) && (c->ln->items || c->ln->format_items) && (fmt))
-     _layout_line_advance(c, fmt);
 
    /* Clean the rest of the format stack */
    while (c->format_stack)
@@ -2937,25 +3458,29 @@ _layout(const Evas_Object *obj, int calc_only, int w, int h, int *w_ret, int *h_
         c->format_stack = eina_list_remove_list(c->format_stack, c->format_stack);
         _format_unref_free(c->obj, fmt);
      }
-   EINA_INLIST_FOREACH(c->par->lines, ln)
+   if (c->old_paragraphs) _paragraphs_clear(obj, c->old_paragraphs);
+   c->old_paragraphs = NULL;
+
+   EINA_INLIST_FOREACH(c->paragraphs, par)
      {
-        if (ln->line_no == -1)
+        if (par->w > c->wmax) c->wmax = par->w;
+        if (par->style_pad.l > style_pad_l) style_pad_l = par->style_pad.l;
+        if (par->style_pad.r > style_pad_r) style_pad_r = par->style_pad.r;
+        if (par->style_pad.t > style_pad_t) style_pad_t = par->style_pad.t;
+        if (par->style_pad.b > style_pad_b) style_pad_b = par->style_pad.b;
+        if (!par->lines)
           {
-             removes = eina_list_append(removes, ln);
-          }
-        else
-          {
-             if ((ln->y + ln->h) > c->hmax) c->hmax = ln->y + ln->h;
+             if ((par->y + par->h) > c->hmax) c->hmax = par->y + par->h;
+             continue;
           }
+        ln = (Evas_Object_Textblock_Line *)EINA_INLIST_GET(par->lines)->last;
+        if ((ln->y + ln->h) > c->hmax) c->hmax = ln->y + ln->h;
      }
-   /* Remove the lines we marked for removal, mostly lines added after
-    * just to force calculation of line sizes */
-   while (removes)
+
+   if (c->est_chars > 0)
      {
-        ln = removes->data;
-        c->par->lines = (Evas_Object_Textblock_Line *)eina_inlist_remove(EINA_INLIST_GET(c->par->lines), EINA_INLIST_GET(ln));
-        removes = eina_list_remove_list(removes, removes);
-        _line_free(obj, ln);
+        o->viewport.char_w = c->est_w / c->est_chars;
+        if (o->viewport.char_w < 1) o->viewport.char_w = 1;
      }
 
    if (w_ret) *w_ret = c->wmax;
@@ -2963,16 +3488,14 @@ _layout(const Evas_Object *obj, int calc_only, int w, int h, int *w_ret, int *h_
    if ((o->style_pad.l != style_pad_l) || (o->style_pad.r != style_pad_r) ||
          (o->style_pad.t != style_pad_t) || (o->style_pad.b != style_pad_b))
      {
-        Evas_Object_Textblock_Line *lines;
-
-        lines = c->par->lines;
-        c->par->lines = NULL;
         o->style_pad.l = style_pad_l;
         o->style_pad.r = style_pad_r;
         o->style_pad.t = style_pad_t;
         o->style_pad.b = style_pad_b;
-        _layout(obj, calc_only, w, h, w_ret, h_ret);
         _paragraphs_clear(obj, c->paragraphs);
+        /* the kept layout was made with the old padding */
+        if (calc_only) _evas_textblock_nodes_dirty_all(o);
+        _layout(obj, calc_only, w, h, w_ret, h_ret);
         return;
      }
    if (!calc_only)
@@ -2993,11 +3516,8 @@ static void
 _relayout(const Evas_Object *obj)
 {
    Evas_Object_Textblock *o;
-   Evas_Object_Textblock_Paragraph *paragraphs;
 
    o = (Evas_Object_Textblock *)(obj->object_data);
-   paragraphs = o->paragraphs;
-   o->paragraphs = NULL;
    o->formatted.valid = 0;
    o->native.valid = 0;
    _layout(obj,
@@ -3005,12 +3525,148 @@ _relayout(const Evas_Object *obj)
          obj->cur.geometry.w, obj->cur.geometry.h,
          &o->formatted.w, &o->formatted.h);
    o->formatted.valid = 1;
-   if (paragraphs) _paragraphs_clear(obj, paragraphs);
    o->last_w = obj->cur.geometry.w;
+   o->last_h = obj->cur.geometry.h;
    o->changed = 0;
    o->redraw = 1;
 }
 
+/**
+ * @internal
+ * Lay out an estimated paragraph for real, and keep it laid out from now
+ * on. Only that paragraph is laid out, it is replaced by the new one and
+ * the paragraphs after it are moved by how much its size was off. So par
+ * is gone, the other paragraphs and their lines stay.
+ *
+ * @param obj the evas object - NOT NULL.
+ * @param par the paragraph - NOT NULL.
+ * @return EINA_TRUE if the layout changed, EINA_FALSE otherwise.
+ */
+static Eina_Bool
+_layout_paragraph_realize(const Evas_Object *obj, Evas_Object_Textblock_Paragraph *par)
+{
+   Evas_Object_Textblock *o;
+   Evas_Object_Textblock_Paragraph *npar, *p;
+   Evas_Object_Textblock_Line *ln;
+   Evas_Object_Textblock_Format *fmt;
+   Evas_Object_Textblock_Node_Text *n;
+   Ctxt ctxt, *c;
+   int dy, dno, wmax = 0, hmax = 0;
+
+   if ((!par->estimated) || (!par->text_node)) return EINA_FALSE;
+   o = (Evas_Object_Textblock *)(obj->object_data);
+   n = par->text_node;
+   n->exact = EINA_TRUE;
+   if (!par->format_stack)
+     {
+        _relayout(obj);
+        return EINA_TRUE;
+     }
+
+   /* pick up the layout where the paragraph starts */
+   c = &ctxt;
+   memset(c, 0, sizeof(Ctxt));
+   c->obj = (Evas_Object *)obj;
+   c->o = o;
+   c->w = o->last_w;
+   c->h = o->last_h;
+   c->align_auto = EINA_TRUE;
+   c->cache = EINA_TRUE;
+   c->y = par->y - o->style_pad.t;
+   c->line_no = par->line_no;
+   c->format_stack = _format_stack_ref(par->format_stack);
+   fmt = c->format_stack->data;
+
+   _layout_paragraph_new(c, n);
+   npar = c->par;
+   _layout_line_new(c, fmt);
+   _layout_paragraph_text(c, n, &fmt);
+   if ((c->ln->items) || (c->ln->format_items))
+     _layout_line_advance(c, fmt);
+   _layout_paragraph_finish(c);
+   _format_stack_unref(c->obj, c->format_stack);
+   if ((!npar->text_node) ||
+       (npar->style_pad.l > o->style_pad.l) ||
+       (npar->style_pad.r > o->style_pad.r) ||
+       (npar->style_pad.t > o->style_pad.t) ||
+       (npar->style_pad.b > o->style_pad.b))
+     {
+        /* doesn't fit in what is laid out around it */
+        if (npar->text_node == n) n->par = par;
+        _paragraph_free(obj, npar);
+        _relayout(obj);
+        return EINA_TRUE;
+     }
+
+   /* swap it in and move the paragraphs after it */
+   o->paragraphs = (Evas_Object_Textblock_Paragraph *)eina_inlist_prepend_relative(EINA_INLIST_GET(o->paragraphs), EINA_INLIST_GET(npar), EINA_INLIST_GET(par));
+   o->paragraphs = (Evas_Object_Textblock_Paragraph *)eina_inlist_remove(EINA_INLIST_GET(o->paragraphs), EINA_INLIST_GET(par));
+   dy = npar->h - par->h;
+   if (npar->lines)
+     {
+        ln = (Evas_Object_Textblock_Line *)EINA_INLIST_GET(npar->lines)->last;
+        dno = ln->line_no + 1;
+     }
+   else
+     dno = npar->line_no;
+   dno -= par->line_no + par->lines_num;
+   _paragraph_free(obj, par);
+   for (p = (Evas_Object_Textblock_Paragraph *)EINA_INLIST_GET(npar)->next;
+        (p) && ((dy) || (dno));
+        p = (Evas_Object_Textblock_Paragraph *)EINA_INLIST_GET(p)->next)
+     {
+        EINA_INLIST_FOREACH(p->lines, ln)
+          {
+             ln->y += dy;
+             ln->line_no += dno;
+          }
+        p->y += dy;
+        p->line_no += dno;
+     }
+
+   EINA_INLIST_FOREACH(o->paragraphs, p)
+     {
+        if (p->w > wmax) wmax = p->w;
+        if (!p->lines)
+          {
+             if ((p->y + p->h) > hmax) hmax = p->y + p->h;
+             continue;
+          }
+        ln = (Evas_Object_Textblock_Line *)EINA_INLIST_GET(p->lines)->last;
+        if ((ln->y + ln->h) > hmax) hmax = ln->y + ln->h;
+     }
+   o->formatted.w = wmax;
+   o->formatted.h = hmax;
+   o->redraw = 1;
+   return EINA_TRUE;
+}
+
+/**
+ * @internal
+ * Find the first paragraph that ends below y, laying it out if it was
+ * only estimated.
+ *
+ * @param obj the evas object - NOT NULL.
+ * @param y the y coord, in layout coordinates.
+ * @return the paragraph found or NULL if none.
+ */
+static Evas_Object_Textblock_Paragraph *
+_find_layout_paragraph_y(const Evas_Object *obj, int y)
+{
+   Evas_Object_Textblock_Paragraph *par;
+   Evas_Object_Textblock *o;
+
+   o = (Evas_Object_Textblock *)(obj->object_data);
+again:
+   EINA_INLIST_FOREACH(o->paragraphs, par)
+     {
+        if ((par->y + par->h) <= y) continue;
+        if (_layout_paragraph_realize(obj, par)) goto again;
+        return par;
+     }
+   return NULL;
+}
+
 /**
  * @internal
  * Find the layout item and line that match the text node and position passed.
@@ -3025,37 +3681,44 @@ _relayout(const Evas_Object *obj)
 static void
 _find_layout_item_line_match(Evas_Object *obj, Evas_Object_Textblock_Node_Text *n, int pos, Evas_Object_Textblock_Line **lnr, Evas_Object_Textblock_Item **itr)
 {
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
    Evas_Object_Textblock *o;
 
    o = (Evas_Object_Textblock *)(obj->object_data);
    if (!o->formatted.valid) _relayout(obj);
-   EINA_INLIST_FOREACH(o->paragraphs->lines, ln)
+   if (n->par) _layout_paragraph_realize(obj, n->par);
+   /* the paragraph of the node holds all of its items */
+   par = n->par;
+   if (!par) par = o->paragraphs;
+   for ( ; par ; par = (Evas_Object_Textblock_Paragraph *)(EINA_INLIST_GET(par))->next)
      {
-        Evas_Object_Textblock_Item *it;
-        Evas_Object_Textblock_Line *lnn;
-
-        lnn = (Evas_Object_Textblock_Line *)(((Eina_Inlist *)ln)->next);
-        EINA_INLIST_FOREACH(ln->items, it)
+        EINA_INLIST_FOREACH(par->lines, ln)
           {
-             if (it->source_node == n)
-               {
-                  int p;
+             Evas_Object_Textblock_Item *it;
 
-                  p = (int)(it->source_pos + eina_unicode_strlen(it->text));
-                  if (((pos >= (int) it->source_pos) && (pos < p)))
-                    {
-                       *lnr = ln;
-                       *itr = it;
-                       return;
-                    }
-                  else if (p == pos)
+             EINA_INLIST_FOREACH(ln->items, it)
+               {
+                  if (it->source_node == n)
                     {
-                       *lnr = ln;
-                       *itr = it;
+                       int p;
+
+                       p = (int)(it->source_pos + eina_unicode_strlen(it->text));
+                       if (((pos >= (int) it->source_pos) && (pos < p)))
+                         {
+                            *lnr = ln;
+                            *itr = it;
+                            return;
+                         }
+                       else if (p == pos)
+                         {
+                            *lnr = ln;
+                            *itr = it;
+                         }
                     }
                }
           }
+        if (par == n->par) return;
      }
 }
 
@@ -3072,22 +3735,31 @@ _find_layout_item_line_match(Evas_Object *obj, Evas_Object_Textblock_Node_Text *
 static void
 _find_layout_format_item_line_match(Evas_Object *obj, Evas_Object_Textblock_Node_Format *n, Evas_Object_Textblock_Line **lnr, Evas_Object_Textblock_Format_Item **fir)
 {
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
    Evas_Object_Textblock *o;
 
    o = (Evas_Object_Textblock *)(obj->object_data);
    if (!o->formatted.valid) _relayout(obj);
-   EINA_INLIST_FOREACH(o->paragraphs->lines, ln)
+   par = NULL;
+   if (n->text_node) par = n->text_node->par;
+   if ((par) && (_layout_paragraph_realize(obj, par)))
+     par = n->text_node->par;
+   if (!par) par = o->paragraphs;
+   for ( ; par ; par = (Evas_Object_Textblock_Paragraph *)(EINA_INLIST_GET(par))->next)
      {
-        Evas_Object_Textblock_Format_Item *fi;
-
-        EINA_INLIST_FOREACH(ln->format_items, fi)
+        EINA_INLIST_FOREACH(par->lines, ln)
           {
-             if (fi->source_node == n)
+             Evas_Object_Textblock_Format_Item *fi;
+
+             EINA_INLIST_FOREACH(ln->format_items, fi)
                {
-                  *lnr = ln;
-                  *fir = fi;
-                  return;
+                  if (fi->source_node == n)
+                    {
+                       *lnr = ln;
+                       *fir = fi;
+                       return;
+                    }
                }
           }
      }
@@ -3104,13 +3776,27 @@ _find_layout_format_item_line_match(Evas_Object *obj, Evas_Object_Textblock_Node
 static Evas_Object_Textblock_Line *
 _find_layout_line_num(const Evas_Object *obj, int line)
 {
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
    Evas_Object_Textblock *o;
 
    o = (Evas_Object_Textblock *)(obj->object_data);
-   EINA_INLIST_FOREACH(o->paragraphs->lines, ln)
+again:
+   EINA_INLIST_FOREACH(o->paragraphs, par)
      {
-        if (ln->line_no == line) return ln;
+        if (par->estimated)
+          {
+             if (line >= (par->line_no + par->lines_num)) continue;
+             if (_layout_paragraph_realize(obj, par)) goto again;
+             return NULL;
+          }
+        if (!par->lines) continue;
+        ln = (Evas_Object_Textblock_Line *)(EINA_INLIST_GET(par->lines))->last;
+        if (ln->line_no < line) continue;
+        EINA_INLIST_FOREACH(par->lines, ln)
+          {
+             if (ln->line_no == line) return ln;
+          }
      }
    return NULL;
 }
@@ -3382,9 +4068,49 @@ evas_object_textblock_replace_char_set(Evas_Object *obj, const char *ch)
    if (o->repch) eina_stringshare_del(o->repch);
    if (ch) o->repch = eina_stringshare_add(ch);
    else o->repch = NULL;
+   _evas_textblock_nodes_dirty_all(o);
     _evas_textblock_changed(o, obj);
 }
 
+/**
+ * @brief Set whether the textblock lays out only what is around its viewport.
+ *
+ * With a virtual layout only the paragraphs that are visible through the
+ * object's clip, and a page above and below them, are laid out. The size
+ * of all the others is guessed from their length and font, and they are
+ * laid out for real once they scroll into view or something asks about
+ * their lines or characters, e.g evas_textblock_cursor_line_set(). This
+ * makes showing huge documents fast, at the price of the formatted size
+ * being an estimate until all of the text was laid out.
+ *
+ * @param obj The given textblock object.
+ * @param virt EINA_TRUE to lay out virtually, EINA_FALSE to lay out all.
+ */
+EAPI void
+evas_object_textblock_virtual_set(Evas_Object *obj, Eina_Bool virt)
+{
+   TB_HEAD();
+   virt = !!virt;
+   if (o->virt == virt) return;
+   o->virt = virt;
+   _evas_textblock_changed(o, obj);
+}
+
+/**
+ * @brief Get whether the textblock lays out only what is around its
+ * viewport.
+ *
+ * @param obj The given textblock object.
+ * @return EINA_TRUE if the layout is virtual, EINA_FALSE otherwise.
+ * @see evas_object_textblock_virtual_set()
+ */
+EAPI Eina_Bool
+evas_object_textblock_virtual_get(const Evas_Object *obj)
+{
+   TB_HEAD_RETURN(EINA_FALSE);
+   return o->virt;
+}
+
 /**
  * @brief Get the "replacement character" for given textblock object. Returns
  * NULL if no replacement character is in use.
@@ -3937,6 +4663,7 @@ _evas_textblock_nodes_merge(Evas_Object_Textblock *o, Evas_Object_Textblock_Node
    text = eina_ustrbuf_string_get(from->unicode);
    len = eina_ustrbuf_length_get(from->unicode);
    eina_ustrbuf_append_length(to->unicode, text, len);
+   to->dirty = EINA_TRUE;
 
    itr = from->format_node;
    if (itr && (itr->text_node == from))
@@ -4823,10 +5550,18 @@ evas_textblock_cursor_line_char_last(Evas_Textblock_Cursor *cur)
      {
 	cur->node = fi->source_node->text_node;
 	cur->pos = _evas_textblock_node_format_pos_get(fi->source_node);
-        /* If it's the last line, advance to the null */
-        if (!EINA_INLIST_GET(ln)->next)
+        /* If it's the last line, advance to the null. lines are per
+         * paragraph, so it has to be the last one of the last paragraph */
+        if ((!EINA_INLIST_GET(ln)->next) && (o->paragraphs))
           {
-             cur->pos++;
+             Evas_Object_Textblock_Paragraph *par;
+
+             par = (Evas_Object_Textblock_Paragraph *)
+                (EINA_INLIST_GET(o->paragraphs))->last;
+             if ((par->lines) &&
+                 (ln == (Evas_Object_Textblock_Line *)
+                  (EINA_INLIST_GET(par->lines))->last))
+               cur->pos++;
           }
      }
 }
@@ -4999,6 +5734,7 @@ _evas_textblock_node_format_adjust_offset(Evas_Object_Textblock *o,
 static void
 _evas_textblock_node_format_remove(Evas_Object_Textblock *o, Evas_Object_Textblock_Node_Format *n, int visible_adjustment)
 {
+   if (n->text_node) n->text_node->dirty = EINA_TRUE;
    /* Update the text nodes about the change */
      {
         Evas_Object_Textblock_Node_Format *nnode;
@@ -5451,6 +6187,7 @@ static void
 _evas_textblock_node_text_free(Evas_Object_Textblock_Node_Text *n)
 {
    if (!n) return;
+   if (n->par) n->par->text_node = NULL;
    eina_ustrbuf_free(n->unicode);
    if (n->utf8)
      free(n->utf8);
@@ -5474,6 +6211,7 @@ _evas_textblock_node_text_new(void)
 
    n = calloc(1, sizeof(Evas_Object_Textblock_Node_Text));
    n->unicode = eina_ustrbuf_new();
+   n->dirty = EINA_TRUE;
 #ifdef BIDI_SUPPORT
    n->bidi_props = evas_bidi_paragraph_props_new();
    n->bidi_props->direction = EVAS_BIDI_PARAGRAPH_NATURAL;
@@ -5534,6 +6272,7 @@ _evas_textblock_cursor_break_paragraph(Evas_Textblock_Cursor *cur,
              n->format_node = fnode;
           }
 
+        cur->node->dirty = EINA_TRUE;
         /* cur->pos now points to the PS, move after. */
         start = cur->pos + 1;
         text = eina_ustrbuf_string_get(cur->node->unicode);
@@ -5654,6 +6393,22 @@ _evas_textblock_cursors_update_offset(const Evas_Textblock_Cursor *cur,
  * @param o the textblock object.
  * @param obj the evas object.
  */
+/**
+ * @internal
+ * Mark all the text nodes as changed, so nothing of the current layout is
+ * reused. For changes that affect every paragraph.
+ *
+ * @param o the textblock object.
+ */
+static void
+_evas_textblock_nodes_dirty_all(Evas_Object_Textblock *o)
+{
+   Evas_Object_Textblock_Node_Text *n;
+
+   EINA_INLIST_FOREACH(o->text_nodes, n)
+      n->dirty = EINA_TRUE;
+}
+
 static void
 _evas_textblock_changed(Evas_Object_Textblock *o, Evas_Object *obj)
 {
@@ -5732,6 +6487,7 @@ evas_textblock_cursor_text_append(Evas_Textblock_Cursor *cur, const char *_text)
      }
 
    eina_ustrbuf_insert_length(n->unicode, text, len, cur->pos);
+   n->dirty = EINA_TRUE;
    /* Advance the formats */
    if (fnode && (fnode->text_node == cur->node))
      fnode->offset += len;
@@ -5920,6 +6676,7 @@ evas_textblock_cursor_format_append(Evas_Textblock_Cursor *cur, const char *form
              cur->node->format_node = n;
           }
      }
+   if (n->text_node) n->text_node->dirty = EINA_TRUE;
    if (is_visible)
      {
         eina_ustrbuf_insert_char(cur->node->unicode,
@@ -6032,6 +6789,7 @@ evas_textblock_cursor_char_delete(Evas_Textblock_Cursor *cur)
         _evas_textblock_node_format_remove_matching(o, fmt);
      }
    eina_ustrbuf_remove(n->unicode, cur->pos, index);
+   n->dirty = EINA_TRUE;
    /* If it was a paragraph separator, we should merge the current with the
     * next, there must be a next. */
    if (merge_nodes)
@@ -6085,6 +6843,8 @@ evas_textblock_cursor_range_delete(Evas_Textblock_Cursor *cur1, Evas_Textblock_C
      }
    n1 = cur1->node;
    n2 = cur2->node;
+   n1->dirty = EINA_TRUE;
+   n2->dirty = EINA_TRUE;
    if ((evas_textblock_cursor_compare(o->cursor, cur1) >= 0) &&
          (evas_textblock_cursor_compare(cur2, o->cursor) >= 0))
      {
@@ -6675,7 +7435,9 @@ evas_textblock_cursor_line_geometry_get(const Evas_Textblock_Cursor *cur, Evas_C
    if (!o->formatted.valid) _relayout(cur->obj);
    if (!cur->node)
      {
-        ln = o->paragraphs->lines;
+        /* the first paragraph may only be estimated, lay it out */
+        if (o->paragraphs) _layout_paragraph_realize(cur->obj, o->paragraphs);
+        if (o->paragraphs) ln = o->paragraphs->lines;
      }
    else
      {
@@ -6731,6 +7493,7 @@ EAPI Eina_Bool
 evas_textblock_cursor_char_coord_set(Evas_Textblock_Cursor *cur, Evas_Coord x, Evas_Coord y)
 {
    Evas_Object_Textblock *o;
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
    Evas_Object_Textblock_Item *it = NULL, *it_break = NULL;
    Evas_Object_Textblock_Format_Item *fi = NULL;
@@ -6740,66 +7503,70 @@ evas_textblock_cursor_char_coord_set(Evas_Textblock_Cursor *cur, Evas_Coord x, E
    if (!o->formatted.valid) _relayout(cur->obj);
    x += o->style_pad.l;
    y += o->style_pad.t;
-   EINA_INLIST_FOREACH(o->paragraphs->lines, ln)
+   for (par = _find_layout_paragraph_y(cur->obj, y) ; par ;
+         par = (Evas_Object_Textblock_Paragraph *)(EINA_INLIST_GET(par))->next)
      {
-	if (ln->y > y) break;
-	if ((ln->y <= y) && ((ln->y + ln->h) > y))
-	  {
-	     EINA_INLIST_FOREACH(ln->items, it)
-	       {
-		  if ((it->x + ln->x) > x)
-		    {
-		       it_break = it;
-		       break;
-		    }
-		  if (((it->x + ln->x) <= x) && (((it->x + ln->x) + it->w) > x))
-		    {
-		       int pos;
-		       int cx, cy, cw, ch;
-
-		       pos = -1;
-		       if (it->format->font.font)
-                         pos = cur->ENFN->font_char_at_coords_get(cur->ENDT,
-                               it->format->font.font,
-                               it->text, &it->bidi_props,
-                               x - it->x - ln->x, 0,
-                               &cx, &cy, &cw, &ch);
-		       if (pos < 0)
-			 return EINA_FALSE;
-		       cur->pos = pos + it->source_pos;
-		       cur->node = it->source_node;
-		       return 1;
-		    }
-	       }
-	     EINA_INLIST_FOREACH(ln->format_items, fi)
-	       {
-		  if ((fi->x + ln->x) > x) break;
-		  if (((fi->x + ln->x) <= x) && (((fi->x + ln->x) + fi->w) > x))
-		    {
-                       cur->pos =
-                          _evas_textblock_node_format_pos_get(fi->source_node);
-
-		       cur->node = fi->source_node->text_node;
-		       return EINA_TRUE;
-		    }
-	       }
-	     if (it_break)
-	       {
-		  it = it_break;
-		  cur->node = it->source_node;
-		  cur->pos = it->source_pos;
-
-                  /*FIXME: needs smarter handling, ATM just check, if it's
-                   * the first item, then go to the end of the line, helps
-                   * with rtl langs, doesn't affect ltr langs that much. */
-                  if (!EINA_INLIST_GET(it)->prev)
+        EINA_INLIST_FOREACH(par->lines, ln)
+          {
+             if (ln->y > y) return EINA_FALSE;
+             if ((ln->y <= y) && ((ln->y + ln->h) > y))
+               {
+                  EINA_INLIST_FOREACH(ln->items, it)
+                    {
+                       if ((it->x + ln->x) > x)
+                         {
+                            it_break = it;
+                            break;
+                         }
+                       if (((it->x + ln->x) <= x) && (((it->x + ln->x) + it->w) > x))
+                         {
+                            int pos;
+                            int cx, cy, cw, ch;
+
+                            pos = -1;
+                            if (it->format->font.font)
+                              pos = cur->ENFN->font_char_at_coords_get(cur->ENDT,
+                                    it->format->font.font,
+                                    it->text, &it->bidi_props,
+                                    x - it->x - ln->x, 0,
+                                    &cx, &cy, &cw, &ch);
+                            if (pos < 0)
+                              return EINA_FALSE;
+                            cur->pos = pos + it->source_pos;
+                            cur->node = it->source_node;
+                            return 1;
+                         }
+                    }
+                  EINA_INLIST_FOREACH(ln->format_items, fi)
                     {
-                       evas_textblock_cursor_line_char_last(cur);
+                       if ((fi->x + ln->x) > x) break;
+                       if (((fi->x + ln->x) <= x) && (((fi->x + ln->x) + fi->w) > x))
+                         {
+                            cur->pos =
+                               _evas_textblock_node_format_pos_get(fi->source_node);
+
+                            cur->node = fi->source_node->text_node;
+                            return EINA_TRUE;
+                         }
                     }
+                  if (it_break)
+                    {
+                       it = it_break;
+                       cur->node = it->source_node;
+                       cur->pos = it->source_pos;
+
+                       /*FIXME: needs smarter handling, ATM just check, if it's
+                        * the first item, then go to the end of the line, helps
+                        * with rtl langs, doesn't affect ltr langs that much. */
+                       if (!EINA_INLIST_GET(it)->prev)
+                         {
+                            evas_textblock_cursor_line_char_last(cur);
+                         }
 
-		  return EINA_TRUE;
-	       }
-	  }
+                       return EINA_TRUE;
+                    }
+               }
+          }
      }
    return EINA_FALSE;
 }
@@ -6815,20 +7582,25 @@ EAPI int
 evas_textblock_cursor_line_coord_set(Evas_Textblock_Cursor *cur, Evas_Coord y)
 {
    Evas_Object_Textblock *o;
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
 
    if (!cur) return -1;
    o = (Evas_Object_Textblock *)(cur->obj->object_data);
    if (!o->formatted.valid) _relayout(cur->obj);
    y += o->style_pad.t;
-   EINA_INLIST_FOREACH(o->paragraphs->lines, ln)
+   for (par = _find_layout_paragraph_y(cur->obj, y) ; par ;
+         par = (Evas_Object_Textblock_Paragraph *)(EINA_INLIST_GET(par))->next)
      {
-	if (ln->y > y) break;
-	if ((ln->y <= y) && ((ln->y + ln->h) > y))
-	  {
-	     evas_textblock_cursor_line_set(cur, ln->line_no);
-	     return ln->line_no;
-	  }
+        EINA_INLIST_FOREACH(par->lines, ln)
+          {
+             if (ln->y > y) return -1;
+             if ((ln->y <= y) && ((ln->y + ln->h) > y))
+               {
+                  evas_textblock_cursor_line_set(cur, ln->line_no);
+                  return ln->line_no;
+               }
+          }
      }
    return -1;
 }
@@ -7206,6 +7978,7 @@ evas_object_textblock_free(Evas_Object *obj)
 static void
 evas_object_textblock_render(Evas_Object *obj, void *output, void *context, void *surface, int x, int y)
 {
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
    Evas_Object_Textblock *o;
    int i, j;
@@ -7237,37 +8010,47 @@ evas_object_textblock_render(Evas_Object *obj, void *output, void *context, void
    if (!o->paragraphs) return;
 
 #define ITEM_WALK() \
-   EINA_INLIST_FOREACH(o->paragraphs->lines, ln) \
+   EINA_INLIST_FOREACH(o->paragraphs, par) \
      { \
-        Evas_Object_Textblock_Item *it; \
-        \
-        pback = 0; \
-        pline = 0; \
-        pline2 = 0; \
-        pstrike = 0; \
         if (clip) \
           { \
-             if ((obj->cur.geometry.y + y + ln->y + ln->h) < (cy - 20)) \
+             if ((obj->cur.geometry.y + y + par->y + par->h) < (cy - 20)) \
              continue; \
-             if ((obj->cur.geometry.y + y + ln->y) > (cy + ch + 20)) \
+             if ((obj->cur.geometry.y + y + par->y) > (cy + ch + 20)) \
              break; \
           } \
-        EINA_INLIST_FOREACH(ln->items, it) \
+        EINA_INLIST_FOREACH(par->lines, ln) \
           { \
-             int yoff; \
+             Evas_Object_Textblock_Item *it; \
              \
-             yoff = ln->baseline; \
-             if (it->format->valign != -1.0) \
-             yoff = (it->format->valign * (double)(ln->h - it->h)) + it->baseline; \
+             pback = 0; \
+             pline = 0; \
+             pline2 = 0; \
+             pstrike = 0; \
              if (clip) \
                { \
-                  if ((obj->cur.geometry.x + x + ln->x + it->x + it->w) < (cx - 20)) \
+                  if ((obj->cur.geometry.y + y + ln->y + ln->h) < (cy - 20)) \
                   continue; \
-                  if ((obj->cur.geometry.x + x + ln->x + it->x) > (cx + cw + 20)) \
+                  if ((obj->cur.geometry.y + y + ln->y) > (cy + ch + 20)) \
                   break; \
-               }
+               } \
+             EINA_INLIST_FOREACH(ln->items, it) \
+               { \
+                  int yoff; \
+                  \
+                  yoff = ln->baseline; \
+                  if (it->format->valign != -1.0) \
+                  yoff = (it->format->valign * (double)(ln->h - it->h)) + it->baseline; \
+                  if (clip) \
+                    { \
+                       if ((obj->cur.geometry.x + x + ln->x + it->x + it->w) < (cx - 20)) \
+                       continue; \
+                       if ((obj->cur.geometry.x + x + ln->x + it->x) > (cx + cw + 20)) \
+                       break; \
+                    }
 
 #define ITEM_WALK_END() \
+               } \
           } \
      }
 #define COLOR_SET(col) \
@@ -7631,6 +8414,21 @@ evas_object_textblock_render(Evas_Object *obj, void *output, void *context, void
    ITEM_WALK_END();
 }
 
+/**
+ * @internal
+ * Check if all that is visible of a virtual layout was laid out exactly.
+ */
+static Eina_Bool
+_layout_viewport_covered(const Evas_Object *obj)
+{
+   Evas_Object_Textblock *o;
+   int y0, y1;
+
+   o = (Evas_Object_Textblock *)(obj->object_data);
+   if (!_layout_viewport_get(obj, &y0, &y1)) return EINA_TRUE;
+   return ((y0 >= o->viewport.y0) && (y1 <= o->viewport.y1));
+}
+
 static void
 evas_object_textblock_render_pre(Evas_Object *obj)
 {
@@ -7647,12 +8445,9 @@ evas_object_textblock_render_pre(Evas_Object *obj)
    /* if so what and where and add the appropriate redraw textblocks */
    o = (Evas_Object_Textblock *)(obj->object_data);
    if ((o->changed) ||
-       (o->last_w != obj->cur.geometry.w))
+       (o->last_w != obj->cur.geometry.w) ||
+       ((o->virt) && (!_layout_viewport_covered(obj))))
      {
-	Evas_Object_Textblock_Paragraph *paragraphs;
-
-	paragraphs = o->paragraphs;
-	o->paragraphs = NULL;
 	o->formatted.valid = 0;
 	o->native.valid = 0;
 	_layout(obj,
@@ -7660,11 +8455,8 @@ evas_object_textblock_render_pre(Evas_Object *obj)
 		obj->cur.geometry.w, obj->cur.geometry.h,
 		&o->formatted.w, &o->formatted.h);
 	o->formatted.valid = 1;
-        if (paragraphs)
-          {
-             _paragraphs_clear(obj, paragraphs);
-          }
 	o->last_w = obj->cur.geometry.w;
+	o->last_h = obj->cur.geometry.h;
 	o->redraw = 0;
 	evas_object_render_pre_prev_cur_add(&obj->layer->evas->clip_changes, obj);
 	o->changed = 0;
@@ -7819,6 +8611,11 @@ evas_object_textblock_coords_recalc(Evas_Object *obj)
 static void
 evas_object_textblock_scale_update(Evas_Object *obj)
 {
+   Evas_Object_Textblock *o;
+
+   o = (Evas_Object_Textblock *)(obj->object_data);
+   /* all the fonts are loaded again at the new scale */
+   _evas_textblock_nodes_dirty_all(o);
    _relayout(obj);
 }
 
@@ -7826,26 +8623,32 @@ void
 _evas_object_textblock_rehint(Evas_Object *obj)
 {
    Evas_Object_Textblock *o;
+   Evas_Object_Textblock_Paragraph *par;
    Evas_Object_Textblock_Line *ln;
 
    o = (Evas_Object_Textblock *)(obj->object_data);
-   EINA_INLIST_FOREACH(o->paragraphs->lines, ln)
+   EINA_INLIST_FOREACH(o->paragraphs, par)
      {
-	Evas_Object_Textblock_Item *it;
+        EINA_INLIST_FOREACH(par->lines, ln)
+          {
+             Evas_Object_Textblock_Item *it;
 
-	EINA_INLIST_FOREACH(ln->items, it)
-	  {
-	     if (it->format->font.font)
-            {  
+             EINA_INLIST_FOREACH(ln->items, it)
+               {
+                  if (it->format->font.font)
+                    {
 #ifdef EVAS_FRAME_QUEUING
-               evas_common_pipe_op_text_flush(it->format->font.font);
+                       evas_common_pipe_op_text_flush(it->format->font.font);
 #endif
-	          evas_font_load_hinting_set(obj->layer->evas,
-			   		  it->format->font.font,
-					  obj->layer->evas->hinting);
-	       }
-	  }
+                       evas_font_load_hinting_set(obj->layer->evas,
+                             it->format->font.font,
+                             obj->layer->evas->hinting);
+                    }
+               }
+          }
      }
+   /* hinting changes the metrics of every glyph */
+   _evas_textblock_nodes_dirty_all(o);
    o->formatted.valid = 0;
    o->native.valid = 0;
    o->changed = 1;
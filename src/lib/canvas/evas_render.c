@@ -74,6 +74,47 @@ evas_damage_rectangle_add(Evas *e, int x, int y, int w, int h)
    e->changed = 1;
 }
 
+/**
+ * Add a scrolled region.
+ *
+ * @param e The given canvas pointer.
+ * @param x The region's left position.
+ * @param y The region's top position.
+ * @param w The region's width.
+ * @param h The region's height.
+ * @param dx How far the content moved to the right.
+ * @param dy How far the content moved down.
+ *
+ * This tells evas that everything shown inside the region moved by
+ * (@p dx, @p dy) since the last render, as when a view is scrolled, and
+ * that nothing else inside it changed. Engines that keep the previous
+ * frame around then copy what is still visible and only draw what
+ * scrolled in; the others redraw as usual. Objects in the region that
+ * changed without moving along are still redrawn, but anything drawn
+ * there that neither moved nor changed, like an unchanged overlay on top
+ * of it, has to be reported with evas_damage_rectangle_add().
+ *
+ * @see evas_damage_rectangle_add().
+ *
+ * @ingroup Evas_Canvas
+ */
+EAPI void
+evas_scroll_rectangle_add(Evas *e, int x, int y, int w, int h, int dx, int dy)
+{
+   Evas_Scroll *sc;
+
+   MAGIC_CHECK(e, Evas, MAGIC_EVAS);
+   return;
+   MAGIC_CHECK_END();
+   if ((w <= 0) || (h <= 0) || ((dx == 0) && (dy == 0))) return;
+   sc = malloc(sizeof(Evas_Scroll));
+   if (!sc) return;
+   sc->x = x; sc->y = y; sc->w = w; sc->h = h;
+   sc->dx = dx; sc->dy = dy;
+   e->scrolls = eina_list_append(e->scrolls, sc);
+   e->changed = 1;
+}
+
 /**
  * Add an obscured region.
  *
@@ -183,6 +224,126 @@ _evas_render_cur_clip_cache_del(Evas *e, Evas_Object *obj)
                                            obj->cur.cache.clip.h);
 }
 
+static void
+_evas_render_scroll_rect_add(Evas *e, Evas_Scroll *sc,
+                             int x, int y, int w, int h)
+{
+   RECTS_CLIP_TO_RECT(x, y, w, h, sc->x, sc->y, sc->w, sc->h);
+   if ((w <= 0) || (h <= 0)) return;
+   e->engine.func->output_redraws_rect_add(e->engine.data.output, x, y, w, h);
+}
+
+/* the copy of a scroll drops what was queued for redraw in its area.
+ * objects that only moved, and along with it, are fine with the copy, put
+ * back the redraws of every other changed object there */
+static void
+_evas_render_scroll_others_add(Evas *e, Evas_Scroll *sc)
+{
+   unsigned int i;
+
+   for (i = 0; i < e->render_objects.count; i++)
+     {
+        Evas_Object *obj;
+
+        obj = eina_array_data_get(&e->render_objects, i);
+        if (!obj->changed) continue;
+        if ((obj->smart.smart) &&
+            (!_evas_render_has_map(obj)) && (!_evas_render_had_map(obj)))
+          continue;
+        if ((!obj->delete_me) && (obj->changed_move) &&
+            ((obj->cur.geometry.x - obj->prev.geometry.x) == sc->dx) &&
+            ((obj->cur.geometry.y - obj->prev.geometry.y) == sc->dy) &&
+            (obj->cur.geometry.w == obj->prev.geometry.w) &&
+            (obj->cur.geometry.h == obj->prev.geometry.h))
+          continue;
+        _evas_render_scroll_rect_add(e, sc,
+                                     obj->prev.cache.clip.x,
+                                     obj->prev.cache.clip.y,
+                                     obj->prev.cache.clip.w,
+                                     obj->prev.cache.clip.h);
+        _evas_render_scroll_rect_add(e, sc,
+                                     obj->cur.cache.clip.x,
+                                     obj->cur.cache.clip.y,
+                                     obj->cur.cache.clip.w,
+                                     obj->cur.cache.clip.h);
+     }
+}
+
+#ifdef EVAS_RENDER_PRE_THREADS
+/* object types whose render_pre does nothing but look at the object and its
+ * clippers and add rects, so it can go on another thread. image and
+ * textblock talk to the engine and the font code */
+static Eina_Bool
+_evas_render_pre_async_type(Evas_Object *obj)
+{
+   switch (obj->func->type_id_get(obj))
+     {
+      case MAGIC_OBJ_RECTANGLE:
+      case MAGIC_OBJ_LINE:
+      case MAGIC_OBJ_POLYGON:
+      case MAGIC_OBJ_TEXT:
+        return EINA_TRUE;
+      default:
+        return EINA_FALSE;
+     }
+}
+
+static Eina_Bool
+_evas_render_pre_async_ok(Evas_Object *obj)
+{
+   Evas_Object *clipper;
+
+   if ((!obj->changed) || (obj->pre_render_done) || (obj->pre_render_async) ||
+       (obj->smart.smart) || (obj->clip.clipees) ||
+       (_evas_render_has_map(obj)) || (_evas_render_had_map(obj)) ||
+       (!_evas_render_pre_async_type(obj)))
+     return EINA_FALSE;
+   for (clipper = obj->cur.clipper; clipper; clipper = clipper->cur.clipper)
+     {
+        if ((clipper->smart.smart) || (!_evas_render_pre_async_type(clipper)))
+          return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+/* do render_pre of what can be done off this thread before the serial
+ * walk. clip recalculation and the render_pre of the clippers, which are
+ * shared, and the spatial index stay here */
+static Eina_Bool
+_evas_render_phase1_threaded(Evas *e, Eina_Array *render_objects)
+{
+   Eina_Array *objs = &e->pre_render_objects;
+   unsigned int i;
+
+   for (i = 0; i < render_objects->count; i++)
+     {
+        Evas_Object *obj;
+
+        obj = eina_array_data_get(render_objects, i);
+        if (!_evas_render_pre_async_ok(obj)) continue;
+        evas_object_clip_recalc(obj);
+        if (obj->cur.clipper)
+          {
+             if (obj->cur.clipper->cur.cache.clip.dirty)
+               evas_object_clip_recalc(obj->cur.clipper);
+             obj->cur.clipper->func->render_pre(obj->cur.clipper);
+          }
+        obj->pre_render_async = 1;
+        eina_array_push(objs, obj);
+     }
+   if (evas_render_pre_run(objs)) return EINA_TRUE;
+   for (i = 0; i < objs->count; i++)
+     {
+        Evas_Object *obj;
+
+        obj = eina_array_data_get(objs, i);
+        obj->pre_render_async = 0;
+     }
+   eina_array_clean(objs);
+   return EINA_FALSE;
+}
+#endif
+
 static void
 _evas_render_phase1_direct(Evas *e,
                            Eina_Array *active_objects __UNUSED__,
@@ -193,8 +354,15 @@ _evas_render_phase1_direct(Evas *e,
    unsigned int i;
    Eina_List *l;
    Evas_Object *proxy;
+#ifdef EVAS_RENDER_PRE_THREADS
+   Eina_Bool threaded;
+   unsigned int async = 0;
+#endif
 
    RD("  [--- PHASE 1 DIRECT\n");
+#ifdef EVAS_RENDER_PRE_THREADS
+   threaded = _evas_render_phase1_threaded(e, render_objects);
+#endif
    for (i = 0; i < render_objects->count; i++)
      {
 	Evas_Object *obj;
@@ -203,6 +371,14 @@ _evas_render_phase1_direct(Evas *e,
         RD("    OBJ [%p] changed %i\n", obj, obj->changed);
 	if (obj->changed)
           {
+#ifdef EVAS_RENDER_PRE_THREADS
+             /* already pre-rendered, hand its updates over in order */
+             if ((threaded) && (obj->pre_render_async))
+               {
+                  evas_render_pre_redraws_flush(e, obj, async++);
+                  obj->pre_render_async = 0;
+               }
+#endif
              /* Flag need redraw on proxy too */
              evas_object_clip_recalc(obj);
              obj->func->render_pre(obj);
@@ -248,6 +424,13 @@ _evas_render_phase1_direct(Evas *e,
                }
 	  }
      }
+#ifdef EVAS_RENDER_PRE_THREADS
+   if (threaded)
+     {
+        eina_array_clean(&e->pre_render_objects);
+        evas_render_pre_finish();
+     }
+#endif
    RD("  ---]\n");
 }
 
@@ -311,6 +494,7 @@ _evas_render_phase1_object_process(Evas *e, Evas_Object *obj,
              eina_array_push(&e->pending_objects, obj);
              obj->changed = 1;
           }
+        obj->changed_move = 0;
 	obj->restack = 1;
 	clean_them = EINA_TRUE;
      }
@@ -621,6 +805,93 @@ pending_change(void *data, void *gdata __UNUSED__)
    return obj->changed ? EINA_TRUE : EINA_FALSE;
 }
 
+/* map surfaces keep their content from one render to the next, so only
+ * what changed in them is cleared and drawn again. members of a mapped
+ * object are not taken through render_pre and their prev state is stale,
+ * so the damage comes from the members themselves: each one remembers
+ * where it last went in the surface, and a changed one damages that and
+ * where it goes now. an object with a map of its own inside it is taken
+ * as a whole, its own surface is looked after when it is drawn */
+static void
+_evas_render_mapped_rect_get(Evas_Object *obj, int *x, int *y, int *w, int *h)
+{
+   const Evas_Map_Point *p, *p_end;
+   int x1, y1, x2, y2;
+
+   *x = obj->cur.cache.clip.x;
+   *y = obj->cur.cache.clip.y;
+   *w = obj->cur.cache.clip.w;
+   *h = obj->cur.cache.clip.h;
+   if (!obj->cur.map) return;
+   p = obj->cur.map->points;
+   p_end = p + obj->cur.map->count;
+   x1 = x2 = p->x;
+   y1 = y2 = p->y;
+   for (p++; p < p_end; p++)
+     {
+        if (p->x < x1) x1 = p->x;
+        if (p->x > x2) x2 = p->x;
+        if (p->y < y1) y1 = p->y;
+        if (p->y > y2) y2 = p->y;
+     }
+   if ((*w > 0) && (*h > 0))
+     {
+        if (*x < x1) x1 = *x;
+        if (*y < y1) y1 = *y;
+        if ((*x + *w - 1) > x2) x2 = *x + *w - 1;
+        if ((*y + *h - 1) > y2) y2 = *y + *h - 1;
+     }
+   *x = x1;
+   *y = y1;
+   *w = x2 - x1 + 1;
+   *h = y2 - y1 + 1;
+}
+
+/* tb is NULL when the whole surface is redrawn anyway, then only the
+ * member rects are brought up to date */
+static void
+_evas_render_mapped_damage_collect(Evas_Object *obj, Tilebuf *tb,
+                                   int off_x, int off_y)
+{
+   Evas_Object *obj2;
+
+   EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(obj), obj2)
+     {
+        Eina_Bool changed, has_map;
+        int x, y, w, h;
+
+        changed = obj2->changed;
+        has_map = _evas_render_has_map(obj2);
+        // a member with its own map still needs the flag for its surface
+        if (!has_map) obj2->changed = 0;
+        if ((obj2->smart.smart) && (!has_map))
+          {
+             _evas_render_mapped_damage_collect(obj2, tb, off_x, off_y);
+             continue;
+          }
+        if ((tb) && (changed) && (obj2->map_drawn.valid))
+          evas_common_tilebuf_add_redraw(tb,
+                                         obj2->map_drawn.x, obj2->map_drawn.y,
+                                         obj2->map_drawn.w, obj2->map_drawn.h);
+        obj2->map_drawn.valid = 0;
+        evas_object_clip_recalc(obj2);
+        if ((!evas_object_is_visible(obj2)) || (obj2->clip.clipees) ||
+            (obj2->cur.have_clipees))
+          continue;
+        _evas_render_mapped_rect_get(obj2, &x, &y, &w, &h);
+        if ((w <= 0) || (h <= 0)) continue;
+        obj2->map_drawn.x = x + off_x;
+        obj2->map_drawn.y = y + off_y;
+        obj2->map_drawn.w = w;
+        obj2->map_drawn.h = h;
+        obj2->map_drawn.valid = 1;
+        if ((tb) && (changed))
+          evas_common_tilebuf_add_redraw(tb,
+                                         obj2->map_drawn.x, obj2->map_drawn.y,
+                                         obj2->map_drawn.w, obj2->map_drawn.h);
+     }
+}
+
 static Eina_Bool
 evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
                    int off_x, int off_y, int mapped
@@ -665,8 +936,8 @@ evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
      {
         const Evas_Map_Point *p, *p_end;
         RGBA_Map_Point pts[4], *pt;
-        int sw, sh;
-        int changed = 0, rendered = 0;
+        int sw, sh, off_x2, off_y2;
+        int changed = 0, full = 0;
 
 	clean_them = EINA_TRUE;
 
@@ -731,27 +1002,42 @@ evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
                 obj->cur.map->alpha);
              RDI(level);
              RD("        fisrt surf: %ix%i\n", sw, sh);
+             if (obj->cur.map->damage)
+               {
+                  evas_common_tilebuf_free(obj->cur.map->damage);
+                  obj->cur.map->damage = NULL;
+               }
              changed = 1;
           }
+        off_x2 = -obj->cur.geometry.x;
+        off_y2 = -obj->cur.geometry.y;
         if (obj->smart.smart)
           {
              Evas_Object *obj2;
-             
-             EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(obj), obj2)
+
+             if (!obj->cur.map->damage)
                {
-                  if (!evas_object_is_visible(obj2) &&
-                      !evas_object_was_visible(obj2))
-                    {
-                       obj2->changed = 0;
-                       continue;
-                    }
-                  if (obj2->changed)
+                  obj->cur.map->damage = evas_common_tilebuf_new(sw, sh);
+                  if (obj->cur.map->damage)
+                    evas_common_tilebuf_set_tile_size(obj->cur.map->damage,
+                                                      TILESIZE, TILESIZE);
+                  changed = 1;
+                  full = 1;
+               }
+             else
+               {
+                  EINA_INLIST_FOREACH(evas_object_smart_members_get_direct(obj), obj2)
                     {
-                       obj2->changed = 0;
-                       changed = 1;
-                       break;
+                       if (obj2->changed)
+                         {
+                            changed = 1;
+                            break;
+                         }
                     }
                }
+             if (changed)
+               _evas_render_mapped_damage_collect
+                 (obj, full ? NULL : obj->cur.map->damage, off_x2, off_y2);
              obj->changed = 0;
           }
         else
@@ -761,78 +1047,88 @@ evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
                   obj->changed = 0;
                   changed = 1;
                }
+             full = 1;
           }
 
-        // clear surface before re-render
+        // clear and re-render only the damaged parts of the surface
         if ((changed) && (obj->cur.map->surface))
           {
-             int off_x2, off_y2;
-             
+             Tilebuf_Rect whole, *rects, *r;
+
              RDI(level);
              RD("        children redraw\n");
-             // FIXME: calculate "changes" within map surface and only clear
-             // and re-render those
-             if (obj->cur.map->alpha)
+             if ((full) || (!obj->cur.map->damage))
                {
-                  ctx = e->engine.func->context_new(e->engine.data.output);
-                  e->engine.func->context_color_set
-                    (e->engine.data.output, ctx, 0, 0, 0, 0);
-                  e->engine.func->context_render_op_set
-                    (e->engine.data.output, ctx, EVAS_RENDER_COPY);
-                  e->engine.func->rectangle_draw(e->engine.data.output,
-                                                 ctx,
-                                                 obj->cur.map->surface,
-                                                 0, 0,
-                                                 obj->cur.map->surface_w,
-                                                 obj->cur.map->surface_h);
-                  e->engine.func->context_free(e->engine.data.output, ctx);
+                  memset(&whole, 0, sizeof(whole));
+                  whole.w = obj->cur.map->surface_w;
+                  whole.h = obj->cur.map->surface_h;
+                  rects = &whole;
                }
-             ctx = e->engine.func->context_new(e->engine.data.output);
-             off_x2 = -obj->cur.geometry.x;
-             off_y2 = -obj->cur.geometry.y;
-             if (obj->smart.smart)
+             else
+               rects = evas_common_tilebuf_get_render_rects(obj->cur.map->damage);
+             EINA_INLIST_FOREACH(EINA_INLIST_GET(rects), r)
                {
-                  EINA_INLIST_FOREACH
-                    (evas_object_smart_members_get_direct(obj), obj2)
+                  RDI(level);
+                  RD("        damage: %i %i %ix%i\n", r->x, r->y, r->w, r->h);
+                  if (obj->cur.map->alpha)
                     {
-                       clean_them |= evas_render_mapped(e, obj2, ctx,
-							obj->cur.map->surface,
-							off_x2, off_y2, 1
+                       ctx = e->engine.func->context_new(e->engine.data.output);
+                       e->engine.func->context_color_set
+                         (e->engine.data.output, ctx, 0, 0, 0, 0);
+                       e->engine.func->context_render_op_set
+                         (e->engine.data.output, ctx, EVAS_RENDER_COPY);
+                       e->engine.func->rectangle_draw(e->engine.data.output,
+                                                      ctx,
+                                                      obj->cur.map->surface,
+                                                      r->x, r->y, r->w, r->h);
+                       e->engine.func->context_free(e->engine.data.output, ctx);
+                    }
+                  ctx = e->engine.func->context_new(e->engine.data.output);
+                  if (obj->smart.smart)
+                    {
+                       e->engine.func->context_clip_set(e->engine.data.output,
+                                                        ctx, r->x, r->y,
+                                                        r->w, r->h);
+                       EINA_INLIST_FOREACH
+                         (evas_object_smart_members_get_direct(obj), obj2)
+                         {
+                            clean_them |= evas_render_mapped(e, obj2, ctx,
+                                                             obj->cur.map->surface,
+                                                             off_x2, off_y2, 1
 #ifdef REND_DGB
-							, level + 1
+                                                             , level + 1
 #endif
-							);
+                                                             );
+                         }
                     }
+                  else
+                    {
+                       int x = r->x, y = r->y, w = r->w, h = r->h;
+
+                       RECTS_CLIP_TO_RECT(x, y, w, h,
+                                          obj->cur.geometry.x + off_x2,
+                                          obj->cur.geometry.y + off_y2,
+                                          obj->cur.geometry.w,
+                                          obj->cur.geometry.h);
+                       e->engine.func->context_clip_set(e->engine.data.output,
+                                                        ctx, x, y, w, h);
+                       obj->func->render(obj, e->engine.data.output, ctx,
+                                         obj->cur.map->surface, off_x2, off_y2);
+                    }
+                  e->engine.func->context_free(e->engine.data.output, ctx);
+                  obj->cur.map->surface = e->engine.func->image_dirty_region
+                    (e->engine.data.output, obj->cur.map->surface,
+                     r->x, r->y, r->w, r->h);
                }
-             else
-               {
-                  int x = 0, y = 0, w = 0, h = 0;
-
-                  w = obj->cur.map->surface_w;
-                  h = obj->cur.map->surface_h;
-                  RECTS_CLIP_TO_RECT(x, y, w, h,
-                                     obj->cur.geometry.x + off_x2,
-                                     obj->cur.geometry.y + off_y2,
-                                     obj->cur.geometry.w,
-                                     obj->cur.geometry.h);
-                  e->engine.func->context_clip_set(e->engine.data.output,
-                                                   ctx, x, y, w, h);
-                  obj->func->render(obj, e->engine.data.output, ctx,
-                                    obj->cur.map->surface, off_x2, off_y2);
-               }
-             e->engine.func->context_free(e->engine.data.output, ctx);
-             rendered = 1;
+             if (rects != &whole)
+               evas_common_tilebuf_free_render_rects(rects);
+             if (obj->cur.map->damage)
+               evas_common_tilebuf_clear(obj->cur.map->damage);
           }
 
         RDI(level);
         RD("        draw map4\n");
 
-        if (rendered)
-          {
-             obj->cur.map->surface = e->engine.func->image_dirty_region
-               (e->engine.data.output, obj->cur.map->surface,
-                0, 0, obj->cur.map->surface_w, obj->cur.map->surface_h);
-          }
         e->engine.func->context_clip_unset(e->engine.data.output,
                                            e->engine.data.context);
         if (obj->cur.map->surface) 
@@ -880,6 +1176,17 @@ evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
                     }
                }
           }
+        if (mapped)
+          {
+             int x, y, w, h;
+
+             // keep to the part of the parent surface being redrawn
+             if (e->engine.func->context_clip_get(e->engine.data.output,
+                                                  context, &x, &y, &w, &h))
+               e->engine.func->context_clip_clip(e->engine.data.output,
+                                                 e->engine.data.context,
+                                                 x, y, w, h);
+          }
         if (obj->cur.cache.clip.visible)
            obj->layer->evas->engine.func->image_map_draw
            (e->engine.data.output, e->engine.data.context, surface,
@@ -895,9 +1202,16 @@ evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
      {
         if (mapped)
           {
+             int x, y, w, h;
+
              RDI(level);
              RD("        draw child of mapped obj\n");
              ctx = e->engine.func->context_new(e->engine.data.output);
+             // the parent may only be redrawing part of its surface
+             if (e->engine.func->context_clip_get(e->engine.data.output,
+                                                  context, &x, &y, &w, &h))
+               e->engine.func->context_clip_set(e->engine.data.output,
+                                                ctx, x, y, w, h);
              if (obj->smart.smart)
                {
                   EINA_INLIST_FOREACH
@@ -926,12 +1240,12 @@ evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
                           obj->cur.geometry.y + off_y,
                           obj->cur.geometry.w,
                           obj->cur.geometry.h);
-                       e->engine.func->context_clip_set(e->engine.data.output,
-                                                        ctx,
-                                                        obj->cur.cache.clip.x + off_x,
-                                                        obj->cur.cache.clip.y + off_y, 
-                                                        obj->cur.cache.clip.w,
-                                                        obj->cur.cache.clip.h);
+                       e->engine.func->context_clip_clip(e->engine.data.output,
+                                                         ctx,
+                                                         obj->cur.cache.clip.x + off_x,
+                                                         obj->cur.cache.clip.y + off_y,
+                                                         obj->cur.cache.clip.w,
+                                                         obj->cur.cache.clip.h);
                     }
                   else
                     {
@@ -966,6 +1280,141 @@ evas_render_mapped(Evas *e, Evas_Object *obj, void *context, void *surface,
    return clean_them;
 }
 
+/* occlusion culling. before an update is drawn its objects are walked top
+ * down once, piling up the opaque parts of the obscuring ones. anything
+ * whose part of the update ends up entirely under that pile is marked
+ * hidden and skipped by the draw loop - the cutouts would have thrown all
+ * of its pixels away anyway, this just saves the trip into the engine.
+ * smart and mapped objects are never culled, they draw outside their own
+ * clip. the pile and the subtraction are bounded, giving up just means
+ * drawing as before */
+#define OCCLUDE_COVERS 16
+#define OCCLUDE_PIECES 64
+
+static Eina_Bool
+_evas_render_rect_covered(const Eina_Rectangle *covers, int ncovers,
+                          int x, int y, int w, int h)
+{
+   Eina_Rectangle pieces[2][OCCLUDE_PIECES];
+   int i, j, n = 1, cur = 0;
+
+   EINA_RECTANGLE_SET(&(pieces[0][0]), x, y, w, h);
+   for (i = 0; (i < ncovers) && (n > 0); i++)
+     {
+        const Eina_Rectangle *c = covers + i;
+        Eina_Rectangle *src = pieces[cur], *dst = pieces[!cur];
+        int m = 0;
+
+        for (j = 0; j < n; j++)
+          {
+             const Eina_Rectangle *p = src + j;
+             int x1, y1, x2, y2;
+
+             if (m > (OCCLUDE_PIECES - 4)) return EINA_FALSE;
+             if (!RECTS_INTERSECT(p->x, p->y, p->w, p->h, c->x, c->y, c->w, c->h))
+               {
+                  dst[m++] = *p;
+                  continue;
+               }
+             /* keep what sticks out of c: the bands above and below it,
+              * then the bits left and right of it in between */
+             x1 = MAX(p->x, c->x);
+             y1 = MAX(p->y, c->y);
+             x2 = MIN(p->x + p->w, c->x + c->w);
+             y2 = MIN(p->y + p->h, c->y + c->h);
+             if (p->y < y1)
+               {
+                  EINA_RECTANGLE_SET(&(dst[m]), p->x, p->y, p->w, y1 - p->y);
+                  m++;
+               }
+             if (y2 < (p->y + p->h))
+               {
+                  EINA_RECTANGLE_SET(&(dst[m]), p->x, y2, p->w, p->y + p->h - y2);
+                  m++;
+               }
+             if (p->x < x1)
+               {
+                  EINA_RECTANGLE_SET(&(dst[m]), p->x, y1, x1 - p->x, y2 - y1);
+                  m++;
+               }
+             if (x2 < (p->x + p->w))
+               {
+                  EINA_RECTANGLE_SET(&(dst[m]), x2, y1, p->x + p->w - x2, y2 - y1);
+                  m++;
+               }
+          }
+        n = m;
+        cur = !cur;
+     }
+   return (n == 0);
+}
+
+/* the part of an obscuring object that is known opaque, in canvas coords */
+static Eina_Bool
+_evas_render_opaque_rect_get(Evas_Object *obj, Eina_Rectangle *r)
+{
+   if (evas_object_is_opaque(obj))
+     {
+        EINA_RECTANGLE_SET(r, obj->cur.cache.clip.x, obj->cur.cache.clip.y,
+                           obj->cur.cache.clip.w, obj->cur.cache.clip.h);
+     }
+   else if (obj->func->get_opaque_rect)
+     {
+        Evas_Coord obx, oby, obw, obh;
+
+        obj->func->get_opaque_rect(obj, &obx, &oby, &obw, &obh);
+        RECTS_CLIP_TO_RECT(obx, oby, obw, obh,
+                           obj->cur.cache.clip.x, obj->cur.cache.clip.y,
+                           obj->cur.cache.clip.w, obj->cur.cache.clip.h);
+        EINA_RECTANGLE_SET(r, obx, oby, obw, obh);
+     }
+   else
+     return EINA_FALSE;
+   return ((r->w > 0) && (r->h > 0));
+}
+
+static void
+_evas_render_occlusion_mark(Evas *e, Eina_Bool binned, const unsigned int *bin,
+                            unsigned int count, int ux, int uy, int uw, int uh)
+{
+   Evas_Render_Bins *bins = &(e->render_bins);
+   Eina_Rectangle covers[OCCLUDE_COVERS];
+   int ncovers = 0;
+   unsigned int k;
+
+   for (k = count; k > 0; k--)
+     {
+        Evas_Object *obj;
+        unsigned int pos;
+        int x, y, w, h;
+
+        pos = binned ? bin[k - 1] : (k - 1);
+        obj = eina_array_data_get(&e->active_objects, pos);
+        bins->hidden[pos] = 0;
+        if (!evas_object_is_in_output_rect(obj, ux, uy, uw, uh)) continue;
+        x = ux; y = uy; w = uw; h = uh;
+        RECTS_CLIP_TO_RECT(x, y, w, h,
+                           obj->cur.cache.clip.x, obj->cur.cache.clip.y,
+                           obj->cur.cache.clip.w, obj->cur.cache.clip.h);
+        if ((w <= 0) || (h <= 0)) continue;
+        if ((ncovers > 0) && (!obj->smart.smart) &&
+            (!((obj->cur.map) && (obj->cur.usemap))) &&
+            (_evas_render_rect_covered(covers, ncovers, x, y, w, h)))
+          {
+             bins->hidden[pos] = 1;
+             continue;
+          }
+        if ((bins->obscuring[pos]) && (ncovers < OCCLUDE_COVERS) &&
+            (_evas_render_opaque_rect_get(obj, &(covers[ncovers]))))
+          {
+             Eina_Rectangle *r = &(covers[ncovers]);
+
+             RECTS_CLIP_TO_RECT(r->x, r->y, r->w, r->h, ux, uy, uw, uh);
+             if ((r->w > 0) && (r->h > 0)) ncovers++;
+          }
+     }
+}
+
 static Eina_List *
 evas_render_updates_internal(Evas *e,
                              unsigned char make_updates,
@@ -977,6 +1426,7 @@ evas_render_updates_internal(Evas *e,
    Eina_Bool clean_them = EINA_FALSE;
    Eina_Bool alpha;
    Eina_Rectangle *r;
+   Evas_Scroll *sc;
    int ux, uy, uw, uh;
    int cx, cy, cw, ch;
    unsigned int i, j;
@@ -1018,6 +1468,21 @@ evas_render_updates_internal(Evas *e,
         _evas_render_prev_cur_clip_cache_add(e, obj);
      }
    eina_array_clean(&e->restack_objects);
+   /* scrolls go after the object updates they replace and before the
+    * exposes, which have to be drawn over the copy */
+   EINA_LIST_FREE(e->scrolls, sc)
+     {
+        if ((e->engine.func->output_redraws_motion_add) &&
+            (!e->viewport.changed) && (!e->output.changed) && (!redraw_all))
+          {
+             e->engine.func->output_redraws_motion_add(e->engine.data.output,
+                                                       sc->x, sc->y,
+                                                       sc->w, sc->h,
+                                                       sc->dx, sc->dy);
+             _evas_render_scroll_others_add(e, sc);
+          }
+        free(sc);
+     }
    /* phase 3. add exposes */
    EINA_LIST_FREE(e->damages, r)
      {
@@ -1056,6 +1521,8 @@ evas_render_updates_internal(Evas *e,
         e->engine.func->output_redraws_rect_del(e->engine.data.output,
 					       r->x, r->y, r->w, r->h);
      }
+   /* file the active objects so each update only walks what overlaps it */
+   if (do_draw) evas_render_bins_build(e, &e->active_objects);
    /* build obscure objects list of active objects that obscure */
    for (i = 0; i < e->active_objects.count; ++i)
      {
@@ -1072,7 +1539,10 @@ evas_render_updates_internal(Evas *e,
                      (obj->cur.cache.clip.visible) &&
                      (!obj->smart.smart)))
 /*	  obscuring_objects = eina_list_append(obscuring_objects, obj); */
-	  eina_array_push(&e->obscuring_objects, obj);
+          {
+             eina_array_push(&e->obscuring_objects, obj);
+             if (e->render_bins.count) e->render_bins.obscuring[i] = 1;
+          }
      }
    /* save this list */
 /*    obscuring_objects_orig = obscuring_objects; */
@@ -1091,7 +1561,10 @@ evas_render_updates_internal(Evas *e,
                     &ux, &uy, &uw, &uh,
                     &cx, &cy, &cw, &ch)))
 	  {
-	     int off_x, off_y;
+	     const unsigned int *bin = NULL;
+	     unsigned int count, k;
+	     int off_x, off_y, bin_count = 0;
+	     Eina_Bool binned;
 
              RD("  [--- UPDATE %i %i %ix%i\n", ux, uy, uw, uh);
 	     if (make_updates)
@@ -1105,13 +1578,31 @@ evas_render_updates_internal(Evas *e,
              haveup = 1;
 	     off_x = cx - ux;
 	     off_y = cy - uy;
+	     /* narrow both walks below down to the binned objects, if any */
+	     binned = evas_render_bins_query(e, ux, uy, uw, uh, &bin, &bin_count);
+	     if (binned)
+	       count = bin_count;
+	     else
+	       count = e->obscuring_objects.count;
+	     /* find what is fully hidden under opaque objects on top */
+	     if (e->render_bins.count)
+	       _evas_render_occlusion_mark(e, binned, bin,
+	                                   binned ? (unsigned int)bin_count :
+	                                   e->active_objects.count,
+	                                   ux, uy, uw, uh);
 	     /* build obscuring objects list (in order from bottom to top) */
-	     for (i = 0; i < e->obscuring_objects.count; ++i)
+	     for (k = 0; k < count; ++k)
 	       {
 		  Evas_Object *obj;
 
-		  obj = (Evas_Object *)eina_array_data_get
-                     (&e->obscuring_objects, i);
+		  if (binned)
+		    {
+		       if (!e->render_bins.obscuring[bin[k]]) continue;
+		       obj = eina_array_data_get(&e->active_objects, bin[k]);
+		    }
+		  else
+		    obj = (Evas_Object *)eina_array_data_get
+		       (&e->obscuring_objects, k);
 		  if (evas_object_is_in_output_rect(obj, ux, uy, uw, uh))
 		    {
 		       eina_array_push(&e->temporary_objects, obj);
@@ -1179,11 +1670,12 @@ evas_render_updates_internal(Evas *e,
                                                      e->engine.data.context);
 	       }
 	     /* render all object that intersect with rect */
-             for (i = 0; i < e->active_objects.count; ++i)
+	     count = binned ? (unsigned int)bin_count : e->active_objects.count;
+             for (k = 0; k < count; ++k)
 	       {
 		  Evas_Object *obj;
 
-		  obj = eina_array_data_get(&e->active_objects, i);
+		  obj = eina_array_data_get(&e->active_objects, binned ? bin[k] : k);
 
 		  /* if it's in our outpout rect and it doesn't clip anything */
                   RD("    OBJ: [%p] '%s' %i %i %ix%i\n", obj, obj->type, obj->cur.geometry.x, obj->cur.geometry.y, obj->cur.geometry.w, obj->cur.geometry.h);
@@ -1202,6 +1694,12 @@ evas_render_updates_internal(Evas *e,
 		       if ((e->temporary_objects.count > offset) &&
 			   (eina_array_data_get(&e->temporary_objects, offset) == obj))
 			 offset++;
+		       if ((e->render_bins.count) &&
+			   (e->render_bins.hidden[binned ? bin[k] : k]))
+			 {
+			    RD("      HIDDEN\n");
+			    continue;
+			 }
 		       x = cx; y = cy; w = cw; h = ch;
                        if (obj->cur.clipper)
                          {
@@ -0,0 +1,270 @@
+#include "evas_common.h"
+#include "evas_private.h"
+
+/* binning of the active objects for the phase 6 draw loop.
+ *
+ * every update rect used to test every active and obscuring object for
+ * overlap, which with many small updates and many objects costs more than
+ * drawing. instead the active objects are filed once per frame in a
+ * uniform grid of BINS_CELL pixel cells, keyed on cur.cache.clip and by
+ * their position in e->active_objects. an update only looks at the cells
+ * it covers and gets back the positions of the objects filed there in
+ * ascending order, so the draw loop keeps walking bottom to top. the bins
+ * only narrow things down, the draw loop still does its own overlap test.
+ *
+ * some objects are handed back to every update: smart objects, which are
+ * drawn whatever their own clip says, mapped ones, whose clip can be
+ * recalculated in the middle of the draw loop, objects with an empty or
+ * negative clip, which the overlap test treats in its own way, and
+ * anything covering more than BINS_BIG cells.
+ */
+
+#define BINS_SHIFT 6
+#define BINS_CELL  (1 << BINS_SHIFT)
+#define BINS_BIG   64
+/* below this a plain walk is as cheap as filing */
+#define BINS_MIN   64
+
+static Eina_Bool
+_evas_render_bin_add(Evas_Render_Bin *bin, unsigned int pos)
+{
+   if (bin->count == bin->alloc)
+     {
+        unsigned int *objs;
+        int alloc;
+
+        alloc = bin->alloc ? bin->alloc * 2 : 16;
+        objs = realloc(bin->objs, alloc * sizeof(unsigned int));
+        if (!objs) return EINA_FALSE;
+        bin->objs = objs;
+        bin->alloc = alloc;
+     }
+   bin->objs[bin->count++] = pos;
+   return EINA_TRUE;
+}
+
+static void
+_evas_render_bin_flush(Evas_Render_Bin *bin)
+{
+   free(bin->objs);
+   bin->objs = NULL;
+   bin->count = 0;
+   bin->alloc = 0;
+}
+
+static void
+_evas_render_bins_span_get(Evas_Render_Bins *bins, int x, int y, int w, int h,
+                           int *cx1, int *cy1, int *cx2, int *cy2)
+{
+   *cx1 = x >> BINS_SHIFT;
+   *cy1 = y >> BINS_SHIFT;
+   *cx2 = (x + w - 1) >> BINS_SHIFT;
+   *cy2 = (y + h - 1) >> BINS_SHIFT;
+   /* clamping keeps overlapping spans overlapping */
+   if (*cx1 < 0) *cx1 = 0;
+   else if (*cx1 >= bins->w) *cx1 = bins->w - 1;
+   if (*cy1 < 0) *cy1 = 0;
+   else if (*cy1 >= bins->h) *cy1 = bins->h - 1;
+   if (*cx2 < 0) *cx2 = 0;
+   else if (*cx2 >= bins->w) *cx2 = bins->w - 1;
+   if (*cy2 < 0) *cy2 = 0;
+   else if (*cy2 >= bins->h) *cy2 = bins->h - 1;
+}
+
+/* per object state, indexed like the active objects */
+static Eina_Bool
+_evas_render_bins_objs_reset(Evas_Render_Bins *bins, int count)
+{
+   if (count > bins->objs_alloc)
+     {
+        unsigned int *stamps;
+        unsigned char *obscuring, *hidden;
+
+        stamps = realloc(bins->stamps, count * sizeof(unsigned int));
+        if (!stamps) return EINA_FALSE;
+        bins->stamps = stamps;
+        obscuring = realloc(bins->obscuring, count * sizeof(unsigned char));
+        if (!obscuring) return EINA_FALSE;
+        bins->obscuring = obscuring;
+        hidden = realloc(bins->hidden, count * sizeof(unsigned char));
+        if (!hidden) return EINA_FALSE;
+        bins->hidden = hidden;
+        bins->objs_alloc = count;
+     }
+   if (count <= 0) return EINA_TRUE;
+   memset(bins->stamps, 0, count * sizeof(unsigned int));
+   memset(bins->obscuring, 0, count * sizeof(unsigned char));
+   memset(bins->hidden, 0, count * sizeof(unsigned char));
+   bins->stamp = 0;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_evas_render_bins_grid_reset(Evas *e)
+{
+   Evas_Render_Bins *bins = &(e->render_bins);
+   int w, h, i;
+
+   w = (e->output.w + BINS_CELL - 1) >> BINS_SHIFT;
+   h = (e->output.h + BINS_CELL - 1) >> BINS_SHIFT;
+   if (w < 1) w = 1;
+   if (h < 1) h = 1;
+   if ((!bins->cells) || (w != bins->w) || (h != bins->h))
+     {
+        Evas_Render_Bin *cells;
+
+        cells = calloc(w * h, sizeof(Evas_Render_Bin));
+        if (!cells) return EINA_FALSE;
+        for (i = 0; i < (bins->w * bins->h); i++)
+          _evas_render_bin_flush(&(bins->cells[i]));
+        free(bins->cells);
+        bins->cells = cells;
+        bins->w = w;
+        bins->h = h;
+     }
+   else
+     {
+        for (i = 0; i < (w * h); i++)
+          bins->cells[i].count = 0;
+     }
+   bins->always.count = 0;
+   return EINA_TRUE;
+}
+
+/**
+ * Set up the per object state for @p objs (the active objects of this
+ * frame) and file them into the bins. bins->count is left at 0 if the per
+ * object state could not be had. If there are too few objects to bother,
+ * or memory runs out, the bins are left inactive and
+ * evas_render_bins_query() says so.
+ */
+void
+evas_render_bins_build(Evas *e, Eina_Array *objs)
+{
+   Evas_Render_Bins *bins = &(e->render_bins);
+   unsigned int i, count;
+
+   bins->active = 0;
+   bins->count = 0;
+   count = eina_array_count_get(objs);
+   if (!_evas_render_bins_objs_reset(bins, count)) return;
+   bins->count = count;
+   if (count < BINS_MIN) return;
+   if (!_evas_render_bins_grid_reset(e)) return;
+
+   for (i = 0; i < count; i++)
+     {
+        Evas_Object *obj;
+        int cx1, cy1, cx2, cy2, cx, cy;
+
+        obj = eina_array_data_get(objs, i);
+        if ((obj->smart.smart) ||
+            ((obj->cur.map) && (obj->cur.usemap)) ||
+            (obj->cur.cache.clip.w <= 0) || (obj->cur.cache.clip.h <= 0))
+          {
+             if (!_evas_render_bin_add(&(bins->always), i)) return;
+             continue;
+          }
+        _evas_render_bins_span_get(bins,
+                                   obj->cur.cache.clip.x, obj->cur.cache.clip.y,
+                                   obj->cur.cache.clip.w, obj->cur.cache.clip.h,
+                                   &cx1, &cy1, &cx2, &cy2);
+        if (((cx2 - cx1 + 1) * (cy2 - cy1 + 1)) > BINS_BIG)
+          {
+             if (!_evas_render_bin_add(&(bins->always), i)) return;
+             continue;
+          }
+        for (cy = cy1; cy <= cy2; cy++)
+          for (cx = cx1; cx <= cx2; cx++)
+            {
+               if (!_evas_render_bin_add(&(bins->cells[(cy * bins->w) + cx]), i))
+                 return;
+            }
+     }
+   bins->active = 1;
+}
+
+static void
+_evas_render_bin_collect(Evas_Render_Bins *bins, Evas_Render_Bin *bin)
+{
+   int i;
+
+   for (i = 0; i < bin->count; i++)
+     {
+        unsigned int pos = bin->objs[i];
+
+        if (bins->stamps[pos] == bins->stamp) continue;
+        bins->stamps[pos] = bins->stamp;
+        if (!_evas_render_bin_add(&(bins->found), pos))
+          {
+             bins->active = 0;
+             return;
+          }
+     }
+}
+
+static int
+_evas_render_bins_pos_cmp(const void *a, const void *b)
+{
+   unsigned int p1 = *((const unsigned int *)a);
+   unsigned int p2 = *((const unsigned int *)b);
+
+   if (p1 < p2) return -1;
+   if (p1 > p2) return 1;
+   return 0;
+}
+
+/**
+ * Get the positions in the active objects array of every object that may
+ * overlap the given update rectangle, lowest (bottom) first. Returns
+ * EINA_FALSE if the bins are not in use this frame, in which case all the
+ * objects have to be looked at.
+ */
+Eina_Bool
+evas_render_bins_query(Evas *e, int x, int y, int w, int h,
+                       const unsigned int **objs, int *count)
+{
+   Evas_Render_Bins *bins = &(e->render_bins);
+   int cx1, cy1, cx2, cy2, cx, cy;
+
+   if (!bins->active) return EINA_FALSE;
+   bins->stamp++;
+   bins->found.count = 0;
+   _evas_render_bins_span_get(bins, x, y, w, h, &cx1, &cy1, &cx2, &cy2);
+   for (cy = cy1; cy <= cy2; cy++)
+     for (cx = cx1; cx <= cx2; cx++)
+       _evas_render_bin_collect(bins, &(bins->cells[(cy * bins->w) + cx]));
+   _evas_render_bin_collect(bins, &(bins->always));
+   if (!bins->active) return EINA_FALSE;
+   if (bins->found.count > 1)
+     qsort(bins->found.objs, bins->found.count, sizeof(unsigned int),
+           _evas_render_bins_pos_cmp);
+   *objs = bins->found.objs;
+   *count = bins->found.count;
+   return EINA_TRUE;
+}
+
+void
+evas_render_bins_free(Evas *e)
+{
+   Evas_Render_Bins *bins = &(e->render_bins);
+   int i;
+
+   for (i = 0; i < (bins->w * bins->h); i++)
+     _evas_render_bin_flush(&(bins->cells[i]));
+   free(bins->cells);
+   bins->cells = NULL;
+   bins->w = 0;
+   bins->h = 0;
+   _evas_render_bin_flush(&(bins->always));
+   _evas_render_bin_flush(&(bins->found));
+   free(bins->stamps);
+   bins->stamps = NULL;
+   free(bins->obscuring);
+   bins->obscuring = NULL;
+   free(bins->hidden);
+   bins->hidden = NULL;
+   bins->objs_alloc = 0;
+   bins->count = 0;
+   bins->active = 0;
+}
@@ -0,0 +1,246 @@
+#include "evas_common.h"
+#include "evas_private.h"
+
+#ifdef EVAS_RENDER_PRE_THREADS
+/* render_pre of changed objects on the thread pool.
+ *
+ * only done for the object types whose render_pre looks at nothing but the
+ * object itself and its clippers, and only once the clip of the object and
+ * the render_pre of its clippers have been done. the objects are cut into
+ * chunks of PRE_CHUNK in stacking order, each one an item of the pool run
+ * (the caller doing some too). while a thread does a chunk,
+ * evas_add_rect() and evas_object_render_pre_effect_updates() called on it
+ * put their rects in that chunk instead of the canvas and the engine. the
+ * caller then hands them to the engine object by object with
+ * evas_render_pre_redraws_flush(), as it walks the render objects in order,
+ * so updates and "un-updates" still reach the engine in stacking order.
+ */
+
+# define PRE_THREADED_MIN 256
+# define PRE_CHUNK 64
+
+typedef struct _Pre_Chunk Pre_Chunk;
+
+struct _Pre_Chunk
+{
+   Eina_Rectangle *rects; /* pending rects of the object being done */
+   int             rects_num, rects_alloc;
+   Eina_Rectangle *redraws; /* output redraws of all its objects */
+   int             redraws_num, redraws_alloc;
+   Eina_Bool       failed : 1;
+};
+
+static pthread_mutex_t pre_busy = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t pre_key_once = PTHREAD_ONCE_INIT;
+/* the chunk a thread is doing, NULL on all others */
+static pthread_key_t pre_key;
+static Eina_Bool pre_key_ok = EINA_FALSE;
+
+static Eina_Array *pre_objs = NULL;
+static Pre_Chunk *pre_chunk = NULL;
+static int pre_chunk_alloc = 0;
+/* end of the redraws of each object in those of its chunk */
+static int *pre_ends = NULL;
+static unsigned int pre_ends_alloc = 0;
+
+static Eina_Bool
+_pre_rect_push(Eina_Rectangle **rects, int *num, int *alloc,
+               int x, int y, int w, int h)
+{
+   if (*num == *alloc)
+     {
+        Eina_Rectangle *tmp;
+        int n;
+
+        n = *alloc ? *alloc * 2 : 32;
+        tmp = realloc(*rects, n * sizeof(Eina_Rectangle));
+        if (!tmp) return EINA_FALSE;
+        *rects = tmp;
+        *alloc = n;
+     }
+   EINA_RECTANGLE_SET(&((*rects)[*num]), x, y, w, h);
+   (*num)++;
+   return EINA_TRUE;
+}
+
+static void
+_pre_key_create(void)
+{
+   pre_key_ok = (pthread_key_create(&pre_key, NULL) == 0);
+}
+
+static void
+_pre_chunk_run(void *data __UNUSED__, int c)
+{
+   Pre_Chunk *ch = &(pre_chunk[c]);
+   unsigned int i, end;
+
+   ch->rects_num = 0;
+   ch->redraws_num = 0;
+   ch->failed = 0;
+   pthread_setspecific(pre_key, ch);
+   end = (c + 1) * PRE_CHUNK;
+   if (end > eina_array_count_get(pre_objs))
+     end = eina_array_count_get(pre_objs);
+   for (i = c * PRE_CHUNK; i < end; i++)
+     {
+        Evas_Object *obj = eina_array_data_get(pre_objs, i);
+
+        obj->func->render_pre(obj);
+        pre_ends[i] = ch->redraws_num;
+     }
+   pthread_setspecific(pre_key, NULL);
+}
+
+static Eina_Bool
+_pre_buffers_get(unsigned int count, int chunks)
+{
+   if (chunks > pre_chunk_alloc)
+     {
+        Pre_Chunk *tmp;
+
+        tmp = realloc(pre_chunk, chunks * sizeof(Pre_Chunk));
+        if (!tmp) return EINA_FALSE;
+        memset(tmp + pre_chunk_alloc, 0,
+               (chunks - pre_chunk_alloc) * sizeof(Pre_Chunk));
+        pre_chunk = tmp;
+        pre_chunk_alloc = chunks;
+     }
+   if (count > pre_ends_alloc)
+     {
+        int *tmp;
+
+        tmp = realloc(pre_ends, count * sizeof(int));
+        if (!tmp) return EINA_FALSE;
+        pre_ends = tmp;
+        pre_ends_alloc = count;
+     }
+   return EINA_TRUE;
+}
+
+/**
+ * Run render_pre of all of @p objs on the thread pool. Returns EINA_FALSE if
+ * that was not done (too few objects, no threads, someone else using
+ * them), the caller then has to do it itself. Otherwise the redraws of
+ * each object have to be handed over with evas_render_pre_redraws_flush()
+ * and evas_render_pre_finish() called once all of them have been.
+ */
+Eina_Bool
+evas_render_pre_run(Eina_Array *objs)
+{
+   unsigned int count = eina_array_count_get(objs);
+   int chunks;
+
+   if (count < PRE_THREADED_MIN) return EINA_FALSE;
+   pthread_once(&pre_key_once, _pre_key_create);
+   if (!pre_key_ok) return EINA_FALSE;
+   if (pthread_mutex_trylock(&pre_busy) != 0) return EINA_FALSE;
+   chunks = (count + PRE_CHUNK - 1) / PRE_CHUNK;
+   if (!_pre_buffers_get(count, chunks))
+     {
+        pthread_mutex_unlock(&pre_busy);
+        return EINA_FALSE;
+     }
+
+   pre_objs = objs;
+   if (!evas_common_thread_pool_run(_pre_chunk_run, NULL, chunks))
+     {
+        pre_objs = NULL;
+        pthread_mutex_unlock(&pre_busy);
+        return EINA_FALSE;
+     }
+   pre_objs = NULL;
+   /* pre_busy stays held, the chunks are still needed */
+   return EINA_TRUE;
+}
+
+/**
+ * Hand the redraws of the object at @p pos in the array given to the last
+ * evas_render_pre_run() to the engine of @p e.
+ */
+void
+evas_render_pre_redraws_flush(Evas *e, Evas_Object *obj, unsigned int pos)
+{
+   Pre_Chunk *ch = &(pre_chunk[pos / PRE_CHUNK]);
+   int i, start;
+
+   if (ch->failed)
+     {
+        /* whatever it lost was clipped to either of these */
+        if ((obj->cur.cache.clip.w > 0) && (obj->cur.cache.clip.h > 0))
+          e->engine.func->output_redraws_rect_add(e->engine.data.output,
+                                                  obj->cur.cache.clip.x,
+                                                  obj->cur.cache.clip.y,
+                                                  obj->cur.cache.clip.w,
+                                                  obj->cur.cache.clip.h);
+        if ((obj->prev.cache.clip.w > 0) && (obj->prev.cache.clip.h > 0))
+          e->engine.func->output_redraws_rect_add(e->engine.data.output,
+                                                  obj->prev.cache.clip.x,
+                                                  obj->prev.cache.clip.y,
+                                                  obj->prev.cache.clip.w,
+                                                  obj->prev.cache.clip.h);
+        return;
+     }
+   start = (pos % PRE_CHUNK) ? pre_ends[pos - 1] : 0;
+   for (i = start; i < pre_ends[pos]; i++)
+     e->engine.func->output_redraws_rect_add(e->engine.data.output,
+                                             ch->redraws[i].x,
+                                             ch->redraws[i].y,
+                                             ch->redraws[i].w,
+                                             ch->redraws[i].h);
+}
+
+void
+evas_render_pre_finish(void)
+{
+   pthread_mutex_unlock(&pre_busy);
+}
+
+/**
+ * Whether the calling thread is doing render_pre for evas_render_pre_run(),
+ * the rects then go to evas_render_pre_rect_add() and
+ * evas_render_pre_redraw_add(). Render_pre of other canvases on other
+ * threads meanwhile is not.
+ */
+Eina_Bool
+evas_render_pre_threaded(void)
+{
+   pthread_once(&pre_key_once, _pre_key_create);
+   if (!pre_key_ok) return EINA_FALSE;
+   return pthread_getspecific(pre_key) != NULL;
+}
+
+/* the ones below are only called from render_pre during a run */
+
+void
+evas_render_pre_rect_add(int x, int y, int w, int h)
+{
+   Pre_Chunk *ch = pthread_getspecific(pre_key);
+
+   if (!_pre_rect_push(&ch->rects, &ch->rects_num, &ch->rects_alloc,
+                       x, y, w, h))
+     ch->failed = 1;
+}
+
+int
+evas_render_pre_rects_take(Eina_Rectangle **rects)
+{
+   Pre_Chunk *ch = pthread_getspecific(pre_key);
+   int num;
+
+   *rects = ch->rects;
+   num = ch->rects_num;
+   ch->rects_num = 0;
+   return num;
+}
+
+void
+evas_render_pre_redraw_add(int x, int y, int w, int h)
+{
+   Pre_Chunk *ch = pthread_getspecific(pre_key);
+
+   if (!_pre_rect_push(&ch->redraws, &ch->redraws_num, &ch->redraws_alloc,
+                       x, y, w, h))
+     ch->failed = 1;
+}
+#endif /* EVAS_RENDER_PRE_THREADS */
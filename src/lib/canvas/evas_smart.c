@@ -156,6 +156,25 @@ evas_smart_callback_description_find(const Evas_Smart *s, const char *name)
    return evas_smart_cb_description_find(&s->callbacks, name);
 }
 
+/**
+ * Resolve a smart callback event name to a stable id.
+ *
+ * The id can be handed to evas_object_smart_callback_call_by_id() so
+ * frequently emitted events do not pay for name lookups on every call.
+ * Resolve it once, for example when the smart class is created, and keep
+ * it: the id stays valid for as long as Evas is initialized.
+ *
+ * @param event the event name, must @b not be @c NULL.
+ * @return the id for @a event, or @c NULL on failure.
+ */
+EAPI const Evas_Smart_Cb_Id *
+evas_smart_callback_id_get(const char *event)
+{
+   if (!event) return NULL;
+   /* the id is the shared string; this reference is never dropped */
+   return (const Evas_Smart_Cb_Id *)eina_stringshare_add(event);
+}
+
 /**
  * Sets one class to inherit from the other.
  *
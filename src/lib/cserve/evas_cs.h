@@ -69,6 +69,8 @@ struct _Server
       int req_from, req_to;
    } ch[2];
    void *main_handle;
+   int epfd; // -1 if the wait loop falls back to select()
+   Eina_List *zombies; // dead clients still owed replies by worker threads
 };
 
 struct _Client
@@ -85,6 +87,7 @@ struct _Client
    void *data;
    pid_t pid;
    int req_from, req_to;
+   int pending; // replies still to be sent from other threads
    LK(lock);
 };
 
@@ -97,9 +100,13 @@ struct _Mem
    int offset;
    int size;
    int ref;
+   Mem *arena; // the pool arena this buffer lives in, if any
    Eina_Bool write : 1;
 };
 
+// set in the id of pool arenas, see evas_cserve_mem_pool_alloc()
+#define EVAS_CSERVE_MEM_POOL 0x40000000
+
 //// for comms
 enum
 {
@@ -122,6 +129,8 @@ enum
    OP_INVALID // 13
 };
 
+#define EVAS_CSERVE_LATENCY_BUCKETS 16
+
 typedef struct
 {
    pid_t pid;
@@ -215,6 +224,9 @@ typedef struct
    int wasted_memory_peak;
    double saved_time_image_header_load;
    double saved_time_image_data_load;
+   // requests per opcode by time to reply, bucket n counts replies that
+   // took less than 16 << n usec, the last one everything slower
+   int latency[OP_INVALID][EVAS_CSERVE_LATENCY_BUCKETS];
 } Op_Getstats_Reply;
 typedef struct
 {
@@ -279,6 +291,16 @@ EAPI void evas_cserve_mem_close(Mem *m);
 EAPI Eina_Bool evas_cserve_mem_resize(Mem *m, int size);
 EAPI void      evas_cserve_mem_del(int pid, int id);
 
+//// for pooled image memory
+EAPI void evas_cserve_mem_pool_init(void);
+EAPI void evas_cserve_mem_pool_shutdown(void);
+// for server
+EAPI Mem *evas_cserve_mem_pool_alloc(int size);
+EAPI void evas_cserve_mem_pool_free(Mem *m);
+// for client
+EAPI Mem *evas_cserve_mem_pool_open(int pid, int id, int offset, int size);
+EAPI void evas_cserve_mem_pool_close(Mem *m);
+
 #endif
 
 #endif
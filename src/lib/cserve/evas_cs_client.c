@@ -216,6 +216,7 @@ EAPI Eina_Bool
 evas_cserve_init(void)
 {
    csrve_init++;
+   evas_cserve_mem_pool_init();
    if (cserve) return 1;
    cserve = server_connect();
    if (!cserve) return 0;
@@ -245,6 +246,7 @@ EAPI void
 evas_cserve_shutdown(void)
 {
    csrve_init--;
+   evas_cserve_mem_pool_shutdown();
    if (csrve_init > 0) return;
    if (!cserve) return;
    server_disconnect(cserve);
@@ -375,7 +377,8 @@ evas_cserve_image_data_load(Image_Entry *ie)
              free(rep);
              return 0;
           }
-        ie->data2 = evas_cserve_mem_open(cserve->pid, rep->mem.id, NULL, rep->mem.size, 0);
+        ie->data2 = evas_cserve_mem_pool_open(cserve->pid, rep->mem.id,
+                                              rep->mem.offset, rep->mem.size);
         free(rep);
         return 1;
      }
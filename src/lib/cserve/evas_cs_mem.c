@@ -6,11 +6,12 @@
 
 #ifdef EVAS_CSERVE
 
-EAPI Mem *
-evas_cserve_mem_new(int size, const char *name)
+static int mem_id = 0;
+
+static Mem *
+_evas_cserve_mem_create(int id, const char *name, int size)
 {
    Mem *m;
-   static int id = 0;
    char buf[PATH_MAX];
    
    m = calloc(1, sizeof(Mem));
@@ -18,10 +19,7 @@ evas_cserve_mem_new(int size, const char *name)
    if (name)
      snprintf(buf, sizeof(buf), "/evas-shm-%x.%s", getuid(), name);
    else
-     {
-        id++;
-        snprintf(buf, sizeof(buf), "/evas-shm-%x.%x.%x", getuid(), getpid(), id);
-     }
+     snprintf(buf, sizeof(buf), "/evas-shm-%x.%x.%x", getuid(), getpid(), id);
    m->id = id;
    m->offset = 0;
    m->name = strdup(buf);
@@ -60,9 +58,21 @@ evas_cserve_mem_new(int size, const char *name)
    return m;
 }
 
+EAPI Mem *
+evas_cserve_mem_new(int size, const char *name)
+{
+   if (!name) mem_id++;
+   return _evas_cserve_mem_create(mem_id, name, size);
+}
+
 EAPI void
 evas_cserve_mem_free(Mem *m)
 {
+   if (m->arena)
+     {
+        evas_cserve_mem_pool_free(m);
+        return;
+     }
    shm_unlink(m->name);
    munmap(m->data, m->size);
    close(m->fd);
@@ -118,6 +128,11 @@ evas_cserve_mem_open(int pid, int id, const char *name, int size, int write)
 EAPI void
 evas_cserve_mem_close(Mem *m)
 {
+   if (m->arena)
+     {
+        evas_cserve_mem_pool_close(m);
+        return;
+     }
    munmap(m->data, m->size);
    close(m->fd);
    free(m->name);
@@ -157,4 +172,311 @@ evas_cserve_mem_del(int pid, int id)
    shm_unlink(buf);
 }
 
+/* image pool - rather than one shm segment (and so an fd, an mmap and an
+ * unlink) per image, the server carves image buffers out of a few big
+ * arenas with a buddy allocator. replies carry the arena id and the offset
+ * of the buffer in it, so a client maps an arena once and every further
+ * image living in it is resolved with no syscall at all. arena ids have
+ * EVAS_CSERVE_MEM_POOL set to tell them from plain segments */
+
+#define POOL_PAGE_SHIFT 12
+#define POOL_ORDERS 14 // 4k pages up to a whole 32Mb arena
+#define POOL_PAGES (1 << (POOL_ORDERS - 1))
+#define POOL_ARENA_SIZE (POOL_PAGES << POOL_PAGE_SHIFT)
+#define POOL_ARENA_MAX 16
+#define POOL_ALLOC_MAX (POOL_ARENA_SIZE / 4)
+
+typedef struct _Mem_Block Mem_Block;
+typedef struct _Mem_Arena Mem_Arena;
+
+struct _Mem_Block
+{
+   int next, prev; // free list links, as page indexes
+   unsigned char order;
+   Eina_Bool free : 1; // only ever set on the first page of a free block
+};
+
+struct _Mem_Arena
+{
+   Mem *mem;
+   int free_list[POOL_ORDERS];
+   int used; // in pages
+   Mem_Block blocks[POOL_PAGES];
+};
+
+static Eina_List *pool_arenas = NULL; // server side, Mem_Arena
+static Eina_List *pool_maps = NULL; // client side, arena Mem
+static int pool_init = 0;
+static LK(pool_lock);
+
+EAPI void
+evas_cserve_mem_pool_init(void)
+{
+   pool_init++;
+   if (pool_init != 1) return;
+   LKI(pool_lock);
+}
+
+EAPI void
+evas_cserve_mem_pool_shutdown(void)
+{
+   Mem_Arena *a;
+
+   if (pool_init < 1) return;
+   pool_init--;
+   if (pool_init != 0) return;
+   EINA_LIST_FREE(pool_arenas, a)
+     {
+        evas_cserve_mem_free(a->mem);
+        free(a);
+     }
+   // maps still used by images are left alone, they go with the process
+   LKD(pool_lock);
+}
+
+static void
+_pool_block_push(Mem_Arena *a, int page, int order)
+{
+   Mem_Block *b = a->blocks + page;
+
+   b->order = order;
+   b->free = 1;
+   b->prev = -1;
+   b->next = a->free_list[order];
+   if (b->next >= 0) a->blocks[b->next].prev = page;
+   a->free_list[order] = page;
+}
+
+static void
+_pool_block_unlink(Mem_Arena *a, int page)
+{
+   Mem_Block *b = a->blocks + page;
+
+   if (b->prev >= 0) a->blocks[b->prev].next = b->next;
+   else a->free_list[b->order] = b->next;
+   if (b->next >= 0) a->blocks[b->next].prev = b->prev;
+   b->free = 0;
+}
+
+static Mem_Arena *
+_pool_arena_new(void)
+{
+   Mem_Arena *a;
+   int i;
+
+   a = calloc(1, sizeof(Mem_Arena));
+   if (!a) return NULL;
+   mem_id++;
+   a->mem = _evas_cserve_mem_create(mem_id | EVAS_CSERVE_MEM_POOL, NULL,
+                                    POOL_ARENA_SIZE);
+   if (!a->mem)
+     {
+        free(a);
+        return NULL;
+     }
+   for (i = 0; i < POOL_ORDERS; i++) a->free_list[i] = -1;
+   _pool_block_push(a, 0, POOL_ORDERS - 1);
+   pool_arenas = eina_list_append(pool_arenas, a);
+   return a;
+}
+
+static int
+_pool_block_alloc(Mem_Arena *a, int order)
+{
+   int o, page;
+
+   for (o = order; o < POOL_ORDERS; o++)
+     {
+        if (a->free_list[o] >= 0) break;
+     }
+   if (o == POOL_ORDERS) return -1;
+   page = a->free_list[o];
+   _pool_block_unlink(a, page);
+   // split down, handing the upper halves back
+   while (o > order)
+     {
+        o--;
+        _pool_block_push(a, page + (1 << o), o);
+     }
+   a->blocks[page].order = order;
+   a->used += 1 << order;
+   return page;
+}
+
+static void
+_pool_block_free(Mem_Arena *a, int page)
+{
+   int o = a->blocks[page].order;
+
+   a->used -= 1 << o;
+#ifdef MADV_REMOVE
+   // give the pages back, a tmpfs arena would keep them otherwise
+   madvise(a->mem->data + (page << POOL_PAGE_SHIFT),
+           (1 << o) << POOL_PAGE_SHIFT, MADV_REMOVE);
+#endif
+   while (o < (POOL_ORDERS - 1))
+     {
+        int buddy = page ^ (1 << o);
+
+        if ((!a->blocks[buddy].free) || (a->blocks[buddy].order != o)) break;
+        _pool_block_unlink(a, buddy);
+        if (buddy < page) page = buddy;
+        o++;
+     }
+   _pool_block_push(a, page, o);
+}
+
+/* allocates @size bytes from the pool. the returned Mem shares the fd and
+ * mapping of its arena, data + offset is where the buffer starts. buffers
+ * too big for an arena or allocated when all arenas are full get a segment
+ * of their own, just like evas_cserve_mem_new() would */
+EAPI Mem *
+evas_cserve_mem_pool_alloc(int size)
+{
+   Eina_List *l;
+   Mem_Arena *a;
+   Mem *m;
+   int order = 0, page = -1;
+
+   if ((size <= 0) || (size > POOL_ALLOC_MAX) || (pool_init < 1))
+     return evas_cserve_mem_new(size, NULL);
+   while ((1 << (order + POOL_PAGE_SHIFT)) < size) order++;
+   m = calloc(1, sizeof(Mem));
+   if (!m) return NULL;
+   LKL(pool_lock);
+   EINA_LIST_FOREACH(pool_arenas, l, a)
+     {
+        if ((POOL_PAGES - a->used) < (1 << order)) continue;
+        page = _pool_block_alloc(a, order);
+        if (page >= 0) break;
+     }
+   if ((page < 0) && (eina_list_count(pool_arenas) < POOL_ARENA_MAX))
+     {
+        a = _pool_arena_new();
+        if (a) page = _pool_block_alloc(a, order);
+     }
+   if (page < 0)
+     {
+        LKU(pool_lock);
+        free(m);
+        return evas_cserve_mem_new(size, NULL);
+     }
+   a->mem->ref++;
+   LKU(pool_lock);
+   m->arena = a->mem;
+   m->data = a->mem->data;
+   m->fd = -1;
+   m->id = a->mem->id;
+   m->offset = page << POOL_PAGE_SHIFT;
+   m->size = size;
+   m->ref = 1;
+   m->write = 1;
+   return m;
+}
+
+EAPI void
+evas_cserve_mem_pool_free(Mem *m)
+{
+   Eina_List *l;
+   Mem_Arena *a;
+
+   if (!m->arena)
+     {
+        evas_cserve_mem_free(m);
+        return;
+     }
+   LKL(pool_lock);
+   EINA_LIST_FOREACH(pool_arenas, l, a)
+     {
+        if (a->mem != m->arena) continue;
+        _pool_block_free(a, m->offset >> POOL_PAGE_SHIFT);
+        a->mem->ref--;
+        // keep one arena around even when empty, drop the others
+        if ((a->used == 0) && (eina_list_count(pool_arenas) > 1))
+          {
+             pool_arenas = eina_list_remove_list(pool_arenas, l);
+             evas_cserve_mem_free(a->mem);
+             free(a);
+          }
+        break;
+     }
+   LKU(pool_lock);
+   free(m);
+}
+
+/* client side of evas_cserve_mem_pool_alloc(). the arena is mapped on its
+ * first use and stays mapped for as long as a buffer in it is open */
+EAPI Mem *
+evas_cserve_mem_pool_open(int pid, int id, int offset, int size)
+{
+   Eina_List *l;
+   Mem *m, *arena = NULL;
+   char buf[PATH_MAX];
+
+   if (!(id & EVAS_CSERVE_MEM_POOL))
+     {
+        m = evas_cserve_mem_open(pid, id, NULL, offset + size, 0);
+        if (m) m->offset = offset;
+        return m;
+     }
+   if ((offset < 0) || (size <= 0) || (offset > (POOL_ARENA_SIZE - size)))
+     return NULL;
+   m = calloc(1, sizeof(Mem));
+   if (!m) return NULL;
+   snprintf(buf, sizeof(buf), "/evas-shm-%x.%x.%x", getuid(), pid, id);
+   LKL(pool_lock);
+   EINA_LIST_FOREACH(pool_maps, l, arena)
+     {
+        if (!strcmp(arena->name, buf)) break;
+     }
+   if (l)
+     {
+        // most recently used arenas are found first
+        if (l != pool_maps) pool_maps = eina_list_promote_list(pool_maps, l);
+        arena->ref++;
+     }
+   else
+     {
+        arena = evas_cserve_mem_open(pid, id, NULL, POOL_ARENA_SIZE, 0);
+        if (!arena)
+          {
+             LKU(pool_lock);
+             free(m);
+             return NULL;
+          }
+        arena->id = id;
+        pool_maps = eina_list_prepend(pool_maps, arena);
+     }
+   LKU(pool_lock);
+   m->arena = arena;
+   m->data = arena->data;
+   m->fd = -1;
+   m->id = id;
+   m->offset = offset;
+   m->size = size;
+   m->ref = 1;
+   return m;
+}
+
+EAPI void
+evas_cserve_mem_pool_close(Mem *m)
+{
+   Mem *arena = m->arena;
+
+   if (!arena)
+     {
+        evas_cserve_mem_close(m);
+        return;
+     }
+   LKL(pool_lock);
+   arena->ref--;
+   if (arena->ref == 0)
+     {
+        pool_maps = eina_list_remove(pool_maps, arena);
+        evas_cserve_mem_close(arena);
+     }
+   LKU(pool_lock);
+   free(m);
+}
+
 #endif
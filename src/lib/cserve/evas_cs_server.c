@@ -4,8 +4,14 @@
 
 #include "evas_cs.h"
 
+#ifdef HAVE_SYS_EPOLL_H
+# include <sys/epoll.h>
+#endif
+
 #ifdef EVAS_CSERVE
 
+#define CLIENT_READ_SIZE 16384
+
 EAPI Server *
 evas_cserve_server_add(void)
 {
@@ -19,6 +25,7 @@ evas_cserve_server_add(void)
    s = calloc(1, sizeof(Server));
    if (!s) return NULL;
    s->ch[0].fd = -1;
+   s->epfd = -1;
    snprintf(buf, sizeof(buf), "/tmp/.evas-cserve-%x", getuid());
    s->socket_path = strdup(buf);
    if (!s->socket_path)
@@ -52,6 +59,23 @@ evas_cserve_server_add(void)
      }
    if (listen(s->ch[0].fd, 4096) < 0) goto error;
    umask(pmode);
+#ifdef HAVE_SYS_EPOLL_H
+   s->epfd = epoll_create(64);
+   if (s->epfd >= 0)
+     {
+        struct epoll_event ev;
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = NULL; // the listening socket
+        if ((fcntl(s->epfd, F_SETFD, FD_CLOEXEC) < 0) ||
+            (epoll_ctl(s->epfd, EPOLL_CTL_ADD, s->ch[0].fd, &ev) < 0))
+          {
+             close(s->epfd);
+             s->epfd = -1;
+          }
+     }
+#endif
    return s;
    error:
    umask(pmode);
@@ -61,6 +85,16 @@ evas_cserve_server_add(void)
    return NULL;
 }
 
+static void
+client_free(Client *c)
+{
+   if (c->fd >= 0) close(c->fd);
+   if (c->buf) free(c->buf);
+   if (c->inbuf) free(c->inbuf);
+   LKD(c->lock);
+   free(c);
+}
+
 EAPI void
 evas_cserve_server_del(Server *s)
 {
@@ -69,19 +103,21 @@ evas_cserve_server_del(Server *s)
    EINA_LIST_FREE(s->clients, c)
      {
         LKL(c->lock);
-        close(c->fd);
-        if (c->buf) free(c->buf);
-        if (c->inbuf) free(c->inbuf);
-        LKD(c->lock);
-        free(c);
+        client_free(c);
      }
+   EINA_LIST_FREE(s->zombies, c)
+     {
+        LKL(c->lock);
+        client_free(c);
+     }
+   if (s->epfd >= 0) close(s->epfd);
    close(s->ch[0].fd);
    unlink(s->socket_path);
    free(s->socket_path);
    free(s);
 }
 
-static void
+static Eina_Bool
 server_accept(Server *s)
 {
    Client *c;
@@ -91,19 +127,59 @@ server_accept(Server *s)
    
    size_in = sizeof(struct sockaddr_in);
    new_fd = accept(s->ch[0].fd, (struct sockaddr *)&incoming, (socklen_t *)&size_in);
-   if (new_fd < 0) return;
+   if (new_fd < 0) return 0;
+   // select() can't watch it
+   if ((s->epfd < 0) && (new_fd >= FD_SETSIZE))
+     {
+        close(new_fd);
+        return 0;
+     }
    fcntl(new_fd, F_SETFL, O_NONBLOCK);
    fcntl(new_fd, F_SETFD, FD_CLOEXEC);
    c = calloc(1, sizeof(Client));
    if (!c)
      {
         close(new_fd);
-        return;
+        return 0;
      }
    c->server = s;
    c->fd = new_fd;
+#ifdef HAVE_SYS_EPOLL_H
+   if (s->epfd >= 0)
+     {
+        struct epoll_event ev;
+
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = c;
+        if (epoll_ctl(s->epfd, EPOLL_CTL_ADD, new_fd, &ev) < 0)
+          {
+             close(new_fd);
+             free(c);
+             return 0;
+          }
+     }
+#endif
    LKI(c->lock);
    s->clients = eina_list_append(s->clients, c);
+   return 1;
+}
+
+/* only ask for writability while there is something queued, else epoll
+ * would report the socket on every single wait */
+static void
+client_events_update(Client *c __UNUSED__)
+{
+#ifdef HAVE_SYS_EPOLL_H
+   struct epoll_event ev;
+
+   if ((c->server->epfd < 0) || (c->fd < 0)) return;
+   memset(&ev, 0, sizeof(ev));
+   ev.events = EPOLLIN;
+   if (c->buf) ev.events |= EPOLLOUT;
+   ev.data.ptr = c;
+   epoll_ctl(c->server->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+#endif
 }
 
 static void
@@ -137,6 +213,7 @@ client_flush(Client *c)
         c->buf = NULL;
         c->bufsize = 0;
         c->bufalloc = 0;
+        client_events_update(c);
      }
 }
 
@@ -156,6 +233,7 @@ client_buf_add(Client *c, unsigned char *data, int size)
      }
    memcpy(c->buf + c->bufsize, data, size);
    c->bufsize += size;
+   if (c->bufsize == size) client_events_update(c);
 }
 
 static void
@@ -166,6 +244,7 @@ client_write(Client *c, unsigned char *data, int size)
    if (!c->buf)
      {
         num = write(c->fd, data, size);
+        if (num < 0) num = 0;
         if (num != size)
           client_buf_add(c, data + num, size - num);
      }
@@ -186,12 +265,16 @@ evas_cserve_client_send(Client *c, int opcode, int size, unsigned char *data)
    ints = (int *)data2;
    ints[0] = size;
    ints[1] = opcode;
-//   LKL(c->lock);
-   c->req_to++;
-   ints[2] = c->req_to;
    memcpy(data2 + (sizeof(int) * 3), data, size);
-   client_write(c, data2, size + (sizeof(int) * 3));
-//   LKU(c->lock);
+   // replies can come from load workers as well as from the wait loop
+   LKL(c->lock);
+   if (!c->dead)
+     {
+        c->req_to++;
+        ints[2] = c->req_to;
+        client_write(c, data2, size + (sizeof(int) * 3));
+     }
+   LKU(c->lock);
    free(data2);
 }
 
@@ -209,20 +292,19 @@ evas_cserve_server_message_handler_set(Server *s, int (*func) (void *fdata, Serv
 }
 
 static int
-server_parse(Server *s, Client *c)
+server_parse(Server *s, Client *c, int *pos)
 {
-   int *ints;
-   unsigned char *data, *newbuf;
+   int ints[3];
 
-   if (c->inbufsize < (int)sizeof(int)) return 0;
-   ints = (int *)((c->inbuf));
+   if ((c->inbufsize - *pos) < (int)sizeof(ints)) return 0;
+   // messages are packed back to back, so the header may be unaligned
+   memcpy(ints, c->inbuf + *pos, sizeof(ints));
    if ((ints[0] < 0) || (ints[0] > (1024 * 1024)))
      return 0;
-   if (c->inbufsize < (ints[0] + ((int)sizeof(int) * 3)))
+   if ((c->inbufsize - *pos) < (ints[0] + (int)sizeof(ints)))
      {
         return 0;
      }
-   data = c->inbuf + (sizeof(int) * 3);
    if (ints[2] != (c->req_from + 1))
      {
         ERR("EEK! sequence number mismatch from client with pid: %i."
@@ -232,74 +314,124 @@ server_parse(Server *s, Client *c)
         return 0;
      }
    c->req_from++;
-   server_message_handle(s, c, ints[1], ints[0], data);
-   c->inbufalloc -= ints[0] + (sizeof(int) * 3);
-   if (c->inbufalloc == 0)
-     {
-        free(c->inbuf);
-        c->inbuf = NULL;
-        c->inbufsize = 0;
-        return 0;
-     }
-   newbuf = malloc(c->inbufalloc);
-   if (!newbuf)
-     {
-        c->inbufalloc += ints[0] + (sizeof(int) * 3);
-        /* fixme - bad situation */
-        return 0;
-     }
-   memcpy(newbuf, c->inbuf + ints[0] + (sizeof(int) * 3), c->inbufalloc);
-   c->inbufsize -= ints[0] + (sizeof(int) * 3);
-   free(c->inbuf);
-   c->inbuf = newbuf;
+   *pos += ints[0] + sizeof(ints);
+   server_message_handle(s, c, ints[1], ints[0],
+                         c->inbuf + *pos - ints[0]);
    return 1;
 }
 
+/* reads straight into the client's input buffer and handles every whole
+ * message in it, a partial one is moved to the front to be completed by
+ * the next read */
 static void
-server_data(Server *s, Client *c, unsigned char *data, int size)
+server_data(Server *s, Client *c)
 {
-   if (!c->inbuf)
+   int num, pos = 0;
+
+   if ((c->inbufalloc - c->inbufsize) < CLIENT_READ_SIZE)
      {
-        c->inbuf = malloc(size);
-        if (c->inbuf)
-          {
-             memcpy(c->inbuf, data, size);
-             c->inbufalloc = size;
-             c->inbufsize = size;
-          }
-        else
+        unsigned char *newbuf;
+
+        newbuf = realloc(c->inbuf, c->inbufsize + CLIENT_READ_SIZE);
+        if (!newbuf)
           {
              /* fixme - bad situation */
              return;
           }
+        c->inbuf = newbuf;
+        c->inbufalloc = c->inbufsize + CLIENT_READ_SIZE;
      }
-   else
+   errno = 0;
+   num = read(c->fd, c->inbuf + c->inbufsize, c->inbufalloc - c->inbufsize);
+   if (num <= 0)
      {
-        int size2;
-        
-        size2 = c->inbufsize + size;
-        if (size2 > c->inbufalloc)
+        if ((num < 0) && ((errno == EAGAIN) || (errno == EINTR))) return;
+        c->dead = 1;
+        return;
+     }
+   c->inbufsize += num;
+   while ((!c->dead) && (server_parse(s, c, &pos)));
+   if (pos == 0) return;
+   c->inbufsize -= pos;
+   if (c->inbufsize > 0)
+     memmove(c->inbuf, c->inbuf + pos, c->inbufsize);
+   else if (c->inbufalloc > (4 * CLIENT_READ_SIZE))
+     {
+        // don't keep what one big message needed around for every client
+        free(c->inbuf);
+        c->inbuf = NULL;
+        c->inbufalloc = 0;
+     }
+}
+
+/* a dead client is only let go once no worker thread still has a reply
+ * for it, until then it stays on the zombie list */
+static void
+server_dead_clean(Server *s, Eina_List *dead)
+{
+   Eina_List *l, *l_next;
+   Client *c;
+
+   EINA_LIST_FREE(dead, c)
+     {
+        s->clients = eina_list_remove(s->clients, c);
+        LKL(c->lock);
+        c->dead = 1;
+        // closing also drops it from the epoll set
+        close(c->fd);
+        c->fd = -1;
+        LKU(c->lock);
+        s->zombies = eina_list_append(s->zombies, c);
+     }
+   EINA_LIST_FOREACH_SAFE(s->zombies, l, l_next, c)
+     {
+        LKL(c->lock);
+        if (c->pending > 0)
           {
-             unsigned char *newbuf;
-             
-             c->inbufalloc = size2;
-             newbuf = realloc(c->inbuf, c->inbufalloc);
-             if (newbuf) c->inbuf = newbuf;
-             else size2 = 0;
+             LKU(c->lock);
+             continue;
           }
-        if (size2 > 0)
+        s->zombies = eina_list_remove_list(s->zombies, l);
+        if (c->func) c->func(c->data, c);
+        client_free(c);
+     }
+}
+
+#ifdef HAVE_SYS_EPOLL_H
+static void
+server_wait_epoll(Server *s, int timeout)
+{
+   struct epoll_event evs[64];
+   Eina_List *dead = NULL;
+   Client *c;
+   int i, num;
+
+   if (timeout > 0)
+     num = epoll_wait(s->epfd, evs, 64, (timeout + 999) / 1000);
+   else
+     num = epoll_wait(s->epfd, evs, 64, -1);
+   for (i = 0; i < num; i++)
+     {
+        c = evs[i].data.ptr;
+        if (!c)
           {
-             memcpy(c->inbuf + c->inbufsize, data, size);
-             c->inbufsize = size2;
+             while (server_accept(s));
+             continue;
           }
-        else
+        if (c->dead) continue;
+        if (evs[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+          server_data(s, c);
+        if ((!c->dead) && (evs[i].events & EPOLLOUT))
           {
-             /* fixme - bad situation */
-             return;
+             LKL(c->lock);
+             if (c->buf) client_flush(c);
+             LKU(c->lock);
           }
+        if (c->dead) dead = eina_list_append(dead, c);
      }
-   while (server_parse(s, c));
+   server_dead_clean(s, dead);
 }
+#endif
 
 EAPI void
 evas_cserve_server_wait(Server *s, int timeout)
@@ -311,6 +443,13 @@ evas_cserve_server_wait(Server *s, int timeout)
    Eina_List *l, *dead = NULL;
    Client *c;
    
+#ifdef HAVE_SYS_EPOLL_H
+   if (s->epfd >= 0)
+     {
+        server_wait_epoll(s, timeout);
+        return;
+     }
+#endif
    maxfd = 0;
    FD_ZERO(&rset);
    FD_ZERO(&wset);
@@ -338,43 +477,20 @@ evas_cserve_server_wait(Server *s, int timeout)
      {
         if (c->dead) continue;
         if (FD_ISSET(c->fd, &rset))
-          {
-	     unsigned char buf[16384];
-             int num;
-             
-             errno = 0;
-             num = read(c->fd, buf, sizeof(buf));
-             if (num <= 0)
-               {
-                  c->dead = 1;
-                  dead = eina_list_append(dead, c);
-               }
-             else if (num > 0)
-               {
-                  server_data(s, c, buf, num);
-               }
-          }
+          server_data(s, c);
         else if (FD_ISSET(c->fd, &wset))
           {
+             LKL(c->lock);
              client_flush(c);
-             if (c->dead) dead = eina_list_append(dead, c);
+             LKU(c->lock);
           }
+        if (c->dead) dead = eina_list_append(dead, c);
      }
    if (FD_ISSET(s->ch[0].fd, &rset))
      {
         server_accept(s);
      }
-   EINA_LIST_FREE(dead, c)
-     {
-        LKL(c->lock);
-        if (c->func) c->func(c->data, c);
-        s->clients = eina_list_remove(s->clients, c);
-        close(c->fd);
-        if (c->buf) free(c->buf);
-        if (c->inbuf) free(c->inbuf);
-        LKD(c->lock);
-        free(c);
-     }
+   server_dead_clean(s, dead);
 }
 
 #endif
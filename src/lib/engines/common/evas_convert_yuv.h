@@ -4,5 +4,8 @@
 
 EAPI void evas_common_convert_yuv_420p_601_rgba                     (DATA8 **src, DATA8 *dst, int w, int h);
 
+EAPI int  evas_common_convert_yuv_rows_get                          (int cspace, int h);
+EAPI void evas_common_convert_yuv_rgba                              (DATA8 **src, DATA8 *dst, int w, int h, int cspace);
+
 
 #endif /* _EVAS_CONVERT_YUV_H */
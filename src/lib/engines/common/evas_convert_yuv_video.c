@@ -0,0 +1,418 @@
+#include "evas_common.h"
+#include "evas_convert_yuv.h"
+
+#ifdef BUILD_X86_TARGETS
+# include <immintrin.h>
+#endif
+
+/* video colorspaces. every layout is walked a row at a time, packed and
+ * semi planar rows are first split into y, u and v runs so one planar
+ * kernel per instruction set does all the maths. the kernels share the
+ * 16 bit fixed point steps of the c one and give the very same pixels.
+ * big frames are cut into bands of rows converted by a few threads */
+
+typedef enum _Yuv_Layout
+{
+   YUV_LAYOUT_420P, /* y rows, then h / 2 u rows, then h / 2 v rows */
+   YUV_LAYOUT_422P, /* y rows, then h u rows, then h v rows */
+   YUV_LAYOUT_YUY2, /* h rows of y0 u y1 v */
+   YUV_LAYOUT_NV12, /* y rows, then h / 2 rows of u v pairs */
+   YUV_LAYOUT_NV21  /* y rows, then h / 2 rows of v u pairs */
+} Yuv_Layout;
+
+typedef struct _Yuv_Matrix Yuv_Matrix;
+typedef struct _Yuv_Job    Yuv_Job;
+
+typedef void (*Yuv_Row_Func)  (const DATA8 *yp, const DATA8 *up, const DATA8 *vp, DATA32 *dst, int w, const Yuv_Matrix *m);
+typedef void (*Yuv_Split_Func)(const DATA8 *src, DATA8 *a, DATA8 *b, int n);
+
+/* all factors are 2.13 fixed point */
+struct _Yuv_Matrix
+{
+   short yoff, ymul;
+   short crv, cgu, cgv, cbu;
+};
+
+struct _Yuv_Job
+{
+   DATA8            **src;
+   DATA32            *dst;
+   int                w, h;
+   Yuv_Layout         layout;
+   const Yuv_Matrix  *m;
+   Yuv_Row_Func       row;
+   Yuv_Split_Func     split;
+};
+
+static const Yuv_Matrix _yuv_601  = { 16, 9539, 13075, 3209, 6660, 16525 };
+static const Yuv_Matrix _yuv_709  = { 16, 9539, 14686, 1747, 4366, 17305 };
+static const Yuv_Matrix _yuv_full = {  0, 8192, 11485, 2819, 5850, 14516 };
+
+/* pixels per pass when rows have to be split up first */
+#define YUV_CHUNK 512
+
+static Eina_Bool
+_evas_yuv_format_get(int cspace, Yuv_Layout *layout, const Yuv_Matrix **m)
+{
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+        *layout = YUV_LAYOUT_420P; *m = &_yuv_601; break;
+      case EVAS_COLORSPACE_YCBCR422P709_PL:
+        *layout = YUV_LAYOUT_420P; *m = &_yuv_709; break;
+      case EVAS_COLORSPACE_YCBCR420PFULL_PL:
+        *layout = YUV_LAYOUT_420P; *m = &_yuv_full; break;
+      case EVAS_COLORSPACE_YCBCR422H601_PL:
+        *layout = YUV_LAYOUT_422P; *m = &_yuv_601; break;
+      case EVAS_COLORSPACE_YCBCR422H709_PL:
+        *layout = YUV_LAYOUT_422P; *m = &_yuv_709; break;
+      case EVAS_COLORSPACE_YCBCR422HFULL_PL:
+        *layout = YUV_LAYOUT_422P; *m = &_yuv_full; break;
+      case EVAS_COLORSPACE_YCBCR422601_PL:
+        *layout = YUV_LAYOUT_YUY2; *m = &_yuv_601; break;
+      case EVAS_COLORSPACE_YCBCR422709_PL:
+        *layout = YUV_LAYOUT_YUY2; *m = &_yuv_709; break;
+      case EVAS_COLORSPACE_YCBCR422FULL_PL:
+        *layout = YUV_LAYOUT_YUY2; *m = &_yuv_full; break;
+      case EVAS_COLORSPACE_YCBCR420NV12601_PL:
+        *layout = YUV_LAYOUT_NV12; *m = &_yuv_601; break;
+      case EVAS_COLORSPACE_YCBCR420NV12709_PL:
+        *layout = YUV_LAYOUT_NV12; *m = &_yuv_709; break;
+      case EVAS_COLORSPACE_YCBCR420NV12FULL_PL:
+        *layout = YUV_LAYOUT_NV12; *m = &_yuv_full; break;
+      case EVAS_COLORSPACE_YCBCR420NV21601_PL:
+        *layout = YUV_LAYOUT_NV21; *m = &_yuv_601; break;
+      case EVAS_COLORSPACE_YCBCR420NV21709_PL:
+        *layout = YUV_LAYOUT_NV21; *m = &_yuv_709; break;
+      case EVAS_COLORSPACE_YCBCR420NV21FULL_PL:
+        *layout = YUV_LAYOUT_NV21; *m = &_yuv_full; break;
+      default:
+        return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
+/* number of row pointers an image of height h needs in this colorspace,
+ * 0 if it is not a yuv one */
+EAPI int
+evas_common_convert_yuv_rows_get(int cspace, int h)
+{
+   Yuv_Layout layout;
+   const Yuv_Matrix *m;
+
+   if (!_evas_yuv_format_get(cspace, &layout, &m)) return 0;
+   switch (layout)
+     {
+      case YUV_LAYOUT_420P:
+        return h * 2;
+      case YUV_LAYOUT_422P:
+        return h * 3;
+      case YUV_LAYOUT_YUY2:
+        return h;
+      default:
+        return h + ((h + 1) / 2);
+     }
+}
+
+#ifdef BUILD_CONVERT_YUV
+
+#define YUV_MULHI(a, b) (((a) * (b)) >> 16)
+#define YUV_CLIP(v) (((v) < 0) ? 0 : (((v) > 255) ? 255 : (v)))
+#define YUV_PIXEL(y, r, g, b) \
+   (0xff000000 | \
+    (YUV_CLIP(((y) + (r) + 8) >> 4) << 16) | \
+    (YUV_CLIP(((y) - (g) + 8) >> 4) << 8) | \
+    (YUV_CLIP(((y) + (b) + 8) >> 4)))
+
+static void
+_evas_yuv_row_c(const DATA8 *yp, const DATA8 *up, const DATA8 *vp, DATA32 *dst, int w, const Yuv_Matrix *m)
+{
+   int x;
+
+   for (x = 0; x < w; x += 2)
+     {
+        int u, v, r, g, b, y;
+
+        u = (*up++ - 128) * 128;
+        v = (*vp++ - 128) * 128;
+        r = YUV_MULHI(v, m->crv);
+        g = YUV_MULHI(u, m->cgu) + YUV_MULHI(v, m->cgv);
+        b = YUV_MULHI(u, m->cbu);
+        y = YUV_MULHI((*yp++ - m->yoff) * 128, m->ymul);
+        *dst++ = YUV_PIXEL(y, r, g, b);
+        y = YUV_MULHI((*yp++ - m->yoff) * 128, m->ymul);
+        *dst++ = YUV_PIXEL(y, r, g, b);
+     }
+}
+
+static void
+_evas_yuv_split_c(const DATA8 *src, DATA8 *a, DATA8 *b, int n)
+{
+   int i;
+
+   for (i = 0; i < n; i++)
+     {
+        a[i] = src[0];
+        b[i] = src[1];
+        src += 2;
+     }
+}
+
+#ifdef BUILD_X86_TARGETS
+# define YUV_TARGET(t) __attribute__ ((target (t)))
+
+/* 8 pixels from 8 lanes of y and of per pixel chroma terms */
+# define YUV_PIXELS8_SSE2(d, y, cr, cg, cb) \
+   do { \
+      __m128i _yy, _r, _g, _b, _bg, _ra; \
+      _yy = _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(y, yoff), 7), ymul); \
+      _r = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(_yy, cr), rnd), 4); \
+      _g = _mm_srai_epi16(_mm_add_epi16(_mm_sub_epi16(_yy, cg), rnd), 4); \
+      _b = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(_yy, cb), rnd), 4); \
+      _r = _mm_min_epi16(_mm_max_epi16(_r, zero), max); \
+      _g = _mm_min_epi16(_mm_max_epi16(_g, zero), max); \
+      _b = _mm_min_epi16(_mm_max_epi16(_b, zero), max); \
+      _bg = _mm_or_si128(_b, _mm_slli_epi16(_g, 8)); \
+      _ra = _mm_or_si128(_r, alpha); \
+      _mm_storeu_si128((__m128i *)(d), _mm_unpacklo_epi16(_bg, _ra)); \
+      _mm_storeu_si128((__m128i *)((d) + 4), _mm_unpackhi_epi16(_bg, _ra)); \
+   } while (0)
+
+static void YUV_TARGET("sse2")
+_evas_yuv_row_sse2(const DATA8 *yp, const DATA8 *up, const DATA8 *vp, DATA32 *dst, int w, const Yuv_Matrix *m)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i c128 = _mm_set1_epi16(128);
+   const __m128i rnd = _mm_set1_epi16(8);
+   const __m128i max = _mm_set1_epi16(255);
+   const __m128i alpha = _mm_set1_epi16((short)0xff00);
+   const __m128i yoff = _mm_set1_epi16(m->yoff);
+   const __m128i ymul = _mm_set1_epi16(m->ymul);
+   const __m128i crv = _mm_set1_epi16(m->crv);
+   const __m128i cgu = _mm_set1_epi16(m->cgu);
+   const __m128i cgv = _mm_set1_epi16(m->cgv);
+   const __m128i cbu = _mm_set1_epi16(m->cbu);
+   int x;
+
+   for (x = 0; (x + 16) <= w; x += 16)
+     {
+        __m128i y8, u, v, cr, cg, cb;
+
+        y8 = _mm_loadu_si128((const __m128i *)(yp + x));
+        u = _mm_loadl_epi64((const __m128i *)(up + (x >> 1)));
+        v = _mm_loadl_epi64((const __m128i *)(vp + (x >> 1)));
+        u = _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(u, zero), c128), 7);
+        v = _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(v, zero), c128), 7);
+        cr = _mm_mulhi_epi16(v, crv);
+        cg = _mm_add_epi16(_mm_mulhi_epi16(u, cgu), _mm_mulhi_epi16(v, cgv));
+        cb = _mm_mulhi_epi16(u, cbu);
+        YUV_PIXELS8_SSE2(dst + x, _mm_unpacklo_epi8(y8, zero),
+                         _mm_unpacklo_epi16(cr, cr), _mm_unpacklo_epi16(cg, cg),
+                         _mm_unpacklo_epi16(cb, cb));
+        YUV_PIXELS8_SSE2(dst + x + 8, _mm_unpackhi_epi8(y8, zero),
+                         _mm_unpackhi_epi16(cr, cr), _mm_unpackhi_epi16(cg, cg),
+                         _mm_unpackhi_epi16(cb, cb));
+     }
+   if (x < w)
+     _evas_yuv_row_c(yp + x, up + (x >> 1), vp + (x >> 1), dst + x, w - x, m);
+}
+
+static void YUV_TARGET("ssse3")
+_evas_yuv_split_ssse3(const DATA8 *src, DATA8 *a, DATA8 *b, int n)
+{
+   const __m128i shuf = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                      1, 3, 5, 7, 9, 11, 13, 15);
+   int i;
+
+   for (i = 0; (i + 8) <= n; i += 8)
+     {
+        __m128i p;
+
+        p = _mm_loadu_si128((const __m128i *)(src + (i * 2)));
+        p = _mm_shuffle_epi8(p, shuf);
+        _mm_storel_epi64((__m128i *)(a + i), p);
+        _mm_storel_epi64((__m128i *)(b + i), _mm_srli_si128(p, 8));
+     }
+   if (i < n)
+     _evas_yuv_split_c(src + (i * 2), a + i, b + i, n - i);
+}
+
+/* 16 pixels. unpacking works per 128 bit lane, so the 4 pixel groups
+ * come out as 0 2 / 1 3 and get put back in order on the way out */
+# define YUV_PIXELS16_AVX2(d, y, cr, cg, cb) \
+   do { \
+      __m256i _yy, _r, _g, _b, _bg, _ra, _lo, _hi; \
+      _yy = _mm256_mulhi_epi16(_mm256_slli_epi16(_mm256_sub_epi16(y, yoff), 7), ymul); \
+      _r = _mm256_srai_epi16(_mm256_add_epi16(_mm256_add_epi16(_yy, cr), rnd), 4); \
+      _g = _mm256_srai_epi16(_mm256_add_epi16(_mm256_sub_epi16(_yy, cg), rnd), 4); \
+      _b = _mm256_srai_epi16(_mm256_add_epi16(_mm256_add_epi16(_yy, cb), rnd), 4); \
+      _r = _mm256_min_epi16(_mm256_max_epi16(_r, zero), max); \
+      _g = _mm256_min_epi16(_mm256_max_epi16(_g, zero), max); \
+      _b = _mm256_min_epi16(_mm256_max_epi16(_b, zero), max); \
+      _bg = _mm256_or_si256(_b, _mm256_slli_epi16(_g, 8)); \
+      _ra = _mm256_or_si256(_r, alpha); \
+      _lo = _mm256_unpacklo_epi16(_bg, _ra); \
+      _hi = _mm256_unpackhi_epi16(_bg, _ra); \
+      _mm256_storeu_si256((__m256i *)(d), _mm256_permute2x128_si256(_lo, _hi, 0x20)); \
+      _mm256_storeu_si256((__m256i *)((d) + 8), _mm256_permute2x128_si256(_lo, _hi, 0x31)); \
+   } while (0)
+
+static void YUV_TARGET("avx2")
+_evas_yuv_row_avx2(const DATA8 *yp, const DATA8 *up, const DATA8 *vp, DATA32 *dst, int w, const Yuv_Matrix *m)
+{
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i c128 = _mm256_set1_epi16(128);
+   const __m256i rnd = _mm256_set1_epi16(8);
+   const __m256i max = _mm256_set1_epi16(255);
+   const __m256i alpha = _mm256_set1_epi16((short)0xff00);
+   const __m256i yoff = _mm256_set1_epi16(m->yoff);
+   const __m256i ymul = _mm256_set1_epi16(m->ymul);
+   const __m256i crv = _mm256_set1_epi16(m->crv);
+   const __m256i cgu = _mm256_set1_epi16(m->cgu);
+   const __m256i cgv = _mm256_set1_epi16(m->cgv);
+   const __m256i cbu = _mm256_set1_epi16(m->cbu);
+   int x;
+
+   for (x = 0; (x + 32) <= w; x += 32)
+     {
+        __m256i u, v, cr, cg, cb;
+
+        u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(up + (x >> 1))));
+        v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(vp + (x >> 1))));
+        u = _mm256_slli_epi16(_mm256_sub_epi16(u, c128), 7);
+        v = _mm256_slli_epi16(_mm256_sub_epi16(v, c128), 7);
+        /* quads 0 2 1 3 so the lane wise unpacks below double up
+         * chroma 0-7 and 8-15 in order */
+        cr = _mm256_permute4x64_epi64(_mm256_mulhi_epi16(v, crv), 0xd8);
+        cg = _mm256_permute4x64_epi64(_mm256_add_epi16(_mm256_mulhi_epi16(u, cgu),
+                                                       _mm256_mulhi_epi16(v, cgv)), 0xd8);
+        cb = _mm256_permute4x64_epi64(_mm256_mulhi_epi16(u, cbu), 0xd8);
+        YUV_PIXELS16_AVX2(dst + x,
+                          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(yp + x))),
+                          _mm256_unpacklo_epi16(cr, cr), _mm256_unpacklo_epi16(cg, cg),
+                          _mm256_unpacklo_epi16(cb, cb));
+        YUV_PIXELS16_AVX2(dst + x + 16,
+                          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(yp + x + 16))),
+                          _mm256_unpackhi_epi16(cr, cr), _mm256_unpackhi_epi16(cg, cg),
+                          _mm256_unpackhi_epi16(cb, cb));
+     }
+   if (x < w)
+     _evas_yuv_row_sse2(yp + x, up + (x >> 1), vp + (x >> 1), dst + x, w - x, m);
+}
+#endif /* BUILD_X86_TARGETS */
+
+static void
+_evas_yuv_job_rows(Yuv_Job *job, int y0, int y1)
+{
+   DATA8 ybuf[YUV_CHUNK], uvbuf[YUV_CHUNK];
+   DATA8 ubuf[YUV_CHUNK / 2], vbuf[YUV_CHUNK / 2];
+   DATA8 **src = job->src;
+   int w = job->w, h = job->h;
+   int x, y, n;
+
+   for (y = y0; y < y1; y++)
+     {
+        DATA32 *d = job->dst + (y * w);
+        DATA8 *s;
+
+        switch (job->layout)
+          {
+           case YUV_LAYOUT_420P:
+             job->row(src[y], src[h + (y / 2)], src[h + (h / 2) + (y / 2)],
+                      d, w, job->m);
+             break;
+           case YUV_LAYOUT_422P:
+             job->row(src[y], src[h + y], src[(h * 2) + y], d, w, job->m);
+             break;
+           case YUV_LAYOUT_YUY2:
+             s = src[y];
+             for (x = 0; x < w; x += n)
+               {
+                  n = w - x;
+                  if (n > YUV_CHUNK) n = YUV_CHUNK;
+                  job->split(s + (x * 2), ybuf, uvbuf, n);
+                  job->split(uvbuf, ubuf, vbuf, n / 2);
+                  job->row(ybuf, ubuf, vbuf, d + x, n, job->m);
+               }
+             break;
+           case YUV_LAYOUT_NV12:
+           case YUV_LAYOUT_NV21:
+             s = src[h + (y / 2)];
+             for (x = 0; x < w; x += n)
+               {
+                  n = w - x;
+                  if (n > YUV_CHUNK) n = YUV_CHUNK;
+                  if (job->layout == YUV_LAYOUT_NV12)
+                    job->split(s + x, ubuf, vbuf, n / 2);
+                  else
+                    job->split(s + x, vbuf, ubuf, n / 2);
+                  job->row(src[y] + x, ubuf, vbuf, d + x, n, job->m);
+               }
+             break;
+          }
+     }
+}
+
+#ifdef BUILD_PTHREAD
+/* big frames are cut into bands of rows for the thread pool */
+# define YUV_THREADED_MIN (640 * 480)
+# define YUV_BAND 16
+
+static void
+_evas_yuv_band_do(void *data, int item)
+{
+   Yuv_Job *job = data;
+   int y1;
+
+   y1 = (item + 1) * YUV_BAND;
+   if (y1 > job->h) y1 = job->h;
+   _evas_yuv_job_rows(job, item * YUV_BAND, y1);
+}
+
+static Eina_Bool
+_evas_yuv_job_threaded(Yuv_Job *job)
+{
+   if ((job->w * job->h) < YUV_THREADED_MIN) return EINA_FALSE;
+   return evas_common_thread_pool_run(_evas_yuv_band_do, job,
+                                      (job->h + YUV_BAND - 1) / YUV_BAND);
+}
+#endif /* BUILD_PTHREAD */
+
+#endif /* BUILD_CONVERT_YUV */
+
+EAPI void
+evas_common_convert_yuv_rgba(DATA8 **src, DATA8 *dst, int w, int h, int cspace)
+{
+#ifdef BUILD_CONVERT_YUV
+   Yuv_Job job;
+
+   if (!_evas_yuv_format_get(cspace, &job.layout, &job.m)) return;
+   if ((w < 2) || (h < 1)) return;
+   job.src = src;
+   job.dst = (DATA32 *)dst;
+   job.w = w & ~0x1;
+   job.h = h;
+   job.row = _evas_yuv_row_c;
+   job.split = _evas_yuv_split_c;
+#ifdef BUILD_X86_TARGETS
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     job.row = _evas_yuv_row_avx2;
+   else if (evas_common_cpu_has_feature(CPU_FEATURE_SSE2))
+     job.row = _evas_yuv_row_sse2;
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSSE3))
+     job.split = _evas_yuv_split_ssse3;
+#endif
+   /* without any of the above the old mmx, sse and altivec kernels are
+    * still the quickest for plain 601 */
+   if ((cspace == EVAS_COLORSPACE_YCBCR422P601_PL) &&
+       (job.row == _evas_yuv_row_c))
+     {
+        evas_common_convert_yuv_420p_601_rgba(src, dst, w, h);
+        return;
+     }
+#ifdef BUILD_PTHREAD
+   if (_evas_yuv_job_threaded(&job)) return;
+#endif
+   _evas_yuv_job_rows(&job, 0, job.h);
+#endif
+}
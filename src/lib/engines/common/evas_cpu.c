@@ -60,6 +60,33 @@ evas_common_cpu_sse_test(void)
 #endif
 }
 
+#ifdef BUILD_X86_TARGETS
+static void
+evas_common_cpu_sse2_test(void)
+{
+   asm volatile ("pxor %%xmm0, %%xmm0" : : : "xmm0");
+}
+
+static void
+evas_common_cpu_ssse3_test(void)
+{
+   asm volatile ("pabsb %%xmm0, %%xmm0" : : : "xmm0");
+}
+
+static void
+evas_common_cpu_sse4_1_test(void)
+{
+   asm volatile ("pmulld %%xmm0, %%xmm0" : : : "xmm0");
+}
+
+static void
+evas_common_cpu_avx2_test(void)
+{
+   /* traps as well when the os does not save the ymm state */
+   asm volatile ("vpaddd %%ymm0, %%ymm0, %%ymm0" : : : "xmm0");
+}
+#endif
+
 void
 evas_common_cpu_altivec_test(void)
 {
@@ -152,6 +179,27 @@ evas_common_cpu_init(void)
      cpu_feature_mask &= ~CPU_FEATURE_SSE;
 #endif /* BUILD_SSE */
 #endif /* BUILD_MMX */
+#ifdef BUILD_X86_TARGETS
+   cpu_feature_mask |= CPU_FEATURE_SSE2 *
+     evas_common_cpu_feature_test(evas_common_cpu_sse2_test);
+   if (getenv("EVAS_CPU_NO_SSE2"))
+     cpu_feature_mask &= ~CPU_FEATURE_SSE2;
+   if (cpu_feature_mask & CPU_FEATURE_SSE2)
+     cpu_feature_mask |= CPU_FEATURE_SSSE3 *
+       evas_common_cpu_feature_test(evas_common_cpu_ssse3_test);
+   if (getenv("EVAS_CPU_NO_SSSE3"))
+     cpu_feature_mask &= ~CPU_FEATURE_SSSE3;
+   if (cpu_feature_mask & CPU_FEATURE_SSSE3)
+     cpu_feature_mask |= CPU_FEATURE_SSE4_1 *
+       evas_common_cpu_feature_test(evas_common_cpu_sse4_1_test);
+   if (getenv("EVAS_CPU_NO_SSE4_1"))
+     cpu_feature_mask &= ~CPU_FEATURE_SSE4_1;
+   if (cpu_feature_mask & CPU_FEATURE_SSSE3)
+     cpu_feature_mask |= CPU_FEATURE_AVX2 *
+       evas_common_cpu_feature_test(evas_common_cpu_avx2_test);
+   if (getenv("EVAS_CPU_NO_AVX2"))
+     cpu_feature_mask &= ~CPU_FEATURE_AVX2;
+#endif /* BUILD_X86_TARGETS */
 #ifdef __POWERPC__
 #ifdef __VEC__
    cpu_feature_mask |= CPU_FEATURE_ALTIVEC *
@@ -219,6 +267,7 @@ evas_common_cpu_can_do(int *mmx, int *sse, int *sse2)
 	if (cpu_feature_mask & CPU_FEATURE_MMX) do_mmx = 1;
 	if (cpu_feature_mask & CPU_FEATURE_MMX2) do_sse = 1;
 	if (cpu_feature_mask & CPU_FEATURE_SSE) do_sse = 1;
+	if (cpu_feature_mask & CPU_FEATURE_SSE2) do_sse2 = 1;
      }
 //   INF("%i %i %i", do_mmx, do_sse, do_sse2);
    *mmx = do_mmx;
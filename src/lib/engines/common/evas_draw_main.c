@@ -52,6 +52,7 @@ evas_common_init(void)
 void
 evas_common_shutdown(void)
 {
+   evas_common_thread_pool_shutdown();
    evas_font_dir_cache_free();
    evas_common_image_cache_free();
 }
@@ -0,0 +1,296 @@
+#include "evas_common.h"
+#include "evas_private.h"
+
+#include "evas_font_private.h"
+
+#include FT_BITMAP_H
+
+extern FT_Library         evas_ft_lib;
+
+/* glyph atlas - rasterized A8 glyphs of all fonts are packed into big
+ * shared pages instead of living in their own little heap blocks. pages
+ * are filled with simple shelf packing: a glyph goes on the first shelf
+ * that is tall enough (but not way too tall) and still has room, or a
+ * new shelf is opened under the last one. glyphs are never moved around
+ * once packed, a page is dropped when its last glyph goes or when it is
+ * evicted as least recently drawn from. */
+
+#define ATLAS_PAGE_W 512
+#define ATLAS_PAGE_H 512
+#define ATLAS_GLYPH_MAX 128
+#define ATLAS_SIZE_DEFAULT (4 * 1024 * 1024)
+
+typedef struct _Font_Atlas_Shelf Font_Atlas_Shelf;
+typedef struct _Font_Atlas_Entry Font_Atlas_Entry;
+
+struct _Font_Atlas_Shelf
+{
+   int x, y, h;
+};
+
+struct _Font_Atlas_Entry
+{
+   RGBA_Font_Glyph *fg;
+   FT_UInt          index;
+};
+
+struct _RGBA_Font_Atlas_Page
+{
+   EINA_INLIST;
+   DATA8            *data;
+   Font_Atlas_Shelf *shelves;
+   int               shelves_num, shelves_alloc;
+   Font_Atlas_Entry *entries;
+   int               entries_num, entries_alloc;
+   int               y;
+   unsigned int      stamp;
+   unsigned char     evicted : 1;
+};
+
+static Eina_Inlist *pages = NULL;
+static int atlas_usage = 0;
+static int atlas_size = ATLAS_SIZE_DEFAULT;
+static unsigned int atlas_stamp = 0;
+static int initialised = 0;
+
+LK(lock_font_atlas); // guards the page list and packing
+
+void
+evas_common_font_atlas_init(void)
+{
+   const char *s;
+
+   initialised++;
+   if (initialised != 1) return;
+   LKI(lock_font_atlas);
+   s = getenv("EVAS_FONT_ATLAS_SIZE");
+   if (s) atlas_size = atoi(s) * 1024;
+}
+
+static void
+_evas_common_font_atlas_page_free(RGBA_Font_Atlas_Page *pg)
+{
+   atlas_usage -= ATLAS_PAGE_W * ATLAS_PAGE_H;
+   free(pg->data);
+   free(pg->shelves);
+   free(pg->entries);
+   free(pg);
+}
+
+void
+evas_common_font_atlas_shutdown(void)
+{
+   if (initialised < 1) return;
+   initialised--;
+   if (initialised != 0) return;
+
+   while (pages)
+     {
+        RGBA_Font_Atlas_Page *pg = (RGBA_Font_Atlas_Page *)pages;
+
+        pages = eina_inlist_remove(pages, pages);
+        _evas_common_font_atlas_page_free(pg);
+     }
+   LKD(lock_font_atlas);
+}
+
+static RGBA_Font_Atlas_Page *
+_evas_common_font_atlas_page_new(void)
+{
+   RGBA_Font_Atlas_Page *pg;
+
+   pg = calloc(1, sizeof(RGBA_Font_Atlas_Page));
+   if (!pg) return NULL;
+   pg->data = malloc(ATLAS_PAGE_W * ATLAS_PAGE_H);
+   if (!pg->data)
+     {
+        free(pg);
+        return NULL;
+     }
+   atlas_usage += ATLAS_PAGE_W * ATLAS_PAGE_H;
+   pages = eina_inlist_prepend(pages, EINA_INLIST_GET(pg));
+   return pg;
+}
+
+static Font_Atlas_Shelf *
+_evas_common_font_atlas_page_shelf_get(RGBA_Font_Atlas_Page *pg, int w, int h)
+{
+   Font_Atlas_Shelf *sh;
+   int i;
+
+   for (i = 0; i < pg->shelves_num; i++)
+     {
+        sh = pg->shelves + i;
+        /* don't waste a tall shelf on a short glyph */
+        if ((sh->h >= h) && (sh->h <= (h + (h >> 2) + 1)) &&
+            ((sh->x + w) <= ATLAS_PAGE_W))
+          return sh;
+     }
+   if ((pg->y + h) > ATLAS_PAGE_H) return NULL;
+   if (pg->shelves_num == pg->shelves_alloc)
+     {
+        Font_Atlas_Shelf *tmp;
+
+        tmp = realloc(pg->shelves, (pg->shelves_alloc + 16) * sizeof(Font_Atlas_Shelf));
+        if (!tmp) return NULL;
+        pg->shelves = tmp;
+        pg->shelves_alloc += 16;
+     }
+   sh = pg->shelves + pg->shelves_num++;
+   sh->x = 0;
+   sh->y = pg->y;
+   sh->h = h;
+   pg->y += h;
+   return sh;
+}
+
+static Eina_Bool
+_evas_common_font_atlas_page_entry_add(RGBA_Font_Atlas_Page *pg, RGBA_Font_Glyph *fg, FT_UInt index)
+{
+   if (pg->entries_num == pg->entries_alloc)
+     {
+        Font_Atlas_Entry *tmp;
+
+        tmp = realloc(pg->entries, (pg->entries_alloc + 64) * sizeof(Font_Atlas_Entry));
+        if (!tmp) return EINA_FALSE;
+        pg->entries = tmp;
+        pg->entries_alloc += 64;
+     }
+   pg->entries[pg->entries_num].fg = fg;
+   pg->entries[pg->entries_num].index = index;
+   pg->entries_num++;
+   return EINA_TRUE;
+}
+
+/* moves the bitmap of a freshly rasterized glyph into the atlas. glyphs
+ * that don't fit (mono, huge, bottom-up) simply keep their own buffer */
+Eina_Bool
+evas_common_font_atlas_glyph_add(RGBA_Font_Glyph *fg, FT_UInt index)
+{
+   RGBA_Font_Atlas_Page *pg;
+   Font_Atlas_Shelf *sh = NULL;
+   FT_Bitmap *bm, tmp;
+   DATA8 *src, *dst;
+   int w, h, y;
+
+   if ((!initialised) || (atlas_size <= 0)) return EINA_FALSE;
+   bm = &(fg->glyph_out->bitmap);
+   if ((bm->pixel_mode != ft_pixel_mode_grays) || (bm->num_grays != 256))
+     return EINA_FALSE;
+   w = bm->width;
+   h = bm->rows;
+   if ((w <= 0) || (h <= 0) || (bm->pitch < w) ||
+       (w > ATLAS_GLYPH_MAX) || (h > ATLAS_GLYPH_MAX))
+     return EINA_FALSE;
+
+   LKL(lock_font_atlas);
+   EINA_INLIST_FOREACH(pages, pg)
+     {
+        sh = _evas_common_font_atlas_page_shelf_get(pg, w, h);
+        if (sh) break;
+     }
+   if (!sh)
+     {
+        pg = _evas_common_font_atlas_page_new();
+        if (pg) sh = _evas_common_font_atlas_page_shelf_get(pg, w, h);
+     }
+   if ((!sh) || (!_evas_common_font_atlas_page_entry_add(pg, fg, index)))
+     {
+        LKU(lock_font_atlas);
+        return EINA_FALSE;
+     }
+   dst = pg->data + (sh->y * ATLAS_PAGE_W) + sh->x;
+   sh->x += w;
+   pg->stamp = atlas_stamp;
+   LKU(lock_font_atlas);
+
+   src = bm->buffer;
+   for (y = 0; y < h; y++)
+     memcpy(dst + (y * ATLAS_PAGE_W), src + (y * bm->pitch), w);
+
+   /* the glyph's own buffer belongs to freetype */
+   tmp = *bm;
+   FT_Bitmap_Done(evas_ft_lib, &tmp);
+   bm->buffer = dst;
+   bm->pitch = ATLAS_PAGE_W;
+   fg->page = pg;
+   return EINA_TRUE;
+}
+
+/* detaches the glyph from its page before the glyph is freed */
+void
+evas_common_font_atlas_glyph_del(RGBA_Font_Glyph *fg)
+{
+   RGBA_Font_Atlas_Page *pg = fg->page;
+   int i;
+
+   if (!pg) return;
+   fg->page = NULL;
+   fg->glyph_out->bitmap.buffer = NULL;
+   LKL(lock_font_atlas);
+   for (i = 0; i < pg->entries_num; i++)
+     {
+        if (pg->entries[i].fg != fg) continue;
+        pg->entries[i] = pg->entries[--pg->entries_num];
+        break;
+     }
+   if (pg->entries_num == 0)
+     {
+        if (!pg->evicted)
+          pages = eina_inlist_remove(pages, EINA_INLIST_GET(pg));
+        _evas_common_font_atlas_page_free(pg);
+     }
+   LKU(lock_font_atlas);
+}
+
+void
+evas_common_font_atlas_glyph_use(RGBA_Font_Glyph *fg)
+{
+   /* racy on purpose, a stale stamp only skews the lru a little */
+   if (fg->page) fg->page->stamp = ++atlas_stamp;
+}
+
+/* evicts least recently drawn pages until the atlas is within budget.
+ * glyphs are dropped from their font caches and rasterized again when
+ * needed, so this must only run where no text is being drawn */
+void
+evas_common_font_atlas_flush(void)
+{
+   if (atlas_usage > atlas_size) evas_common_font_word_cache_flush();
+   while (atlas_usage > atlas_size)
+     {
+        RGBA_Font_Atlas_Page *pg, *lru = NULL;
+        Font_Atlas_Entry *entries;
+        int i, num;
+
+        LKL(lock_font_atlas);
+        EINA_INLIST_FOREACH(pages, pg)
+          {
+             if ((!lru) || (pg->stamp < lru->stamp)) lru = pg;
+          }
+        if (!lru)
+          {
+             LKU(lock_font_atlas);
+             return;
+          }
+        pages = eina_inlist_remove(pages, EINA_INLIST_GET(lru));
+        lru->evicted = 1;
+        num = lru->entries_num;
+        entries = NULL;
+        if (num > 0) entries = malloc(num * sizeof(Font_Atlas_Entry));
+        if (!entries)
+          {
+             /* nothing we can hand back to the fonts, just lose the page */
+             if (num == 0) _evas_common_font_atlas_page_free(lru);
+             LKU(lock_font_atlas);
+             continue;
+          }
+        memcpy(entries, lru->entries, num * sizeof(Font_Atlas_Entry));
+        LKU(lock_font_atlas);
+
+        /* the last glyph to go frees the page */
+        for (i = 0; i < num; i++)
+          evas_common_font_int_cache_glyph_drop(entries[i].fg, entries[i].index);
+        free(entries);
+     }
+}
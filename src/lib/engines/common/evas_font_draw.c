@@ -40,6 +40,7 @@ struct cinfo
      {
         int w,h;
         int rows;
+        int pitch;
         unsigned char *data;
      } bm;
 };
@@ -67,6 +68,27 @@ evas_common_font_draw_init(void)
      }
 }
 
+/* cached words point at glyphs in the atlas, so they have to go before
+ * it evicts any */
+void
+evas_common_font_word_cache_flush(void)
+{
+#if defined(METRIC_CACHE) || defined(WORD_CACHE)
+   LKL(lock_words);
+   while (words)
+     {
+        struct prword *w = (struct prword *)words;
+
+        words = eina_inlist_remove(words, words);
+        if (w->im) free(w->im);
+        if (w->cinfo) free(w->cinfo);
+        eina_ustringshare_del(w->str);
+        free(w);
+     }
+   LKU(lock_words);
+#endif
+}
+
 #ifdef EVAS_FRAME_QUEUING
 EAPI void
 evas_common_font_draw_finish(void)
@@ -100,6 +122,18 @@ _fash_int_new(void)
    return fash;
 }
 
+static Fash_Int *
+_fash_int_get(Fash_Int **fash)
+{
+   Fash_Int *fash_new;
+
+   if (*fash) return *fash;
+   fash_new = _fash_int_new();
+   if ((fash_new) && (!FASH_CAS(fash, NULL, fash_new)))
+     fash_new->freeme(fash_new);
+   return *fash;
+}
+
 static Fash_Item_Index_Map *
 _fash_int_find(Fash_Int *fash, int item)
 {
@@ -124,11 +158,23 @@ _fash_int_add(Fash_Int *fash, int item, RGBA_Font_Int *fint, int index)
    maj = (item >> 8) & 0xff;
    min = item & 0xff;
    if (!fash->bucket[grp])
-     fash->bucket[grp] = calloc(1, sizeof(Fash_Int_Map2));
+     {
+        Fash_Int_Map2 *map2 = calloc(1, sizeof(Fash_Int_Map2));
+
+        if (!map2) return;
+        if (!FASH_CAS(&(fash->bucket[grp]), NULL, map2)) free(map2);
+     }
    if (!fash->bucket[grp]->bucket[maj])
-     fash->bucket[grp]->bucket[maj] = calloc(1, sizeof(Fash_Int_Map));
-   fash->bucket[grp]->bucket[maj]->item[min].fint = fint;
+     {
+        Fash_Int_Map *map = calloc(1, sizeof(Fash_Int_Map));
+
+        if (!map) return;
+        if (!FASH_CAS(&(fash->bucket[grp]->bucket[maj]), NULL, map)) free(map);
+     }
+   /* readers look at fint first, so index must land before it */
    fash->bucket[grp]->bucket[maj]->item[min].index = index;
+   FASH_SYNC();
+   fash->bucket[grp]->bucket[maj]->item[min].fint = fint;
 }
 
 static void
@@ -157,6 +203,18 @@ _fash_gl_new(void)
    return fash;
 }
 
+static Fash_Glyph *
+_fash_gl_get(Fash_Glyph **fash)
+{
+   Fash_Glyph *fash_new;
+
+   if (*fash) return *fash;
+   fash_new = _fash_gl_new();
+   if ((fash_new) && (!FASH_CAS(fash, NULL, fash_new)))
+     fash_new->freeme(fash_new);
+   return *fash;
+}
+
 static RGBA_Font_Glyph *
 _fash_gl_find(Fash_Glyph *fash, int item)
 {
@@ -181,9 +239,21 @@ _fash_gl_add(Fash_Glyph *fash, int item, RGBA_Font_Glyph *glyph)
    maj = (item >> 8) & 0xff;
    min = item & 0xff;
    if (!fash->bucket[grp])
-     fash->bucket[grp] = calloc(1, sizeof(Fash_Glyph_Map2));
+     {
+        Fash_Glyph_Map2 *map2 = calloc(1, sizeof(Fash_Glyph_Map2));
+
+        if (!map2) return;
+        if (!FASH_CAS(&(fash->bucket[grp]), NULL, map2)) free(map2);
+     }
    if (!fash->bucket[grp]->bucket[maj])
-     fash->bucket[grp]->bucket[maj] = calloc(1, sizeof(Fash_Glyph_Map));
+     {
+        Fash_Glyph_Map *map = calloc(1, sizeof(Fash_Glyph_Map));
+
+        if (!map) return;
+        if (!FASH_CAS(&(fash->bucket[grp]->bucket[maj]), NULL, map)) free(map);
+     }
+   /* the glyph must be complete before anyone can see it */
+   FASH_SYNC();
    fash->bucket[grp]->bucket[maj]->item[min] = glyph;
 }
 
@@ -198,6 +268,7 @@ evas_common_font_int_cache_glyph_get(RGBA_Font_Int *fi, FT_UInt index)
      { FT_LOAD_NO_HINTING, FT_LOAD_FORCE_AUTOHINT, FT_LOAD_NO_AUTOHINT };
 
    evas_common_font_int_promote(fi);
+   /* cached glyphs never take a lock */
    if (fi->fash)
      {
         fg = _fash_gl_find(fi->fash, index);
@@ -207,108 +278,82 @@ evas_common_font_int_cache_glyph_get(RGBA_Font_Int *fi, FT_UInt index)
 
    hindex = index + (fi->hinting * 500000000);
 
-//   fg = eina_hash_find(fi->glyphs, &hindex);
-//   if (fg) return fg;
-
    evas_common_font_int_reload(fi);
-   FTLOCK();
+   FSLOCK(fi->src);
+   /* someone else may have loaded it while we waited for the face */
+   if (fi->fash)
+     {
+        fg = _fash_gl_find(fi->fash, index);
+        if (fg)
+          {
+             FSUNLOCK(fi->src);
+             if (fg == (void *)(-1)) return NULL;
+             return fg;
+          }
+     }
+   evas_common_font_int_size_activate(fi);
 //   error = FT_Load_Glyph(fi->src->ft.face, index, FT_LOAD_NO_BITMAP);
    error = FT_Load_Glyph(fi->src->ft.face, index,
 			 FT_LOAD_RENDER | hintflags[fi->hinting]);
-   FTUNLOCK();
-   if (error)
+   if (error) goto on_error;
+
+   fg = malloc(sizeof(struct _RGBA_Font_Glyph));
+   if (!fg)
      {
-        if (!fi->fash) fi->fash = _fash_gl_new();
-        if (fi->fash) _fash_gl_add(fi->fash, index, (void *)(-1));
+        FSUNLOCK(fi->src);
         return NULL;
      }
-
-   fg = malloc(sizeof(struct _RGBA_Font_Glyph));
-   if (!fg) return NULL;
    memset(fg, 0, (sizeof(struct _RGBA_Font_Glyph)));
 
-   FTLOCK();
    error = FT_Get_Glyph(fi->src->ft.face->glyph, &(fg->glyph));
-   FTUNLOCK();
    if (error)
      {
 	free(fg);
-        if (!fi->fash) fi->fash = _fash_gl_new();
-        if (fi->fash) _fash_gl_add(fi->fash, index, (void *)(-1));
-	return NULL;
+        goto on_error;
      }
    if (fg->glyph->format != FT_GLYPH_FORMAT_BITMAP)
      {
-        FTLOCK();
 	error = FT_Glyph_To_Bitmap(&(fg->glyph), FT_RENDER_MODE_NORMAL, 0, 1);
 	if (error)
 	  {
 	     FT_Done_Glyph(fg->glyph);
-             FTUNLOCK();
 	     free(fg);
-             if (!fi->fash) fi->fash = _fash_gl_new();
-             if (fi->fash) _fash_gl_add(fi->fash, index, (void *)(-1));
-	     return NULL;
+             goto on_error;
 	  }
-        FTUNLOCK();
      }
    fg->glyph_out = (FT_BitmapGlyph)fg->glyph;
    fg->index = hindex;
    fg->fi = fi;
+   evas_common_font_atlas_glyph_add(fg, index);
 
-   if (!fi->fash) fi->fash = _fash_gl_new();
-   if (fi->fash) _fash_gl_add(fi->fash, index, fg);
+   if (_fash_gl_get(&(fi->fash))) _fash_gl_add(fi->fash, index, fg);
    size = sizeof(RGBA_Font_Glyph) + sizeof(Eina_List) +
-    (fg->glyph_out->bitmap.width * fg->glyph_out->bitmap.rows) + 200;
+    (fg->glyph_out->bitmap.width * fg->glyph_out->bitmap.rows);
+   /* a glyph outside the atlas pays for its own heap block */
+   if (!fg->page) size += 200;
    fi->usage += size;
    if (fi->inuse) evas_common_font_int_use_increase(size);
+   FSUNLOCK(fi->src);
 
 //   eina_hash_direct_add(fi->glyphs, &fg->index, fg);
    return fg;
-}
 
-typedef struct _Font_Char_Index Font_Char_Index;
-struct _Font_Char_Index
-{
-   FT_UInt index;
-   int gl;
-};
+on_error:
+   if (_fash_gl_get(&(fi->fash))) _fash_gl_add(fi->fash, index, (void *)(-1));
+   FSUNLOCK(fi->src);
+   return NULL;
+}
 
 static FT_UInt
 _evas_common_get_char_index(RGBA_Font_Int* fi, int gl)
 {
-   Font_Char_Index result;
-   //FT_UInt ret;
-
-#ifdef HAVE_PTHREAD
-///   pthread_mutex_lock(&fi->ft_mutex);
-#endif
-
-//   result = eina_hash_find(fi->indexes, &gl);
-//   if (result) goto on_correct;
-//
-//   result = malloc(sizeof (Font_Char_Index));
-//   if (!result)
-//     {
-//#ifdef HAVE_PTHREAD
-//	pthread_mutex_unlock(&fi->ft_mutex);
-//#endif
-//	return FT_Get_Char_Index(fi->src->ft.face, gl);
-//     }
+   FT_UInt index;
 
    evas_common_font_int_reload(fi);
-   FTLOCK();
-   result.index = FT_Get_Char_Index(fi->src->ft.face, gl);
-   FTUNLOCK();
-   result.gl = gl;
-
-//   eina_hash_direct_add(fi->indexes, &result->gl, result);
-//
-// on_correct:
-#ifdef HAVE_PTHREAD
-//   pthread_mutex_unlock(&fi->ft_mutex);
-#endif
-   return result.index;
+   FSLOCK(fi->src);
+   index = FT_Get_Char_Index(fi->src->ft.face, gl);
+   FSUNLOCK(fi->src);
+   return index;
 }
 
 EAPI int
@@ -368,15 +413,15 @@ evas_common_font_glyph_search(RGBA_Font *fn, RGBA_Font_Int **fi_ret, int gl)
 	       {
 		  if (!fi->ft.size)
                      evas_common_font_int_load_complete(fi);
-                  if (!fn->fash) fn->fash = _fash_int_new();
-                  if (fn->fash) _fash_int_add(fn->fash, gl, fi, index);
+                  if (_fash_int_get(&(fn->fash)))
+                    _fash_int_add(fn->fash, gl, fi, index);
 		  *fi_ret = fi;
 		  return index;
 	       }
              else
                {
-                  if (!fn->fash) fn->fash = _fash_int_new();
-                  if (fn->fash) _fash_int_add(fn->fash, gl, NULL, -1);
+                  if (_fash_int_get(&(fn->fash)))
+                    _fash_int_add(fn->fash, gl, NULL, -1);
                }
 	  }
      }
@@ -472,7 +517,7 @@ evas_common_font_draw_internal(RGBA_Image *dst, RGBA_Draw_Context *dc, RGBA_Font
                   struct cinfo *ci = word->cinfo + ind;
                   for (j = rowstart ; j < rowend ; j ++)
                     {
-                       if ((ci->fg->ext_dat) && (dc->font_ext.func.gl_draw))
+                       if ((ci->fg) && (ci->fg->ext_dat) && (dc->font_ext.func.gl_draw))
                          {
                             /* ext glyph draw */
                             dc->font_ext.func.gl_draw(dc->font_ext.data,
@@ -527,20 +572,9 @@ evas_common_font_draw_internal(RGBA_Image *dst, RGBA_Draw_Context *dc, RGBA_Font
 	gl = *text;
 
 	index = evas_common_font_glyph_search(fn, &fi, gl);
-	LKL(fi->ft_mutex);
-        if (fi->src->current_size != fi->size)
-          {
-	     FTLOCK();
-             FT_Activate_Size(fi->ft.size);
-	     FTUNLOCK();
-             fi->src->current_size = fi->size;
-          }
 	fg = evas_common_font_int_cache_glyph_get(fi, index);
-	if (!fg)
-          {
-             LKU(fi->ft_mutex);
-             continue;
-          }
+	if (!fg) continue;
+	evas_common_font_atlas_glyph_use(fg);
 	/* hmmm kerning means i can't sanely do my own cached metric tables! */
 	/* grrr - this means font face sharing is kinda... not an option if */
 	/* you want performance */
@@ -551,7 +585,6 @@ evas_common_font_draw_internal(RGBA_Image *dst, RGBA_Draw_Context *dc, RGBA_Font
                pen_x += kern;
           }
         pface = fi->src->ft.face;
-        LKU(fi->ft_mutex);
 
         if (dc->font_ext.func.gl_new)
           {
@@ -752,6 +785,7 @@ evas_common_font_draw(RGBA_Image *dst, RGBA_Draw_Context *dc, RGBA_Font *fn, int
 #ifdef EVAS_FRAME_QUEUING
    LKL(fn->lock);
 #endif
+   FONT_READ_BEGIN();
    evas_common_font_int_reload(fi);
 //   evas_common_font_size_use(fn);
    use_kerning = FT_HAS_KERNING(fi->src->ft.face);
@@ -783,11 +817,43 @@ evas_common_font_draw(RGBA_Image *dst, RGBA_Draw_Context *dc, RGBA_Font *fn, int
           }
         dc->clip.use = c; dc->clip.x = cx; dc->clip.y = cy; dc->clip.w = cw; dc->clip.h = ch;
      }
+   FONT_READ_END();
 #ifdef EVAS_FRAME_QUEUING
    LKU(fn->lock);
 #endif
 }
 
+/* renders the text once as an 8 bit coverage mask, for effects that work
+ * on the shape of the text instead of drawing it over and over again */
+EAPI Eina_Bool
+evas_common_font_mask_draw(RGBA_Font *fn, DATA8 *mask, int w, int h, int x, int y, const Eina_Unicode *text,
+                           const Evas_BiDi_Props *intl_props)
+{
+   RGBA_Draw_Context *dc;
+   RGBA_Image *im;
+   DATA32 *p;
+   int i;
+
+   im = evas_common_image_new(w, h, 1);
+   if (!im) return EINA_FALSE;
+   dc = evas_common_draw_context_new();
+   if (!dc)
+     {
+        evas_common_rgba_image_free(&im->cache_entry);
+        return EINA_FALSE;
+     }
+   memset(im->image.data, 0, w * h * sizeof(DATA32));
+   evas_common_draw_context_set_color(dc, 255, 255, 255, 255);
+   evas_common_font_draw(im, dc, fn, x, y, text, intl_props);
+   evas_common_cpu_end_opt();
+   p = im->image.data;
+   for (i = 0; i < (w * h); i++)
+     mask[i] = A_VAL(p + i);
+   evas_common_draw_context_free(dc);
+   evas_common_rgba_image_free(&im->cache_entry);
+   return EINA_TRUE;
+}
+
 /* FIXME: Where is it freed at? */
 /* Only used if cache is on */
 #if defined(METRIC_CACHE) || defined(WORD_CACHE)
@@ -830,7 +896,9 @@ evas_font_word_prerender(RGBA_Draw_Context *dc, const Eina_Unicode *in_text, Eva
 
    pen_x = pen_y = 0;
    above = 0; below = 0; baseline = 0; height = 0; descent = 0;
-   metrics = malloc(sizeof(struct cinfo) * len);
+   /* glyphs that can't be had are left empty */
+   metrics = calloc(len, sizeof(struct cinfo));
+   if (!metrics) return NULL;
 
    /* First pass: Work out how big */
    for (char_index = 0, c = 0, chr = 0 ; *text ; text++, char_index ++)
@@ -838,20 +906,9 @@ evas_font_word_prerender(RGBA_Draw_Context *dc, const Eina_Unicode *in_text, Eva
 	struct cinfo *ci = metrics + char_index;
 	ci->gl = *text;
 	ci->index = evas_common_font_glyph_search(fn, &fi, ci->gl);
-	LKL(fi->ft_mutex);
-	if (fi->src->current_size != fi->size)
-	  {
-	     FTLOCK();
-	     FT_Activate_Size(fi->ft.size);
-	     FTUNLOCK();
-             fi->src->current_size = fi->size;
-          }
        ci->fg = evas_common_font_int_cache_glyph_get(fi, ci->index);
-       if (!ci->fg)
-	 {
-            LKU(fi->ft_mutex);
-	    continue;
-	 }
+       if (!ci->fg) continue;
+       evas_common_font_atlas_glyph_use(ci->fg);
 
 	if ((use_kerning) && (prev_index) && (ci->index) &&
             (pface == fi->src->ft.face))
@@ -882,15 +939,15 @@ evas_font_word_prerender(RGBA_Draw_Context *dc, const Eina_Unicode *in_text, Eva
 
         pface = fi->src->ft.face;
 
-        LKU(fi->ft_mutex);
         if (gl)
           {
              ci->fg->ext_dat =dc->font_ext.func.gl_new(dc->font_ext.data,ci->fg);
              ci->fg->ext_dat_free = dc->font_ext.func.gl_free;
           }
         ci->bm.data = ci->fg->glyph_out->bitmap.buffer;
-        ci->bm.w = MAX(ci->fg->glyph_out->bitmap.pitch,
-                       ci->fg->glyph_out->bitmap.width);
+        /* rows are a page pitch apart in the atlas */
+        ci->bm.w = ci->fg->glyph_out->bitmap.width;
+        ci->bm.pitch = ci->fg->glyph_out->bitmap.pitch;
         ci->bm.rows = ci->fg->glyph_out->bitmap.rows;
         ci->bm.h = ci->fg->glyph_out->top;
         above = ci->bm.rows - (ci->bm.rows - ci->bm.h);
@@ -911,12 +968,23 @@ evas_font_word_prerender(RGBA_Draw_Context *dc, const Eina_Unicode *in_text, Eva
    if (!gl)
      {
         im = calloc(height, width);
-        for (i = 0 ; i  < char_index ; i ++)
+        for (i = 0 ; (im) && (i < char_index) ; i ++)
           {
              struct cinfo *ci = metrics + i;
+             int x0 = ci->pos.x, skip = 0, n = ci->bm.w;
 
+             /* keep bearings that stick out of the word inside it */
+             if (x0 < 0)
+               {
+                  skip = -x0;
+                  n -= skip;
+                  x0 = 0;
+               }
+             if ((x0 + n) > width) n = width - x0;
+             if (n <= 0) continue;
              for (j = 0 ; j < ci->bm.rows ; j ++)
-               memcpy(im + ci->pos.x + (j + baseline - ci->bm.h) * width, ci->bm.data + j * ci->bm.w, ci->bm.w);
+               memcpy(im + x0 + (j + baseline - ci->bm.h) * width,
+                      ci->bm.data + (j * ci->bm.pitch) + skip, n);
           }
      }
    else 
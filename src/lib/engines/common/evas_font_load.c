@@ -17,6 +17,13 @@ static Eina_List   *fonts_lru = NULL;
 static Eina_Inlist *fonts_use_lru = NULL;
 static int          fonts_use_usage = 0;
 
+/* glyph lookups take no lock, so what drop and clear take out of the fash
+ * is kept here until evas_common_font_retired_free() sees no readers.
+ * only ever touched by the thread driving the canvas */
+volatile int        evas_common_font_readers = 0;
+static Eina_List   *retired_glyphs = NULL;
+static Eina_List   *retired_fash = NULL;
+
 static void _evas_common_font_int_clear(RGBA_Font_Int *fi);
 
 static int
@@ -45,6 +52,7 @@ _evas_common_font_source_free(RGBA_Font_Source *fs)
    FT_Done_Face(fs->ft.face);
    FTUNLOCK();
    if (fs->name) eina_stringshare_del(fs->name);
+   LKD(fs->ft_mutex);
    free(fs);
 }
 
@@ -91,6 +99,7 @@ evas_common_font_load_shutdown(void)
    fonts = NULL;
    eina_hash_free(fonts_src);
    fonts_src = NULL;
+   evas_common_font_retired_free();
 }
 
 EAPI void
@@ -127,6 +136,8 @@ evas_common_font_source_memory_load(const char *name, const void *data, int data
   if (error)
     {
       FT_Done_Face(fs->ft.face);
+      FTUNLOCK();
+      eina_stringshare_del(fs->name);
       fs->ft.face = NULL;
       free(fs);
       return NULL;
@@ -134,6 +145,7 @@ evas_common_font_source_memory_load(const char *name, const void *data, int data
    FTUNLOCK();
    fs->ft.orig_upem = fs->ft.face->units_per_EM;
    fs->references = 1;
+   LKI(fs->ft_mutex);
    eina_hash_direct_add(fonts_src, fs->name, fs);
    return fs;
 }
@@ -154,6 +166,7 @@ evas_common_font_source_load(const char *name)
    fs->file = fs->name;
    fs->ft.orig_upem = 0;
    fs->references = 1;
+   LKI(fs->ft_mutex);
    eina_hash_direct_add(fonts_src, fs->name, fs);
    return fs;
 }
@@ -241,6 +254,15 @@ evas_common_font_source_free(RGBA_Font_Source *fs)
    eina_hash_del(fonts_src, fs->name, fs);
 }
 
+/* caller holds FSLOCK(fi->src) */
+void
+evas_common_font_int_size_activate(RGBA_Font_Int *fi)
+{
+   if (fi->src->current_size == fi->size) return;
+   FT_Activate_Size(fi->ft.size);
+   fi->src->current_size = fi->size;
+}
+
 EAPI void
 evas_common_font_size_use(RGBA_Font *fn)
 {
@@ -251,11 +273,10 @@ evas_common_font_size_use(RGBA_Font *fn)
      {
 	if (fi->src->current_size != fi->size)
 	  {
+             FSLOCK(fi->src);
              evas_common_font_source_reload(fi->src);
-             FTLOCK();
-	     FT_Activate_Size(fi->ft.size);
-             FTUNLOCK();
-	     fi->src->current_size = fi->size;
+             evas_common_font_int_size_activate(fi);
+             FSUNLOCK(fi->src);
 	  }
      }
 }
@@ -353,8 +374,16 @@ evas_common_font_int_load_complete(RGBA_Font_Int *fi)
    int ret;
    int error;
 
+   FSLOCK(fi->src);
+   /* glyph searches in several threads can race to get here */
+   if (fi->ft.size)
+     {
+        FSUNLOCK(fi->src);
+        return fi;
+     }
    FTLOCK();
    error = FT_New_Size(fi->src->ft.face, &(fi->ft.size));
+   FTUNLOCK();
    if (!error)
      {
 	FT_Activate_Size(fi->ft.size);
@@ -366,7 +395,6 @@ evas_common_font_int_load_complete(RGBA_Font_Int *fi)
 	fi->real_size = fi->size;
 	error = FT_Set_Pixel_Sizes(fi->src->ft.face, 0, fi->real_size);
      }
-   FTUNLOCK();
    if (error)
      {
 	int i;
@@ -391,9 +419,7 @@ evas_common_font_int_load_complete(RGBA_Font_Int *fi)
 	     if (d == 0) break;
 	  }
 	fi->real_size = chosen_size;
-        FTLOCK();
 	error = FT_Set_Pixel_Sizes(fi->src->ft.face, chosen_width, fi->real_size);
-        FTUNLOCK();
 	if (error)
 	  {
 	     /* couldn't choose the size anyway... what now? */
@@ -417,6 +443,7 @@ evas_common_font_int_load_complete(RGBA_Font_Int *fi)
      }
    else ret = val;
    fi->max_h += ret;
+   FSUNLOCK(fi->src);
    return fi;
 }
 
@@ -693,9 +720,94 @@ evas_common_font_memory_hinting_add(RGBA_Font *fn, const char *name, int size, c
    return fn;
 }
 
+static void
+_evas_common_font_glyph_free(RGBA_Font_Glyph *fg)
+{
+   evas_common_font_atlas_glyph_del(fg);
+   FT_Done_Glyph(fg->glyph);
+   /* extension calls */
+   if (fg->ext_dat_free) fg->ext_dat_free(fg->ext_dat);
+   free(fg);
+}
+
+/* takes one glyph out of its font's cache, it is loaded again on next use */
+void
+evas_common_font_int_cache_glyph_drop(RGBA_Font_Glyph *fg, FT_UInt index)
+{
+   RGBA_Font_Int *fi;
+   Fash_Glyph_Map2 *fmap2;
+   Fash_Glyph_Map *fmap;
+
+   /* already out, and its font may be gone */
+   if (fg->retired) return;
+   fi = fg->fi;
+   LKL(fi->ft_mutex);
+   FSLOCK(fi->src);
+   if (fi->fash)
+     {
+        fmap2 = fi->fash->bucket[(index >> 16) & 0xff];
+        fmap = fmap2 ? fmap2->bucket[(index >> 8) & 0xff] : NULL;
+        if ((fmap) && (fmap->item[index & 0xff] == fg))
+          {
+             fmap->item[index & 0xff] = NULL;
+             fg->retired = 1;
+             retired_glyphs = eina_list_append(retired_glyphs, fg);
+          }
+     }
+   FSUNLOCK(fi->src);
+   LKU(fi->ft_mutex);
+}
+
+static void
+_evas_common_font_fash_glyphs_free(Fash_Glyph *fash)
+{
+   int i, j, k;
+
+   for (k = 0; k <= 0xff; k++) // 24bits for unicode - v6 up to E01EF (chrs) & 10FFFD for private use (plane 16)
+     {
+        Fash_Glyph_Map2 *fmap2 = fash->bucket[k];
+        if (!fmap2) continue;
+        for (j = 0; j <= 0xff; j++) // 24bits for unicode - v6 up to E01EF (chrs) & 10FFFD for private use (plane 16)
+          {
+             Fash_Glyph_Map *fmap = fmap2->bucket[j];
+             if (!fmap) continue;
+             for (i = 0; i <= 0xff; i++)
+               {
+                  RGBA_Font_Glyph *fg = fmap->item[i];
+                  if ((fg) && (fg != (void *)(-1)))
+                    {
+                       _evas_common_font_glyph_free(fg);
+                       fmap->item[i] = NULL;
+                    }
+               }
+          }
+     }
+   fash->freeme(fash);
+}
+
+/* frees what drop and clear took out, unless text is being drawn, then it
+ * is left for a later call */
+void
+evas_common_font_retired_free(void)
+{
+   Fash_Glyph *fash;
+   RGBA_Font_Glyph *fg;
+
+   if ((!retired_glyphs) && (!retired_fash)) return;
+   /* the tables were unpublished before this, a reader coming in now
+    * cannot find what is in the lists */
+   FASH_SYNC();
+   if (evas_common_font_readers > 0) return;
+   EINA_LIST_FREE(retired_glyphs, fg)
+     _evas_common_font_glyph_free(fg);
+   EINA_LIST_FREE(retired_fash, fash)
+     _evas_common_font_fash_glyphs_free(fash);
+}
+
 static void
 _evas_common_font_int_clear(RGBA_Font_Int *fi)
 {
+   Fash_Glyph *fash;
    int i, j, k;
    
    LKL(fi->ft_mutex);
@@ -704,41 +816,34 @@ _evas_common_font_int_clear(RGBA_Font_Int *fi)
         LKU(fi->ft_mutex);
         return;
      }
+   /* keep glyph loads from publishing into the table while it goes */
+   FSLOCK(fi->src);
    evas_common_font_int_modify_cache_by(fi, -1);
-  if (fi->fash)
-    {
-      for (k = 0; k <= 0xff; k++) // 24bits for unicode - v6 up to E01EF (chrs) & 10FFFD for private use (plane 16)
-        {
-          Fash_Glyph_Map2 *fmap2 = fi->fash->bucket[k];
-          if (fmap2)
-            {
-              for (j = 0; j <= 0xff; j++) // 24bits for unicode - v6 up to E01EF (chrs) & 10FFFD for private use (plane 16)
-                {
-                  Fash_Glyph_Map *fmap = fmap2->bucket[j];
-                  if (fmap)
-                    {
-                      for (i = 0; i <= 0xff; i++)
-                        {
-                          RGBA_Font_Glyph *fg = fmap->item[i];
-                          if ((fg) && (fg != (void *)(-1)))
-                            {
-                              FT_Done_Glyph(fg->glyph);
-                              /* extension calls */
-                              if (fg->ext_dat_free) fg->ext_dat_free(fg->ext_dat);
-                              free(fg);
-                              fmap->item[i] = NULL;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-      fi->fash->freeme(fi->fash);
-      fi->fash = NULL;
+   fash = fi->fash;
+   fi->fash = NULL;
+   /* the glyphs stay in the table until it is freed, drops must leave
+    * them alone from now on */
+   for (k = 0; k <= 0xff; k++) // 24bits for unicode - v6 up to E01EF (chrs) & 10FFFD for private use (plane 16)
+     {
+        Fash_Glyph_Map2 *fmap2 = fash->bucket[k];
+        if (!fmap2) continue;
+        for (j = 0; j <= 0xff; j++) // 24bits for unicode - v6 up to E01EF (chrs) & 10FFFD for private use (plane 16)
+          {
+             Fash_Glyph_Map *fmap = fmap2->bucket[j];
+             if (!fmap) continue;
+             for (i = 0; i <= 0xff; i++)
+               {
+                  RGBA_Font_Glyph *fg = fmap->item[i];
+                  if ((fg) && (fg != (void *)(-1))) fg->retired = 1;
+               }
+          }
      }
+   retired_fash = eina_list_append(retired_fash, fash);
    if (fi->inuse) fonts_use_usage -= fi->usage;
    fi->usage = 0;
+   FSUNLOCK(fi->src);
    LKU(fi->ft_mutex);
+   evas_common_font_retired_free();
 }
 
 static Eina_Bool
@@ -841,6 +946,8 @@ evas_common_font_cache_set(int size)
 EAPI void
 evas_common_font_flush(void)
 {
+   evas_common_font_atlas_flush();
+   evas_common_font_retired_free();
    if (font_cache_usage < font_cache) return;
    while (font_cache_usage > font_cache)
      {
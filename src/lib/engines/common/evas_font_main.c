@@ -21,6 +21,7 @@ evas_common_font_init(void)
    if (error) return;
    evas_common_font_load_init();
    evas_common_font_draw_init();
+   evas_common_font_atlas_init();
    LKI(lock_font_draw);
    LKI(lock_bidi);
 }
@@ -40,6 +41,7 @@ evas_common_font_shutdown(void)
    evas_common_font_load_shutdown();
    evas_common_font_cache_set(0);
    evas_common_font_flush();
+   evas_common_font_atlas_shutdown();
 
    error = FT_Done_FreeType(evas_ft_lib);
 #ifdef EVAS_FRAME_QUEUING
@@ -86,18 +88,14 @@ evas_common_font_ascent_get(RGBA_Font *fn)
 #endif
    fi = fn->fonts->data;
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FSLOCK(fi->src);
+   evas_common_font_int_size_activate(fi);
    if (!FT_IS_SCALABLE(fi->src->ft.face))
      {
         WRN("NOT SCALABLE!");
      }
    val = (int)fi->src->ft.face->size->metrics.ascender;
+   FSUNLOCK(fi->src);
    return val >> 6;
 //   printf("%i | %i\n", val, val >> 6);
 //   if (fi->src->ft.face->units_per_EM == 0)
@@ -116,14 +114,10 @@ evas_common_font_descent_get(RGBA_Font *fn)
 //   evas_common_font_size_use(fn);
    fi = fn->fonts->data;
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FSLOCK(fi->src);
+   evas_common_font_int_size_activate(fi);
    val = -(int)fi->src->ft.face->size->metrics.descender;
+   FSUNLOCK(fi->src);
    return val >> 6;
 //   if (fi->src->ft.face->units_per_EM == 0)
 //     return val;
@@ -142,14 +136,10 @@ evas_common_font_max_ascent_get(RGBA_Font *fn)
 //   evas_common_font_size_use(fn);
    fi = fn->fonts->data;
    evas_common_font_int_reload(fi); 
-  if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FSLOCK(fi->src);
+   evas_common_font_int_size_activate(fi);
    val = (int)fi->src->ft.face->bbox.yMax;
+   FSUNLOCK(fi->src);
    if (fi->src->ft.face->units_per_EM == 0)
      return val;
    dv = (fi->src->ft.orig_upem * 2048) / fi->src->ft.face->units_per_EM;
@@ -167,14 +157,10 @@ evas_common_font_max_descent_get(RGBA_Font *fn)
 //   evas_common_font_size_use(fn);
    fi = fn->fonts->data;
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FSLOCK(fi->src);
+   evas_common_font_int_size_activate(fi);
    val = -(int)fi->src->ft.face->bbox.yMin;
+   FSUNLOCK(fi->src);
    if (fi->src->ft.face->units_per_EM == 0)
      return val;
    dv = (fi->src->ft.orig_upem * 2048) / fi->src->ft.face->units_per_EM;
@@ -191,14 +177,10 @@ evas_common_font_get_line_advance(RGBA_Font *fn)
 //   evas_common_font_size_use(fn);
    fi = fn->fonts->data;
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
+   FSLOCK(fi->src);
+   evas_common_font_int_size_activate(fi);
    val = (int)fi->src->ft.face->size->metrics.height;
+   FSUNLOCK(fi->src);
    if (fi->src->ft.face->units_per_EM == 0)
      return val;
    return val >> 6;
@@ -7,19 +7,47 @@ extern LK(lock_bidi); // for fribidi API calls
 #endif
 
 # if defined(EVAS_FRAME_QUEUING) || defined(BUILD_PIPE_RENDER)
+/* FTLOCK is only for FT_Library wide calls (creating and destroying faces
+ * and sizes). anything working on a face takes that face's FSLOCK, so
+ * different fonts load and render glyphs in parallel */
 #  define FTLOCK() LKL(lock_font_draw)
 #  define FTUNLOCK() LKU(lock_font_draw)
+#  define FSLOCK(fs) LKL((fs)->ft_mutex)
+#  define FSUNLOCK(fs) LKU((fs)->ft_mutex)
 
 #  define BIDILOCK() LKL(lock_bidi)
 #  define BIDIUNLOCK() LKU(lock_bidi)
 # else
 #  define FTLOCK(x) 
 #  define FTUNLOCK(x) 
+#  define FSLOCK(fs)
+#  define FSUNLOCK(fs)
 
 #  define BIDILOCK() 
 #  define BIDIUNLOCK() 
 # endif
 
+/* fash tables are read without any lock. entries are fully built before
+ * they are published and new buckets are swapped in atomically */
+# ifdef BUILD_PTHREAD
+#  define FASH_CAS(p, o, n) __sync_bool_compare_and_swap((p), (o), (n))
+#  define FASH_SYNC() __sync_synchronize()
+# else
+#  define FASH_CAS(p, o, n) ((*(p) == (o)) ? ((*(p) = (n)), 1) : 0)
+#  define FASH_SYNC()
+# endif
+
+/* glyphs and tables taken out of the fash are only freed once no one is
+ * drawing text, drawing counts itself in evas_common_font_readers */
+extern volatile int evas_common_font_readers;
+# ifdef BUILD_PTHREAD
+#  define FONT_READ_BEGIN() __sync_fetch_and_add(&evas_common_font_readers, 1)
+#  define FONT_READ_END() __sync_fetch_and_sub(&evas_common_font_readers, 1)
+# else
+#  define FONT_READ_BEGIN() evas_common_font_readers++
+#  define FONT_READ_END() evas_common_font_readers--
+# endif
+
 void evas_common_font_source_unload(RGBA_Font_Source *fs);
 void evas_common_font_source_reload(RGBA_Font_Source *fs);
 
@@ -28,5 +56,17 @@ void evas_common_font_int_use_increase(int size);
 void evas_common_font_int_use_trim(void);
 void evas_common_font_int_unload(RGBA_Font_Int *fi);
 void evas_common_font_int_reload(RGBA_Font_Int *fi);
+void evas_common_font_int_size_activate(RGBA_Font_Int *fi);
+void evas_common_font_int_cache_glyph_drop(RGBA_Font_Glyph *fg, FT_UInt index);
+void evas_common_font_retired_free(void);
+
+void evas_common_font_atlas_init(void);
+void evas_common_font_atlas_shutdown(void);
+Eina_Bool evas_common_font_atlas_glyph_add(RGBA_Font_Glyph *fg, FT_UInt index);
+void evas_common_font_atlas_glyph_del(RGBA_Font_Glyph *fg);
+void evas_common_font_atlas_glyph_use(RGBA_Font_Glyph *fg);
+void evas_common_font_atlas_flush(void);
+
+void evas_common_font_word_cache_flush(void);
 
 #endif /* !_EVAS_FONT_PRIVATE_H */
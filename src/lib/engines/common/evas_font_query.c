@@ -16,6 +16,7 @@ evas_common_font_query_kerning(RGBA_Font_Int* fi,
    key[0] = left;
    key[1] = right;
 
+   LKL(fi->ft_mutex);
    result = eina_hash_find(fi->kerning, key);
    if (result)
      {
@@ -28,18 +29,19 @@ evas_common_font_query_kerning(RGBA_Font_Int* fi,
     * prev_index and index. auto/bytecode or none hinting doesn't
     * matter */
    evas_common_font_int_reload(fi);
-   FTLOCK();
+   FSLOCK(fi->src);
+   evas_common_font_int_size_activate(fi);
    if (FT_Get_Kerning(fi->src->ft.face,
 		      key[0], key[1],
 		      ft_kerning_default, &delta) == 0)
      {
 	int *push;
 
-        FTUNLOCK();
+        FSUNLOCK(fi->src);
 	*kerning = delta.x >> 6;
 
 	push = malloc(sizeof (int) * 3);
-	if (!push) return 1;
+	if (!push) goto on_correct;
 
 	push[0] = key[0];
 	push[1] = key[1];
@@ -50,10 +52,11 @@ evas_common_font_query_kerning(RGBA_Font_Int* fi,
 	goto on_correct;
      }
 
-        FTUNLOCK();
+   FSUNLOCK(fi->src);
    error = 0;
 
  on_correct:
+   LKU(fi->ft_mutex);
    return error;
 }
 
@@ -97,14 +100,6 @@ evas_common_font_query_size(RGBA_Font *fn, const Eina_Unicode *text, const Evas_
 	gl = *text;
 	if (gl == 0) break;
 	index = evas_common_font_glyph_search(fn, &fi, gl);
-	LKL(fi->ft_mutex);
-        if (fi->src->current_size != fi->size)
-          {
-	     FTLOCK();
-             FT_Activate_Size(fi->ft.size);
-	     FTUNLOCK();
-             fi->src->current_size = fi->size;
-          }
 	kern = 0;
         /* hmmm kerning means i can't sanely do my own cached metric tables! */
 	/* grrr - this means font face sharing is kinda... not an option if */
@@ -137,7 +132,6 @@ evas_common_font_query_size(RGBA_Font *fn, const Eina_Unicode *text, const Evas_
 
 	pface = fi->src->ft.face;
 	fg = evas_common_font_int_cache_glyph_get(fi, index);
-	LKU(fi->ft_mutex);
 	if (!fg || !fg->glyph) continue;
 
 	if (kern < 0) kern = 0;
@@ -190,17 +184,8 @@ evas_common_font_query_inset(RGBA_Font *fn, const Eina_Unicode *text)
    if (gl == 0) return 0;
 //   evas_common_font_size_use(fn);
    index = evas_common_font_glyph_search(fn, &fi, gl);
-   LKL(fi->ft_mutex);
    evas_common_font_int_reload(fi);
-   if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
    fg = evas_common_font_int_cache_glyph_get(fi, index);
-   LKU(fi->ft_mutex);
    if (!fg) return 0;
 /*
    INF("fg->glyph_out->left = %i, "
@@ -245,9 +230,7 @@ evas_common_font_query_advance(RGBA_Font *fn, const Eina_Unicode *text, const Ev
    pen_y = 0;
 //   evas_common_font_size_use(fn);
    evas_common_font_int_reload(fi);
-   FTLOCK();
    use_kerning = FT_HAS_KERNING(fi->src->ft.face);
-   FTUNLOCK();
    prev_index = 0;
    for (char_index = 0 ; *text ; text++, char_index++)
      {
@@ -258,21 +241,8 @@ evas_common_font_query_advance(RGBA_Font *fn, const Eina_Unicode *text, const Ev
 	gl = *text;
 	if (gl == 0) break;
 	index = evas_common_font_glyph_search(fn, &fi, gl);
-	LKL(fi->ft_mutex);
-        if (fi->src->current_size != fi->size)
-          {
-	     FTLOCK();
-             FT_Activate_Size(fi->ft.size);
-	     FTUNLOCK();
-             fi->src->current_size = fi->size;
-          }
 	fg = evas_common_font_int_cache_glyph_get(fi, index);
-	if (!fg) 
-          {
-             LKU(fi->ft_mutex);
-             continue;
-          }
-	// FIXME: Why no FT_Activate_Size here ?
+	if (!fg) continue;
 	kern = 0;
         /* hmmm kerning means i can't sanely do my own cached metric tables! */
 	/* grrr - this means font face sharing is kinda... not an option if */
@@ -304,7 +274,6 @@ evas_common_font_query_advance(RGBA_Font *fn, const Eina_Unicode *text, const Ev
            }
 
 	pface = fi->src->ft.face;
-	LKU(fi->ft_mutex);
 
 	pen_x += fg->glyph->advance.x >> 16;
 	prev_index = index;
@@ -367,13 +336,6 @@ evas_common_font_query_char_coords(RGBA_Font *fn, const Eina_Unicode *in_text, c
    pen_y = 0;
    evas_common_font_int_reload(fi);
 //   evas_common_font_size_use(fn);
-   if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
    use_kerning = FT_HAS_KERNING(fi->src->ft.face);
    prev_index = 0;
    prev_chr_end = 0;
@@ -419,14 +381,8 @@ evas_common_font_query_char_coords(RGBA_Font *fn, const Eina_Unicode *in_text, c
 	gl = *text;
 	if (gl == 0) break;
 	index = evas_common_font_glyph_search(fn, &fi, gl);
-	LKL(fi->ft_mutex);
 	fg = evas_common_font_int_cache_glyph_get(fi, index);
-	if (!fg) 
-          {
-             LKU(fi->ft_mutex);
-             continue;
-          }
-	// FIXME: Why no FT_Activate_Size here ?
+	if (!fg) continue;
 	kern = 0;
         /* hmmm kerning means i can't sanely do my own cached metric tables! */
 	/* grrr - this means font face sharing is kinda... not an option if */
@@ -439,7 +395,6 @@ evas_common_font_query_char_coords(RGBA_Font *fn, const Eina_Unicode *in_text, c
            }
 
 	pface = fi->src->ft.face;
-	LKU(fi->ft_mutex);
 	/* If the current one is not a compositing char, do the previous advance
 	 * and set the current advance as the next advance to do */
 	if (fg->glyph->advance.x >> 16 > 0) 
@@ -536,13 +491,6 @@ evas_common_font_query_char_at_coords(RGBA_Font *fn, const Eina_Unicode *in_text
    pen_y = 0;
    evas_common_font_int_reload(fi);
 //   evas_common_font_size_use(fn);
-   if (fi->src->current_size != fi->size)
-     {
-	FTLOCK();
-        FT_Activate_Size(fi->ft.size);
-	FTUNLOCK();
-        fi->src->current_size = fi->size;
-     }
    use_kerning = FT_HAS_KERNING(fi->src->ft.face);
    last_adv = 0;
    prev_index = 0;
@@ -560,15 +508,9 @@ evas_common_font_query_char_at_coords(RGBA_Font *fn, const Eina_Unicode *in_text
 	gl = *text;
 	if (gl == 0) break;
 	index = evas_common_font_glyph_search(fn, &fi, gl);
-	LKL(fi->ft_mutex);
 	fg = evas_common_font_int_cache_glyph_get(fi, index);
-	if (!fg) 
-          {
-             LKU(fi->ft_mutex);
-             continue;
-          }
+	if (!fg) continue;
            
-	// FIXME: Why not FT_Activate_Size here ?
 	kern = 0;
         /* hmmm kerning means i can't sanely do my own cached metric tables! */
 	/* grrr - this means font face sharing is kinda... not an option if */
@@ -580,7 +522,6 @@ evas_common_font_query_char_at_coords(RGBA_Font *fn, const Eina_Unicode *in_text
                 pen_x += kern;
            }
 	pface = fi->src->ft.face;
-	LKU(fi->ft_mutex);
 	/* If the current one is not a compositing char, do the previous advance 
 	 * and set the current advance as the next advance to do */
 	if (fg->glyph->advance.x >> 16 > 0) 
@@ -685,14 +626,6 @@ evas_common_font_query_last_up_to_pos(RGBA_Font *fn, const Eina_Unicode *in_text
 	gl = *text;
 	if (gl == 0) break;
 	index = evas_common_font_glyph_search(fn, &fi, gl);
-	LKL(fi->ft_mutex);
-        if (fi->src->current_size != fi->size)
-          {
-	     FTLOCK();
-             FT_Activate_Size(fi->ft.size);
-	     FTUNLOCK();
-             fi->src->current_size = fi->size;
-          }
         kern = 0;
         /* hmmm kerning means i can't sanely do my own cached metric tables! */
         /* grrr - this means font face sharing is kinda... not an option if */
@@ -727,7 +660,6 @@ evas_common_font_query_last_up_to_pos(RGBA_Font *fn, const Eina_Unicode *in_text
           }
 	pface = fi->src->ft.face;
 	fg = evas_common_font_int_cache_glyph_get(fi, index);
-	LKU(fi->ft_mutex);
 
 	if (kern < 0) kern = 0;
         chr_x = ((pen_x - kern) + (fg->glyph_out->left));
@@ -55,4 +55,7 @@ EAPI void
 EAPI int evas_common_load_rgba_image_module_from_file (Image_Entry *im);
 EAPI int evas_common_load_rgba_image_data_from_file   (Image_Entry *im);
 
+EAPI void evas_common_image_disk_cache_init           (void);
+EAPI void evas_common_image_disk_cache_shutdown       (void);
+
 #endif /* _EVAS_IMAGE_H */
@@ -17,17 +17,14 @@ evas_common_rgba_image_from_data(Image_Entry* ie_dst, int w, int h, DATA32 *imag
 	dst->image.no_free = 1;
 	dst->cache_entry.flags.alpha = alpha ? 1 : 0;
 	break;
-      case EVAS_COLORSPACE_YCBCR422P601_PL:
-      case EVAS_COLORSPACE_YCBCR422P709_PL:
+      default:
+	if (!evas_common_convert_yuv_rows_get(cspace, 1)) abort();
 	w &= ~0x1;
 	dst->cache_entry.w = w;
 	dst->cache_entry.h = h;
 	dst->cs.data = image_data;
 	dst->cs.no_free = 1;
 	break;
-      default:
-	abort();
-	break;
      }
    dst->cache_entry.space = cspace;
    evas_common_image_colorspace_dirty(dst);
@@ -38,6 +35,7 @@ int
 evas_common_rgba_image_from_copied_data(Image_Entry* ie_dst, int w, int h, DATA32 *image_data, int alpha, int cspace)
 {
    RGBA_Image   *dst = (RGBA_Image *) ie_dst;
+   int           rows;
 
    /* FIXME: Is dst->image.data valid. */
    switch (cspace)
@@ -47,14 +45,12 @@ evas_common_rgba_image_from_copied_data(Image_Entry* ie_dst, int w, int h, DATA3
         if (image_data)
           memcpy(dst->image.data, image_data, w * h * sizeof(DATA32));
         break;
-     case EVAS_COLORSPACE_YCBCR422P601_PL:
-     case EVAS_COLORSPACE_YCBCR422P709_PL:
-        dst->cs.data = calloc(1, dst->cache_entry.h * sizeof(unsigned char*) * 2);
-        if (image_data && (dst->cs.data))
-          memcpy(dst->cs.data,  image_data, dst->cache_entry.h * sizeof(unsigned char*) * 2);
-        break;
      default:
-        abort();
+        if (!evas_common_convert_yuv_rows_get(cspace, 1)) abort();
+        rows = evas_common_convert_yuv_rows_get(cspace, dst->cache_entry.h);
+        dst->cs.data = calloc(1, rows * sizeof(unsigned char*));
+        if (image_data && (dst->cs.data))
+          memcpy(dst->cs.data,  image_data, rows * sizeof(unsigned char*));
         break;
      }
 
@@ -68,16 +64,18 @@ evas_common_rgba_image_size_set(Image_Entry *ie_dst, const Image_Entry *ie_im, u
 {
    RGBA_Image   *dst = (RGBA_Image *) ie_dst;
    RGBA_Image   *im = (RGBA_Image *) ie_im;
+   int           yuv;
 
-   if ((im->cache_entry.space == EVAS_COLORSPACE_YCBCR422P601_PL) ||
-       (im->cache_entry.space == EVAS_COLORSPACE_YCBCR422P709_PL))
+   yuv = evas_common_convert_yuv_rows_get(im->cache_entry.space, 1);
+   if (yuv)
      w &= ~0x1;
 
    dst->flags = im->flags;
    dst->cs.no_free = 0;
-   if ((im->cache_entry.space == EVAS_COLORSPACE_YCBCR422P601_PL) ||
-       (im->cache_entry.space == EVAS_COLORSPACE_YCBCR422P709_PL))
-     dst->cs.data = calloc(1, dst->cache_entry.h * sizeof(unsigned char *) * 2);
+   if (yuv)
+     dst->cs.data = calloc(1, evas_common_convert_yuv_rows_get(im->cache_entry.space,
+                                                               dst->cache_entry.h) *
+                           sizeof(unsigned char *));
    evas_common_image_colorspace_dirty(dst);
 
    return 0;
@@ -87,6 +85,7 @@ int
 evas_common_rgba_image_colorspace_set(Image_Entry* ie_dst, int cspace)
 {
    RGBA_Image   *dst = (RGBA_Image *) ie_dst;
+   int           rows;
 
    switch (cspace)
      {
@@ -98,8 +97,9 @@ evas_common_rgba_image_colorspace_set(Image_Entry* ie_dst, int cspace)
 	     dst->cs.no_free = 0;
 	  }
 	break;
-      case EVAS_COLORSPACE_YCBCR422P601_PL:
-      case EVAS_COLORSPACE_YCBCR422P709_PL:
+      default:
+	if (!evas_common_convert_yuv_rows_get(cspace, 1)) abort();
+	rows = evas_common_convert_yuv_rows_get(cspace, dst->cache_entry.h);
 	if (dst->image.no_free)
 	  {
 	     dst->image.data = NULL;
@@ -110,12 +110,9 @@ evas_common_rgba_image_colorspace_set(Image_Entry* ie_dst, int cspace)
 	  {
 	     if (!dst->cs.no_free) free(dst->cs.data);
 	  }
-	dst->cs.data = calloc(1, dst->cache_entry.h * sizeof(unsigned char *) * 2);
+	dst->cs.data = calloc(1, rows * sizeof(unsigned char *));
 	dst->cs.no_free = 0;
 	break;
-      default:
-	abort();
-	break;
      }
    dst->cache_entry.space = cspace;
    evas_common_image_colorspace_dirty(dst);
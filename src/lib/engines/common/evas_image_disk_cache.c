@@ -0,0 +1,369 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#ifdef HAVE_EVIL
+# include <Evil.h>
+#endif
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#include "evas_common.h"
+#include "evas_private.h"
+#include "evas_image_private.h"
+
+/* persistent cache of decoded images. every entry is one file holding a
+ * small header, the lookup key and the ARGB8888 pixels starting on their
+ * own page, so in-process images can map the pixels in place and the cache
+ * server can read them straight into its shm. the key covers the source
+ * file's path, mtime and size, the image key and all load options, so an
+ * edited source simply stops matching and its stale entry ages out. the
+ * mtime of an entry is bumped on every hit, eviction drops the oldest
+ * entries until the directory is back under budget.
+ *
+ * the cache is off unless EVAS_IMAGE_DISK_CACHE_SIZE (in Kb) is set, it
+ * lives in EVAS_IMAGE_DISK_CACHE_DIR or else $XDG_CACHE_HOME/evas/images */
+
+#define DISK_CACHE_MAGIC 0x43445645 // "EVDC"
+#define DISK_CACHE_VERSION 1
+#define DISK_CACHE_DATA_OFFSET 4096
+#define DISK_CACHE_KEY_MAX (DISK_CACHE_DATA_OFFSET - sizeof(Disk_Cache_Header))
+
+typedef struct _Disk_Cache_Header Disk_Cache_Header;
+typedef struct _Disk_Cache_File Disk_Cache_File;
+
+struct _Disk_Cache_Header
+{
+   unsigned int magic;
+   unsigned int version;
+   unsigned int w, h;
+   unsigned int alpha;
+   unsigned int key_size; // the key follows the header
+};
+
+struct _Disk_Cache_File
+{
+   char *name;
+   time_t mtime;
+   off_t size;
+};
+
+static char *disk_cache_dir = NULL;
+static long long disk_cache_max = 0;
+static long long disk_cache_usage = -1; // unknown until the first scan
+static int initialised = 0;
+
+LK(lock_disk_cache); // guards the usage count and eviction
+
+static void
+_disk_cache_mkdir(char *path)
+{
+   char *p;
+
+   for (p = path + 1; *p; p++)
+     {
+        if (*p != '/') continue;
+        *p = 0;
+        mkdir(path, S_IRWXU);
+        *p = '/';
+     }
+   mkdir(path, S_IRWXU);
+}
+
+void
+evas_common_image_disk_cache_init(void)
+{
+   char buf[PATH_MAX];
+   const char *s;
+
+   initialised++;
+   if (initialised != 1) return;
+   LKI(lock_disk_cache);
+   s = getenv("EVAS_IMAGE_DISK_CACHE_SIZE");
+   if (s) disk_cache_max = atoll(s) * 1024;
+   if (disk_cache_max <= 0) return;
+   s = getenv("EVAS_IMAGE_DISK_CACHE_DIR");
+   if (s)
+     snprintf(buf, sizeof(buf), "%s", s);
+   else if ((s = getenv("XDG_CACHE_HOME")))
+     snprintf(buf, sizeof(buf), "%s/evas/images", s);
+   else if ((s = getenv("HOME")))
+     snprintf(buf, sizeof(buf), "%s/.cache/evas/images", s);
+   else
+     {
+        disk_cache_max = 0;
+        return;
+     }
+   _disk_cache_mkdir(buf);
+   disk_cache_dir = strdup(buf);
+   if (!disk_cache_dir) disk_cache_max = 0;
+}
+
+void
+evas_common_image_disk_cache_shutdown(void)
+{
+   if (initialised < 1) return;
+   initialised--;
+   if (initialised != 0) return;
+   free(disk_cache_dir);
+   disk_cache_dir = NULL;
+   disk_cache_max = 0;
+   disk_cache_usage = -1;
+   LKD(lock_disk_cache);
+}
+
+static int
+_disk_cache_key(Image_Entry *ie, char *key, char *path)
+{
+   RGBA_Image_Loadopts *lo = &(ie->load_opts);
+   struct stat st;
+   int len;
+
+   if ((!disk_cache_dir) || (!ie->file)) return 0;
+   if (ie->space != EVAS_COLORSPACE_ARGB8888) return 0;
+   if ((ie->w <= 0) || (ie->h <= 0)) return 0;
+   if (stat(ie->file, &st) < 0) return 0;
+   len = snprintf(key, DISK_CACHE_KEY_MAX, "%s\n%s\n%lli.%lli\n%i/%1.8f/%ux%u/%u,%u,%ux%u",
+                  ie->file, ie->key ? ie->key : "",
+                  (long long)st.st_mtime, (long long)st.st_size,
+                  lo->scale_down_by, lo->dpi, lo->w, lo->h,
+                  lo->region.x, lo->region.y, lo->region.w, lo->region.h);
+   if ((len <= 0) || (len >= (int)DISK_CACHE_KEY_MAX)) return 0;
+   snprintf(path, PATH_MAX, "%s/%08x%08x.evc", disk_cache_dir,
+            eina_hash_superfast(key, len), eina_hash_djb2(key, len));
+   return len;
+}
+
+/* opens the entry for @ie if there is a valid one, returns its fd */
+static int
+_disk_cache_open(Image_Entry *ie)
+{
+   unsigned char buf[DISK_CACHE_DATA_OFFSET];
+   char key[DISK_CACHE_KEY_MAX], path[PATH_MAX];
+   Disk_Cache_Header *hd = (Disk_Cache_Header *)buf;
+   struct stat st;
+   int fd, len;
+
+   len = _disk_cache_key(ie, key, path);
+   if (len <= 0) return -1;
+   fd = open(path, O_RDONLY);
+   if (fd < 0) return -1;
+   if ((pread(fd, buf, sizeof(buf), 0) != sizeof(buf)) ||
+       (hd->magic != DISK_CACHE_MAGIC) ||
+       (hd->version != DISK_CACHE_VERSION) ||
+       (hd->w != ie->w) || (hd->h != ie->h) ||
+       (hd->alpha != ie->flags.alpha) ||
+       (hd->key_size != (unsigned int)len) ||
+       (memcmp(buf + sizeof(Disk_Cache_Header), key, len)))
+     {
+        close(fd);
+        return -1;
+     }
+   /* a cut short entry (disk full, crash) would fault when mapped */
+   if ((fstat(fd, &st) < 0) ||
+       ((size_t)st.st_size <
+        (DISK_CACHE_DATA_OFFSET + ((size_t)ie->w * ie->h * sizeof(DATA32)))))
+     {
+        close(fd);
+        unlink(path);
+        return -1;
+     }
+   // keeps the lru order for eviction
+   futimens(fd, NULL);
+   return fd;
+}
+
+/* in-process images map the pixels copy-on-write, so writing to the image
+ * never reaches the cache file */
+static Eina_Bool
+_disk_cache_map(RGBA_Image *im, int fd)
+{
+   Image_Entry *ie = &(im->cache_entry);
+   size_t size;
+   void *map;
+
+   if (im->flags & RGBA_IMAGE_ALPHA_ONLY) return EINA_FALSE;
+   size = DISK_CACHE_DATA_OFFSET + (ie->w * ie->h * sizeof(DATA32));
+   map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   if (map == MAP_FAILED) return EINA_FALSE;
+   evas_common_image_disk_cache_unmap(im);
+   if ((im->image.data) && (!im->image.no_free)) free(im->image.data);
+   im->image.map = map;
+   im->image.map_size = size;
+   im->image.data = (DATA32 *)((unsigned char *)map + DISK_CACHE_DATA_OFFSET);
+   im->image.no_free = 1;
+   ie->allocated.w = ie->w;
+   ie->allocated.h = ie->h;
+   return EINA_TRUE;
+}
+
+/* fills @ie from its cache entry. images of the common cache get their
+ * pixels mapped, any other surface (the cache server's shm) has them read
+ * into it */
+Eina_Bool
+evas_common_image_disk_cache_load(Image_Entry *ie)
+{
+   DATA32 *pixels;
+   ssize_t size;
+   int fd;
+
+   if (disk_cache_max <= 0) return EINA_FALSE;
+   fd = _disk_cache_open(ie);
+   if (fd < 0) return EINA_FALSE;
+   if (ie->cache == evas_common_image_cache_get())
+     {
+        if (_disk_cache_map((RGBA_Image *)ie, fd))
+          {
+             close(fd);
+             return EINA_TRUE;
+          }
+     }
+   size = ie->w * ie->h * sizeof(DATA32);
+   evas_cache_image_surface_alloc(ie, ie->w, ie->h);
+   pixels = evas_cache_image_pixels(ie);
+   if ((!pixels) ||
+       (pread(fd, pixels, size, DISK_CACHE_DATA_OFFSET) != size))
+     {
+        close(fd);
+        return EINA_FALSE;
+     }
+   close(fd);
+   return EINA_TRUE;
+}
+
+void
+evas_common_image_disk_cache_unmap(RGBA_Image *im)
+{
+   unsigned char *map = im->image.map;
+
+   if (!map) return;
+   if (((unsigned char *)im->image.data >= map) &&
+       ((unsigned char *)im->image.data < (map + im->image.map_size)))
+     {
+        im->image.data = NULL;
+        im->image.no_free = 0;
+     }
+   munmap(map, im->image.map_size);
+   im->image.map = NULL;
+   im->image.map_size = 0;
+}
+
+static int
+_disk_cache_file_cmp(const void *a, const void *b)
+{
+   const Disk_Cache_File *fa = a, *fb = b;
+
+   if (fa->mtime < fb->mtime) return -1;
+   if (fa->mtime > fb->mtime) return 1;
+   return 0;
+}
+
+/* rescans the directory, other processes share it so the running count is
+ * only an estimate. if over budget drop the least recently used entries
+ * until a quarter of the budget is free again */
+static void
+_disk_cache_evict(void)
+{
+   Disk_Cache_File *files = NULL, *tmp;
+   int num = 0, alloc = 0, i;
+   long long total = 0;
+   char path[PATH_MAX];
+   struct dirent *de;
+   struct stat st;
+   DIR *dir;
+
+   dir = opendir(disk_cache_dir);
+   if (!dir) return;
+   while ((de = readdir(dir)))
+     {
+        size_t len = strlen(de->d_name);
+
+        if ((len < 5) || (strcmp(de->d_name + len - 4, ".evc"))) continue;
+        snprintf(path, sizeof(path), "%s/%s", disk_cache_dir, de->d_name);
+        if (stat(path, &st) < 0) continue;
+        if (num == alloc)
+          {
+             tmp = realloc(files, (alloc + 64) * sizeof(Disk_Cache_File));
+             if (!tmp) break;
+             files = tmp;
+             alloc += 64;
+          }
+        files[num].name = strdup(de->d_name);
+        if (!files[num].name) break;
+        files[num].mtime = st.st_mtime;
+        files[num].size = st.st_size;
+        total += st.st_size;
+        num++;
+     }
+   closedir(dir);
+   if (total > disk_cache_max)
+     {
+        qsort(files, num, sizeof(Disk_Cache_File), _disk_cache_file_cmp);
+        for (i = 0; (i < num) && (total > ((disk_cache_max * 3) / 4)); i++)
+          {
+             snprintf(path, sizeof(path), "%s/%s", disk_cache_dir, files[i].name);
+             if (unlink(path) == 0) total -= files[i].size;
+          }
+     }
+   for (i = 0; i < num; i++) free(files[i].name);
+   free(files);
+   disk_cache_usage = total;
+}
+
+/* writes the freshly decoded pixels of @ie out. entries are written under
+ * a temporary name, synced and renamed into place, so a reader never sees
+ * half of one, not even after a crash */
+void
+evas_common_image_disk_cache_store(Image_Entry *ie)
+{
+   unsigned char buf[DISK_CACHE_DATA_OFFSET];
+   char path[PATH_MAX], tmppath[PATH_MAX];
+   Disk_Cache_Header *hd = (Disk_Cache_Header *)buf;
+   DATA32 *pixels;
+   ssize_t size;
+   int fd, len;
+
+   if (disk_cache_max <= 0) return;
+   if ((ie->cache == evas_common_image_cache_get()) &&
+       (((RGBA_Image *)ie)->flags & RGBA_IMAGE_ALPHA_ONLY))
+     return;
+   size = ie->w * ie->h * sizeof(DATA32);
+   if ((size + DISK_CACHE_DATA_OFFSET) > disk_cache_max) return;
+   memset(buf, 0, sizeof(buf));
+   len = _disk_cache_key(ie, (char *)buf + sizeof(Disk_Cache_Header), path);
+   if (len <= 0) return;
+   pixels = evas_cache_image_pixels(ie);
+   if (!pixels) return;
+   hd->magic = DISK_CACHE_MAGIC;
+   hd->version = DISK_CACHE_VERSION;
+   hd->w = ie->w;
+   hd->h = ie->h;
+   hd->alpha = ie->flags.alpha;
+   hd->key_size = len;
+
+   snprintf(tmppath, sizeof(tmppath), "%s/.tmp-XXXXXX", disk_cache_dir);
+   fd = mkstemp(tmppath);
+   if (fd < 0) return;
+   if ((write(fd, buf, sizeof(buf)) != sizeof(buf)) ||
+       (write(fd, pixels, size) != size) ||
+       (fsync(fd) < 0) ||
+       (rename(tmppath, path) < 0))
+     {
+        close(fd);
+        unlink(tmppath);
+        return;
+     }
+   close(fd);
+
+   LKL(lock_disk_cache);
+   if (disk_cache_usage >= 0)
+     disk_cache_usage += DISK_CACHE_DATA_OFFSET + size;
+   if ((disk_cache_usage < 0) || (disk_cache_usage > disk_cache_max))
+     _disk_cache_evict();
+   LKU(lock_disk_cache);
+}
@@ -1,6 +1,7 @@
 #include "evas_common.h"
 #include "evas_private.h"
 #include "evas_cs.h"
+#include "evas_image_private.h"
 
 struct ext_loader_s
 {
@@ -239,6 +240,8 @@ evas_common_load_rgba_image_data_from_file(Image_Entry *ie)
 
    if (!ie->info.module) return EVAS_LOAD_ERROR_GENERIC;
 
+   if (evas_common_image_disk_cache_load(ie)) return EVAS_LOAD_ERROR_NONE;
+
 //   printf("load data [%p] %s %s\n", ie, ie->file, ie->key);
            
    evas_image_load_func = ie->info.loader;
@@ -247,6 +250,7 @@ evas_common_load_rgba_image_data_from_file(Image_Entry *ie)
      {
         return ret;
      }
+   evas_common_image_disk_cache_store(ie);
 
 //   evas_module_unref((Evas_Module*) ie->info.module);
 //   ie->info.module = NULL;
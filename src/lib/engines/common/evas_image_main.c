@@ -88,6 +88,7 @@ evas_common_image_init(void)
    eet_init();
 #endif
    evas_common_scalecache_init();
+   evas_common_image_disk_cache_init();
 }
 
 EAPI void
@@ -119,6 +120,7 @@ evas_common_image_shutdown(void)
    eet_shutdown();
 #endif
    evas_common_scalecache_shutdown();
+   evas_common_image_disk_cache_shutdown();
 }
 
 EAPI void
@@ -217,6 +219,7 @@ evas_common_rgba_image_unload(Image_Entry *ie)
      }
 #endif   
    
+   evas_common_image_disk_cache_unmap(im);
    if (im->image.data && !im->image.no_free)
      free(im->image.data);
    im->image.data = NULL;
@@ -264,6 +267,8 @@ _evas_common_rgba_image_surface_delete(Image_Entry *ie)
 
    if (ie->file)
      DBG("unload: [%p] %s %s", ie, ie->file, ie->key);
+   /* scale jobs may still be reading the pixels, let them go first */
+   evas_common_rgba_image_scalecache_dirty(&im->cache_entry);
    if ((im->cs.data) && (im->image.data))
      {
 	if (im->cs.data != im->image.data)
@@ -277,6 +282,7 @@ _evas_common_rgba_image_surface_delete(Image_Entry *ie)
      }
    im->cs.data = NULL;
 
+   evas_common_image_disk_cache_unmap(im);
    if (im->image.data && !im->image.no_free)
      free(im->image.data);
 #ifdef EVAS_CSERVE
@@ -284,7 +290,6 @@ _evas_common_rgba_image_surface_delete(Image_Entry *ie)
      evas_cserve_image_free(ie);
 #endif   
    im->image.data = NULL;
-   evas_common_rgba_image_scalecache_dirty(&im->cache_entry);
 }
 
 static void
@@ -506,15 +511,14 @@ evas_common_image_colorspace_normalize(RGBA_Image *im)
 	     im->cs.no_free = im->image.no_free;
 	  }
 	break;
-      case EVAS_COLORSPACE_YCBCR422P601_PL:
+      default:
 #ifdef BUILD_CONVERT_YUV
 	if ((im->image.data) && (*((unsigned char **)im->cs.data)))
-	  evas_common_convert_yuv_420p_601_rgba(im->cs.data, (DATA8*) im->image.data,
-						im->cache_entry.w, im->cache_entry.h);
+	  evas_common_convert_yuv_rgba(im->cs.data, (DATA8*) im->image.data,
+				       im->cache_entry.w, im->cache_entry.h,
+				       im->cache_entry.space);
 #endif
 	break;
-      default:
-	break;
      }
    im->cs.dirty = 0;
 }
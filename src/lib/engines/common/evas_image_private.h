@@ -13,5 +13,9 @@ void evas_common_rgba_image_scalecache_shutdown(Image_Entry *ie);
 void evas_common_rgba_image_scalecache_dirty(Image_Entry *ie);
 void evas_common_rgba_image_scalecache_orig_use(Image_Entry *ie);
 int evas_common_rgba_image_scalecache_usage_get(Image_Entry *ie);
+
+Eina_Bool evas_common_image_disk_cache_load(Image_Entry *ie);
+void evas_common_image_disk_cache_store(Image_Entry *ie);
+void evas_common_image_disk_cache_unmap(RGBA_Image *im);
     
 #endif /* _EVAS_IMAGE_PRIVATE_H */
@@ -23,15 +23,24 @@
 #define FLOP_DEL 1
 #define SCALE_CACHE_SIZE 4 * 1024 * 1024
 //#define SCALE_CACHE_SIZE 0
+#define SCALE_CACHE_GROW 4
+#define SCALECACHE_SHARDS 16
+#define SCALECACHE_BUCKETS 64
 
 typedef struct _Scaleitem Scaleitem;
+typedef struct _Scalecache_Shard Scalecache_Shard;
+typedef struct _Scalecache_Job Scalecache_Job;
 
 struct _Scaleitem
 {
    EINA_INLIST;
+   Scaleitem *hnext;
+   unsigned int hash;
+   Eina_List *node; // in parent_im->cache.list
    unsigned long long usage;
    unsigned long long usage_count;
    RGBA_Image *im, *parent_im;
+   Scalecache_Job *job;
    int src_x, src_y;
    unsigned int src_w, src_h;
    unsigned int dst_w, dst_h;
@@ -45,17 +54,42 @@ struct _Scaleitem
    Eina_Bool populate_me : 1;
 };
 
+/* all items of an image live in the same shard. a shard has its own lock,
+ * its own lru of populated items and a hash of all its items by key, so
+ * drawing different images neither contends on one lock nor walks lists */
+struct _Scalecache_Shard
+{
+   LK(lock);
+   Eina_Inlist *lru;
+   unsigned int size;
+   Scaleitem *buckets[SCALECACHE_BUCKETS];
+};
+
+/* a scaled copy being made on a preload worker. the item it is for can go
+ * away in the meantime, then sci is NULL and the result is thrown away */
+struct _Scalecache_Job
+{
+   LK(lock); // held by the worker while it reads the source
+   Scalecache_Shard *shard;
+   Scaleitem *sci;
+   RGBA_Image *src, *out;
+   RGBA_Draw_Context dc;
+   int src_x, src_y, src_w, src_h;
+   Eina_Bool smooth : 1;
+   Eina_Bool done : 1;
+};
+
 #ifdef SCALECACHE
 static unsigned long long use_counter = 0;
 
-#ifdef BUILD_PTHREAD
-static LK(cache_lock);
-#endif
-static Eina_Inlist *cache_list = NULL;
-static unsigned int cache_size = 0;
+static Scalecache_Shard shards[SCALECACHE_SHARDS];
 static int init = 0;
 
+/* the budget starts at max_cache_size and grows when what is drawn does
+ * not fit, up to a ceiling that also depends on how much memory is left.
+ * flushing the cache brings it back down */
 static unsigned int max_cache_size = SCALE_CACHE_SIZE;
+static unsigned int cache_budget = SCALE_CACHE_SIZE;
 static unsigned int max_dimension = MAX_SCALECACHE_DIM;
 static unsigned int max_flop_count = MAX_FLOP_COUNT;
 static unsigned int max_scale_items = MAX_SCALEITEMS;
@@ -67,13 +101,16 @@ evas_common_scalecache_init(void)
 {
 #ifdef SCALECACHE
    const char *s;
+   int i;
 
    init++;
    if (init > 1) return;
    use_counter = 0;
-   LKI(cache_lock);
+   for (i = 0; i < SCALECACHE_SHARDS; i++)
+     LKI(shards[i].lock);
    s = getenv("EVAS_SCALECACHE_SIZE");
    if (s) max_cache_size = atoi(s) * 1024;
+   cache_budget = max_cache_size;
    s = getenv("EVAS_SCALECACHE_MAX_DIMENSION");
    if (s) max_dimension = atoi(s);
    s = getenv("EVAS_SCALECACHE_MAX_FLOP_COUNT");
@@ -89,11 +126,145 @@ void
 evas_common_scalecache_shutdown(void)
 {
 #ifdef SCALECACHE
+   int i;
+
    init--;
-   if (init ==0)
-      LKD(cache_lock);
+   if (init == 0)
+     {
+        for (i = 0; i < SCALECACHE_SHARDS; i++)
+          LKD(shards[i].lock);
+     }
+#endif
+}
+
+#ifdef SCALECACHE
+static inline Scalecache_Shard *
+_shard_get(const RGBA_Image *im)
+{
+   unsigned long v = (unsigned long)im;
+
+   /* low bits are the same for all heap blocks */
+   v = (v >> 4) ^ (v >> 12);
+   return shards + (v % SCALECACHE_SHARDS);
+}
+
+static inline unsigned int
+_sci_hash(const RGBA_Image *im, int smooth,
+          int src_region_x, int src_region_y,
+          unsigned int src_region_w, unsigned int src_region_h,
+          unsigned int dst_region_w, unsigned int dst_region_h)
+{
+   unsigned int h;
+
+   h = (unsigned int)((unsigned long)im >> 4);
+   h = (h * 31) + src_region_x;
+   h = (h * 31) + src_region_y;
+   h = (h * 31) + src_region_w;
+   h = (h * 31) + src_region_h;
+   h = (h * 31) + dst_region_w;
+   h = (h * 31) + dst_region_h;
+   return (h << 1) | (!!smooth);
+}
+
+static void
+_sci_hash_add(Scalecache_Shard *sh, Scaleitem *sci)
+{
+   Scaleitem **b = &(sh->buckets[sci->hash % SCALECACHE_BUCKETS]);
+
+   sci->hnext = *b;
+   *b = sci;
+}
+
+static void
+_sci_hash_del(Scalecache_Shard *sh, Scaleitem *sci)
+{
+   Scaleitem **p = &(sh->buckets[sci->hash % SCALECACHE_BUCKETS]);
+
+   for (; *p; p = &((*p)->hnext))
+     {
+        if (*p != sci) continue;
+        *p = sci->hnext;
+        sci->hnext = NULL;
+        return;
+     }
+}
+
+/* drops the scaled copy of an item, shard lock held */
+static void
+_sci_unpopulate(Scalecache_Shard *sh, Scaleitem *sci)
+{
+   evas_common_rgba_image_free(&sci->im->cache_entry);
+   sci->im = NULL;
+   if (!sci->forced_unload)
+     sh->size -= sci->dst_w * sci->dst_h * 4;
+   else
+     sh->size -= sci->size_adjust;
+   sh->lru = eina_inlist_remove(sh->lru, (Eina_Inlist *)sci);
+   memset(sci, 0, sizeof(Eina_Inlist));
+}
+
+/* forgets the job working for an item whose source is about to go away.
+ * shard lock held, the job's worker never waits on it while reading */
+static void
+_sci_job_detach(Scaleitem *sci)
+{
+   Scalecache_Job *job = sci->job;
+
+   if (!job) return;
+   sci->job = NULL;
+   job->sci = NULL;
+   LKL(job->lock);
+   LKU(job->lock);
+}
+
+#ifndef EVAS_FRAME_QUEUING
+static Eina_Bool
+_sci_jobs_pending(RGBA_Image *im)
+{
+   Eina_List *l;
+   Scaleitem *sci;
+
+   EINA_LIST_FOREACH(im->cache.list, l, sci)
+     if (sci->job) return EINA_TRUE;
+   return EINA_FALSE;
+}
+#endif
+
+static unsigned int
+_cache_size_total(void)
+{
+   unsigned int size = 0;
+   int i;
+
+   /* read without locks, it only steers pruning */
+   for (i = 0; i < SCALECACHE_SHARDS; i++)
+     size += shards[i].size;
+   return size;
+}
+
+static void
+_cache_budget_grow(unsigned int size)
+{
+   unsigned int ceiling;
+
+   ceiling = max_cache_size * SCALE_CACHE_GROW;
+#if defined(_SC_AVPHYS_PAGES) && defined(_SC_PAGESIZE)
+     {
+        long pages, psize;
+
+        pages = sysconf(_SC_AVPHYS_PAGES);
+        psize = sysconf(_SC_PAGESIZE);
+        /* never take more than an 8th of what is still free */
+        if ((pages > 0) && (psize > 0) &&
+            ((unsigned long long)pages * psize / 8) < ceiling)
+          ceiling = (unsigned long long)pages * psize / 8;
+     }
 #endif
+   if (ceiling < max_cache_size) ceiling = max_cache_size;
+   if ((cache_budget + size) < ceiling) cache_budget += size;
+   else cache_budget = ceiling;
 }
+#endif
 
 void
 evas_common_rgba_image_scalecache_init(Image_Entry *ie)
@@ -119,6 +290,7 @@ evas_common_rgba_image_scalecache_dirty(Image_Entry *ie)
 {
 #ifdef SCALECACHE
    RGBA_Image *im = (RGBA_Image *)ie;
+   Scalecache_Shard *sh = _shard_get(im);
    LKL(im->cache.lock);
    while (im->cache.list)
      {
@@ -127,19 +299,13 @@ evas_common_rgba_image_scalecache_dirty(Image_Entry *ie)
 #ifdef EVAS_FRAME_QUEUING
         WRLKL(sci->lock);
 #endif
-        im->cache.list = eina_list_remove(im->cache.list, sci);
-        if (sci->im)
-          {
-//             INF(" 0- %i", sci->dst_w * sci->dst_h * 4);
-             LKL(cache_lock);
-             evas_common_rgba_image_free(&sci->im->cache_entry);
-             if (!sci->forced_unload)
-               cache_size -= sci->dst_w * sci->dst_h * 4;
-             else
-               cache_size -= sci->size_adjust;
-             cache_list = eina_inlist_remove(cache_list, (Eina_Inlist *)sci);
-             LKU(cache_lock);
-          }
+        im->cache.list = eina_list_remove_list(im->cache.list, sci->node);
+        LKL(sh->lock);
+        _sci_hash_del(sh, sci);
+        _sci_job_detach(sci);
+//        if (sci->im) INF(" 0- %i", sci->dst_w * sci->dst_h * 4);
+        if (sci->im) _sci_unpopulate(sh, sci);
+        LKU(sh->lock);
 #ifdef EVAS_FRAME_QUEUING
          RWLKU(sci->lock);
          RWLKD(sci->lock);
@@ -205,7 +371,7 @@ _sci_fix_newest(RGBA_Image *im)
 }
 
 static Scaleitem *
-_sci_find(RGBA_Image *im,
+_sci_find(Scalecache_Shard *sh, RGBA_Image *im,
           RGBA_Draw_Context *dc __UNUSED__, int smooth,
           int src_region_x, int src_region_y,
           unsigned int src_region_w, unsigned int src_region_h,
@@ -213,10 +379,15 @@ _sci_find(RGBA_Image *im,
 {
    Eina_List *l;
    Scaleitem *sci;
+   unsigned int hash;
 
-   EINA_LIST_FOREACH(im->cache.list, l, sci)
+   hash = _sci_hash(im, smooth, src_region_x, src_region_y,
+                    src_region_w, src_region_h, dst_region_w, dst_region_h);
+   for (sci = sh->buckets[hash % SCALECACHE_BUCKETS]; sci; sci = sci->hnext)
      {
         if (
+            (sci->hash == hash) &&
+            (sci->parent_im == im) &&
             (sci->src_w == src_region_w) &&
             (sci->src_h == src_region_h) &&
             (sci->dst_w == dst_region_w) &&
@@ -226,11 +397,7 @@ _sci_find(RGBA_Image *im,
             (sci->smooth == smooth)
             )
           {
-             if (im->cache.list != l)
-               {
-                  im->cache.list = eina_list_remove_list(im->cache.list, l);
-                  im->cache.list = eina_list_prepend(im->cache.list, sci);
-               }
+             im->cache.list = eina_list_promote_list(im->cache.list, sci->node);
              return sci;
           }
      }
@@ -238,23 +405,18 @@ _sci_find(RGBA_Image *im,
      {
         l = eina_list_last(im->cache.list);
         sci = l->data;
+        /* a copy is being made for it, try again once it's in */
+        if (sci->job) return NULL;
 #ifdef EVAS_FRAME_QUEUING
         WRLKL(sci->lock);
 #endif
         im->cache.list = eina_list_remove_list(im->cache.list, l);
+        _sci_hash_del(sh, sci);
         if ((sci->usage == im->cache.newest_usage) ||
             (sci->usage_count == im->cache.newest_usage_count))
           _sci_fix_newest(im);
-        if (sci->im)
-          {
-             evas_common_rgba_image_free(&sci->im->cache_entry);
-             if (!sci->forced_unload)
-               cache_size -= sci->dst_w * sci->dst_h * 4;
-             else
-               cache_size -= sci->size_adjust;
-//             INF(" 1- %i", sci->dst_w * sci->dst_h * 4);
-             cache_list = eina_inlist_remove(cache_list, (Eina_Inlist *)sci);
-          }
+//        if (sci->im) INF(" 1- %i", sci->dst_w * sci->dst_h * 4);
+        if (sci->im) _sci_unpopulate(sh, sci);
 #ifdef EVAS_FRAME_QUEUING
         RWLKU(sci->lock);
 #endif
@@ -267,6 +429,7 @@ _sci_find(RGBA_Image *im,
         if (eina_list_count(im->cache.list) > (max_scale_items - 1))
           return NULL;
         sci = calloc(1, sizeof(Scaleitem));
+        if (!sci) return NULL;
         sci->parent_im = im;
 #ifdef EVAS_FRAME_QUEUING
         RWLKI(sci->lock);
@@ -285,18 +448,23 @@ _sci_find(RGBA_Image *im,
    sci->src_h = src_region_h;
    sci->dst_w = dst_region_w;
    sci->dst_h = dst_region_h;
+   sci->hash = hash;
+   _sci_hash_add(sh, sci);
    im->cache.list = eina_list_prepend(im->cache.list, sci);
+   sci->node = im->cache.list;
    return sci;
 }
 
+/* evicts least recently used copies of the shard until the whole cache is
+ * within budget. shard lock held */
 static void
-_cache_prune(Scaleitem *notsci, Eina_Bool copies_only)
+_cache_prune(Scalecache_Shard *sh, Scaleitem *notsci, Eina_Bool copies_only)
 {
    Scaleitem *sci;
-   while (cache_size > max_cache_size)
+   while (_cache_size_total() > cache_budget)
      {
-        if (!cache_list) break;
-        sci = (Scaleitem *)(cache_list);
+        if (!sh->lru) break;
+        sci = (Scaleitem *)(sh->lru);
         if (copies_only)
           {
              while ((sci) && (!sci->parent_im->image.data))
@@ -309,39 +477,62 @@ _cache_prune(Scaleitem *notsci, Eina_Bool copies_only)
 #endif
         if (sci->im)
           {
-             evas_common_rgba_image_free(&sci->im->cache_entry);
-             sci->im = NULL;
+//             INF(" 2- %i", sci->dst_w * sci->dst_h * 4);
+             _sci_unpopulate(sh, sci);
              sci->usage = 0;
              sci->usage_count = 0;
              sci->flop += FLOP_ADD;
-             if (!sci->forced_unload)
-               cache_size -= sci->dst_w * sci->dst_h * 4;
-             else
-               cache_size -= sci->size_adjust;
-//             INF(" 2- %i", sci->dst_w * sci->dst_h * 4);
-             cache_list = eina_inlist_remove(cache_list, (Eina_Inlist *)sci);
-             memset(sci, 0, sizeof(Eina_Inlist));
           }
 #ifdef EVAS_FRAME_QUEUING
         RWLKU(sci->lock);
 #endif
 
-//        INF("FLUSH %i > %i", cache_size, max_cache_size);
+//        INF("FLUSH %i > %i", _cache_size_total(), cache_budget);
       }
 }
+
+/* after pruning its own shard, a shard that is still over budget takes
+ * from the others too, but only from those nobody is using right now */
+static void
+_cache_prune_others(Scalecache_Shard *sh)
+{
+   int i, busy;
+
+   for (i = 0; i < SCALECACHE_SHARDS; i++)
+     {
+        if (_cache_size_total() <= cache_budget) return;
+        if ((shards + i) == sh) continue;
+        busy = LKT(shards[i].lock);
+        if (busy) continue;
+        _cache_prune(shards + i, NULL, 0);
+        LKU(shards[i].lock);
+     }
+}
+
+static void
+_cache_prune_all(Eina_Bool copies_only)
+{
+   int i;
+
+   for (i = 0; i < SCALECACHE_SHARDS; i++)
+     {
+        LKL(shards[i].lock);
+        _cache_prune(shards + i, NULL, copies_only);
+        LKU(shards[i].lock);
+     }
+}
 #endif
 
 EAPI void
 evas_common_rgba_image_scalecache_size_set(unsigned int size)
 {
 #ifdef SCALECACHE
-   LKL(cache_lock);
    if (size != max_cache_size)
      {
         max_cache_size = size;
-        _cache_prune(NULL, 1);
+        cache_budget = size;
+        _cache_prune_all(1);
      }
-   LKU(cache_lock);
 #endif   
 }
 
@@ -349,11 +540,7 @@ EAPI unsigned int
 evas_common_rgba_image_scalecache_size_get(void)
 {
 #ifdef SCALECACHE
-   int t;
-   LKL(cache_lock);
-   t = max_cache_size;
-   LKU(cache_lock);
-   return t;
+   return max_cache_size;
 #else
    return 0;
 #endif   
@@ -363,13 +550,11 @@ EAPI void
 evas_common_rgba_image_scalecache_dump(void)
 {
 #ifdef SCALECACHE
-   int t;
-   LKL(cache_lock);
-   t = max_cache_size;
-   max_cache_size = 0;
-   _cache_prune(NULL, 0);
-   max_cache_size = t;
-   LKU(cache_lock);
+   unsigned int t;
+   t = cache_budget;
+   cache_budget = 0;
+   _cache_prune_all(0);
+   cache_budget = t;
 #endif   
 }
 
@@ -377,13 +562,10 @@ EAPI void
 evas_common_rgba_image_scalecache_flush(void)
 {
 #ifdef SCALECACHE
-   int t;
-   LKL(cache_lock);
-   t = max_cache_size;
-   max_cache_size = 0;
-   _cache_prune(NULL, 1);
-   max_cache_size = t;
-   LKU(cache_lock);
+   /* asked to give memory back, so forget what the budget grew to */
+   cache_budget = 0;
+   _cache_prune_all(1);
+   cache_budget = max_cache_size;
 #endif   
 }
 
@@ -397,6 +579,7 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst __UNU
 {
 #ifdef SCALECACHE
    RGBA_Image *im = (RGBA_Image *)ie;
+   Scalecache_Shard *sh;
    Scaleitem *sci;
    if (!im->image.data) return;
    if ((dst_region_w == 0) || (dst_region_h == 0) ||
@@ -420,13 +603,14 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst __UNU
         LKU(im->cache.lock);
         return;
      }
-   LKL(cache_lock);
-   sci = _sci_find(im, dc, smooth, 
+   sh = _shard_get(im);
+   LKL(sh->lock);
+   sci = _sci_find(sh, im, dc, smooth, 
                    src_region_x, src_region_y, src_region_w, src_region_h, 
                    dst_region_w, dst_region_h);
    if (!sci)
      {
-        LKU(cache_lock);
+        LKU(sh->lock);
         LKU(im->cache.lock);
         return;
      }
@@ -440,7 +624,7 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst __UNU
 //       && (sci->usage_count > (use_counter - MIN_SCALE_AGE_GAP))
        )
      {
-        if (!sci->im)
+        if ((!sci->im) && (!sci->job))
           {
              if ((sci->dst_w < max_dimension) && 
                  (sci->dst_h < max_dimension))
@@ -455,7 +639,7 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst __UNU
      }
    sci->usage++;
    sci->usage_count = use_counter;
-   LKU(cache_lock);
+   LKU(sh->lock);
    if (sci->usage > im->cache.newest_usage) 
      im->cache.newest_usage = sci->usage;
 //   INF("newset? %p %i > %i", im, 
@@ -473,6 +657,125 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst __UNU
 //static int hits = 0;
 //static int misses = 0;
 //static int noscales = 0;
+
+/* the scalers clip with the context, so each scale gets its own */
+static void
+_scale_context_init(RGBA_Draw_Context *ct)
+{
+   memset(ct, 0, sizeof(RGBA_Draw_Context));
+   ct->sli.h = 1;
+   evas_common_draw_context_set_render_op(ct, _EVAS_RENDER_COPY);
+}
+
+#ifdef BUILD_ASYNC_PRELOAD
+/* im->cache.lock held */
+static Scalecache_Job *
+_scalecache_job_new(Scalecache_Shard *sh, Scaleitem *sci, RGBA_Image *im,
+                    int smooth,
+                    int src_region_x, int src_region_y,
+                    int src_region_w, int src_region_h,
+                    int dst_region_w, int dst_region_h)
+{
+   Scalecache_Job *job;
+
+   job = calloc(1, sizeof(Scalecache_Job));
+   if (!job) return NULL;
+   job->out = evas_common_image_new(dst_region_w, dst_region_h,
+                                    im->cache_entry.flags.alpha);
+   if (!job->out)
+     {
+        free(job);
+        return NULL;
+     }
+   _scale_context_init(&job->dc);
+   LKI(job->lock);
+   job->shard = sh;
+   job->sci = sci;
+   job->src = im;
+   job->src_x = src_region_x;
+   job->src_y = src_region_y;
+   job->src_w = src_region_w;
+   job->src_h = src_region_h;
+   job->smooth = smooth;
+   sci->job = job;
+   return job;
+}
+
+static void
+_scalecache_job_run(void *data)
+{
+   Scalecache_Job *job = data;
+   RGBA_Image *src;
+
+   LKL(job->shard->lock);
+   if (!job->sci)
+     {
+        LKU(job->shard->lock);
+        return;
+     }
+   LKL(job->lock);
+   LKU(job->shard->lock);
+   src = job->src;
+   if (src->image.data)
+     {
+        if (job->smooth)
+          evas_common_scale_rgba_in_to_out_clip_smooth
+          (src, job->out, &job->dc,
+           job->src_x, job->src_y, job->src_w, job->src_h,
+           0, 0, job->out->cache_entry.w, job->out->cache_entry.h);
+        else
+          evas_common_scale_rgba_in_to_out_clip_sample
+          (src, job->out, &job->dc,
+           job->src_x, job->src_y, job->src_w, job->src_h,
+           0, 0, job->out->cache_entry.w, job->out->cache_entry.h);
+        job->done = 1;
+     }
+   LKU(job->lock);
+}
+
+/* runs in the main loop, also for jobs that never got to run */
+static void
+_scalecache_job_end(void *data)
+{
+   Scalecache_Job *job = data;
+   Scalecache_Shard *sh = job->shard;
+   Scaleitem *sci;
+   RGBA_Image *im;
+
+   LKL(sh->lock);
+   sci = job->sci;
+   LKU(sh->lock);
+   if (sci)
+     {
+        /* images are freed from the main loop only and a freed image
+         * would have detached us, so the source is still around */
+        im = job->src;
+        LKL(im->cache.lock);
+        LKL(sh->lock);
+        if (job->sci)
+          {
+             sci->job = NULL;
+             if (job->done)
+               {
+//                  pops++;
+                  sci->im = job->out;
+                  job->out = NULL;
+                  im->cache.orig_usage++;
+                  im->cache.usage_count = use_counter;
+                  sh->size += sci->dst_w * sci->dst_h * 4;
+                  sh->lru = eina_inlist_append(sh->lru, (Eina_Inlist *)sci);
+                  _cache_prune(sh, sci, 0);
+                  _cache_prune_others(sh);
+               }
+          }
+        LKU(sh->lock);
+        LKU(im->cache.lock);
+     }
+   if (job->out) evas_common_rgba_image_free(&job->out->cache_entry);
+   LKD(job->lock);
+   free(job);
+}
+#endif
 #endif
 
 EAPI void
@@ -485,9 +788,16 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
 {
 #ifdef SCALECACHE
    RGBA_Image *im = (RGBA_Image *)ie;
+   Scalecache_Shard *sh;
    Scaleitem *sci;
+#ifdef BUILD_ASYNC_PRELOAD
+   Scalecache_Job *job = NULL;
+#endif
    int didpop = 0;
    int dounload = 0;
+#ifndef EVAS_FRAME_QUEUING
+   int busy = 0;
+#endif
 /*
    static int i = 0;
 
@@ -531,11 +841,12 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
           }
         return;
      }
-   LKL(cache_lock);
-   sci = _sci_find(im, dc, smooth,
+   sh = _shard_get(im);
+   LKL(sh->lock);
+   sci = _sci_find(sh, im, dc, smooth,
                    src_region_x, src_region_y, src_region_w, src_region_h,
                    dst_region_w, dst_region_h);
-   LKU(cache_lock);
+   LKU(sh->lock);
    if (!sci)
      {
 #ifdef EVAS_FRAME_QUEUING
@@ -598,13 +909,33 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
         else
           {
              size *= sizeof(DATA32);
-             if ((cache_size + size) > max_cache_size)
+             /* not fitting means the cache is too small for what is
+              * drawn, let it grow if there is memory to spare */
+             if ((_cache_size_total() + size) > cache_budget)
+               _cache_budget_grow(size);
+             if ((_cache_size_total() + size) > cache_budget)
                {
                   sci->populate_me = 0;
                   im->cache.populate_count--;
                }
           }
      }
+#ifdef BUILD_ASYNC_PRELOAD
+   if ((sci->populate_me) && (!dounload))
+     {
+        /* drawn the slow way this time, a worker makes the copy for the
+         * next ones */
+        job = _scalecache_job_new(sh, sci, im, smooth,
+                                  src_region_x, src_region_y,
+                                  src_region_w, src_region_h,
+                                  dst_region_w, dst_region_h);
+        if (job)
+          {
+             sci->populate_me = 0;
+             im->cache.populate_count--;
+          }
+     }
+#endif
    if (sci->populate_me)
      {
 //        INF("##! populate!");
@@ -612,20 +943,14 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
           (dst_region_w, dst_region_h, im->cache_entry.flags.alpha);
         if (sci->im)
           {
-             static RGBA_Draw_Context *ct = NULL;
+             RGBA_Draw_Context ct;
         
-             LKL(cache_lock);
+             LKL(sh->lock);
              im->cache.orig_usage++;
              im->cache.usage_count = use_counter;
              im->cache.populate_count--;
 //             pops++;
-             if (!ct)
-               {
-                  // FIXME: static ct - never can free on shutdown? not a leak
-                  // or real harm - just annoying valgrind bitch
-                  ct = evas_common_draw_context_new();
-                  evas_common_draw_context_set_render_op(ct, _EVAS_RENDER_COPY);
-               }
+             _scale_context_init(&ct);
              if (im->cache_entry.space == EVAS_COLORSPACE_ARGB8888)
                evas_cache_image_load_data(&im->cache_entry);
              evas_common_image_colorspace_normalize(im);
@@ -633,14 +958,14 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
                {
                   if (smooth)
                     evas_common_scale_rgba_in_to_out_clip_smooth
-                    (im, sci->im, ct,
+                    (im, sci->im, &ct,
                      src_region_x, src_region_y, 
                      src_region_w, src_region_h,
                      0, 0,
                      dst_region_w, dst_region_h);
                   else
                     evas_common_scale_rgba_in_to_out_clip_sample
-                    (im, sci->im, ct,
+                    (im, sci->im, &ct,
                      src_region_x, src_region_y, 
                      src_region_w, src_region_h,
                      0, 0,
@@ -674,18 +999,19 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
              if (dounload)
                {
                   sci->forced_unload = 1;
-                  cache_size += sci->size_adjust;
+                  sh->size += sci->size_adjust;
                }
              else
                {
-                  cache_size += sci->dst_w * sci->dst_h * 4;
+                  sh->size += sci->dst_w * sci->dst_h * 4;
                }
 //             INF(" + %i @ flop: %i (%ix%i)", 
 //                    sci->dst_w * sci->dst_h * 4, sci->flop, 
 //                    sci->dst_w, sci->dst_h);
-             cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
-             _cache_prune(sci, 0);
-             LKU(cache_lock);
+             sh->lru = eina_inlist_append(sh->lru, (Eina_Inlist *)sci);
+             _cache_prune(sh, sci, 0);
+             _cache_prune_others(sh);
+             LKU(sh->lock);
              didpop = 1;
           }
      }
@@ -693,10 +1019,9 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
      {
         if (!didpop)
           {
-	     LKL(cache_lock);
-             cache_list = eina_inlist_remove(cache_list, (Eina_Inlist *)sci);
-             cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
-	     LKU(cache_lock);
+	     LKL(sh->lock);
+             sh->lru = eina_inlist_demote(sh->lru, (Eina_Inlist *)sci);
+	     LKU(sh->lock);
           }
         else
           {
@@ -705,6 +1030,9 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
 //        INF("use cached!");
 #ifdef EVAS_FRAME_QUEUING
         RDLKL(sci->lock);
+#else
+        /* workers may still be reading the original */
+        busy = _sci_jobs_pending(im);
 #endif
         LKU(im->cache.lock);
         evas_common_scale_rgba_in_to_out_clip_sample
@@ -729,14 +1057,15 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
          * causes only speed-down side-effect and no memory usage gain;
          * it will be loaded again for the very next rendering for this image.
          */
-        if ((dounload) || 
+        if ((!busy) &&
+            ((dounload) || 
             ((im->cache_entry.flags.loaded) && 
              ((!im->cs.no_free) 
 #ifdef EVAS_CSERVE             
              || (ie->data1)
 #endif             
               )  &&
-             (im->cache_entry.space == EVAS_COLORSPACE_ARGB8888)))
+             (im->cache_entry.space == EVAS_COLORSPACE_ARGB8888))))
           {
              if ((dounload) || (im->cache.orig_usage < 
                                 (im->cache.newest_usage / 20)))
@@ -773,6 +1102,14 @@ evas_common_rgba_image_scalecache_do(Image_Entry *ie, RGBA_Image *dst,
                                                             dst_region_x, dst_region_y, 
                                                             dst_region_w, dst_region_h);
           }
+#ifdef BUILD_ASYNC_PRELOAD
+        if (job)
+          evas_preload_thread_run(_scalecache_job_run,
+                                  _scalecache_job_end,
+                                  _scalecache_job_end,
+                                  job,
+                                  EVAS_IMAGE_PRELOAD_PRIORITY_SOON_VISIBLE);
+#endif
      }
 #else   
    RGBA_Image *im = (RGBA_Image *)ie;
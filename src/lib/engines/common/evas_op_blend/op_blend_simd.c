@@ -0,0 +1,243 @@
+/* blend spans, sse4.1 / avx2. included once per vector width, the last
+ * (l % V_W) pixels of a span are left to the C kernels */
+
+#include "evas_blend_simd.h"
+
+/* blend pixel --> dst */
+
+static void V_TARGET
+V_FN(_op_blend_p_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T v256 = V(set1)(256);
+
+   for (; d < e; s += V_W, d += V_W)
+     {
+        V_T vs = V(load)(s);
+
+        V(store)(d, V(add)(vs, V(mul_256)(V(sub)(v256, V(alpha)(vs)), V(load)(d))));
+     }
+   _op_blend_p_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_pas_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T v256 = V(set1)(256);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; s += V_W, d += V_W)
+     {
+        V_T vs = V(load)(s), vd, va;
+
+        va = V(alpha)(vs);
+        if (V(none)(va)) continue;
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(va, zero), vd,
+                              V(add)(vs, V(mul_256)(V(sub)(v256, va), vd))));
+     }
+   _op_blend_pas_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* blend color --> dst */
+
+static void V_TARGET
+V_FN(_op_blend_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T va = V(set1)(256 - (c >> 24));
+
+   for (; d < e; d += V_W)
+     V(store)(d, V(add)(vc, V(mul_256)(va, V(load)(d))));
+   _op_blend_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* blend pixel x color --> dst */
+
+static void V_TARGET
+V_FN(_op_blend_p_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T v256 = V(set1)(256);
+
+   for (; d < e; s += V_W, d += V_W)
+     {
+        V_T sc = V(mul4_sym)(vc, V(load)(s));
+
+        V(store)(d, V(add)(sc, V(mul_256)(V(sub)(v256, V(alpha)(sc)), V(load)(d))));
+     }
+   _op_blend_p_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_pan_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T vca = V(set1)(c & 0xff000000);
+   const V_T va = V(set1)(256 - (c >> 24));
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(add)(V(add)(vca, V(mul3_sym)(vc, V(load)(s))),
+                        V(mul_256)(va, V(load)(d))));
+   _op_blend_pan_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_p_can_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T v256 = V(set1)(256);
+   const V_T amask = V(set1)(0xff000000);
+
+   for (; d < e; s += V_W, d += V_W)
+     {
+        V_T vs = V(load)(s);
+
+        V(store)(d, V(add)(V(add)(V(and)(vs, amask), V(mul3_sym)(vc, vs)),
+                           V(mul_256)(V(sub)(v256, V(alpha)(vs)), V(load)(d))));
+     }
+   _op_blend_p_can_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_pan_can_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T amask = V(set1)(0xff000000);
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(add)(amask, V(mul3_sym)(vc, V(load)(s))));
+   _op_blend_pan_can_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_p_caa_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(1 + (c & 0xff));
+   const V_T v256 = V(set1)(256);
+
+   for (; d < e; s += V_W, d += V_W)
+     {
+        V_T sc = V(mul_256)(vc, V(load)(s));
+
+        V(store)(d, V(add)(sc, V(mul_256)(V(sub)(v256, V(alpha)(sc)), V(load)(d))));
+     }
+   _op_blend_p_caa_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_pan_caa_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(1 + (c & 0xff));
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(interp_256)(vc, V(load)(s), V(load)(d)));
+   _op_blend_pan_caa_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* blend mask x color -> dst */
+
+static void V_TARGET
+V_FN(_op_blend_mas_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T v256 = V(set1)(256);
+
+   for (; d < e; m += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), mc;
+
+        if (V(none)(vm)) continue;
+        mc = V(mul_sym)(vm, vc);
+        V(store)(d, V(add)(mc, V(mul_256)(V(sub)(v256, V(alpha)(mc)), V(load)(d))));
+     }
+   _op_blend_mas_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_mas_can_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T one = V(set1)(1);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; m += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), vd;
+
+        if (V(none)(vm)) continue;
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(vm, zero), vd,
+                              V(interp_256)(V(add)(vm, one), vc, vd)));
+     }
+   _op_blend_mas_can_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* blend pixel x mask --> dst */
+
+static void V_TARGET
+V_FN(_op_blend_p_mas_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T v256 = V(set1)(256);
+
+   for (; d < e; m += V_W, s += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), ms;
+
+        if (V(none)(vm)) continue;
+        ms = V(mul_sym)(vm, V(load)(s));
+        V(store)(d, V(add)(ms, V(mul_256)(V(sub)(v256, V(alpha)(ms)), V(load)(d))));
+     }
+   _op_blend_p_mas_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_blend_pan_mas_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T one = V(set1)(1);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; m += V_W, s += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), vd;
+
+        if (V(none)(vm)) continue;
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(vm, zero), vd,
+                              V(interp_256)(V(add)(vm, one), V(load)(s), vd)));
+     }
+   _op_blend_pan_mas_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* same table slots as the C kernels, pas x mask stays with C */
+static void
+V_FN(init_blend_simd_span_funcs)(void)
+{
+   int dp;
+
+   for (dp = DP; dp <= DP_AN; dp++)
+     {
+        op_blend_span_funcs[SP][SM_N][SC_N][dp][V_CPU] = V_FN(_op_blend_p_dp);
+        op_blend_span_funcs[SP_AS][SM_N][SC_N][dp][V_CPU] = V_FN(_op_blend_pas_dp);
+
+        op_blend_span_funcs[SP_N][SM_N][SC][dp][V_CPU] = V_FN(_op_blend_c_dp);
+        op_blend_span_funcs[SP_N][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_blend_c_dp);
+
+        op_blend_span_funcs[SP][SM_N][SC][dp][V_CPU] = V_FN(_op_blend_p_c_dp);
+        op_blend_span_funcs[SP_AS][SM_N][SC][dp][V_CPU] = V_FN(_op_blend_p_c_dp);
+        op_blend_span_funcs[SP_AN][SM_N][SC][dp][V_CPU] = V_FN(_op_blend_pan_c_dp);
+        op_blend_span_funcs[SP][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_blend_p_can_dp);
+        op_blend_span_funcs[SP_AS][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_blend_p_can_dp);
+        op_blend_span_funcs[SP_AN][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_blend_pan_can_dp);
+        op_blend_span_funcs[SP][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_blend_p_caa_dp);
+        op_blend_span_funcs[SP_AS][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_blend_p_caa_dp);
+        op_blend_span_funcs[SP_AN][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_blend_pan_caa_dp);
+
+        op_blend_span_funcs[SP_N][SM_AS][SC][dp][V_CPU] = V_FN(_op_blend_mas_c_dp);
+        op_blend_span_funcs[SP_N][SM_AS][SC_N][dp][V_CPU] = V_FN(_op_blend_mas_can_dp);
+        op_blend_span_funcs[SP_N][SM_AS][SC_AN][dp][V_CPU] = V_FN(_op_blend_mas_can_dp);
+        op_blend_span_funcs[SP_N][SM_AS][SC_AA][dp][V_CPU] = V_FN(_op_blend_mas_c_dp);
+
+        op_blend_span_funcs[SP][SM_AS][SC_N][dp][V_CPU] = V_FN(_op_blend_p_mas_dp);
+        op_blend_span_funcs[SP_AN][SM_AS][SC_N][dp][V_CPU] = V_FN(_op_blend_pan_mas_dp);
+     }
+}
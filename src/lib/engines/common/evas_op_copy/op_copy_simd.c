@@ -0,0 +1,100 @@
+/* copy spans, sse4.1 / avx2. plain pixel copies stay a memcpy */
+
+#include "evas_blend_simd.h"
+
+/* copy color --> dst */
+
+static void V_TARGET
+V_FN(_op_copy_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+
+   for (; d < e; d += V_W)
+     V(store)(d, vc);
+   _op_copy_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* copy pixel x color --> dst */
+
+static void V_TARGET
+V_FN(_op_copy_p_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(mul4_sym)(vc, V(load)(s)));
+   _op_copy_p_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_copy_p_caa_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(1 + (c >> 24));
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(mul_256)(vc, V(load)(s)));
+   _op_copy_p_caa_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* copy mask x color -> dst */
+
+static void V_TARGET
+V_FN(_op_copy_mas_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+   const V_T one = V(set1)(1);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; m += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), vd;
+
+        if (V(none)(vm)) continue;
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(vm, zero), vd,
+                              V(interp_256)(V(add)(vm, one), vc, vd)));
+     }
+   _op_copy_mas_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* copy pixel x mask --> dst */
+
+static void V_TARGET
+V_FN(_op_copy_p_mas_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T one = V(set1)(1);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; m += V_W, s += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), vd;
+
+        if (V(none)(vm)) continue;
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(vm, zero), vd,
+                              V(interp_256)(V(add)(vm, one), V(load)(s), vd)));
+     }
+   _op_copy_p_mas_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void
+V_FN(init_copy_simd_span_funcs)(void)
+{
+   int dp, sc, sp;
+
+   for (dp = DP; dp <= DP_AN; dp++)
+     {
+        for (sc = SC_N; sc <= SC_AA; sc++)
+          {
+             op_copy_span_funcs[SP_N][SM_N][sc][dp][V_CPU] = V_FN(_op_copy_c_dp);
+             op_copy_span_funcs[SP_N][SM_AS][sc][dp][V_CPU] = V_FN(_op_copy_mas_c_dp);
+          }
+        for (sp = SP; sp <= SP_AS; sp++)
+          {
+             op_copy_span_funcs[sp][SM_N][SC][dp][V_CPU] = V_FN(_op_copy_p_c_dp);
+             op_copy_span_funcs[sp][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_copy_p_c_dp);
+             op_copy_span_funcs[sp][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_copy_p_caa_dp);
+             op_copy_span_funcs[sp][SM_AS][SC_N][dp][V_CPU] = V_FN(_op_copy_p_mas_dp);
+          }
+     }
+}
@@ -94,6 +94,15 @@ evas_common_gfx_compositor_copy_rel_get(void)
 # include "./evas_op_copy/op_copy_mask_color_neon.c"
 //# include "./evas_op_copy/op_copy_pixel_mask_color_neon.c"
 
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+# define EVAS_SIMD_W 4
+# include "./evas_op_copy/op_copy_simd.c"
+# undef EVAS_SIMD_W
+# define EVAS_SIMD_W 8
+# include "./evas_op_copy/op_copy_simd.c"
+# undef EVAS_SIMD_W
+#endif
+
 
 static void
 op_copy_init(void)
@@ -139,6 +148,10 @@ op_copy_init(void)
    init_copy_color_pt_funcs_c();
    init_copy_mask_color_pt_funcs_c();
 #endif
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+   init_copy_simd_span_funcs_sse4();
+   init_copy_simd_span_funcs_avx2();
+#endif
 }
 
 static void
@@ -151,6 +164,20 @@ copy_gfx_span_func_cpu(int s, int m, int c, int d)
 {
    RGBA_Gfx_Func  func = NULL;
    int cpu = CPU_N;
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     {
+	cpu = CPU_AVX2;
+	func = op_copy_span_funcs[s][m][c][d][cpu];
+	if (func) return func;
+     }
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE4_1))
+     {
+	cpu = CPU_SSE4;
+	func = op_copy_span_funcs[s][m][c][d][cpu];
+	if (func) return func;
+     }
+#endif
 #ifdef BUILD_MMX
    if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
     {
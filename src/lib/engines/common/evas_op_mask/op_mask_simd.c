@@ -0,0 +1,115 @@
+/* mask spans, sse4.1 / avx2 */
+
+#include "evas_blend_simd.h"
+
+/* mask color --> dst */
+
+static void V_TARGET
+V_FN(_op_mask_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(1 + (c >> 24));
+
+   for (; d < e; d += V_W)
+     V(store)(d, V(mul_256)(vc, V(load)(d)));
+   _op_mask_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mask pixel --> dst */
+
+static void V_TARGET
+V_FN(_op_mask_p_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(mul_sym)(V(alpha)(V(load)(s)), V(load)(d)));
+   _op_mask_p_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mask pixel x color --> dst */
+
+static void V_TARGET
+V_FN(_op_mask_p_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(1 + (c >> 24));
+   const V_T one = V(set1)(1);
+
+   for (; d < e; s += V_W, d += V_W)
+     {
+        V_T a = V(add)(one, V(shr)(V(mullo)(vc, V(alpha)(V(load)(s))), 8));
+
+        V(store)(d, V(mul_256)(a, V(load)(d)));
+     }
+   _op_mask_p_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mask mask x color -> dst. with m at 0 or 255 the general formula
+ * comes out as 256 and 1 + a, just what the C kernel picks for them */
+
+static void V_TARGET
+V_FN(_op_mask_mas_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T nc = V(set1)(257 - (1 + (c >> 24)));
+   const V_T v256 = V(set1)(256);
+
+   for (; d < e; m += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), a;
+
+        if (V(none)(vm)) continue;
+        a = V(sub)(v256, V(shr)(V(mullo)(nc, vm), 8));
+        V(store)(d, V(mul_256)(a, V(load)(d)));
+     }
+   _op_mask_mas_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mask pixel x mask --> dst */
+
+static void V_TARGET
+V_FN(_op_mask_p_mas_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T v255 = V(set1)(255);
+   const V_T v256 = V(set1)(256);
+
+   for (; d < e; m += V_W, s += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), sa, a, vd;
+
+        if (V(none)(vm)) continue;
+        sa = V(alpha)(V(load)(s));
+        vd = V(load)(d);
+        a = V(sub)(v256, V(shr)(V(mullo)(V(sub)(v256, sa), vm), 8));
+        V(store)(d, V(select)(V(eq)(vm, v255), V(mul_sym)(sa, vd),
+                              V(mul_256)(a, vd)));
+     }
+   _op_mask_p_mas_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void
+V_FN(init_mask_simd_span_funcs)(void)
+{
+   int dp;
+
+   for (dp = DP; dp <= DP_AN; dp++)
+     {
+        op_mask_span_funcs[SP_N][SM_N][SC][dp][V_CPU] = V_FN(_op_mask_c_dp);
+        op_mask_span_funcs[SP_N][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_mask_c_dp);
+
+        op_mask_span_funcs[SP][SM_N][SC_N][dp][V_CPU] = V_FN(_op_mask_p_dp);
+        op_mask_span_funcs[SP_AS][SM_N][SC_N][dp][V_CPU] = V_FN(_op_mask_p_dp);
+
+        op_mask_span_funcs[SP][SM_N][SC][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+        op_mask_span_funcs[SP_AS][SM_N][SC][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+        op_mask_span_funcs[SP_AN][SM_N][SC][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+        op_mask_span_funcs[SP][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+        op_mask_span_funcs[SP_AS][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+        op_mask_span_funcs[SP][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+        op_mask_span_funcs[SP_AS][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+        op_mask_span_funcs[SP_AN][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_mask_p_c_dp);
+
+        op_mask_span_funcs[SP_N][SM_AS][SC][dp][V_CPU] = V_FN(_op_mask_mas_c_dp);
+        op_mask_span_funcs[SP_N][SM_AS][SC_AA][dp][V_CPU] = V_FN(_op_mask_mas_c_dp);
+
+        op_mask_span_funcs[SP][SM_AS][SC_N][dp][V_CPU] = V_FN(_op_mask_p_mas_dp);
+        op_mask_span_funcs[SP_AS][SM_AS][SC_N][dp][V_CPU] = V_FN(_op_mask_p_mas_dp);
+     }
+}
@@ -49,6 +49,15 @@ evas_common_gfx_compositor_mask_get(void)
 # include "./evas_op_mask/op_mask_mask_color_i386.c"
 //# include "./evas_op_mask/op_mask_pixel_mask_color_i386.c"
 
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+# define EVAS_SIMD_W 4
+# include "./evas_op_mask/op_mask_simd.c"
+# undef EVAS_SIMD_W
+# define EVAS_SIMD_W 8
+# include "./evas_op_mask/op_mask_simd.c"
+# undef EVAS_SIMD_W
+#endif
+
 
 static void
 op_mask_init(void)
@@ -81,6 +90,10 @@ op_mask_init(void)
    init_mask_color_pt_funcs_c();
    init_mask_mask_color_pt_funcs_c();
 #endif
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+   init_mask_simd_span_funcs_sse4();
+   init_mask_simd_span_funcs_avx2();
+#endif
 }
 
 static void
@@ -93,6 +106,20 @@ mask_gfx_span_func_cpu(int s, int m, int c, int d)
 {
    RGBA_Gfx_Func func = NULL;
    int cpu = CPU_N;
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     {
+	cpu = CPU_AVX2;
+	func = op_mask_span_funcs[s][m][c][d][cpu];
+	if (func) return func;
+     }
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE4_1))
+     {
+	cpu = CPU_SSE4;
+	func = op_mask_span_funcs[s][m][c][d][cpu];
+	if (func) return func;
+     }
+#endif
 #ifdef BUILD_MMX
    if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
     {
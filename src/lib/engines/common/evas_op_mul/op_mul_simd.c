@@ -0,0 +1,150 @@
+/* mul spans, sse4.1 / avx2 */
+
+#include "evas_blend_simd.h"
+
+/* mul color --> dst */
+
+static void V_TARGET
+V_FN(_op_mul_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+
+   for (; d < e; d += V_W)
+     V(store)(d, V(mul4_sym)(vc, V(load)(d)));
+   _op_mul_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_mul_caa_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(1 + (c >> 24));
+
+   for (; d < e; d += V_W)
+     V(store)(d, V(mul_256)(vc, V(load)(d)));
+   _op_mul_caa_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mul pixel --> dst */
+
+static void V_TARGET
+V_FN(_op_mul_p_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(mul4_sym)(V(load)(s), V(load)(d)));
+   _op_mul_p_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mul pixel x color --> dst */
+
+static void V_TARGET
+V_FN(_op_mul_p_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(c);
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(mul4_sym)(V(mul4_sym)(vc, V(load)(s)), V(load)(d)));
+   _op_mul_p_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_mul_p_caa_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T vc = V(set1)(1 + (c >> 24));
+
+   for (; d < e; s += V_W, d += V_W)
+     V(store)(d, V(mul4_sym)(V(mul_256)(vc, V(load)(s)), V(load)(d)));
+   _op_mul_p_caa_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mul mask x color -> dst. a zero mask gives ~0 for the color, which
+ * MUL4_SYM does not quite treat as 1, so those lanes keep dst */
+
+static void V_TARGET
+V_FN(_op_mul_mas_c_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T nc = V(set1)(~c);
+   const V_T ones = V(set1)(0xffffffff);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; m += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), mc, vd;
+
+        if (V(none)(vm)) continue;
+        mc = V(sub)(ones, V(mul_sym)(vm, nc));
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(vm, zero), vd, V(mul4_sym)(mc, vd)));
+     }
+   _op_mul_mas_c_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* mul pixel x mask --> dst */
+
+static void V_TARGET
+V_FN(_op_mul_p_mas_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T ones = V(set1)(0xffffffff);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; m += V_W, s += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), ms, vd;
+
+        if (V(none)(vm)) continue;
+        ms = V(sub)(ones, V(mul_sym)(vm, V(sub)(ones, V(load)(s))));
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(vm, zero), vd, V(mul4_sym)(ms, vd)));
+     }
+   _op_mul_p_mas_dp(s, m, c, d, l & (V_W - 1));
+}
+
+static void V_TARGET
+V_FN(_op_mul_pan_mas_dp)(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~(V_W - 1));
+   const V_T ones = V(set1)(0xffffffff);
+   const V_T amask = V(set1)(0xff000000);
+   const V_T zero = V(set1)(0);
+
+   for (; d < e; m += V_W, s += V_W, d += V_W)
+     {
+        V_T vm = V(mask)(m), ms, vd;
+
+        if (V(none)(vm)) continue;
+        ms = V(sub)(ones, V(mul_sym)(vm, V(sub)(ones, V(load)(s))));
+        vd = V(load)(d);
+        V(store)(d, V(select)(V(eq)(vm, zero), vd,
+                              V(add)(V(and)(vd, amask), V(mul3_sym)(ms, vd))));
+     }
+   _op_mul_pan_mas_dp(s, m, c, d, l & (V_W - 1));
+}
+
+/* the C pixel x mask spans for rgb dst are left alone, they don't step
+ * through the source */
+static void
+V_FN(init_mul_simd_span_funcs)(void)
+{
+   int dp, sp;
+
+   for (dp = DP; dp <= DP_AN; dp++)
+     {
+        op_mul_span_funcs[SP_N][SM_N][SC][dp][V_CPU] = V_FN(_op_mul_c_dp);
+        op_mul_span_funcs[SP_N][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_mul_c_dp);
+        op_mul_span_funcs[SP_N][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_mul_caa_dp);
+
+        op_mul_span_funcs[SP_N][SM_AS][SC][dp][V_CPU] = V_FN(_op_mul_mas_c_dp);
+        op_mul_span_funcs[SP_N][SM_AS][SC_AN][dp][V_CPU] = V_FN(_op_mul_mas_c_dp);
+        op_mul_span_funcs[SP_N][SM_AS][SC_AA][dp][V_CPU] = V_FN(_op_mul_mas_c_dp);
+
+        for (sp = SP; sp <= SP_AS; sp++)
+          {
+             op_mul_span_funcs[sp][SM_N][SC_N][dp][V_CPU] = V_FN(_op_mul_p_dp);
+             op_mul_span_funcs[sp][SM_N][SC][dp][V_CPU] = V_FN(_op_mul_p_c_dp);
+             op_mul_span_funcs[sp][SM_N][SC_AN][dp][V_CPU] = V_FN(_op_mul_p_c_dp);
+             op_mul_span_funcs[sp][SM_N][SC_AA][dp][V_CPU] = V_FN(_op_mul_p_caa_dp);
+          }
+     }
+   op_mul_span_funcs[SP][SM_AS][SC_N][DP][V_CPU] = V_FN(_op_mul_p_mas_dp);
+   op_mul_span_funcs[SP_AS][SM_AS][SC_N][DP][V_CPU] = V_FN(_op_mul_p_mas_dp);
+   op_mul_span_funcs[SP_AN][SM_AS][SC_N][DP][V_CPU] = V_FN(_op_mul_pan_mas_dp);
+}
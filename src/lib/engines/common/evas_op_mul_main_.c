@@ -49,6 +49,15 @@ evas_common_gfx_compositor_mul_get(void)
 # include "./evas_op_mul/op_mul_mask_color_i386.c"
 // # include "./evas_op_mul/op_mul_pixel_mask_color_i386.c"
 
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+# define EVAS_SIMD_W 4
+# include "./evas_op_mul/op_mul_simd.c"
+# undef EVAS_SIMD_W
+# define EVAS_SIMD_W 8
+# include "./evas_op_mul/op_mul_simd.c"
+# undef EVAS_SIMD_W
+#endif
+
 static void
 op_mul_init(void)
 {
@@ -80,6 +89,10 @@ op_mul_init(void)
    init_mul_color_pt_funcs_c();
    init_mul_mask_color_pt_funcs_c();
 #endif
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+   init_mul_simd_span_funcs_sse4();
+   init_mul_simd_span_funcs_avx2();
+#endif
 }
 
 static void
@@ -92,6 +105,20 @@ mul_gfx_span_func_cpu(int s, int m, int c, int d)
 {
    RGBA_Gfx_Func func = NULL;
    int cpu = CPU_N;
+#if defined(BUILD_X86_TARGETS) && defined(BUILD_C)
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     {
+	cpu = CPU_AVX2;
+	func = op_mul_span_funcs[s][m][c][d][cpu];
+	if (func) return func;
+     }
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE4_1))
+     {
+	cpu = CPU_SSE4;
+	func = op_mul_span_funcs[s][m][c][d][cpu];
+	if (func) return func;
+     }
+#endif
 #ifdef BUILD_MMX
    if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
      {
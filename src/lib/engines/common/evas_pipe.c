@@ -1,5 +1,3 @@
-// THIS IS DEPRECATED. WILL GO EVENTUALLTY. NO NEED TO SUPPORT ANYMORE
-
 #include "evas_common.h"
 
 #ifdef BUILD_PIPE_RENDER
@@ -260,46 +258,6 @@ evas_common_pipe_op_free(RGBA_Pipe_Op *op)
 }
 
 #ifdef BUILD_PTHREAD
-/* main api calls */
-static void *
-evas_common_pipe_thread(void *data)
-{
-   Thinfo *thinfo;
-
-// INF("TH [...........");
-   thinfo = data;
-   for (;;)
-     {
-        RGBA_Pipe_Thread_Info *info;
-        RGBA_Pipe *p;
-
-        /* wait for start signal */
-// INF(" TH %i START...", thinfo->thread_num);
-        pthread_barrier_wait(&(thinfo->barrier[0]));
-        info = thinfo->info;
-// if (info)
-//   {
-//      thinfo->info = NULL;
-//      INF(" TH %i GO", thinfo->thread_num);
-        EINA_INLIST_FOREACH(EINA_INLIST_GET(info->im->cache_entry.pipe), p)
-          {
-             int i;
-
-             for (i = 0; i < p->op_num; i++)
-               {
-                  if (p->op[i].op_func)
-                  p->op[i].op_func(info->im, &(p->op[i]), info);
-               }
-          }
-        free(info);
-//   }
-// INF(" TH %i DONE", thinfo->thread_num);
-        /* send finished signal */
-        pthread_barrier_wait(&(thinfo->barrier[1]));
-     }
-   return NULL;
-}
-
 #ifdef EVAS_FRAME_QUEUING
 static void
 evas_common_frameq_release(void *data)
@@ -797,58 +755,50 @@ evas_common_frameq_thread_post(void *data)
 #endif
 
 #ifdef BUILD_PTHREAD
-static int               thread_num = 0;
-static Thinfo            thinfo[TH_MAX];
-static pthread_barrier_t thbarrier[2];
-#endif
+/* the pipe is replayed on the thread pool. the target surface is cut into
+ * small tiles, each one an item of the pool run. the thread doing the
+ * flush takes part. */
+#define PIPE_TILE_W 128
+#define PIPE_TILE_H 32
 
 static void
-evas_common_pipe_begin(RGBA_Image *im)
+evas_common_pipe_tile_do(void *data, int item)
 {
-#ifdef BUILD_PTHREAD
-   int i, y, h;
-
-#ifdef EVAS_FRAME_QUEUING
-   return;
-#endif
-
-   if (!im->cache_entry.pipe) return;
-   if (thread_num == 1) return;
-   y = 0;
-   h = im->cache_entry.h / thread_num;
-   if (h < 1) h = 1;
-   for (i = 0; i < thread_num; i++)
+   RGBA_Image *im;
+   RGBA_Pipe *p;
+   RGBA_Pipe_Thread_Info info;
+   int cols, i;
+
+   im = data;
+   cols = (im->cache_entry.w + PIPE_TILE_W - 1) / PIPE_TILE_W;
+   info.im = im;
+   info.x = (item % cols) * PIPE_TILE_W;
+   info.y = (item / cols) * PIPE_TILE_H;
+   info.w = PIPE_TILE_W;
+   info.h = PIPE_TILE_H;
+   if ((info.x + info.w) > (int)im->cache_entry.w)
+     info.w = im->cache_entry.w - info.x;
+   if ((info.y + info.h) > (int)im->cache_entry.h)
+     info.h = im->cache_entry.h - info.y;
+
+   EINA_INLIST_FOREACH(EINA_INLIST_GET(im->cache_entry.pipe), p)
      {
-        RGBA_Pipe_Thread_Info *info;
-
-//      if (y >= im->cache_entry.h) break;
-        info = calloc(1, sizeof(RGBA_Pipe_Thread_Info));
-        info->im = im;
-#ifdef EVAS_SLI
-        info->x = 0;
-        info->w = im->cache_entry.w;
-        info->y = i;
-        info->h = thread_num;
-#else
-        info->x = 0;
-        info->y = y;
-        info->w = im->cache_entry.w;
-        if (i == (thread_num - 1))
-          {
-             info->h = im->cache_entry.h - y;
-          }
-        else
+        for (i = 0; i < p->op_num; i++)
           {
-             info->h = h;
+             RGBA_Pipe_Op *op = &(p->op[i]);
+
+             if (!op->op_func) continue;
+             /* most ops touch a few tiles only - skip the rest early */
+             if ((op->context.clip.use) &&
+                 (!RECTS_INTERSECT(info.x, info.y, info.w, info.h,
+                                   op->context.clip.x, op->context.clip.y,
+                                   op->context.clip.w, op->context.clip.h)))
+               continue;
+             op->op_func(im, op, &info);
           }
-        y += info->h;
-#endif
-        thinfo[i].info = info;
      }
-   /* tell worker threads to start */
-   pthread_barrier_wait(&(thbarrier[0]));
-#endif
 }
+#endif
 
 #ifdef EVAS_FRAME_QUEUING
 EAPI void
@@ -956,12 +906,9 @@ evas_common_pipe_flush(RGBA_Image *im)
    if (!im->cache_entry.pipe) return;
 #ifndef EVAS_FRAME_QUEUING
 #ifdef BUILD_PTHREAD
-   if (thread_num > 1)
-     {
-        /* sync worker threads */
-        pthread_barrier_wait(&(thbarrier[1]));
-     }
-   else
+   if (!evas_common_thread_pool_run(evas_common_pipe_tile_do, im,
+                                    ((im->cache_entry.w + PIPE_TILE_W - 1) / PIPE_TILE_W) *
+                                    ((im->cache_entry.h + PIPE_TILE_H - 1) / PIPE_TILE_H)))
 #endif
      {
        RGBA_Pipe *p;
@@ -1472,14 +1419,14 @@ evas_common_pipe_map4_draw_do(RGBA_Image *dst, RGBA_Pipe_Op *op, RGBA_Pipe_Threa
 	evas_common_draw_context_clip_clip(&(context), info->x, info->y, info->w, info->h);
 #endif
 
-	evas_common_map4_rgba(op->op.map4.src, dst,
-			      &context, op->op.map4.p,
+	evas_common_map_rgba(op->op.map4.src, dst,
+			     &context, 4, op->op.map4.p,
 			      op->op.map4.smooth, op->op.map4.level);
      }
    else
      {
-	evas_common_map4_rgba(op->op.map4.src, dst,
-			      &(op->context), op->op.map4.p,
+	evas_common_map_rgba(op->op.map4.src, dst,
+			     &(op->context), 4, op->op.map4.p,
 			      op->op.map4.smooth, op->op.map4.level);
      }
 }
@@ -1559,67 +1506,58 @@ evas_common_pipe_map4_render(RGBA_Image *root)
 	}
     }
 
-  evas_common_pipe_begin(root);
   evas_common_pipe_flush(root);
 }
 
-#ifdef BUILD_PTHREAD
 static Eina_List *task = NULL;
-static Thinfo task_thinfo[TH_MAX];
-static pthread_barrier_t task_thbarrier[2];
-static LK(task_mutext) = PTHREAD_MUTEX_INITIALIZER;
-#endif
 
 #ifdef BUILD_PTHREAD
-static void*
-evas_common_pipe_load(void *data)
+static void
+evas_common_pipe_load(void *data, int item)
 {
-  Thinfo *thinfo;
-
-  thinfo = data;
-  for (;;)
-    {
-      /* wait for start signal */
-      pthread_barrier_wait(&(thinfo->barrier[0]));
-
-      while (task)
-	{
-	  RGBA_Image *im = NULL;
-
-	  LKL(task_mutext);
-	  im = eina_list_data_get(task);
-	  task = eina_list_remove_list(task, task);
-	  LKU(task_mutext);
-
-	  if (im)
-	    {
-	      if (im->cache_entry.space == EVAS_COLORSPACE_ARGB8888)
-		evas_cache_image_load_data(&im->cache_entry);
-	      evas_common_image_colorspace_normalize(im);
-
-	      im->flags &= ~RGBA_IMAGE_TODO_LOAD;
-	    }
-	}
+  RGBA_Image *im;
 
-      /* send finished signal */    
-      pthread_barrier_wait(&(thinfo->barrier[1]));
-    }
+  im = ((RGBA_Image **)data)[item];
+  if (im->cache_entry.space == EVAS_COLORSPACE_ARGB8888)
+    evas_cache_image_load_data(&im->cache_entry);
+  evas_common_image_colorspace_normalize(im);
 
-  return NULL;
+  im->flags &= ~RGBA_IMAGE_TODO_LOAD;
 }
 #endif
 
-static volatile int bval = 0;
-
 static void
 evas_common_pipe_image_load_do(void)
 {
 #ifdef BUILD_PTHREAD
-  /* Notify worker thread. */
-  pthread_barrier_wait(&(task_thbarrier[0]));
+  RGBA_Image *local[64], **ims = local;
+  RGBA_Image *im;
+  int count = 0;
+
+  if (!task) return;
+  if (eina_list_count(task) > (sizeof(local) / sizeof(local[0])))
+    {
+       ims = malloc(eina_list_count(task) * sizeof(RGBA_Image *));
+       if (!ims)
+         {
+            /* no memory, just load them here */
+            EINA_LIST_FREE(task, im)
+              evas_common_pipe_load(&im, 0);
+            return;
+         }
+    }
+  EINA_LIST_FREE(task, im)
+    ims[count++] = im;
 
-  /* sync worker threads */
-  pthread_barrier_wait(&(task_thbarrier[1]));
+  /* decode the pending images on the same pool that renders */
+  if (!evas_common_thread_pool_run(evas_common_pipe_load, ims, count))
+    {
+       int i;
+
+       for (i = 0; i < count; i++)
+         evas_common_pipe_load(ims, i);
+    }
+  if (ims != local) free(ims);
 #endif
 }
 
@@ -1627,62 +1565,15 @@ static Eina_Bool
 evas_common_pipe_init(void)
 {
 #ifdef BUILD_PTHREAD
-   if (thread_num == 0)
+   if (evas_common_thread_pool_threads_get() < 1) return EINA_FALSE;
+#if defined(METRIC_CACHE) || defined(WORD_CACHE)
      {
-	int cpunum;
-	int i;
-
-	cpunum = eina_cpu_count();
-	thread_num = cpunum;
-// on  single cpu we still want this initted.. otherwise we block forever
-// waiting onm pthread barriers for async rendering on a single core!
-//	if (thread_num == 1) return EINA_FALSE;
-
-	pthread_barrier_init(&(thbarrier[0]), NULL, thread_num + 1);
-	pthread_barrier_init(&(thbarrier[1]), NULL, thread_num + 1);
-	for (i = 0; i < thread_num; i++)
-	  {
-	     pthread_attr_t attr;
-	     cpu_set_t cpu;
-
-	     pthread_attr_init(&attr);
-	     CPU_ZERO(&cpu);
-	     CPU_SET(i % cpunum, &cpu);
-	     pthread_attr_setaffinity_np(&attr, sizeof(cpu), &cpu);
-	     thinfo[i].thread_num = i;
-	     thinfo[i].info = NULL;
-	     thinfo[i].barrier = thbarrier;
-	     /* setup initial locks */
-	     pthread_create(&(thinfo[i].thread_id), &attr,
-			    evas_common_pipe_thread, &(thinfo[i]));
-	     pthread_attr_destroy(&attr);
-	  }
-
-	pthread_barrier_init(&(task_thbarrier[0]), NULL, thread_num + 1);
-	pthread_barrier_init(&(task_thbarrier[1]), NULL, thread_num + 1);
-	for (i = 0; i < thread_num; i++)
-	  {
-	     pthread_attr_t attr;
-	     cpu_set_t cpu;
-
-	     pthread_attr_init(&attr);
-	     CPU_ZERO(&cpu);
-	     CPU_SET(i % cpunum, &cpu);
-	     pthread_attr_setaffinity_np(&attr, sizeof(cpu), &cpu);
-	     task_thinfo[i].thread_num = i;
-	     task_thinfo[i].info = NULL;
-	     task_thinfo[i].barrier = task_thbarrier;
-	     /* setup initial locks */
-	     pthread_create(&(task_thinfo[i].thread_id), &attr,
-			    evas_common_pipe_load, &(task_thinfo[i]));
-	     pthread_attr_destroy(&attr);
-	  }
+        static Eina_Bool threads_init = EINA_FALSE;
 
-#if defined(METRIC_CACHE) || defined(WORD_CACHE)
-	eina_threads_init();
-#endif
+        if (!threads_init) eina_threads_init();
+        threads_init = EINA_TRUE;
      }
-   if (thread_num == 1) return EINA_FALSE;
+#endif
    return EINA_TRUE;
 #endif
    return EINA_FALSE;
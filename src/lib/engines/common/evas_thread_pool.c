@@ -0,0 +1,357 @@
+#include "evas_common.h"
+
+#ifdef BUILD_PTHREAD
+/* the one pool of threads all of evas splits its work over. there are
+ * two ways to use it:
+ *
+ * evas_common_thread_pool_run() runs func on items 0 to count - 1 and
+ * returns once all are done. the caller works on them too, as worker 0.
+ * every worker starts on its own contiguous run of items and one that runs
+ * dry steals half of the remaining run of another one. only one such run
+ * is on at a time, anyone else (including a func calling it again) is told
+ * to do its items itself.
+ *
+ * evas_common_thread_pool_task_add() queues a func to be called on
+ * whichever thread is free first, and returns right away.
+ *
+ * the threads are started on first use and stopped and joined by
+ * evas_common_thread_pool_shutdown(). */
+
+typedef struct _Evas_Thread_Pool_Worker Evas_Thread_Pool_Worker;
+typedef struct _Evas_Thread_Pool_Task   Evas_Thread_Pool_Task;
+
+struct _Evas_Thread_Pool_Worker
+{
+   int                       num;
+   pthread_t                 thread_id;
+   LK(lock);
+   unsigned int              generation; // of the run the items are of
+   int                       begin, end; // [begin, end) items left here
+};
+
+struct _Evas_Thread_Pool_Task
+{
+   Evas_Thread_Pool_Task_Func func;
+   void                      *data;
+};
+
+static pthread_mutex_t pool_start_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t pool_busy = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_cond_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_cond_done = PTHREAD_COND_INITIALIZER;
+static int pool_threads_num = -1; // not started yet
+static int pool_worker_num = 0;
+static Evas_Thread_Pool_Worker *pool_workers = NULL;
+static Eina_List *pool_tasks = NULL;
+static Eina_Bool pool_exit = 0;
+
+/* the run on, all under pool_lock */
+static Evas_Thread_Pool_Func pool_func = NULL;
+static void *pool_data = NULL;
+static int pool_count = 0, pool_done = 0;
+static unsigned int pool_generation = 0;
+
+/* a worker still on a run that is over must not take items of the next */
+static int
+_evas_thread_pool_item_get(Evas_Thread_Pool_Worker *w, unsigned int generation)
+{
+   int i, item = -1;
+
+   LKL(w->lock);
+   if ((w->generation == generation) && (w->begin < w->end))
+     item = w->begin++;
+   LKU(w->lock);
+   if (item >= 0) return item;
+
+   /* nothing left here - steal the back half of someone else's run */
+   for (i = 1; i < pool_worker_num; i++)
+     {
+        Evas_Thread_Pool_Worker *v;
+        int begin = 0, end = 0;
+
+        v = &(pool_workers[(w->num + i) % pool_worker_num]);
+        LKL(v->lock);
+        if ((v->generation == generation) && (v->begin < v->end))
+          {
+             end = v->end;
+             begin = v->begin + ((v->end - v->begin) / 2);
+             v->end = begin;
+          }
+        LKU(v->lock);
+        if (begin < end)
+          {
+             LKL(w->lock);
+             w->generation = generation;
+             w->begin = begin + 1;
+             w->end = end;
+             LKU(w->lock);
+             return begin;
+          }
+     }
+   return -1;
+}
+
+static void
+_evas_thread_pool_work(Evas_Thread_Pool_Worker *w, unsigned int generation)
+{
+   Evas_Thread_Pool_Func func;
+   void *data;
+   int item, done = 0;
+
+   /* func and data stay until all items of the run are done */
+   pthread_mutex_lock(&pool_lock);
+   if ((generation != pool_generation) || (!pool_func))
+     {
+        pthread_mutex_unlock(&pool_lock);
+        return;
+     }
+   func = pool_func;
+   data = pool_data;
+   pthread_mutex_unlock(&pool_lock);
+   while ((item = _evas_thread_pool_item_get(w, generation)) >= 0)
+     {
+        func(data, item);
+        done++;
+     }
+   if (done > 0)
+     {
+        pthread_mutex_lock(&pool_lock);
+        pool_done += done;
+        if (pool_done >= pool_count)
+          pthread_cond_broadcast(&pool_cond_done);
+        pthread_mutex_unlock(&pool_lock);
+     }
+}
+
+static void *
+_evas_thread_pool_thread(void *data)
+{
+   Evas_Thread_Pool_Worker *w = data;
+   unsigned int generation;
+
+   pthread_mutex_lock(&pool_lock);
+   generation = pool_generation;
+   for (;;)
+     {
+        Evas_Thread_Pool_Task *t;
+
+        while ((generation == pool_generation) && (!pool_tasks) &&
+               (!pool_exit))
+          pthread_cond_wait(&pool_cond_start, &pool_lock);
+        if (pool_exit) break;
+        if (generation != pool_generation)
+          {
+             generation = pool_generation;
+             pthread_mutex_unlock(&pool_lock);
+             _evas_thread_pool_work(w, generation);
+             pthread_mutex_lock(&pool_lock);
+             continue;
+          }
+        t = eina_list_data_get(pool_tasks);
+        pool_tasks = eina_list_remove_list(pool_tasks, pool_tasks);
+        pthread_mutex_unlock(&pool_lock);
+        t->func(t->data);
+        free(t);
+        pthread_mutex_lock(&pool_lock);
+     }
+   pthread_mutex_unlock(&pool_lock);
+   return NULL;
+}
+
+static int
+_evas_thread_pool_start(void)
+{
+   int i, num, ret;
+
+   pthread_mutex_lock(&pool_start_lock);
+   if (pool_threads_num >= 0) goto done;
+   pool_threads_num = 0;
+   pthread_mutex_lock(&pool_lock);
+   pool_exit = 0;
+   pthread_mutex_unlock(&pool_lock);
+   /* worker 0 is whoever runs a job */
+   num = eina_cpu_count();
+   if (num < 1) num = 1;
+   pool_workers = calloc(num, sizeof(Evas_Thread_Pool_Worker));
+   if (!pool_workers) goto done;
+   for (i = 0; i < num; i++)
+     {
+        pool_workers[i].num = i;
+        LKI(pool_workers[i].lock);
+     }
+   for (i = 1; i < num; i++)
+     {
+        if (pthread_create(&(pool_workers[i].thread_id), NULL,
+                           _evas_thread_pool_thread, &(pool_workers[i])) != 0)
+          {
+             ERR("can't create pool thread %i of %i", i, num - 1);
+             break;
+          }
+     }
+   pool_worker_num = i;
+   pool_threads_num = i - 1;
+ done:
+   ret = pool_threads_num;
+   pthread_mutex_unlock(&pool_start_lock);
+   return ret;
+}
+#endif
+
+/**
+ * The number of threads of the pool, not counting the callers of
+ * evas_common_thread_pool_run(). Starts them if they are not yet.
+ */
+EAPI int
+evas_common_thread_pool_threads_get(void)
+{
+#ifdef BUILD_PTHREAD
+   return _evas_thread_pool_start();
+#else
+   return 0;
+#endif
+}
+
+/**
+ * Run @p func on items 0 to @p count - 1, on the calling thread and the
+ * threads of the pool. Returns once all are done, or EINA_FALSE right
+ * away if the pool did not take them (no threads, or a run is already
+ * on), the caller then has to do them itself.
+ */
+EAPI Eina_Bool
+evas_common_thread_pool_run(Evas_Thread_Pool_Func func, void *data, int count)
+{
+#ifdef BUILD_PTHREAD
+   unsigned int generation;
+   int i, item, per, rem;
+
+   if (count < 2) return EINA_FALSE;
+   if (_evas_thread_pool_start() < 1) return EINA_FALSE;
+   if (pthread_mutex_trylock(&pool_busy) != 0) return EINA_FALSE;
+   /* the pool may have been shut down meanwhile */
+   if (pool_worker_num < 2)
+     {
+        pthread_mutex_unlock(&pool_busy);
+        return EINA_FALSE;
+     }
+
+   /* only runs change the generation, and they hold pool_busy */
+   generation = pool_generation + 1;
+   per = count / pool_worker_num;
+   rem = count % pool_worker_num;
+   item = 0;
+   for (i = 0; i < pool_worker_num; i++)
+     {
+        Evas_Thread_Pool_Worker *w = &(pool_workers[i]);
+
+        LKL(w->lock);
+        w->generation = generation;
+        w->begin = item;
+        item += per + ((i < rem) ? 1 : 0);
+        w->end = item;
+        LKU(w->lock);
+     }
+
+   pthread_mutex_lock(&pool_lock);
+   pool_func = func;
+   pool_data = data;
+   pool_count = count;
+   pool_done = 0;
+   pool_generation = generation;
+   pthread_cond_broadcast(&pool_cond_start);
+   pthread_mutex_unlock(&pool_lock);
+
+   _evas_thread_pool_work(&(pool_workers[0]), generation);
+
+   pthread_mutex_lock(&pool_lock);
+   while (pool_done < pool_count)
+     pthread_cond_wait(&pool_cond_done, &pool_lock);
+   pool_func = NULL;
+   pool_data = NULL;
+   pthread_mutex_unlock(&pool_lock);
+
+   pthread_mutex_unlock(&pool_busy);
+   return EINA_TRUE;
+#else
+   return EINA_FALSE;
+#endif
+}
+
+/**
+ * Have @p func called with @p data on the first thread of the pool that is
+ * free. Returns EINA_FALSE if it could not be queued, the caller then has
+ * to call it itself. Tasks still queued at shutdown are dropped.
+ */
+EAPI Eina_Bool
+evas_common_thread_pool_task_add(Evas_Thread_Pool_Task_Func func, void *data)
+{
+#ifdef BUILD_PTHREAD
+   Evas_Thread_Pool_Task *t;
+
+   if (_evas_thread_pool_start() < 1) return EINA_FALSE;
+   t = malloc(sizeof(Evas_Thread_Pool_Task));
+   if (!t) return EINA_FALSE;
+   t->func = func;
+   t->data = data;
+   pthread_mutex_lock(&pool_lock);
+   if (pool_exit)
+     {
+        /* being shut down */
+        pthread_mutex_unlock(&pool_lock);
+        free(t);
+        return EINA_FALSE;
+     }
+   pool_tasks = eina_list_append(pool_tasks, t);
+   pthread_cond_signal(&pool_cond_start);
+   pthread_mutex_unlock(&pool_lock);
+   return EINA_TRUE;
+#else
+   return EINA_FALSE;
+#endif
+}
+
+/**
+ * Stop the threads of the pool and wait for them. A run on is finished
+ * first, so are the tasks already being done. The next use starts them
+ * again.
+ */
+EAPI void
+evas_common_thread_pool_shutdown(void)
+{
+#ifdef BUILD_PTHREAD
+   Evas_Thread_Pool_Task *t;
+   int i;
+
+   /* from here on the pool looks empty, so whoever wants it meanwhile,
+    * the tasks being done included, does things itself instead of waiting
+    * for pool_start_lock */
+   pthread_mutex_lock(&pool_start_lock);
+   if (pool_threads_num < 0)
+     {
+        pthread_mutex_unlock(&pool_start_lock);
+        return;
+     }
+   pool_threads_num = 0;
+   pthread_mutex_unlock(&pool_start_lock);
+
+   pthread_mutex_lock(&pool_busy);
+   pthread_mutex_lock(&pool_lock);
+   pool_exit = 1;
+   pthread_cond_broadcast(&pool_cond_start);
+   pthread_mutex_unlock(&pool_lock);
+   for (i = 1; i < pool_worker_num; i++)
+     pthread_join(pool_workers[i].thread_id, NULL);
+   EINA_LIST_FREE(pool_tasks, t)
+     free(t);
+   for (i = 0; i < pool_worker_num; i++)
+     LKD(pool_workers[i].lock);
+   free(pool_workers);
+   pool_workers = NULL;
+   pool_worker_num = 0;
+   pthread_mutex_unlock(&pool_busy);
+
+   pthread_mutex_lock(&pool_start_lock);
+   pool_threads_num = -1;
+   pthread_mutex_unlock(&pool_start_lock);
+#endif
+}
@@ -4,60 +4,51 @@
 static const list_node_t list_node_zeroed = { NULL };
 static const list_t list_zeroed = { NULL, NULL };
 
-typedef struct list_node_pool
-{
-   list_node_t *node;
-   int len;
-   int max;
-} list_node_pool_t;
-
-static list_node_pool_t list_node_pool = { NULL, 0, 1024 };
-
 void
-rect_list_node_pool_set_max(int max)
+rect_list_node_pool_set_max(list_node_pool_t *pool, int max)
 {
    int diff;
 
-   diff = list_node_pool.len - max;
-   for (; diff > 0 && list_node_pool.node; diff--)
+   diff = pool->len - max;
+   for (; diff > 0 && pool->node; diff--)
      {
         list_node_t *node;
 
-        node = list_node_pool.node;
-        list_node_pool.node = node->next;
-        list_node_pool.len--;
+        node = pool->node;
+        pool->node = node->next;
+        pool->len--;
 
         free(node);
      }
 
-   list_node_pool.max = max;
+   pool->max = max;
 }
 
 void
-rect_list_node_pool_flush(void)
+rect_list_node_pool_flush(list_node_pool_t *pool)
 {
-   while (list_node_pool.node)
+   while (pool->node)
      {
         list_node_t *node;
 
-        node = list_node_pool.node;
-        list_node_pool.node = node->next;
-        list_node_pool.len--;
+        node = pool->node;
+        pool->node = node->next;
+        pool->len--;
 
         free(node);
      }
 }
 
 inline list_node_t *
-rect_list_node_pool_get(void)
+rect_list_node_pool_get(list_node_pool_t *pool)
 {
-   if (list_node_pool.node)
+   if (pool->node)
      {
         list_node_t *node;
 
-        node = list_node_pool.node;
-        list_node_pool.node = node->next;
-        list_node_pool.len--;
+        node = pool->node;
+        pool->node = node->next;
+        pool->len--;
 
         return node;
      }
@@ -65,13 +56,13 @@ rect_list_node_pool_get(void)
 }
 
 inline void
-rect_list_node_pool_put(list_node_t *node)
+rect_list_node_pool_put(list_node_pool_t *pool, list_node_t *node)
 {
-   if (list_node_pool.len < list_node_pool.max)
+   if (pool->len < pool->max)
      {
-        node->next = list_node_pool.node;
-        list_node_pool.node = node;
-        list_node_pool.len++;
+        node->next = pool->node;
+        pool->node = node;
+        pool->len++;
      }
    else free(node);
 }
@@ -140,11 +131,11 @@ rect_list_append_node(list_t *rects, list_node_t *node)
 }
 
 inline void
-rect_list_append(list_t *rects, const rect_t r)
+rect_list_append(list_node_pool_t *pool, list_t *rects, const rect_t r)
 {
    rect_node_t *rect_node;
 
-   rect_node = (rect_node_t *)rect_list_node_pool_get();
+   rect_node = (rect_node_t *)rect_list_node_pool_get(pool);
    rect_node->rect = r;
    rect_node->_lst = list_node_zeroed;
 
@@ -152,12 +143,12 @@ rect_list_append(list_t *rects, const rect_t r)
 }
 
 inline void
-rect_list_append_xywh(list_t *rects, int x, int y, int w, int h)
+rect_list_append_xywh(list_node_pool_t *pool, list_t *rects, int x, int y, int w, int h)
 {
    rect_t r;
 
    rect_init(&r, x, y, w, h);
-   rect_list_append(rects, r);
+   rect_list_append(pool, rects, r);
 }
 
 inline void
@@ -201,16 +192,16 @@ rect_list_unlink_next(list_t *rects, list_node_t *parent_node)
 }
 
 inline void
-rect_list_del_next(list_t *rects, list_node_t *parent_node)
+rect_list_del_next(list_node_pool_t *pool, list_t *rects, list_node_t *parent_node)
 {
     list_node_t *node;
 
     node = rect_list_unlink_next(rects, parent_node);
-    rect_list_node_pool_put(node);
+    rect_list_node_pool_put(pool, node);
 }
 
 void
-rect_list_clear(list_t *rects)
+rect_list_clear(list_node_pool_t *pool, list_t *rects)
 {
    list_node_t *node;
 
@@ -220,7 +211,7 @@ rect_list_clear(list_t *rects)
         list_node_t *aux;
 
         aux = node->next;
-        rect_list_node_pool_put(node);
+        rect_list_node_pool_put(pool, node);
         node = aux;
      }
    *rects = list_zeroed;
@@ -249,7 +240,7 @@ _calc_intra_rect_area(const rect_t a, const rect_t b, int *width, int *height)
 }
 
 static inline void
-_split_strict(list_t *dirty, const rect_t current, rect_t r)
+_split_strict(list_node_pool_t *pool, list_t *dirty, const rect_t current, rect_t r)
 {
    int h_1, h_2, w_1, w_2;
 
@@ -267,7 +258,7 @@ _split_strict(list_t *dirty, const rect_t current, rect_t r)
          *  | `--'  |        `---'
          *  `-------'
          */
-        rect_list_append_xywh(dirty, r.left, r.top, r.width, h_1);
+        rect_list_append_xywh(pool, dirty, r.left, r.top, r.width, h_1);
         r.height -= h_1;
         r.top = current.top;
      }
@@ -281,7 +272,7 @@ _split_strict(list_t *dirty, const rect_t current, rect_t r)
          *    |   |                     |   |
          *    `---'r (b)                `---'
          */
-        rect_list_append_xywh(dirty, r.left, current.bottom, r.width, h_2);
+        rect_list_append_xywh(pool, dirty, r.left, current.bottom, r.width, h_2);
         r.height -= h_2;
      }
 
@@ -293,7 +284,7 @@ _split_strict(list_t *dirty, const rect_t current, rect_t r)
          *     `--|-'  |      `--'     `-'
          *        `----'
          */
-        rect_list_append_xywh(dirty, r.left, r.top, w_1, r.height);
+        rect_list_append_xywh(pool, dirty, r.left, r.top, w_1, r.height);
         /* not necessary to keep these, r (b) will be destroyed */
         /* r.width -= w_1; */
         /* r.left = current.left; */
@@ -308,14 +299,14 @@ _split_strict(list_t *dirty, const rect_t current, rect_t r)
          *  |  `-|--'       `-'    `--'
          *  `----'
          */
-        rect_list_append_xywh(dirty, current.right, r.top, w_2, r.height);
+        rect_list_append_xywh(pool, dirty, current.right, r.top, w_2, r.height);
         /* not necessary to keep this, r (b) will be destroyed */
         /* r.width -= w_2; */
      }
 }
 
 void
-rect_list_del_split_strict(list_t *rects, const rect_t del_r)
+rect_list_del_split_strict(list_node_pool_t *pool, list_t *rects, const rect_t del_r)
 {
    list_t modified = list_zeroed;
    list_node_t *cur_node, *prev_node;
@@ -353,13 +344,13 @@ rect_list_del_split_strict(list_t *rects, const rect_t del_r)
               * current is contained, remove from rects
               */
               cur_node = cur_node->next;
-              rect_list_del_next(rects, prev_node);
+              rect_list_del_next(pool, rects, prev_node);
           }
         else
           {
-              _split_strict(&modified, del_r, current);
+              _split_strict(pool, &modified, del_r, current);
               cur_node = cur_node->next;
-              rect_list_del_next(rects, prev_node);
+              rect_list_del_next(pool, rects, prev_node);
           }
      }
 
@@ -367,7 +358,7 @@ rect_list_del_split_strict(list_t *rects, const rect_t del_r)
 }
 
 void
-rect_list_add_split_strict(list_t *rects, list_node_t *node)
+rect_list_add_split_strict(list_node_pool_t *pool, list_t *rects, list_node_t *node)
 {
    list_t dirty = list_zeroed;
    list_t new_dirty = list_zeroed;
@@ -408,7 +399,7 @@ rect_list_add_split_strict(list_t *rects, list_node_t *node)
 		*  | `---' |
 		*  `-------'
 		*/
-	       rect_list_del_next(&dirty, NULL);
+	       rect_list_del_next(pool, &dirty, NULL);
 	     else if ((intra_width <= 0) || (intra_height <= 0))
 	       {
 		  /*  .---.cur     .---.r
@@ -423,8 +414,8 @@ rect_list_add_split_strict(list_t *rects, list_node_t *node)
 	       }
 	     else
 	       {
-		  _split_strict(&new_dirty, current, r);
-		  rect_list_del_next(&dirty, NULL);
+		  _split_strict(pool, &new_dirty, current, r);
+		  rect_list_del_next(pool, &dirty, NULL);
 	       }
 	  }
         dirty = new_dirty;
@@ -515,7 +506,7 @@ enum
 };
 
 static inline int
-_split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
+_split_fuzzy(list_node_pool_t *pool, list_t *dirty, const rect_t a, rect_t *b)
 {
    int h_1, h_2, w_1, w_2, action;
 
@@ -535,7 +526,7 @@ _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          *  | `--'  |        `---'
          *  `-------'
          */
-        rect_list_append_xywh(dirty, b->left, b->top, b->width, h_1);
+        rect_list_append_xywh(pool, dirty, b->left, b->top, b->width, h_1);
         b->height -= h_1;
         b->top = a.top;
         action = SPLIT_FUZZY_ACTION_SPLIT;
@@ -550,7 +541,7 @@ _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          *    |   |                     |   |
          *    `---'r (b)                `---'
          */
-        rect_list_append_xywh(dirty, b->left, a.bottom, b->width, h_2);
+        rect_list_append_xywh(pool, dirty, b->left, a.bottom, b->width, h_2);
         b->height -= h_2;
         action = SPLIT_FUZZY_ACTION_SPLIT;
      }
@@ -566,7 +557,7 @@ _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          *      `--|-'  |      `--'     `-'
          *         `----'
          */
-        rect_list_append_xywh(dirty, b->left, b->top, w_1, b->height);
+        rect_list_append_xywh(pool, dirty, b->left, b->top, w_1, b->height);
         /* not necessary to keep these, r (b) will be destroyed */
         /* b->width -= w_1; */
         /* b->left = a.left; */
@@ -582,7 +573,7 @@ _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
          * |  `-|--'       `-'    `--'
          * `----'
          */
-        rect_list_append_xywh(dirty, a.right, b->top, w_2, b->height);
+        rect_list_append_xywh(pool, dirty, a.right, b->top, w_2, b->height);
         /* not necessary to keep these, r (b) will be destroyed */
         /* b->width -= w_2; */
         action = SPLIT_FUZZY_ACTION_SPLIT;
@@ -592,7 +583,7 @@ _split_fuzzy(list_t *dirty, const rect_t a, rect_t *b)
 }
 
 list_node_t *
-rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
+rect_list_add_split_fuzzy(list_node_pool_t *pool, list_t *rects, list_node_t *node, int accepted_error)
 {
    list_t dirty = list_zeroed;
    list_node_t *old_last;
@@ -651,7 +642,7 @@ rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
 		  if (old_last == cur_node)
                     old_last = prev_cur_node;
 		  cur_node = cur_node->next;
-		  rect_list_del_next(rects, prev_cur_node);
+		  rect_list_del_next(pool, rects, prev_cur_node);
 	       }
 	     else if ((outer.area - area) <= accepted_error)
 	       {
@@ -690,7 +681,7 @@ rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
 	     else
 	       {
 		  /* split is required */
-		  action = _split_fuzzy(&dirty, current, &r);
+		  action = _split_fuzzy(pool, &dirty, current, &r);
 		  if (action == SPLIT_FUZZY_ACTION_MERGE)
 		    {
 		       /* horizontal merge is possible: remove both, add merged */
@@ -726,7 +717,7 @@ rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error)
 	  }
 
         if (UNLIKELY(keep_dirty)) rect_list_append_node(rects, d_node);
-        else rect_list_node_pool_put(d_node);
+        else rect_list_node_pool_put(pool, d_node);
     }
 
     return old_last;
@@ -762,7 +753,7 @@ _calc_outer_rect_area(const rect_t a, const rect_t b, rect_t *outer)
 }
 
 void
-rect_list_merge_rects(list_t *rects, list_t *to_merge, int accepted_error)
+rect_list_merge_rects(list_node_pool_t *pool, list_t *rects, list_t *to_merge, int accepted_error)
 {
    while (to_merge->head)
      {
@@ -810,19 +801,19 @@ rect_list_merge_rects(list_t *rects, list_t *to_merge, int accepted_error)
 	     rect_list_append_node(rects, n);
 	  }
 	else
-	  rect_list_del_next(to_merge, NULL);
+	  rect_list_del_next(pool, to_merge, NULL);
     }
 }
 
 void
-rect_list_add_split_fuzzy_and_merge(list_t *rects,
+rect_list_add_split_fuzzy_and_merge(list_node_pool_t *pool, list_t *rects,
                                     list_node_t *node,
                                     int split_accepted_error,
                                     int merge_accepted_error)
 {
    list_node_t *n;
 
-   n = rect_list_add_split_fuzzy(rects, node, split_accepted_error);
+   n = rect_list_add_split_fuzzy(pool, rects, node, split_accepted_error);
    if (n && n->next)
      {
         list_t to_merge;
@@ -833,7 +824,7 @@ rect_list_add_split_fuzzy_and_merge(list_t *rects,
         rects->tail = n;
         n->next = NULL;
 
-        rect_list_merge_rects(rects, &to_merge, merge_accepted_error);
+        rect_list_merge_rects(pool, rects, &to_merge, merge_accepted_error);
      }
 }
 #endif /* EVAS_RECT_SPLIT */
@@ -866,6 +857,9 @@ evas_common_tilebuf_new(int w, int h)
    tb->tile_size.h = 8;
    tb->outbuf_w = w;
    tb->outbuf_h = h;
+#ifdef EVAS_RECT_SPLIT
+   tb->pool.max = 1024;
+#endif
 
    return tb;
 }
@@ -876,11 +870,13 @@ evas_common_tilebuf_free(Tilebuf *tb)
 #ifdef RECTUPDATE
    evas_common_regionbuf_free(tb->rb);
 #elif defined(EVAS_RECT_SPLIT)
-   rect_list_clear(&tb->rects);
-   rect_list_node_pool_flush();
+   rect_list_clear(&tb->pool, &tb->rects);
+   rect_list_node_pool_flush(&tb->pool);
 #else
    if (tb->tiles.tiles) free(tb->tiles.tiles);
 #endif
+   evas_common_tilebuf_free_motion_vectors(evas_common_tilebuf_get_motion_vectors(tb));
+   free(tb->frame.rects);
    free(tb);
 }
 
@@ -901,7 +897,7 @@ evas_common_tilebuf_get_tile_size(Tilebuf *tb, int *tw, int *th)
 
 #ifdef EVAS_RECT_SPLIT
 static inline int
-_add_redraw(list_t *rects, int max_w, int max_h, int x, int y, int w, int h)
+_add_redraw(list_node_pool_t *pool, list_t *rects, int max_w, int max_h, int x, int y, int w, int h)
 {
    rect_node_t *rn;
 
@@ -916,13 +912,13 @@ _add_redraw(list_t *rects, int max_w, int max_h, int x, int y, int w, int h)
    h += 2;
    h >>= 1;
 
-   rn = (rect_node_t *)rect_list_node_pool_get();
+   rn = (rect_node_t *)rect_list_node_pool_get(pool);
    rn->_lst = list_node_zeroed;
    rect_init(&rn->rect, x, y, w, h);
    //INF("ACCOUNTING: add_redraw: %4d,%4d %3dx%3d", x, y, w, h);
    //testing on my core2 duo desktop - fuzz of 32 or 48 is best.
 #define FUZZ 32
-   rect_list_add_split_fuzzy_and_merge(rects, (list_node_t *)rn,
+   rect_list_add_split_fuzzy_and_merge(pool, rects, (list_node_t *)rn,
                                        FUZZ * FUZZ, FUZZ * FUZZ);
    return 1;
 }
@@ -941,7 +937,7 @@ evas_common_tilebuf_add_redraw(Tilebuf *tb, int x, int y, int w, int h)
      evas_common_regionbuf_span_add(tb->rb, x, x + w - 1, y + i);
    return 1;
 #elif defined(EVAS_RECT_SPLIT)
-   return _add_redraw(&tb->rects, tb->outbuf_w, tb->outbuf_h, x, y, w, h);
+   return _add_redraw(&tb->pool, &tb->rects, tb->outbuf_w, tb->outbuf_h, x, y, w, h);
 #else
    int tx1, tx2, ty1, ty2, tfx1, tfx2, tfy1, tfy2, xx, yy;
    int num;
@@ -1009,7 +1005,7 @@ evas_common_tilebuf_del_redraw(Tilebuf *tb, int x, int y, int w, int h)
    rect_init(&r, x, y, w, h);
    //ERR("ACCOUNTING: del_redraw: %4d,%4d %3dx%3d", x, y, w, h);
 
-   rect_list_del_split_strict(&tb->rects, r);
+   rect_list_del_split_strict(&tb->pool, &tb->rects, r);
    tb->need_merge = 1;
    return 0;
 #else
@@ -1051,40 +1047,69 @@ evas_common_tilebuf_del_redraw(Tilebuf *tb, int x, int y, int w, int h)
 #endif
 }
 
+/* (x, y, w, h) is a region of the output whose whole content moved by
+ * (dx, dy) since the last frame, like a scrolled view. the part of the
+ * region that is still on screen after the move is recorded to be copied
+ * from the previous frame and only what scrolled in is redrawn. anything
+ * queued for redraw inside the copied area is dropped, so changes there
+ * must be added after this. a region with alpha (its content blends over
+ * something that did not move) or one overlapping another move is just
+ * redrawn as a whole */
 EAPI int
-evas_common_tilebuf_add_motion_vector(Tilebuf *tb, int x, int y, int w, int h, int dx, int dy, int alpha __UNUSED__)
+evas_common_tilebuf_add_motion_vector(Tilebuf *tb, int x, int y, int w, int h, int dx, int dy, int alpha)
 {
-#ifdef EVAS_RECT_SPLIT
-   list_t lr = list_zeroed;
+   Tilebuf_Motion *tm;
+   int cx, cy, cw, ch;
    int num;
 
-   num = _add_redraw(&lr, tb->outbuf_w, tb->outbuf_h, x, y, w, h);
-   num += _add_redraw(&lr, tb->outbuf_w, tb->outbuf_h, x + dx, y + dy, w, h);
-   while (lr.head)
+   if ((w <= 0) || (h <= 0)) return 0;
+   RECTS_CLIP_TO_RECT(x, y, w, h, 0, 0, tb->outbuf_w, tb->outbuf_h);
+   if ((w <= 0) || (h <= 0)) return 0;
+   if ((dx == 0) && (dy == 0)) return 0;
+   cx = x + dx; cy = y + dy; cw = w; ch = h;
+   RECTS_CLIP_TO_RECT(cx, cy, cw, ch, x, y, w, h);
+   if ((alpha) || (cw <= 0) || (ch <= 0))
+     return evas_common_tilebuf_add_redraw(tb, x, y, w, h);
+   /* copies are done one after the other, so one may not read what
+    * another one already wrote */
+   EINA_INLIST_FOREACH(tb->motions, tm)
      {
-        list_node_t *node = rect_list_unlink_next(&lr, NULL);
-        rect_list_add_split_fuzzy_and_merge(&tb->rects, node,
-                                            FUZZ * FUZZ, FUZZ * FUZZ);
+        if (RECTS_INTERSECT(x, y, w, h,
+                            tm->x - ((tm->dx > 0) ? tm->dx : 0),
+                            tm->y - ((tm->dy > 0) ? tm->dy : 0),
+                            tm->w + abs(tm->dx), tm->h + abs(tm->dy)))
+          return evas_common_tilebuf_add_redraw(tb, x, y, w, h);
      }
+   tm = malloc(sizeof(Tilebuf_Motion));
+   if (!tm) return evas_common_tilebuf_add_redraw(tb, x, y, w, h);
+   tm->x = cx; tm->y = cy; tm->w = cw; tm->h = ch;
+   tm->dx = dx; tm->dy = dy;
+   tb->motions = eina_inlist_append(tb->motions, EINA_INLIST_GET(tm));
+
+   evas_common_tilebuf_del_redraw(tb, cx, cy, cw, ch);
+   /* what scrolled in: a full width strip above or below the copy and
+    * a strip left or right of it */
+   num = 0;
+   if (cy > y)
+     num += evas_common_tilebuf_add_redraw(tb, x, y, w, cy - y);
+   if ((cy + ch) < (y + h))
+     num += evas_common_tilebuf_add_redraw(tb, x, cy + ch, w, (y + h) - (cy + ch));
+   if (cx > x)
+     num += evas_common_tilebuf_add_redraw(tb, x, cy, cx - x, ch);
+   if ((cx + cw) < (x + w))
+     num += evas_common_tilebuf_add_redraw(tb, cx + cw, cy, (x + w) - (cx + cw), ch);
    return num;
-#else
-   /* FIXME: need to actually implement motion vectors. for now it just */
-   /*        implements redraws */
-   int num;
-
-   num = evas_common_tilebuf_add_redraw(tb, x, y, w, h);
-   num += evas_common_tilebuf_add_redraw(tb, x + dx, y + dy, w, h);
-   return num;
-#endif
 }
 
 EAPI void
 evas_common_tilebuf_clear(Tilebuf *tb)
 {
+   evas_common_tilebuf_free_motion_vectors(evas_common_tilebuf_get_motion_vectors(tb));
+   tb->frame.num = 0;
 #ifdef RECTUPDATE
    evas_common_regionbuf_clear(tb->rb);
 #elif defined(EVAS_RECT_SPLIT)
-   rect_list_clear(&tb->rects);
+   rect_list_clear(&tb->pool, &tb->rects);
    tb->need_merge = 0;
 #else
    if (!tb->tiles.tiles) return;
@@ -1092,20 +1117,117 @@ evas_common_tilebuf_clear(Tilebuf *tb)
 #endif
 }
 
+/* out of memory for another rect. rather than lose damage, grow the last
+ * rect over the new one */
+static void
+_tilebuf_frame_rect_merge(Tilebuf *tb, int x, int y, int w, int h)
+{
+   Tilebuf_Rect *r;
+   int x2, y2;
+
+   r = tb->frame.alloc ? tb->frame.rects + tb->frame.num - 1 : &(tb->frame.whole);
+   if (tb->frame.num == 0)
+     {
+        r->x = x;
+        r->y = y;
+        r->w = w;
+        r->h = h;
+        tb->frame.num = 1;
+        return;
+     }
+   x2 = MAX(r->x + r->w, x + w);
+   y2 = MAX(r->y + r->h, y + h);
+   r->x = MIN(r->x, x);
+   r->y = MIN(r->y, y);
+   r->w = x2 - r->x;
+   r->h = y2 - r->y;
+}
+
+/* render rects are handed out from one array owned by the tilebuf. it
+ * grows to the largest frame seen and is only emptied, never freed, when
+ * the frame is done, so getting the rects of a frame allocates nothing
+ * once the canvas has settled */
+static Eina_Bool
+_tilebuf_frame_rect_add(Tilebuf *tb, int x, int y, int w, int h)
+{
+   Tilebuf_Rect *r;
+
+   if (tb->frame.num >= tb->frame.alloc)
+     {
+        Tilebuf_Rect *tmp;
+        int alloc;
+
+        alloc = tb->frame.alloc ? tb->frame.alloc * 2 : 32;
+        tmp = realloc(tb->frame.rects, alloc * sizeof(Tilebuf_Rect));
+        if (!tmp)
+          {
+             _tilebuf_frame_rect_merge(tb, x, y, w, h);
+             return EINA_FALSE;
+          }
+        /* what was kept aside while there was no array */
+        if ((!tb->frame.alloc) && (tb->frame.num > 0))
+          tmp[0] = tb->frame.whole;
+        tb->frame.rects = tmp;
+        tb->frame.alloc = alloc;
+     }
+   r = tb->frame.rects + tb->frame.num++;
+   r->x = x;
+   r->y = y;
+   r->w = w;
+   r->h = h;
+   return EINA_TRUE;
+}
+
+/* the array may move while it fills up, so it is only linked up as an
+ * inlist for the engines once it is complete */
+static Tilebuf_Rect *
+_tilebuf_frame_rects_link(Tilebuf *tb)
+{
+   Tilebuf_Rect *rects;
+   int i;
+
+   if (tb->frame.num == 0) return NULL;
+   rects = tb->frame.alloc ? tb->frame.rects : &(tb->frame.whole);
+   for (i = 0; i < tb->frame.num; i++)
+     {
+        Eina_Inlist *l = EINA_INLIST_GET(rects + i);
+
+        l->prev = (i > 0) ? EINA_INLIST_GET(rects + i - 1) : NULL;
+        l->next = (i < (tb->frame.num - 1)) ? EINA_INLIST_GET(rects + i + 1) : NULL;
+        l->last = NULL;
+     }
+   EINA_INLIST_GET(rects)->last = EINA_INLIST_GET(rects + tb->frame.num - 1);
+   return rects;
+}
+
+/* the returned rects stay valid until the next call or until the
+ * tilebuf is cleared */
 EAPI Tilebuf_Rect *
 evas_common_tilebuf_get_render_rects(Tilebuf *tb)
 {
 #ifdef RECTUPDATE
-   return evas_common_regionbuf_rects_get(tb->rb);
+   Tilebuf_Rect *rects, *r;
+
+   tb->frame.num = 0;
+   rects = evas_common_regionbuf_rects_get(tb->rb);
+   EINA_INLIST_FOREACH(EINA_INLIST_GET(rects), r)
+     _tilebuf_frame_rect_add(tb, r->x, r->y, r->w, r->h);
+   while (rects)
+     {
+	r = rects;
+	rects = (Tilebuf_Rect *)eina_inlist_remove(EINA_INLIST_GET(rects), EINA_INLIST_GET(r));
+	free(r);
+     }
+   return _tilebuf_frame_rects_link(tb);
 #elif defined(EVAS_RECT_SPLIT)
    list_node_t *n;
-   Tilebuf_Rect *rects = NULL;
 
+   tb->frame.num = 0;
    if (tb->need_merge) {
        list_t to_merge;
        to_merge = tb->rects;
        tb->rects = list_zeroed;
-       rect_list_merge_rects(&tb->rects, &to_merge, FUZZ * FUZZ);
+       rect_list_merge_rects(&tb->pool, &tb->rects, &to_merge, FUZZ * FUZZ);
        tb->need_merge = 0;
    }
 
@@ -1122,25 +1244,15 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
        RECTS_CLIP_TO_RECT(cur.left, cur.top, cur.width, cur.height,
 			  0, 0, tb->outbuf_w, tb->outbuf_h);
        if ((cur.width > 0) && (cur.height > 0))
-	 {
-	    Tilebuf_Rect *r;
-
-	    r = malloc(sizeof(Tilebuf_Rect));
-	    r->x = cur.left;
-	    r->y = cur.top;
-	    r->w = cur.width;
-	    r->h = cur.height;
-
-	    rects = (Tilebuf_Rect *)eina_inlist_append(EINA_INLIST_GET(rects), EINA_INLIST_GET(r));
-	 }
+	 _tilebuf_frame_rect_add(tb, cur.left, cur.top, cur.width, cur.height);
    }
-   return rects;
+   return _tilebuf_frame_rects_link(tb);
 
 #else
-   Tilebuf_Rect *rects = NULL;
    Tilebuf_Tile *tbt;
    int x, y;
 
+   tb->frame.num = 0;
    tbt = &(TILE(tb, 0, 0));
    for (y = 0; y < tb->tiles.h; y++)
      {
@@ -1150,12 +1262,7 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
 	       {
                   Tilebuf_Tile *tbti;
 		  int can_expand_x = 1, can_expand_y = 1;
-		  Tilebuf_Rect *r = NULL;
 		  int xx = 0, yy = 0;
-		  r = malloc(sizeof(Tilebuf_Rect));
-                  r->_list_data.next = NULL;
-                  r->_list_data.prev = NULL;
-                  r->_list_data.last = NULL;
 
 /* amalgamate tiles */
 #if 1
@@ -1208,35 +1315,52 @@ evas_common_tilebuf_get_render_rects(Tilebuf *tb)
 		  xx = 1;
 		  yy = 1;
 #endif
-		  r->x = x * tb->tile_size.w;
-		  r->y = y * tb->tile_size.h;
-		  r->w = (xx) * tb->tile_size.w;
-		  r->h = (yy) * tb->tile_size.h;
-		  rects = eina_inlist_append(rects, r);
+		  _tilebuf_frame_rect_add(tb,
+					  x * tb->tile_size.w,
+					  y * tb->tile_size.h,
+					  (xx) * tb->tile_size.w,
+					  (yy) * tb->tile_size.h);
 		  x = x + (xx - 1);
                   tbt += xx - 1;
 	       }
 	  }
      }
-   return rects;
+   return _tilebuf_frame_rects_link(tb);
 #endif
 }
 
+/* the rects belong to the tilebuf they came from, this is only kept so
+ * engines don't need to change */
 EAPI void
-evas_common_tilebuf_free_render_rects(Tilebuf_Rect *rects)
+evas_common_tilebuf_free_render_rects(Tilebuf_Rect *rects __UNUSED__)
 {
-   while (rects)
+}
+
+/* hands the recorded copies over to the caller, who has to do them
+ * before drawing any of the render rects */
+EAPI Tilebuf_Motion *
+evas_common_tilebuf_get_motion_vectors(Tilebuf *tb)
+{
+   Tilebuf_Motion *motions;
+
+   motions = (Tilebuf_Motion *)tb->motions;
+   tb->motions = NULL;
+   return motions;
+}
+
+EAPI void
+evas_common_tilebuf_free_motion_vectors(Tilebuf_Motion *motions)
+{
+   while (motions)
      {
-	Tilebuf_Rect *r;
+	Tilebuf_Motion *tm;
 
-	r = rects;
-	rects = (Tilebuf_Rect *)eina_inlist_remove(EINA_INLIST_GET(rects), EINA_INLIST_GET(r));
-	free(r);
+	tm = motions;
+	motions = (Tilebuf_Motion *)eina_inlist_remove(EINA_INLIST_GET(motions), EINA_INLIST_GET(tm));
+	free(tm);
      }
 }
 
-/* need a way of getting rectangles to: blit, re-render */
-
 
 
 
@@ -67,8 +67,12 @@
 #define CPU_SSE2 4
 /* cpu flags count */
 #define CPU_NEON 5
+/* cpu SSE4.1 */
+#define CPU_SSE4 6
+/* cpu AVX2 */
+#define CPU_AVX2 7
 /* cpu flags count */
-#define CPU_LAST 6
+#define CPU_LAST 8
 
 
 /* some useful constants */
@@ -0,0 +1,333 @@
+/* sse4.1 and avx2 helpers for the op span kernels.
+ *
+ * the op_*_simd.c kernels are written once against the V() helpers and
+ * included twice by their op main file, once with EVAS_SIMD_W set to 4
+ * (sse4.1, 4 pixels per vector) and once with it set to 8 (avx2). this
+ * header is included by each pass and points V(), V_T, V_FN() and
+ * friends at the right width every time.
+ *
+ * every helper gives exactly what the matching C macro in
+ * evas_blend_ops.h gives, so the kernels match the C ones bit for bit */
+
+#ifndef EVAS_BLEND_SIMD_H
+#define EVAS_BLEND_SIMD_H
+
+#ifdef BUILD_X86_TARGETS
+# include <immintrin.h>
+
+# define V4_TARGET __attribute__ ((target ("sse4.1")))
+# define V8_TARGET __attribute__ ((target ("avx2")))
+
+/* 4 pixels */
+
+static inline __m128i V4_TARGET
+_evas_v4_load(const DATA32 *p)
+{
+   return _mm_loadu_si128((const __m128i *)p);
+}
+
+static inline void V4_TARGET
+_evas_v4_store(DATA32 *p, __m128i v)
+{
+   _mm_storeu_si128((__m128i *)p, v);
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_set1(DATA32 c)
+{
+   return _mm_set1_epi32(c);
+}
+
+/* mask bytes widened to one per 32 bit lane */
+static inline __m128i V4_TARGET
+_evas_v4_mask(const DATA8 *m)
+{
+   int v;
+
+   memcpy(&v, m, sizeof(v));
+   return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(v));
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_add(__m128i a, __m128i b)
+{
+   return _mm_add_epi32(a, b);
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_sub(__m128i a, __m128i b)
+{
+   return _mm_sub_epi32(a, b);
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_and(__m128i a, __m128i b)
+{
+   return _mm_and_si128(a, b);
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_mullo(__m128i a, __m128i b)
+{
+   return _mm_mullo_epi32(a, b);
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_shr(__m128i a, int n)
+{
+   return _mm_srli_epi32(a, n);
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_alpha(__m128i c)
+{
+   return _mm_srli_epi32(c, 24);
+}
+
+static inline __m128i V4_TARGET
+_evas_v4_eq(__m128i a, __m128i b)
+{
+   return _mm_cmpeq_epi32(a, b);
+}
+
+/* lanes of a where sel is set, of b elsewhere */
+static inline __m128i V4_TARGET
+_evas_v4_select(__m128i sel, __m128i a, __m128i b)
+{
+   return _mm_blendv_epi8(b, a, sel);
+}
+
+static inline int V4_TARGET
+_evas_v4_none(__m128i a)
+{
+   return _mm_testz_si128(a, a);
+}
+
+/* the 4 channels of each pixel times its own 16 bit factor, + rnd, >> 8 */
+static inline __m128i V4_TARGET
+_evas_v4_mul_ch(__m128i lo, __m128i hi, __m128i c, __m128i rnd)
+{
+   const __m128i zero = _mm_setzero_si128();
+
+   lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), lo), rnd);
+   hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), hi), rnd);
+   return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+/* MUL_256(a, c), a is 1 - 256 per pixel */
+static inline __m128i V4_TARGET
+_evas_v4_mul_256(__m128i a, __m128i c)
+{
+   a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+   return _evas_v4_mul_ch(_mm_unpacklo_epi32(a, a), _mm_unpackhi_epi32(a, a),
+                          c, _mm_setzero_si128());
+}
+
+/* MUL_SYM(a, c), a is 0 - 255 per pixel */
+static inline __m128i V4_TARGET
+_evas_v4_mul_sym(__m128i a, __m128i c)
+{
+   a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+   return _evas_v4_mul_ch(_mm_unpacklo_epi32(a, a), _mm_unpackhi_epi32(a, a),
+                          c, _mm_set1_epi16(0xff));
+}
+
+/* MUL4_SYM(x, y). the macro rounds every channel but green */
+static inline __m128i V4_TARGET
+_evas_v4_mul4_sym(__m128i x, __m128i y)
+{
+   const __m128i zero = _mm_setzero_si128();
+
+   return _evas_v4_mul_ch(_mm_unpacklo_epi8(x, zero), _mm_unpackhi_epi8(x, zero),
+                          y, _mm_set1_epi64x(0x00ff00ff000000ffLL));
+}
+
+/* MUL3_SYM(x, y) */
+static inline __m128i V4_TARGET
+_evas_v4_mul3_sym(__m128i x, __m128i y)
+{
+   return _mm_and_si128(_evas_v4_mul4_sym(x, y), _mm_set1_epi32(0x00ffffff));
+}
+
+/* INTERP_256(a, c0, c1), word for word as the macro does it */
+static inline __m128i V4_TARGET
+_evas_v4_interp_256(__m128i a, __m128i c0, __m128i c1)
+{
+   const __m128i m1 = _mm_set1_epi32(0x00ff00ff);
+   const __m128i m2 = _mm_set1_epi32(0xff00ff00);
+   __m128i ag, rb;
+
+   ag = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(c0, 8), m1),
+                      _mm_and_si128(_mm_srli_epi32(c1, 8), m1));
+   ag = _mm_and_si128(_mm_add_epi32(_mm_mullo_epi32(ag, a),
+                                    _mm_and_si128(c1, m2)), m2);
+   rb = _mm_sub_epi32(_mm_and_si128(c0, m1), _mm_and_si128(c1, m1));
+   rb = _mm_and_si128(_mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi32(rb, a), 8),
+                                    _mm_and_si128(c1, m1)), m1);
+   return _mm_add_epi32(ag, rb);
+}
+
+/* 8 pixels. the byte and word unpacks work per 128 bit half, but they
+ * always pair up the same pixels, so nothing needs shuffling across */
+
+static inline __m256i V8_TARGET
+_evas_v8_load(const DATA32 *p)
+{
+   return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline void V8_TARGET
+_evas_v8_store(DATA32 *p, __m256i v)
+{
+   _mm256_storeu_si256((__m256i *)p, v);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_set1(DATA32 c)
+{
+   return _mm256_set1_epi32(c);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_mask(const DATA8 *m)
+{
+   return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)m));
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_add(__m256i a, __m256i b)
+{
+   return _mm256_add_epi32(a, b);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_sub(__m256i a, __m256i b)
+{
+   return _mm256_sub_epi32(a, b);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_and(__m256i a, __m256i b)
+{
+   return _mm256_and_si256(a, b);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_mullo(__m256i a, __m256i b)
+{
+   return _mm256_mullo_epi32(a, b);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_shr(__m256i a, int n)
+{
+   return _mm256_srli_epi32(a, n);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_alpha(__m256i c)
+{
+   return _mm256_srli_epi32(c, 24);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_eq(__m256i a, __m256i b)
+{
+   return _mm256_cmpeq_epi32(a, b);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_select(__m256i sel, __m256i a, __m256i b)
+{
+   return _mm256_blendv_epi8(b, a, sel);
+}
+
+static inline int V8_TARGET
+_evas_v8_none(__m256i a)
+{
+   return _mm256_testz_si256(a, a);
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_mul_ch(__m256i lo, __m256i hi, __m256i c, __m256i rnd)
+{
+   const __m256i zero = _mm256_setzero_si256();
+
+   lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero), lo), rnd);
+   hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero), hi), rnd);
+   return _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_mul_256(__m256i a, __m256i c)
+{
+   a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+   return _evas_v8_mul_ch(_mm256_unpacklo_epi32(a, a), _mm256_unpackhi_epi32(a, a),
+                          c, _mm256_setzero_si256());
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_mul_sym(__m256i a, __m256i c)
+{
+   a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+   return _evas_v8_mul_ch(_mm256_unpacklo_epi32(a, a), _mm256_unpackhi_epi32(a, a),
+                          c, _mm256_set1_epi16(0xff));
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_mul4_sym(__m256i x, __m256i y)
+{
+   const __m256i zero = _mm256_setzero_si256();
+
+   return _evas_v8_mul_ch(_mm256_unpacklo_epi8(x, zero), _mm256_unpackhi_epi8(x, zero),
+                          y, _mm256_set1_epi64x(0x00ff00ff000000ffLL));
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_mul3_sym(__m256i x, __m256i y)
+{
+   return _mm256_and_si256(_evas_v8_mul4_sym(x, y), _mm256_set1_epi32(0x00ffffff));
+}
+
+static inline __m256i V8_TARGET
+_evas_v8_interp_256(__m256i a, __m256i c0, __m256i c1)
+{
+   const __m256i m1 = _mm256_set1_epi32(0x00ff00ff);
+   const __m256i m2 = _mm256_set1_epi32(0xff00ff00);
+   __m256i ag, rb;
+
+   ag = _mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(c0, 8), m1),
+                         _mm256_and_si256(_mm256_srli_epi32(c1, 8), m1));
+   ag = _mm256_and_si256(_mm256_add_epi32(_mm256_mullo_epi32(ag, a),
+                                          _mm256_and_si256(c1, m2)), m2);
+   rb = _mm256_sub_epi32(_mm256_and_si256(c0, m1), _mm256_and_si256(c1, m1));
+   rb = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(rb, a), 8),
+                                          _mm256_and_si256(c1, m1)), m1);
+   return _mm256_add_epi32(ag, rb);
+}
+#endif /* BUILD_X86_TARGETS */
+
+#endif /* EVAS_BLEND_SIMD_H */
+
+/* per pass names */
+#undef V_W
+#undef V_T
+#undef V_TARGET
+#undef V_CPU
+#undef V_FN
+#undef V
+#if EVAS_SIMD_W == 8
+# define V_W 8
+# define V_T __m256i
+# define V_TARGET V8_TARGET
+# define V_CPU CPU_AVX2
+# define V_FN(f) f##_avx2
+# define V(f) _evas_v8_##f
+#else
+# define V_W 4
+# define V_T __m128i
+# define V_TARGET V4_TARGET
+# define V_CPU CPU_SSE4
+# define V_FN(f) f##_sse4
+# define V(f) _evas_v4_##f
+#endif
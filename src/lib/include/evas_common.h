@@ -387,6 +387,7 @@ typedef struct _RGBA_Font             RGBA_Font;
 typedef struct _RGBA_Font_Int         RGBA_Font_Int;
 typedef struct _RGBA_Font_Source      RGBA_Font_Source;
 typedef struct _RGBA_Font_Glyph       RGBA_Font_Glyph;
+typedef struct _RGBA_Font_Atlas_Page  RGBA_Font_Atlas_Page;
 typedef struct _RGBA_Gfx_Compositor   RGBA_Gfx_Compositor;
 
 typedef struct _Cutout_Rect           Cutout_Rect;
@@ -397,6 +398,7 @@ typedef struct _Convert_Pal             Convert_Pal;
 typedef struct _Tilebuf                 Tilebuf;
 typedef struct _Tilebuf_Tile            Tilebuf_Tile;
 typedef struct _Tilebuf_Rect		Tilebuf_Rect;
+typedef struct _Tilebuf_Motion		Tilebuf_Motion;
 
 typedef struct _Evas_Common_Transform        Evas_Common_Transform;
 
@@ -467,9 +469,22 @@ typedef enum _CPU_Features
    CPU_FEATURE_ALTIVEC = (1 << 3),
    CPU_FEATURE_VIS     = (1 << 4),
    CPU_FEATURE_VIS2    = (1 << 5),
-   CPU_FEATURE_NEON    = (1 << 6)
+   CPU_FEATURE_NEON    = (1 << 6),
+   CPU_FEATURE_SSE2    = (1 << 7),
+   CPU_FEATURE_SSSE3   = (1 << 8),
+   CPU_FEATURE_AVX2    = (1 << 9),
+   CPU_FEATURE_SSE4_1  = (1 << 10)
 } CPU_Features;
 
+/* x86 kernels for extensions beyond what the build targets are compiled
+ * per function with target attributes and only called when the cpu has
+ * the matching CPU_FEATURE_ bit */
+#if defined(__GNUC__) && \
+   ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))) && \
+   (defined(__i386__) || defined(__x86_64__))
+# define BUILD_X86_TARGETS 1
+#endif
+
 typedef enum _Font_Hint_Flags
 {
    FONT_NO_HINT,
@@ -521,6 +536,7 @@ struct _Image_Entry
    Evas_Cache_Image      *cache;
 
    const char            *cache_key;
+   unsigned int           cache_hash;
 
    const char            *file;
    const char            *key;
@@ -743,6 +759,8 @@ struct _RGBA_Image
    /* RGBA stuff */
    struct {
       DATA32            *data;
+      void              *map; // disk cache entry data points into, if any
+      size_t             map_size;
       Eina_Bool          no_free : 1;
    } image;
 
@@ -871,6 +889,7 @@ struct _RGBA_Font_Source
       int            orig_upem;
       FT_Face        face;
    } ft;
+   LK(ft_mutex); // guards ft.face and current_size
 };
 
 struct _RGBA_Font_Glyph
@@ -882,6 +901,8 @@ struct _RGBA_Font_Glyph
    void           *ext_dat;
    void           (*ext_dat_free) (void *ext_dat);
    RGBA_Font_Int   *fi;
+   RGBA_Font_Atlas_Page *page; // glyph_out bitmap lives in this atlas page
+   Eina_Bool        retired : 1; // out of the cache, waiting to be freed
 };
 
 struct _RGBA_Gfx_Compositor
@@ -910,6 +931,7 @@ typedef struct list_node list_node_t;
 typedef struct list list_t;
 typedef struct rect rect_t;
 typedef struct rect_node rect_node_t;
+typedef struct list_node_pool list_node_pool_t;
 
 struct list_node
 {
@@ -939,28 +961,43 @@ struct rect_node
     struct rect rect;
 };
 
-void rect_list_node_pool_set_max(int max);
-void rect_list_node_pool_flush(void);
-list_node_t *rect_list_node_pool_get(void);
-void rect_list_node_pool_put(list_node_t *node);
+/* spare rect nodes, one per tilebuf so canvases don't share it */
+struct list_node_pool
+{
+   list_node_t *node;
+   int len;
+   int max;
+};
+
+void rect_list_node_pool_set_max(list_node_pool_t *pool, int max);
+void rect_list_node_pool_flush(list_node_pool_t *pool);
+list_node_t *rect_list_node_pool_get(list_node_pool_t *pool);
+void rect_list_node_pool_put(list_node_pool_t *pool, list_node_t *node);
 
 void rect_init(rect_t *r, int x, int y, int w, int h);
 void rect_list_append_node(list_t *rects, list_node_t *node);
-void rect_list_append(list_t *rects, const rect_t r);
-void rect_list_append_xywh(list_t *rects, int x, int y, int w, int h);
+void rect_list_append(list_node_pool_t *pool, list_t *rects, const rect_t r);
+void rect_list_append_xywh(list_node_pool_t *pool, list_t *rects, int x, int y, int w, int h);
 void rect_list_concat(list_t *rects, list_t *other);
 list_node_t *rect_list_unlink_next(list_t *rects, list_node_t *parent_node);
-void rect_list_del_next(list_t *rects, list_node_t *parent_node);
-void rect_list_clear(list_t *rects);
-void rect_list_del_split_strict(list_t *rects, const rect_t del_r);
-void rect_list_add_split_strict(list_t *rects, list_node_t *node);
-list_node_t *rect_list_add_split_fuzzy(list_t *rects, list_node_t *node, int accepted_error);
-void rect_list_merge_rects(list_t *rects, list_t *to_merge, int accepted_error);void rect_list_add_split_fuzzy_and_merge(list_t *rects, list_node_t *node, int split_accepted_error, int merge_accepted_error);
+void rect_list_del_next(list_node_pool_t *pool, list_t *rects, list_node_t *parent_node);
+void rect_list_clear(list_node_pool_t *pool, list_t *rects);
+void rect_list_del_split_strict(list_node_pool_t *pool, list_t *rects, const rect_t del_r);
+void rect_list_add_split_strict(list_node_pool_t *pool, list_t *rects, list_node_t *node);
+list_node_t *rect_list_add_split_fuzzy(list_node_pool_t *pool, list_t *rects, list_node_t *node, int accepted_error);
+void rect_list_merge_rects(list_node_pool_t *pool, list_t *rects, list_t *to_merge, int accepted_error);
+void rect_list_add_split_fuzzy_and_merge(list_node_pool_t *pool, list_t *rects, list_node_t *node, int split_accepted_error, int merge_accepted_error);
 
 void rect_print(const rect_t r);
 void rect_list_print(const list_t rects);
 #endif /* EVAS_RECT_SPLIT */
 
+struct _Tilebuf_Rect
+{
+   EINA_INLIST;
+   int               x, y, w, h;
+};
+
 struct _Tilebuf
 {
    int outbuf_w;
@@ -975,12 +1012,21 @@ struct _Tilebuf
 #elif defined(EVAS_RECT_SPLIT)
    int need_merge;
    list_t rects;
+   list_node_pool_t pool;
 #else
    struct {
       int           w, h;
       Tilebuf_Tile *tiles;
    } tiles;
 #endif
+   Eina_Inlist *motions;
+
+   /* the render rects of the frame, reused from one frame to the next */
+   struct {
+      Tilebuf_Rect *rects;
+      int           num, alloc;
+      Tilebuf_Rect  whole; /* the only one if rects could not be had */
+   } frame;
 };
 
 struct _Tilebuf_Tile
@@ -998,10 +1044,13 @@ struct _Tilebuf_Tile
  */
 };
 
-struct _Tilebuf_Rect
+/* x, y, w, h is the area to fill by copying what was on screen at
+ * x - dx, y - dy before anything of this frame gets drawn */
+struct _Tilebuf_Motion
 {
    EINA_INLIST;
    int               x, y, w, h;
+   int               dx, dy;
 };
 /*
 struct _Regionbuf
@@ -1099,6 +1148,14 @@ int  evas_common_cpu_has_feature                        (unsigned int feature);
 EAPI void evas_common_cpu_can_do                        (int *mmx, int *sse, int *sse2);
 EAPI void evas_common_cpu_end_opt                       (void);
 
+typedef void (*Evas_Thread_Pool_Func)      (void *data, int item);
+typedef void (*Evas_Thread_Pool_Task_Func) (void *data);
+
+EAPI int       evas_common_thread_pool_threads_get      (void);
+EAPI Eina_Bool evas_common_thread_pool_run              (Evas_Thread_Pool_Func func, void *data, int count);
+EAPI Eina_Bool evas_common_thread_pool_task_add         (Evas_Thread_Pool_Task_Func func, void *data);
+EAPI void      evas_common_thread_pool_shutdown         (void);
+
 /****/
 #include "../engines/common/evas_blend.h"
 
@@ -1142,6 +1199,8 @@ EAPI int           evas_common_tilebuf_add_motion_vector (Tilebuf *tb, int x, in
 EAPI void          evas_common_tilebuf_clear             (Tilebuf *tb);
 EAPI Tilebuf_Rect *evas_common_tilebuf_get_render_rects  (Tilebuf *tb);
 EAPI void          evas_common_tilebuf_free_render_rects (Tilebuf_Rect *rects);
+EAPI Tilebuf_Motion *evas_common_tilebuf_get_motion_vectors (Tilebuf *tb);
+EAPI void          evas_common_tilebuf_free_motion_vectors (Tilebuf_Motion *motions);
 
 /*
 Regionbuf    *evas_common_regionbuf_new       (int w, int h);
@@ -27,6 +27,13 @@ evas_add_rect(Eina_Array *rects, int x, int y, int w, int h)
 {
    Eina_Rectangle *r;
 
+#ifdef EVAS_RENDER_PRE_THREADS
+   if (evas_render_pre_threaded())
+     {
+        evas_render_pre_rect_add(x, y, w, h);
+        return;
+     }
+#endif
    NEW_RECT(r, x, y, w, h);
    if (r) eina_array_push(rects, r);
 }
@@ -88,6 +95,12 @@ evas_event_passes_through(Evas_Object *obj)
    return 0;
 }
 
+static inline Eina_Bool
+evas_object_event_callback_listened(const Evas_Object *obj, Evas_Callback_Type type)
+{
+   return ((obj->callbacks) && (obj->callbacks->mask & (1 << type)));
+}
+
 static inline int
 evas_object_is_visible(Evas_Object *obj)
 {
@@ -180,6 +193,7 @@ evas_object_clip_recalc(Evas_Object *obj)
 {
    int cx, cy, cw, ch, cvis, cr, cg, cb, ca;
    int nx, ny, nw, nh, nvis, nr, ng, nb, na;
+   Eina_Bool moved;
 
    if ((!obj->cur.cache.clip.dirty) &&
        !(!obj->cur.clipper || obj->cur.clipper->cur.cache.clip.dirty))
@@ -230,6 +244,9 @@ evas_object_clip_recalc(Evas_Object *obj)
 	ca = (ca * (na + 1)) >> 8;
      }
    if ((ca == 0 && obj->cur.render_op == EVAS_RENDER_BLEND) || (cw <= 0) || (ch <= 0)) cvis = 0;
+   moved = ((obj->cur.cache.clip.x != cx) || (obj->cur.cache.clip.y != cy) ||
+            (obj->cur.cache.clip.w != cw) || (obj->cur.cache.clip.h != ch) ||
+            (!obj->index.node));
    obj->cur.cache.clip.x = cx;
    obj->cur.cache.clip.y = cy;
    obj->cur.cache.clip.w = cw;
@@ -240,6 +257,8 @@ evas_object_clip_recalc(Evas_Object *obj)
    obj->cur.cache.clip.b = cb;
    obj->cur.cache.clip.a = ca;
    obj->cur.cache.clip.dirty = 0;
+   /* keep the hit-testing index in step with the clip cache */
+   if (moved) evas_object_index_update(obj);
 }
 
 #endif
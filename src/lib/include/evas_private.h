@@ -43,6 +43,11 @@ typedef struct _Evas_Format                 Evas_Format;
 typedef struct _Evas_Map_Point              Evas_Map_Point;
 typedef struct _Evas_Smart_Cb_Description_Array Evas_Smart_Cb_Description_Array;
 typedef struct _Evas_Post_Callback          Evas_Post_Callback;
+typedef struct _Evas_Object_Index           Evas_Object_Index;
+typedef struct _Evas_Object_Index_Cell      Evas_Object_Index_Cell;
+typedef struct _Evas_Render_Bins            Evas_Render_Bins;
+typedef struct _Evas_Render_Bin             Evas_Render_Bin;
+typedef struct _Evas_Scroll                 Evas_Scroll;
 
 #define MAGIC_EVAS                 0x70777770
 #define MAGIC_OBJ                  0x71777770
@@ -217,13 +222,58 @@ struct _Evas_Post_Callback
    unsigned char              delete_me : 1;
 };
 
+struct _Evas_Scroll
+{
+   int x, y, w, h;
+   int dx, dy;
+};
+
 struct _Evas_Callbacks
 {
-   Eina_Inlist *callbacks;
+   Eina_Inlist      *callbacks[EVAS_CALLBACK_LAST];
+   DATA32            mask; /* bit per type with a non-empty bucket */
    int               walking_list;
    unsigned char     deletions_waiting : 1;
 };
 
+struct _Evas_Object_Index_Cell
+{
+   Evas_Object     **objs;
+   int               count, alloc;
+};
+
+struct _Evas_Object_Index
+{
+   Evas_Object_Index_Cell *cells;
+   Evas_Object_Index_Cell  big;
+   Eina_List              *objects;
+   Eina_Array              pending;
+   Eina_Array              query;
+   int                     w, h;
+   unsigned int            stamp;
+   unsigned char           order_dirty : 1;
+};
+
+struct _Evas_Render_Bin
+{
+   unsigned int     *objs;
+   int               count, alloc;
+};
+
+struct _Evas_Render_Bins
+{
+   Evas_Render_Bin  *cells;
+   Evas_Render_Bin   always;
+   Evas_Render_Bin   found;
+   unsigned int     *stamps;
+   unsigned char    *obscuring;
+   unsigned char    *hidden;
+   int               count, objs_alloc;
+   unsigned int      stamp;
+   int               w, h;
+   unsigned char     active : 1;
+};
+
 struct _Evas
 {
    EINA_INLIST;
@@ -254,6 +304,7 @@ struct _Evas
 
    Eina_List        *damages;
    Eina_List        *obscures;
+   Eina_List        *scrolls;
 
    Evas_Layer       *layers;
 
@@ -286,6 +337,10 @@ struct _Evas
    Eina_Array     temporary_objects;
    Eina_Array     calculate_objects;
    Eina_Array     clip_changes;
+   Eina_Array     pre_render_objects;
+
+   Evas_Object_Index index;
+   Evas_Render_Bins  render_bins;
 
    Eina_List     *post_events; // free me on evas_free
 
@@ -369,6 +424,7 @@ struct _Evas_Map
    Evas_Coord_Rectangle  normal_geometry; // bounding box of map geom actually
    void                 *surface; // surface holding map if needed
    int                   surface_w, surface_h; // current surface w & h alloc
+   Tilebuf              *damage; // parts of surface to redraw, NULL if all
    Evas_Coord            mx, my; // mouse x, y after conversion to map space
    struct {
       Evas_Coord         px, py, z0, foc;
@@ -443,9 +499,24 @@ struct _Evas_Object
       Eina_List               *proxies;
       void                    *surface;
       int		       w,h;
+      Tilebuf                 *damage; // parts of surface to redraw, NULL if all
+      Evas_Coord               x, y; // where the source was when last drawn
+      unsigned int             stamp; // member changes seen up to then
       Eina_Bool                redraw;
+      Eina_Bool                alpha : 1; // surface has alpha
    } proxy;
 
+   struct {
+      Evas_Coord               x, y, w, h; // last drawn in proxy surfaces
+      unsigned int             stamp; // last change under a proxy source
+      Eina_Bool                valid : 1;
+   } proxy_drawn;
+
+   struct {
+      Evas_Coord               x, y, w, h; // last drawn in map parent surface
+      Eina_Bool                valid : 1;
+   } map_drawn;
+
    Evas_Size_Hints            *size_hints;
 
    int                         last_mouse_down_counter;
@@ -458,6 +529,16 @@ struct _Evas_Object
       int                      in_move, in_resize;
    } doing;
 
+   struct {
+      Eina_List               *node;
+      Evas_Coord               x, y, w, h;
+      int                      cx1, cy1, cx2, cy2;
+      unsigned int             order;
+      unsigned int             stamp;
+      Eina_Bool                big : 1;
+      Eina_Bool                pending : 1;
+   } index;
+
    unsigned char               delete_me;
 
    Evas_Object_Pointer_Mode    pointer_mode : 1;
@@ -476,6 +557,7 @@ struct _Evas_Object
    Eina_Bool                   rect_del : 1;
    Eina_Bool                   mouse_in : 1;
    Eina_Bool                   pre_render_done : 1;
+   Eina_Bool                   pre_render_async : 1;
    Eina_Bool                   intercepted : 1;
    Eina_Bool                   focused : 1;
    Eina_Bool                   in_layer : 1;
@@ -677,6 +759,10 @@ struct _Evas_Func
 
    void (*image_content_hint_set)          (void *data, void *surface, int hint);
    int  (*image_content_hint_get)          (void *data, void *surface);
+
+   Eina_Bool (*font_mask_draw)             (void *data, void *font, DATA8 *mask, int w, int h, int x, int y, const Eina_Unicode *text, const Evas_BiDi_Props *intl_props);
+
+   void (*output_redraws_motion_add)       (void *data, int x, int y, int w, int h, int dx, int dy);
 };
 
 struct _Evas_Image_Load_Func
@@ -726,9 +812,19 @@ int evas_object_clippers_was_visible(Evas_Object *obj);
 void evas_object_clip_across_check(Evas_Object *obj);
 void evas_object_clip_across_clippees_check(Evas_Object *obj);
 void evas_object_mapped_clip_across_mark(Evas_Object *obj);
+void evas_object_proxy_change(Evas_Object *obj);
+void evas_object_proxy_invalidate(Evas_Object *obj);
+void evas_object_proxy_surface_free(Evas_Object *obj);
 void evas_event_callback_call(Evas *e, Evas_Callback_Type type, void *event_info);
 void evas_object_event_callback_call(Evas_Object *obj, Evas_Callback_Type type, void *event_info);
 Eina_List *evas_event_objects_event_list(Evas *e, Evas_Object *stop, int x, int y);
+void evas_object_index_update(Evas_Object *obj);
+void evas_object_index_del(Evas_Object *obj);
+void evas_object_index_clip_dirty(Evas_Object *obj);
+void evas_object_index_order_dirty(Evas_Object *obj);
+void evas_object_index_free(Evas *e);
+void evas_object_index_top_level_recalc(Evas *e);
+void evas_object_index_query(Evas *e, Eina_Array *res, int x, int y, int w, int h);
 int evas_mem_free(int mem_required);
 int evas_mem_degrade(int mem_required);
 void evas_debug_error(void);
@@ -755,7 +851,7 @@ void evas_call_smarts_calculate(Evas *e);
 void *evas_mem_calloc(int size);
 void _evas_post_event_callback_call(Evas *e);
 void _evas_post_event_callback_free(Evas *e);
-void evas_event_callback_list_post_free(Eina_Inlist **list);
+void evas_event_callback_list_post_free(Evas_Callbacks *cbs);
 void evas_object_event_callback_all_del(Evas_Object *obj);
 void evas_object_event_callback_cleanup(Evas_Object *obj);
 void evas_event_callback_all_del(Evas *e);
@@ -818,8 +914,10 @@ void _evas_preload_thread_shutdown(void);
 Evas_Preload_Pthread *evas_preload_thread_run(void (*func_heavy)(void *data),
 					     void (*func_end)(void *data),
 					     void (*func_cancel)(void *data),
-					     const void *data);
+					     const void *data,
+					     Evas_Image_Preload_Priority priority);
 Eina_Bool evas_preload_thread_cancel(Evas_Preload_Pthread *thread);
+void evas_preload_thread_priority_set(Evas_Preload_Pthread *thread, Evas_Image_Preload_Priority priority);
 
 void _evas_walk(Evas *e);
 void _evas_unwalk(Evas *e);
@@ -828,9 +926,24 @@ EAPI int _evas_module_engine_inherit(Evas_Func *funcs, char *name);
 
 void evas_render_invalidate(Evas *e);
 void evas_render_object_recalc(Evas_Object *obj);
+void evas_render_bins_build(Evas *e, Eina_Array *objs);
+Eina_Bool evas_render_bins_query(Evas *e, int x, int y, int w, int h, const unsigned int **objs, int *count);
+void evas_render_bins_free(Evas *e);
+
+#ifdef BUILD_PTHREAD
+# define EVAS_RENDER_PRE_THREADS 1
+Eina_Bool evas_render_pre_run(Eina_Array *objs);
+void evas_render_pre_redraws_flush(Evas *e, Evas_Object *obj, unsigned int pos);
+void evas_render_pre_finish(void);
+Eina_Bool evas_render_pre_threaded(void);
+void evas_render_pre_rect_add(int x, int y, int w, int h);
+int evas_render_pre_rects_take(Eina_Rectangle **rects);
+void evas_render_pre_redraw_add(int x, int y, int w, int h);
+#endif
 
 Eina_Bool evas_map_inside_get(const Evas_Map *m, Evas_Coord x, Evas_Coord y);
 Eina_Bool evas_map_coords_get(const Evas_Map *m, Evas_Coord x, Evas_Coord y, Evas_Coord *mx, Evas_Coord *my, int grab);
+void evas_object_map_surface_invalidate(Evas_Object *obj);
 
 /****************************************************************************/
 /*****************************************/
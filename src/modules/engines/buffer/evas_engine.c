@@ -40,6 +40,7 @@ static void eng_output_tile_size_set(void *data, int w, int h);
 static void eng_output_redraws_rect_add(void *data, int x, int y, int w, int h);
 static void eng_output_redraws_rect_del(void *data, int x, int y, int w, int h);
 static void eng_output_redraws_clear(void *data);
+static void eng_output_redraws_motion_add(void *data, int x, int y, int w, int h, int dx, int dy);
 static void *eng_output_redraws_next_update_get(void *data, int *x, int *y, int *w, int *h, int *cx, int *cy, int *cw, int *ch);
 static void eng_output_redraws_next_update_push(void *data, void *surface, int x, int y, int w, int h);
 static void eng_output_flush(void *data);
@@ -259,6 +260,17 @@ eng_output_redraws_clear(void *data)
    evas_common_tilebuf_clear(re->tb);
 }
 
+static void
+eng_output_redraws_motion_add(void *data, int x, int y, int w, int h, int dx, int dy)
+{
+   Render_Engine *re;
+
+   re = (Render_Engine *)data;
+   /* the last frame is only still there if the whole buffer is ours */
+   if ((!re->ob->dest) || (re->ob->func.new_update_region)) return;
+   evas_common_tilebuf_add_motion_vector(re->tb, x, y, w, h, dx, dy, 0);
+}
+
 static void *
 eng_output_redraws_next_update_get(void *data, int *x, int *y, int *w, int *h, int *cx, int *cy, int *cw, int *ch)
 {
@@ -275,6 +287,14 @@ eng_output_redraws_next_update_get(void *data, int *x, int *y, int *w, int *h, i
      }
    if (!re->rects)
      {
+	Tilebuf_Motion *motions, *tm;
+
+	/* scrolled content is copied before anything is drawn over it */
+	motions = evas_common_tilebuf_get_motion_vectors(re->tb);
+	EINA_INLIST_FOREACH(EINA_INLIST_GET(motions), tm)
+	  evas_buffer_outbuf_buf_copy_region(re->ob, tm->x, tm->y, tm->w, tm->h,
+					     tm->dx, tm->dy);
+	evas_common_tilebuf_free_motion_vectors(motions);
 	re->rects = evas_common_tilebuf_get_render_rects(re->tb);
 	re->cur_rect = EINA_INLIST_GET(re->rects);
      }
@@ -370,6 +390,7 @@ module_open(Evas_Module *em)
    ORD(output_redraws_rect_add);
    ORD(output_redraws_rect_del);
    ORD(output_redraws_clear);
+   ORD(output_redraws_motion_add);
    ORD(output_redraws_next_update_get);
    ORD(output_redraws_next_update_push);
    ORD(output_flush);
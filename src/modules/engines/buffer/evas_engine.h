@@ -78,6 +78,7 @@ Outbuf      *evas_buffer_outbuf_buf_setup_fb               (int w, int h, Outbuf
 
 
 RGBA_Image  *evas_buffer_outbuf_buf_new_region_for_update  (Outbuf *buf, int x, int y, int w, int h, int *cx, int *cy, int *cw, int *ch);
+void         evas_buffer_outbuf_buf_copy_region            (Outbuf *buf, int x, int y, int w, int h, int dx, int dy);
 void         evas_buffer_outbuf_buf_free_region_for_update (Outbuf *buf, RGBA_Image *update);
 void         evas_buffer_outbuf_buf_push_updated_region    (Outbuf *buf, RGBA_Image *update, int x, int y, int w, int h);
 
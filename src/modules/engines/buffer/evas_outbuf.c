@@ -98,6 +98,32 @@ evas_buffer_outbuf_buf_new_region_for_update(Outbuf *buf, int x, int y, int w, i
    return im;
 }
 
+void
+evas_buffer_outbuf_buf_copy_region(Outbuf *buf, int x, int y, int w, int h, int dx, int dy)
+{
+   DATA8 *src, *dst;
+   int bpp, row_bytes, yy;
+
+   /* moves what the last frame left at x - dx, y - dy to x, y */
+   bpp = sizeof(DATA32);
+   if ((buf->depth == OUTBUF_DEPTH_RGB_24BPP_888_888) ||
+       (buf->depth == OUTBUF_DEPTH_BGR_24BPP_888_888))
+     bpp = 3;
+   row_bytes = buf->dest_row_bytes;
+   dst = (DATA8 *)(buf->dest) + (y * row_bytes) + (x * bpp);
+   src = dst - (dy * row_bytes) - (dx * bpp);
+   if (dy > 0)
+     {
+	for (yy = h - 1; yy >= 0; yy--)
+	  memmove(dst + (yy * row_bytes), src + (yy * row_bytes), w * bpp);
+     }
+   else
+     {
+	for (yy = 0; yy < h; yy++)
+	  memmove(dst + (yy * row_bytes), src + (yy * row_bytes), w * bpp);
+     }
+}
+
 void
 evas_buffer_outbuf_buf_free_region_for_update(Outbuf *buf, RGBA_Image *update)
 {
@@ -1214,6 +1214,22 @@ evas_engine_dfb_image_colorspace_get(void *data __UNUSED__, void *image)
    return eim->cache_entry.src->space;
 }
 
+/* only the 2 original yuv spaces are handled here, the others are not
+ * drawn */
+static int
+_dfb_colorspace_supported(int cspace)
+{
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_ARGB8888:
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+      case EVAS_COLORSPACE_YCBCR422P709_PL:
+        return 1;
+      default:
+        return 0;
+     }
+}
+
 static void
 evas_engine_dfb_image_colorspace_set(void *data, void *image, int cspace)
 {
@@ -1221,6 +1237,7 @@ evas_engine_dfb_image_colorspace_set(void *data, void *image, int cspace)
 
    if (!eim) return;
    if (eim->cache_entry.src->space == cspace) return;
+   if (!_dfb_colorspace_supported(cspace)) return;
 
    evas_cache_engine_image_colorspace(&eim->cache_entry, cspace, data);
 }
@@ -1230,6 +1247,7 @@ evas_engine_dfb_image_new_from_copied_data(void *data, int w, int h, DATA32* ima
 {
    Render_Engine *re = data;
 
+   if (!_dfb_colorspace_supported(cspace)) return NULL;
    return evas_cache_engine_image_copied_data(re->cache, w, h, image_data,
 					      alpha, cspace, NULL);
 }
@@ -1239,6 +1257,7 @@ evas_engine_dfb_image_new_from_data(void *data, int w, int h, DATA32* image_data
 {
    Render_Engine *re = data;
 
+   if (!_dfb_colorspace_supported(cspace)) return NULL;
    return evas_cache_engine_image_data(re->cache, w, h, image_data,
 				       alpha, cspace, NULL);
 }
@@ -1336,7 +1355,7 @@ evas_engine_dfb_image_data_get(void *data __UNUSED__, void *image, int to_write,
         *image_data = im->cs.data;
         break;
      default:
-        abort();
+        *image_data = NULL;
         break;
      }
    return deie;
@@ -1394,7 +1413,6 @@ evas_engine_dfb_image_data_put(void *data, void *image, DATA32* image_data)
           }
         break;
      default:
-        abort();
         break;
      }
    return deie;
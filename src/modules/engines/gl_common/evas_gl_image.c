@@ -1,5 +1,20 @@
 #include "evas_gl_private.h"
 
+/* only the 2 original yuv spaces have a shader, the others are not drawn */
+int
+evas_gl_common_image_colorspace_supported(int cspace)
+{
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_ARGB8888:
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+      case EVAS_COLORSPACE_YCBCR422P709_PL:
+        return 1;
+      default:
+        return 0;
+     }
+}
+
 void
 evas_gl_common_image_all_unload(Evas_GL_Context *gc)
 {
@@ -69,6 +84,7 @@ evas_gl_common_image_new_from_data(Evas_GL_Context *gc, unsigned int w, unsigned
    Evas_GL_Image *im;
    Eina_List *l;
 
+   if (!evas_gl_common_image_colorspace_supported(cspace)) return NULL;
    if (data)
      {
         EINA_LIST_FOREACH(gc->shared->images, l, im)
@@ -111,7 +127,6 @@ evas_gl_common_image_new_from_data(Evas_GL_Context *gc, unsigned int w, unsigned
 	im->cs.no_free = 1;
 	break;
       default:
-	abort();
 	break;
      }
    return im;
@@ -122,6 +137,7 @@ evas_gl_common_image_new_from_copied_data(Evas_GL_Context *gc, unsigned int w, u
 {
    Evas_GL_Image *im;
 
+   if (!evas_gl_common_image_colorspace_supported(cspace)) return NULL;
    im = calloc(1, sizeof(Evas_GL_Image));
    if (!im) return NULL;
    im->references = 1;
@@ -152,7 +168,6 @@ evas_gl_common_image_new_from_copied_data(Evas_GL_Context *gc, unsigned int w, u
 	  memcpy(im->cs.data, data, im->im->cache_entry.h * sizeof(unsigned char *) * 2);
 	break;
       default:
-	abort();
 	break;
      }
    return im;
@@ -163,6 +178,7 @@ evas_gl_common_image_new(Evas_GL_Context *gc, unsigned int w, unsigned int h, in
 {
    Evas_GL_Image *im;
 
+   if (!evas_gl_common_image_colorspace_supported(cspace)) return NULL;
    im = calloc(1, sizeof(Evas_GL_Image));
    if (!im) return NULL;
    im->references = 1;
@@ -195,7 +211,6 @@ evas_gl_common_image_new(Evas_GL_Context *gc, unsigned int w, unsigned int h, in
           im->cs.data = calloc(1, im->im->cache_entry.h * sizeof(unsigned char *) * 2);
 	break;
       default:
-	abort();
 	break;
      }
    return im;
@@ -454,6 +454,7 @@ eng_image_colorspace_set(void *data, void *image, int cspace)
    if (im->native.data) return;
    /* FIXME: can move to gl_common */
    if (im->cs.space == cspace) return;
+   if (!evas_gl_common_image_colorspace_supported(cspace)) return;
    evas_cache_image_colorspace(&im->im->cache_entry, cspace);
    switch (cspace)
      {
@@ -477,7 +478,6 @@ eng_image_colorspace_set(void *data, void *image, int cspace)
 	im->cs.no_free = 0;
 	break;
       default:
-	abort();
 	break;
      }
    im->cs.space = cspace;
@@ -685,7 +685,7 @@ eng_image_data_get(void *data, void *image, int to_write, DATA32 **image_data)
 	*image_data = im->cs.data;
 	break;
       default:
-	abort();
+	*image_data = NULL;
 	break;
      }
    return im;
@@ -730,7 +730,6 @@ eng_image_data_put(void *data, void *image, DATA32 *image_data)
 	  }
 	break;
       default:
-	abort();
 	break;
      }
    /* hmmm - but if we wrote... why bother? */
@@ -918,6 +917,8 @@ module_open(Evas_Module *em)
    ORD(image_native_set);
    ORD(image_native_get);
    ORD(font_draw);
+   /* glyphs live in textures here, soft styles stay tap by tap */
+   func.font_mask_draw = NULL;
    
    ORD(image_scale_hint_set);
    ORD(image_scale_hint_get);
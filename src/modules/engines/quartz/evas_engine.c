@@ -521,11 +521,29 @@ eng_image_load(void *data, const char *file, const char *key, int *error, Evas_I
    return im;
 }
 
+/* only the 2 original yuv spaces are handled here, the others are not
+ * drawn */
+static int
+_quartz_colorspace_supported(int cspace)
+{
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_ARGB8888:
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+      case EVAS_COLORSPACE_YCBCR422P709_PL:
+        return 1;
+      default:
+        return 0;
+     }
+}
+
 static void *
 eng_image_new_from_data(void *data, int w, int h, DATA32 *image_data, int alpha, int cspace)
 {
-   Evas_Quartz_Image *im = calloc(1, sizeof(Evas_Quartz_Image));
+   Evas_Quartz_Image *im;
 
+   if (!_quartz_colorspace_supported(cspace)) return NULL;
+   im = calloc(1, sizeof(Evas_Quartz_Image));
    if (!im) return NULL;
 
    im->im = (RGBA_Image *)evas_cache_image_data(evas_common_image_cache_get(), w, h, image_data, alpha, cspace);
@@ -543,8 +561,10 @@ eng_image_new_from_data(void *data, int w, int h, DATA32 *image_data, int alpha,
 static void *
 eng_image_new_from_copied_data(void *data, int w, int h, DATA32 *image_data, int alpha, int cspace)
 {
-   Evas_Quartz_Image *im = calloc(1, sizeof(Evas_Quartz_Image));
+   Evas_Quartz_Image *im;
 
+   if (!_quartz_colorspace_supported(cspace)) return NULL;
+   im = calloc(1, sizeof(Evas_Quartz_Image));
    if (!im) return NULL;
 
    im->im = (RGBA_Image *)evas_cache_image_copied_data(evas_common_image_cache_get(), w, h, image_data, alpha, cspace);
@@ -703,7 +723,7 @@ eng_image_colorspace_set(void *data, void *image, int cspace)
 {
    Evas_Quartz_Image *im = (Evas_Quartz_Image *)image;
 
-   if (!im)
+   if ((!im) || (!_quartz_colorspace_supported(cspace)))
       return;
    else
       evas_cache_image_colorspace(&im->im->cache_entry, cspace);
@@ -830,7 +850,7 @@ eng_image_data_get(void *data, void *image, int to_write, DATA32 **image_data)
          im->references++;
          break;
       default:
-         abort(); // this seems ... incredibly unreasonable, but GL does it...
+         if (image_data) *image_data = NULL;
          break;
    }
 
@@ -1247,6 +1267,8 @@ module_open(Evas_Module *em)
    ORD(font_descent_get);
    ORD(font_draw);
    ORD(font_free);
+   /* not a common font, the software mask code can't draw it */
+   func.font_mask_draw = NULL;
    ORD(font_hinting_can_hint);
    ORD(font_hinting_set);
    ORD(font_h_advance_get);
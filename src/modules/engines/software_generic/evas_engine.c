@@ -428,13 +428,10 @@ eng_image_data_get(void *data __UNUSED__, void *image, int to_write, DATA32 **im
           im = (RGBA_Image *) evas_cache_image_alone(&im->cache_entry);
 	*image_data = im->image.data;
 	break;
-      case EVAS_COLORSPACE_YCBCR422P601_PL:
-      case EVAS_COLORSPACE_YCBCR422P709_PL:
+      default:
+	if (!evas_common_convert_yuv_rows_get(im->cache_entry.space, 1)) abort();
 	*image_data = im->cs.data;
         break;
-      default:
-	abort();
-	break;
      }
    return im;
 }
@@ -462,8 +459,8 @@ eng_image_data_put(void *data, void *image, DATA32 *image_data)
 	     im = im2;
 	  }
 	break;
-      case EVAS_COLORSPACE_YCBCR422P601_PL:
-      case EVAS_COLORSPACE_YCBCR422P709_PL:
+      default:
+	if (!evas_common_convert_yuv_rows_get(im->cache_entry.space, 1)) abort();
 	if (image_data != im->cs.data)
 	  {
 	     if (im->cs.data)
@@ -473,9 +470,6 @@ eng_image_data_put(void *data, void *image, DATA32 *image_data)
 	     im->cs.data = image_data;
 	  }
         break;
-      default:
-	abort();
-	break;
      }
    return im;
 }
@@ -589,12 +583,12 @@ eng_image_map_draw(void *data __UNUSED__, void *context, void *surface, void *im
    else
      {
 #ifdef BUILD_PIPE_RENDER
-        if ((cpunum > 1)
+        if ((cpunum > 1) && (npoints == 4)
 # ifdef EVAS_FRAME_QUEUING
        && evas_common_frameq_enabled()
 # endif
         )
-          evas_common_pipe_map_draw(im, surface, context, npoints, p, smooth, level);
+          evas_common_pipe_map4_draw(im, surface, context, p, smooth, level);
         else
 #endif
           evas_common_map_rgba(im, surface, context, npoints, p, smooth, level);
@@ -790,6 +784,12 @@ eng_font_draw(void *data __UNUSED__, void *context, void *surface, void *font, i
      }
 }
 
+static Eina_Bool
+eng_font_mask_draw(void *data __UNUSED__, void *font, DATA8 *mask, int w, int h, int x, int y, const Eina_Unicode *text, const Evas_BiDi_Props *intl_props)
+{
+   return evas_common_font_mask_draw(font, mask, w, h, x, y, text, intl_props);
+}
+
 static void
 eng_font_cache_flush(void *data __UNUSED__)
 {
@@ -943,7 +943,11 @@ static Evas_Func func =
      eng_image_map_surface_new,
      eng_image_map_surface_free,
      NULL, // eng_image_content_hint_set - software doesn't use it
-     NULL // eng_image_content_hint_get - software doesn't use it
+     NULL, // eng_image_content_hint_get - software doesn't use it
+     eng_font_mask_draw,
+     NULL // eng_output_redraws_motion_add - needs an output to copy in, the
+          // outputs that keep the last frame set it (buffer). software_x11
+          // doesn't, copying in a window gets obscured parts wrong
      /* FUTURE software generic calls go here */
 };
 
@@ -361,6 +361,22 @@ evas_engine_sdl_image_colorspace_get(void *data __UNUSED__, void *image)
    return eim->cache_entry.src->space;
 }
 
+/* only the 2 original yuv spaces are handled here, the others are not
+ * drawn */
+static int
+_sdl_colorspace_supported(int cspace)
+{
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_ARGB8888:
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+      case EVAS_COLORSPACE_YCBCR422P709_PL:
+        return 1;
+      default:
+        return 0;
+     }
+}
+
 static void
 evas_engine_sdl_image_colorspace_set(void *data __UNUSED__, void *image, int cspace)
 {
@@ -368,6 +384,7 @@ evas_engine_sdl_image_colorspace_set(void *data __UNUSED__, void *image, int csp
 
    if (!eim) return;
    if (eim->cache_entry.src->space == cspace) return;
+   if (!_sdl_colorspace_supported(cspace)) return;
 
    evas_cache_engine_image_colorspace(&eim->cache_entry, cspace, NULL);
 }
@@ -380,6 +397,7 @@ evas_engine_sdl_image_new_from_copied_data(void *data,
 {
    Render_Engine	*re = (Render_Engine*) data;
 
+   if (!_sdl_colorspace_supported(cspace)) return NULL;
    return evas_cache_engine_image_copied_data(re->cache, w, h, image_data, alpha, cspace, NULL);
 }
 
@@ -388,6 +406,7 @@ evas_engine_sdl_image_new_from_data(void *data, int w, int h, DATA32* image_data
 {
    Render_Engine	*re = (Render_Engine*) data;
 
+   if (!_sdl_colorspace_supported(cspace)) return NULL;
    return evas_cache_engine_image_data(re->cache, w, h, image_data, alpha, cspace, NULL);
 }
 
@@ -453,7 +472,7 @@ evas_engine_sdl_image_data_get(void *data, void *image,
         *image_data = im->cs.data;
         break;
      default:
-        abort();
+        *image_data = NULL;
         break;
      }
    return eim;
@@ -495,7 +514,6 @@ evas_engine_sdl_image_data_put(void *data, void *image, DATA32* image_data)
           }
         break;
      default:
-        abort();
         break;
      }
    return eim;
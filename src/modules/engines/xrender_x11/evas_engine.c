@@ -825,6 +825,22 @@ eng_image_format_get(void *data __UNUSED__, void *image)
    return ((XR_Image *)image)->format;
 }
 
+/* only the 2 original yuv spaces are converted here, the others are not
+ * drawn */
+static int
+_xre_colorspace_supported(int cspace)
+{
+   switch (cspace)
+     {
+      case EVAS_COLORSPACE_ARGB8888:
+      case EVAS_COLORSPACE_YCBCR422P601_PL:
+      case EVAS_COLORSPACE_YCBCR422P709_PL:
+        return 1;
+      default:
+        return 0;
+     }
+}
+
 static void
 eng_image_colorspace_set(void *data, void *image, int cspace)
 {
@@ -834,6 +850,7 @@ eng_image_colorspace_set(void *data, void *image, int cspace)
    if (!image) return;
    im = (XR_Image *)image;
    if (im->cs.space == cspace) return;
+   if (!_xre_colorspace_supported(cspace)) return;
 
    if (im->im) evas_cache_image_drop(&im->im->cache_entry);
    im->im = NULL;
@@ -862,7 +879,6 @@ eng_image_colorspace_set(void *data, void *image, int cspace)
 	im->cs.no_free = 0;
 	break;
       default:
-	abort();
 	break;
      }
    im->cs.space = cspace;
@@ -900,6 +916,7 @@ eng_image_new_from_data(void *data, int w, int h, DATA32 *image_data, int alpha,
    Render_Engine *re;
    XR_Image *im;
 
+   if (!_xre_colorspace_supported(cspace)) return NULL;
    re = (Render_Engine *)data;
    im = re->image_new_from_data(re->xinf, w, h, image_data, alpha, cspace);
    return im;
@@ -911,6 +928,7 @@ eng_image_new_from_copied_data(void *data, int w, int h, DATA32 *image_data, int
    Render_Engine *re;
    XR_Image *im;
 
+   if (!_xre_colorspace_supported(cspace)) return NULL;
    re = (Render_Engine *)data;
    im = re->image_new_from_copied_data(re->xinf, w, h, image_data, alpha, cspace);
    return im;
@@ -1013,7 +1031,8 @@ eng_image_data_get(void *data, void *image, int to_write, DATA32 **image_data)
       case EVAS_COLORSPACE_YCBCR422P709_PL:
 	break;
       default:
-	abort();
+	if (image_data) *image_data = NULL;
+	return im;
 	break;
      }
    if (image_data) *image_data = re->image_data_get(im);
@@ -1082,7 +1101,6 @@ eng_image_data_put(void *data, void *image, DATA32 *image_data)
 	  }
         break;
       default:
-	abort();
 	break;
      }
    return image;
@@ -154,7 +154,6 @@ _xre_xcb_image_new_from_data(Ximage_Info *xinf, int w, int h, void *data, int al
 	im->cs.no_free = 1;
 	break;
       default:
-	abort();
 	break;
      }
    im->dirty = 1;
@@ -198,7 +197,6 @@ _xre_xcb_image_new_from_copied_data(Ximage_Info *xinf, int w, int h, void *data,
 	  memcpy(im->cs.data, data, h * sizeof(unsigned char *) * 2);
 	break;
       default:
-	abort();
 	break;
      }
    im->w = w;
@@ -383,7 +381,6 @@ _xre_xcb_image_resize(XR_Image *im, int w, int h)
 	  }
 	break;
       default:
-	abort();
 	break;
      }
    __xre_xcb_image_dirty_hash_del(im);
@@ -463,7 +460,6 @@ _xre_xcb_image_data_put(XR_Image *im, void *data)
 	im->cs.data = data;
 	break;
       default:
-	abort();
 	break;
      }
    __xre_xcb_image_dirty_hash_del(im);
@@ -597,7 +593,6 @@ _xre_xcb_image_surface_gen(XR_Image *im)
 	       }
 	     break;
 	   default:
-	     abort();
 	     break;
 	  }
 	if (!data) return;